@@ -34,6 +34,7 @@ DEFINE_int32(meta_client_retry_interval_secs, 1, "meta client sleep interval bet
 DEFINE_int32(meta_client_timeout_ms, 60 * 1000, "meta client timeout");
 DEFINE_string(cluster_id_path, "cluster.id", "file path saved clusterId");
 DEFINE_int32(check_plan_killed_frequency, 8, "check plan killed every 1<<n times");
+DEFINE_int32(stats_cache_ttl_secs, 300, "How long the stats of a space are cached by graphd");
 
 namespace nebula {
 namespace meta {
@@ -44,6 +45,7 @@ MetaClient::MetaClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool
     : ioThreadPool_(ioThreadPool),
       addrs_(std::move(addrs)),
       options_(options),
+      metadata_(new MetaData{}),
       sessionMap_(new SessionMap{}),
       killedPlans_(new folly::F14FastSet<std::pair<SessionID, ExecutionPlanID>>{}) {
   CHECK(ioThreadPool_ != nullptr) << "IOThreadPool is required";
@@ -59,6 +61,7 @@ MetaClient::MetaClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool
 
 MetaClient::~MetaClient() {
   stop();
+  delete metadata_.load();
   delete sessionMap_.load();
   delete killedPlans_.load();
   VLOG(3) << "~MetaClient";
@@ -142,7 +145,7 @@ void MetaClient::heartBeatThreadFunc() {
 
   // if MetaServer has some changes, refesh the localCache_
   if (localLastUpdateTime_ < metadLastUpdateTime_) {
-    bool ldRet = loadData();
+    bool ldRet = loadChangedData();
     bool lcRet = true;
     if (!options_.skipConfig_) {
       lcRet = loadCfg();
@@ -210,73 +213,162 @@ bool MetaClient::loadData() {
     return false;
   }
 
-  decltype(localCache_) cache;
-  decltype(spaceIndexByName_) spaceIndexByName;
-  decltype(spaceTagIndexByName_) spaceTagIndexByName;
-  decltype(spaceEdgeIndexByName_) spaceEdgeIndexByName;
-  decltype(spaceNewestTagVerMap_) spaceNewestTagVerMap;
-  decltype(spaceNewestEdgeVerMap_) spaceNewestEdgeVerMap;
-  decltype(spaceEdgeIndexByType_) spaceEdgeIndexByType;
-  decltype(spaceTagIndexById_) spaceTagIndexById;
-  decltype(spaceAllEdgeMap_) spaceAllEdgeMap;
+  auto metadata = std::make_unique<MetaData>();
+  auto& cache = metadata->localCache_;
+  auto& spaceIndexByName = metadata->spaceIndexByName_;
+  auto& spaceTagIndexByName = metadata->spaceTagIndexByName_;
+  auto& spaceEdgeIndexByName = metadata->spaceEdgeIndexByName_;
+  auto& spaceNewestTagVerMap = metadata->spaceNewestTagVerMap_;
+  auto& spaceNewestEdgeVerMap = metadata->spaceNewestEdgeVerMap_;
+  auto& spaceEdgeIndexByType = metadata->spaceEdgeIndexByType_;
+  auto& spaceTagIndexById = metadata->spaceTagIndexById_;
+  auto& spaceAllEdgeMap = metadata->spaceAllEdgeMap_;
 
   for (auto space : ret.value()) {
-    auto spaceId = space.first;
-    MetaClient::PartTerms partTerms;
-    auto r = getPartsAlloc(spaceId, &partTerms).get();
-    if (!r.ok()) {
-      LOG(ERROR) << "Get parts allocation failed for spaceId " << spaceId << ", status "
-                 << r.status();
+    auto spaceCache = loadSpace(space.first,
+                                space.second,
+                                spaceTagIndexByName,
+                                spaceTagIndexById,
+                                spaceEdgeIndexByName,
+                                spaceEdgeIndexByType,
+                                spaceNewestTagVerMap,
+                                spaceNewestEdgeVerMap,
+                                spaceAllEdgeMap);
+    if (spaceCache == nullptr) {
       return false;
     }
+    cache.emplace(space.first, std::move(spaceCache));
+    spaceIndexByName.emplace(space.second, space.first);
+  }
 
-    auto spaceCache = std::make_shared<SpaceInfoCache>();
-    auto partsAlloc = r.value();
-    auto& spaceName = space.second;
-    spaceCache->partsOnHost_ = reverse(partsAlloc);
-    spaceCache->partsAlloc_ = std::move(partsAlloc);
-    spaceCache->termOfPartition_ = std::move(partTerms);
-    VLOG(2) << "Load space " << spaceId << ", parts num:" << spaceCache->partsAlloc_.size();
-
-    // loadSchemas
-    if (!loadSchemas(spaceId,
-                     spaceCache,
-                     spaceTagIndexByName,
-                     spaceTagIndexById,
-                     spaceEdgeIndexByName,
-                     spaceEdgeIndexByType,
-                     spaceNewestTagVerMap,
-                     spaceNewestEdgeVerMap,
-                     spaceAllEdgeMap)) {
-      LOG(ERROR) << "Load Schemas Failed";
-      return false;
-    }
+  auto hostsRet = listHosts().get();
+  if (!ret.ok()) {
+    LOG(ERROR) << "List hosts failed, status:" << hostsRet.status();
+    return false;
+  }
 
-    if (!loadIndexes(spaceId, spaceCache)) {
-      LOG(ERROR) << "Load Indexes Failed";
-      return false;
-    }
+  auto& hostItems = hostsRet.value();
+  std::vector<HostAddr> hosts(hostItems.size());
+  std::transform(hostItems.begin(), hostItems.end(), hosts.begin(), [](auto& hostItem) -> HostAddr {
+    return *hostItem.hostAddr_ref();
+  });
 
-    if (!loadListeners(spaceId, spaceCache)) {
-      LOG(ERROR) << "Load Listeners Failed";
-      return false;
-    }
+  loadLeader(hostItems, spaceIndexByName);
+  metadata->storageHosts_ = std::move(hosts);
+  publishMetaData(std::move(metadata));
+  ready_ = true;
+  return true;
+}
+
+bool MetaClient::loadChangedData() {
+  auto changesRet = getMetaChanges(localLastUpdateTime_).get();
+  if (!changesRet.ok()) {
+    LOG(INFO) << "Get meta changes failed, reload all, status: " << changesRet.status();
+    return loadData();
+  }
+  auto& changes = changesRet.value();
+  if (!ready_ || changes.get_full()) {
+    return loadData();
+  }
+
+  // The users, sessions, hosts and so on are not per space, and cheap to
+  // reload, so only the spaces are loaded incrementally
+  if (!loadUsersAndRoles()) {
+    LOG(ERROR) << "Load roles Failed";
+    return false;
+  }
+
+  if (!loadFulltextClients()) {
+    LOG(ERROR) << "Load fulltext services Failed";
+    return false;
+  }
+
+  if (!loadFulltextIndexes()) {
+    LOG(ERROR) << "Load fulltext indexes Failed";
+    return false;
+  }
+
+  if (!loadSessions()) {
+    LOG(ERROR) << "Load sessions Failed";
+    return false;
+  }
+
+  auto ret = listSpaces().get();
+  if (!ret.ok()) {
+    LOG(ERROR) << "List space failed, status:" << ret.status();
+    return false;
+  }
+  std::unordered_map<GraphSpaceID, std::string> spaceNames;
+  for (auto& space : ret.value()) {
+    spaceNames.emplace(space.first, std::move(space.second));
+  }
 
-    // get space properties
-    auto resp = getSpace(spaceName).get();
-    if (!resp.ok()) {
-      LOG(ERROR) << "Get space properties failed for space " << spaceId;
+  // Copy on write, the caches of the spaces not changed are shared with the
+  // current ones
+  std::unique_ptr<MetaData> metadata;
+  {
+    folly::rcu_reader guard;
+    metadata = std::make_unique<MetaData>(*metadata_.load());
+  }
+  auto& cache = metadata->localCache_;
+  auto& spaceIndexByName = metadata->spaceIndexByName_;
+  auto& spaceTagIndexByName = metadata->spaceTagIndexByName_;
+  auto& spaceEdgeIndexByName = metadata->spaceEdgeIndexByName_;
+  auto& spaceNewestTagVerMap = metadata->spaceNewestTagVerMap_;
+  auto& spaceNewestEdgeVerMap = metadata->spaceNewestEdgeVerMap_;
+  auto& spaceEdgeIndexByType = metadata->spaceEdgeIndexByType_;
+  auto& spaceTagIndexById = metadata->spaceTagIndexById_;
+  auto& spaceAllEdgeMap = metadata->spaceAllEdgeMap_;
+
+  auto eraseSpace = [](auto& map, GraphSpaceID spaceId) {
+    for (auto it = map.begin(); it != map.end();) {
+      if (it->first.first == spaceId) {
+        it = map.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  };
+  for (auto spaceId : changes.get_spaces()) {
+    cache.erase(spaceId);
+    for (auto it = spaceIndexByName.begin(); it != spaceIndexByName.end();) {
+      if (it->second == spaceId) {
+        it = spaceIndexByName.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    eraseSpace(spaceTagIndexByName, spaceId);
+    eraseSpace(spaceTagIndexById, spaceId);
+    eraseSpace(spaceEdgeIndexByName, spaceId);
+    eraseSpace(spaceEdgeIndexByType, spaceId);
+    eraseSpace(spaceNewestTagVerMap, spaceId);
+    eraseSpace(spaceNewestEdgeVerMap, spaceId);
+    spaceAllEdgeMap.erase(spaceId);
+
+    auto nameIt = spaceNames.find(spaceId);
+    if (nameIt == spaceNames.end()) {
+      VLOG(1) << "Space " << spaceId << " has been dropped";
+      continue;
+    }
+    auto spaceCache = loadSpace(spaceId,
+                                nameIt->second,
+                                spaceTagIndexByName,
+                                spaceTagIndexById,
+                                spaceEdgeIndexByName,
+                                spaceEdgeIndexByType,
+                                spaceNewestTagVerMap,
+                                spaceNewestEdgeVerMap,
+                                spaceAllEdgeMap);
+    if (spaceCache == nullptr) {
       return false;
     }
-    auto properties = resp.value().get_properties();
-    spaceCache->spaceDesc_ = std::move(properties);
-
-    cache.emplace(spaceId, spaceCache);
-    spaceIndexByName.emplace(space.second, spaceId);
+    cache.emplace(spaceId, std::move(spaceCache));
+    spaceIndexByName.emplace(nameIt->second, spaceId);
   }
 
   auto hostsRet = listHosts().get();
-  if (!ret.ok()) {
+  if (!hostsRet.ok()) {
     LOG(ERROR) << "List hosts failed, status:" << hostsRet.status();
     return false;
   }
@@ -287,29 +379,81 @@ bool MetaClient::loadData() {
     return *hostItem.hostAddr_ref();
   });
 
-  loadLeader(hostItems, spaceIndexByName_);
+  VLOG(1) << "Reload " << changes.get_spaces().size() << " changed spaces";
+  loadLeader(hostItems, spaceIndexByName);
+  metadata->storageHosts_ = std::move(hosts);
+  publishMetaData(std::move(metadata));
+  return true;
+}
 
-  decltype(localCache_) oldCache;
-  {
-    folly::RWSpinLock::WriteHolder holder(localCacheLock_);
-    oldCache = std::move(localCache_);
-    localCache_ = std::move(cache);
-    spaceIndexByName_ = std::move(spaceIndexByName);
-    spaceTagIndexByName_ = std::move(spaceTagIndexByName);
-    spaceEdgeIndexByName_ = std::move(spaceEdgeIndexByName);
-    spaceNewestTagVerMap_ = std::move(spaceNewestTagVerMap);
-    spaceNewestEdgeVerMap_ = std::move(spaceNewestEdgeVerMap);
-    spaceEdgeIndexByType_ = std::move(spaceEdgeIndexByType);
-    spaceTagIndexById_ = std::move(spaceTagIndexById);
-    spaceAllEdgeMap_ = std::move(spaceAllEdgeMap);
-    storageHosts_ = std::move(hosts);
-  }
-
-  diff(oldCache, localCache_);
-  listenerDiff(oldCache, localCache_);
+void MetaClient::publishMetaData(std::unique_ptr<MetaData> metadata) {
+  // Only the bg thread publishes after the client is ready, so the old one
+  // is not retired by others while diffing
+  auto* newMetaData = metadata.release();
+  auto* oldMetaData = metadata_.exchange(newMetaData);
+  diff(oldMetaData->localCache_, newMetaData->localCache_);
+  listenerDiff(oldMetaData->localCache_, newMetaData->localCache_);
+  folly::rcu_retire(oldMetaData);
   loadRemoteListeners();
-  ready_ = true;
-  return true;
+}
+
+std::shared_ptr<SpaceInfoCache> MetaClient::loadSpace(GraphSpaceID spaceId,
+                                                      const std::string& spaceName,
+                                                      SpaceTagNameIdMap& tagNameIdMap,
+                                                      SpaceTagIdNameMap& tagIdNameMap,
+                                                      SpaceEdgeNameTypeMap& edgeNameTypeMap,
+                                                      SpaceEdgeTypeNameMap& edgeTypeNameMap,
+                                                      SpaceNewestTagVerMap& newestTagVerMap,
+                                                      SpaceNewestEdgeVerMap& newestEdgeVerMap,
+                                                      SpaceAllEdgeMap& allEdgeMap) {
+  MetaClient::PartTerms partTerms;
+  auto r = getPartsAlloc(spaceId, &partTerms).get();
+  if (!r.ok()) {
+    LOG(ERROR) << "Get parts allocation failed for spaceId " << spaceId << ", status "
+               << r.status();
+    return nullptr;
+  }
+
+  auto spaceCache = std::make_shared<SpaceInfoCache>();
+  auto partsAlloc = r.value();
+  spaceCache->partsOnHost_ = reverse(partsAlloc);
+  spaceCache->partsAlloc_ = std::move(partsAlloc);
+  spaceCache->termOfPartition_ = std::move(partTerms);
+  VLOG(2) << "Load space " << spaceId << ", parts num:" << spaceCache->partsAlloc_.size();
+
+  // loadSchemas
+  if (!loadSchemas(spaceId,
+                   spaceCache,
+                   tagNameIdMap,
+                   tagIdNameMap,
+                   edgeNameTypeMap,
+                   edgeTypeNameMap,
+                   newestTagVerMap,
+                   newestEdgeVerMap,
+                   allEdgeMap)) {
+    LOG(ERROR) << "Load Schemas Failed";
+    return nullptr;
+  }
+
+  if (!loadIndexes(spaceId, spaceCache)) {
+    LOG(ERROR) << "Load Indexes Failed";
+    return nullptr;
+  }
+
+  if (!loadListeners(spaceId, spaceCache)) {
+    LOG(ERROR) << "Load Listeners Failed";
+    return nullptr;
+  }
+
+  // get space properties
+  auto resp = getSpace(spaceName).get();
+  if (!resp.ok()) {
+    LOG(ERROR) << "Get space properties failed for space " << spaceId;
+    return nullptr;
+  }
+  auto properties = resp.value().get_properties();
+  spaceCache->spaceDesc_ = std::move(properties);
+  return spaceCache;
 }
 
 bool MetaClient::loadSchemas(GraphSpaceID spaceId,
@@ -523,9 +667,10 @@ bool MetaClient::loadFulltextIndexes() {
 }
 
 Status MetaClient::checkTagIndexed(GraphSpaceID space, IndexID indexID) {
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = localCache_.find(space);
-  if (it != localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.localCache_.find(space);
+  if (it != metadata.localCache_.end()) {
     auto indexIt = it->second->tagIndexes_.find(indexID);
     if (indexIt != it->second->tagIndexes_.end()) {
       return Status::OK();
@@ -537,9 +682,10 @@ Status MetaClient::checkTagIndexed(GraphSpaceID space, IndexID indexID) {
 }
 
 Status MetaClient::checkEdgeIndexed(GraphSpaceID space, IndexID indexID) {
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = localCache_.find(space);
-  if (it != localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.localCache_.find(space);
+  if (it != metadata.localCache_.end()) {
     auto indexIt = it->second->edgeIndexes_.find(indexID);
     if (indexIt != it->second->edgeIndexes_.end()) {
       return Status::OK();
@@ -1195,9 +1341,10 @@ StatusOr<GraphSpaceID> MetaClient::getSpaceIdByNameFromCache(const std::string&
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = spaceIndexByName_.find(name);
-  if (it != spaceIndexByName_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.spaceIndexByName_.find(name);
+  if (it != metadata.spaceIndexByName_.end()) {
     return it->second;
   }
   return Status::SpaceNotFound();
@@ -1207,9 +1354,10 @@ StatusOr<std::string> MetaClient::getSpaceNameByIdFromCache(GraphSpaceID spaceId
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt == metadata.localCache_.end()) {
     LOG(ERROR) << "Space " << spaceId << " not found!";
     return Status::Error("Space %d not found", spaceId);
   }
@@ -1221,9 +1369,10 @@ StatusOr<TagID> MetaClient::getTagIDByNameFromCache(const GraphSpaceID& space,
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = spaceTagIndexByName_.find(std::make_pair(space, name));
-  if (it == spaceTagIndexByName_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.spaceTagIndexByName_.find(std::make_pair(space, name));
+  if (it == metadata.spaceTagIndexByName_.end()) {
     return Status::Error("TagName `%s'  is nonexistent", name.c_str());
   }
   return it->second;
@@ -1234,9 +1383,10 @@ StatusOr<std::string> MetaClient::getTagNameByIdFromCache(const GraphSpaceID& sp
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = spaceTagIndexById_.find(std::make_pair(space, tagId));
-  if (it == spaceTagIndexById_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.spaceTagIndexById_.find(std::make_pair(space, tagId));
+  if (it == metadata.spaceTagIndexById_.end()) {
     return Status::Error("TagID `%d'  is nonexistent", tagId);
   }
   return it->second;
@@ -1247,9 +1397,10 @@ StatusOr<EdgeType> MetaClient::getEdgeTypeByNameFromCache(const GraphSpaceID& sp
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = spaceEdgeIndexByName_.find(std::make_pair(space, name));
-  if (it == spaceEdgeIndexByName_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.spaceEdgeIndexByName_.find(std::make_pair(space, name));
+  if (it == metadata.spaceEdgeIndexByName_.end()) {
     return Status::Error("EdgeName `%s'  is nonexistent", name.c_str());
   }
   return it->second;
@@ -1260,9 +1411,10 @@ StatusOr<std::string> MetaClient::getEdgeNameByTypeFromCache(const GraphSpaceID&
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = spaceEdgeIndexByType_.find(std::make_pair(space, edgeType));
-  if (it == spaceEdgeIndexByType_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.spaceEdgeIndexByType_.find(std::make_pair(space, edgeType));
+  if (it == metadata.spaceEdgeIndexByType_.end()) {
     return Status::Error("EdgeType `%d'  is nonexistent", edgeType);
   }
   return it->second;
@@ -1272,9 +1424,10 @@ StatusOr<std::vector<std::string>> MetaClient::getAllEdgeFromCache(const GraphSp
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = spaceAllEdgeMap_.find(space);
-  if (it == spaceAllEdgeMap_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.spaceAllEdgeMap_.find(space);
+  if (it == metadata.spaceAllEdgeMap_.end()) {
     return Status::Error("SpaceId `%d'  is nonexistent", space);
   }
   return it->second;
@@ -1407,14 +1560,16 @@ folly::Future<StatusOr<bool>> MetaClient::removeRange(std::string segment,
 }
 
 PartsMap MetaClient::getPartsMapFromCache(const HostAddr& host) {
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  return doGetPartsMap(host, localCache_);
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  return doGetPartsMap(host, metadata.localCache_);
 }
 
 StatusOr<PartHosts> MetaClient::getPartHostsFromCache(GraphSpaceID spaceId, PartitionID partId) {
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = localCache_.find(spaceId);
-  if (it == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.localCache_.find(spaceId);
+  if (it == metadata.localCache_.end()) {
     return Status::Error("Space not found, spaceid: %d", spaceId);
   }
   auto& cache = it->second;
@@ -1432,9 +1587,10 @@ StatusOr<PartHosts> MetaClient::getPartHostsFromCache(GraphSpaceID spaceId, Part
 Status MetaClient::checkPartExistInCache(const HostAddr& host,
                                          GraphSpaceID spaceId,
                                          PartitionID partId) {
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = localCache_.find(spaceId);
-  if (it != localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.localCache_.find(spaceId);
+  if (it != metadata.localCache_.end()) {
     auto partsIt = it->second->partsOnHost_.find(host);
     if (partsIt != it->second->partsOnHost_.end()) {
       for (auto& pId : partsIt->second) {
@@ -1451,9 +1607,10 @@ Status MetaClient::checkPartExistInCache(const HostAddr& host,
 }
 
 Status MetaClient::checkSpaceExistInCache(const HostAddr& host, GraphSpaceID spaceId) {
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = localCache_.find(spaceId);
-  if (it != localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.localCache_.find(spaceId);
+  if (it != metadata.localCache_.end()) {
     auto partsIt = it->second->partsOnHost_.find(host);
     if (partsIt != it->second->partsOnHost_.end() && !partsIt->second.empty()) {
       return Status::OK();
@@ -1465,9 +1622,10 @@ Status MetaClient::checkSpaceExistInCache(const HostAddr& host, GraphSpaceID spa
 }
 
 StatusOr<int32_t> MetaClient::partsNum(GraphSpaceID spaceId) const {
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = localCache_.find(spaceId);
-  if (it == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.localCache_.find(spaceId);
+  if (it == metadata.localCache_.end()) {
     return Status::Error("Space not found, spaceid: %d", spaceId);
   }
   return it->second->partsAlloc_.size();
@@ -1850,9 +2008,10 @@ StatusOr<int32_t> MetaClient::getSpaceVidLen(const GraphSpaceID& spaceId) {
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt == metadata.localCache_.end()) {
     LOG(ERROR) << "Space " << spaceId << " not found!";
     return Status::Error("Space %d not found", spaceId);
   }
@@ -1868,9 +2027,10 @@ StatusOr<nebula::cpp2::PropertyType> MetaClient::getSpaceVidType(const GraphSpac
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt == metadata.localCache_.end()) {
     LOG(ERROR) << "Space " << spaceId << " not found!";
     return Status::Error("Space %d not found", spaceId);
   }
@@ -1889,9 +2049,10 @@ StatusOr<cpp2::SpaceDesc> MetaClient::getSpaceDesc(const GraphSpaceID& space) {
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(space);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(space);
+  if (spaceIt == metadata.localCache_.end()) {
     LOG(ERROR) << "Space " << space << " not found!";
     return Status::Error("Space %d not found", space);
   }
@@ -1912,9 +2073,10 @@ StatusOr<std::shared_ptr<const NebulaSchemaProvider>> MetaClient::getTagSchemaFr
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt != localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt != metadata.localCache_.end()) {
     auto tagIt = spaceIt->second->tagSchemas_.find(tagID);
     if (tagIt != spaceIt->second->tagSchemas_.end() && !tagIt->second.empty()) {
       size_t vNum = tagIt->second.size();
@@ -1932,9 +2094,10 @@ StatusOr<std::shared_ptr<const NebulaSchemaProvider>> MetaClient::getEdgeSchemaF
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt != localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt != metadata.localCache_.end()) {
     auto edgeIt = spaceIt->second->edgeSchemas_.find(edgeType);
     if (edgeIt != spaceIt->second->edgeSchemas_.end() && !edgeIt->second.empty()) {
       size_t vNum = edgeIt->second.size();
@@ -1951,9 +2114,10 @@ StatusOr<TagSchemas> MetaClient::getAllVerTagSchema(GraphSpaceID spaceId) {
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto iter = localCache_.find(spaceId);
-  if (iter == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto iter = metadata.localCache_.find(spaceId);
+  if (iter == metadata.localCache_.end()) {
     return Status::Error("Space %d not found", spaceId);
   }
   return iter->second->tagSchemas_;
@@ -1963,9 +2127,10 @@ StatusOr<TagSchema> MetaClient::getAllLatestVerTagSchema(const GraphSpaceID& spa
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto iter = localCache_.find(spaceId);
-  if (iter == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto iter = metadata.localCache_.find(spaceId);
+  if (iter == metadata.localCache_.end()) {
     return Status::Error("Space %d not found", spaceId);
   }
   TagSchema tagsSchema;
@@ -1981,9 +2146,10 @@ StatusOr<EdgeSchemas> MetaClient::getAllVerEdgeSchema(GraphSpaceID spaceId) {
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto iter = localCache_.find(spaceId);
-  if (iter == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto iter = metadata.localCache_.find(spaceId);
+  if (iter == metadata.localCache_.end()) {
     return Status::Error("Space %d not found", spaceId);
   }
   return iter->second->edgeSchemas_;
@@ -1993,9 +2159,10 @@ StatusOr<EdgeSchema> MetaClient::getAllLatestVerEdgeSchemaFromCache(const GraphS
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto iter = localCache_.find(spaceId);
-  if (iter == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto iter = metadata.localCache_.find(spaceId);
+  if (iter == metadata.localCache_.end()) {
     return Status::Error("Space %d not found", spaceId);
   }
   EdgeSchema edgesSchema;
@@ -2083,9 +2250,10 @@ StatusOr<std::shared_ptr<cpp2::IndexItem>> MetaClient::getTagIndexFromCache(Grap
     return Status::Error("Not ready!");
   }
 
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt == metadata.localCache_.end()) {
     VLOG(3) << "Space " << spaceId << " not found!";
     return Status::SpaceNotFound();
   } else {
@@ -2120,9 +2288,10 @@ StatusOr<std::shared_ptr<cpp2::IndexItem>> MetaClient::getEdgeIndexFromCache(Gra
     return Status::Error("Not ready!");
   }
 
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt == metadata.localCache_.end()) {
     VLOG(3) << "Space " << spaceId << " not found!";
     return Status::SpaceNotFound();
   } else {
@@ -2157,9 +2326,10 @@ StatusOr<std::vector<std::shared_ptr<cpp2::IndexItem>>> MetaClient::getTagIndexe
     return Status::Error("Not ready!");
   }
 
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt == metadata.localCache_.end()) {
     VLOG(3) << "Space " << spaceId << " not found!";
     return Status::SpaceNotFound();
   } else {
@@ -2180,9 +2350,10 @@ StatusOr<std::vector<std::shared_ptr<cpp2::IndexItem>>> MetaClient::getEdgeIndex
     return Status::Error("Not ready!");
   }
 
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt == metadata.localCache_.end()) {
     VLOG(3) << "Space " << spaceId << " not found!";
     return Status::SpaceNotFound();
   } else {
@@ -2287,9 +2458,10 @@ bool MetaClient::checkShadowAccountFromCache(const std::string& account) const {
 }
 
 StatusOr<TermID> MetaClient::getTermFromCache(GraphSpaceID spaceId, PartitionID partId) const {
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceInfo = localCache_.find(spaceId);
-  if (spaceInfo == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceInfo = metadata.localCache_.find(spaceId);
+  if (spaceInfo == metadata.localCache_.end()) {
     return Status::Error("Term not found!");
   }
 
@@ -2306,8 +2478,9 @@ StatusOr<std::vector<HostAddr>> MetaClient::getStorageHosts() const {
     return Status::Error("Not ready!");
   }
 
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  return storageHosts_;
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  return metadata.storageHosts_;
 }
 
 StatusOr<SchemaVer> MetaClient::getLatestTagVersionFromCache(const GraphSpaceID& space,
@@ -2315,9 +2488,10 @@ StatusOr<SchemaVer> MetaClient::getLatestTagVersionFromCache(const GraphSpaceID&
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = spaceNewestTagVerMap_.find(std::make_pair(space, tagId));
-  if (it == spaceNewestTagVerMap_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.spaceNewestTagVerMap_.find(std::make_pair(space, tagId));
+  if (it == metadata.spaceNewestTagVerMap_.end()) {
     return Status::TagNotFound();
   }
   return it->second;
@@ -2328,9 +2502,10 @@ StatusOr<SchemaVer> MetaClient::getLatestEdgeVersionFromCache(const GraphSpaceID
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto it = spaceNewestEdgeVerMap_.find(std::make_pair(space, edgeType));
-  if (it == spaceNewestEdgeVerMap_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto it = metadata.spaceNewestEdgeVerMap_.find(std::make_pair(space, edgeType));
+  if (it == metadata.spaceNewestEdgeVerMap_.end()) {
     return Status::EdgeNotFound();
   }
   return it->second;
@@ -2388,6 +2563,19 @@ folly::Future<StatusOr<bool>> MetaClient::heartbeat() {
   return future;
 }
 
+folly::Future<StatusOr<cpp2::GetMetaChangesResp>> MetaClient::getMetaChanges(int64_t since) {
+  cpp2::GetMetaChangesReq req;
+  req.set_since_in_ms(since);
+  folly::Promise<StatusOr<cpp2::GetMetaChangesResp>> promise;
+  auto future = promise.getFuture();
+  getResponse(
+      std::move(req),
+      [](auto client, auto request) { return client->future_getMetaChanges(request); },
+      [](cpp2::GetMetaChangesResp&& resp) { return std::move(resp); },
+      std::move(promise));
+  return future;
+}
+
 folly::Future<StatusOr<bool>> MetaClient::createUser(std::string account,
                                                      std::string password,
                                                      bool ifNotExists) {
@@ -2801,9 +2989,10 @@ MetaClient::getListenersBySpaceHostFromCache(GraphSpaceID spaceId, const HostAdd
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt == metadata.localCache_.end()) {
     VLOG(3) << "Space " << spaceId << " not found!";
     return Status::SpaceNotFound();
   }
@@ -2820,8 +3009,9 @@ StatusOr<ListenersMap> MetaClient::getListenersByHostFromCache(const HostAddr& h
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  return doGetListenersMap(host, localCache_);
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  return doGetListenersMap(host, metadata.localCache_);
 }
 
 ListenersMap MetaClient::doGetListenersMap(const HostAddr& host, const LocalCache& localCache) {
@@ -2857,9 +3047,10 @@ StatusOr<HostAddr> MetaClient::getListenerHostsBySpacePartType(GraphSpaceID spac
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt == metadata.localCache_.end()) {
     VLOG(3) << "Space " << spaceId << " not found!";
     return Status::SpaceNotFound();
   }
@@ -2878,9 +3069,10 @@ StatusOr<std::vector<RemoteListenerInfo>> MetaClient::getListenerHostTypeBySpace
   if (!ready_) {
     return Status::Error("Not ready!");
   }
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  auto spaceIt = localCache_.find(spaceId);
-  if (spaceIt == localCache_.end()) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  auto spaceIt = metadata.localCache_.find(spaceId);
+  if (spaceIt == metadata.localCache_.end()) {
     VLOG(3) << "Space " << spaceId << " not found!";
     return Status::SpaceNotFound();
   }
@@ -2965,8 +3157,9 @@ void MetaClient::updateNestedGflags(const std::unordered_map<std::string, Value>
     optionMap.emplace(value.first, value.second.toString());
   }
 
-  folly::RWSpinLock::ReadHolder holder(localCacheLock_);
-  for (const auto& spaceEntry : localCache_) {
+  folly::rcu_reader guard;
+  const auto& metadata = *metadata_.load();
+  for (const auto& spaceEntry : metadata.localCache_) {
     listener_->onSpaceOptionUpdated(spaceEntry.first, optionMap);
   }
 }
@@ -3220,6 +3413,47 @@ folly::Future<StatusOr<cpp2::StatsItem>> MetaClient::getStats(GraphSpaceID space
   return future;
 }
 
+std::shared_ptr<const cpp2::StatsItem> MetaClient::getStatsFromCache(GraphSpaceID spaceId) {
+  auto now = time::WallClock::fastNowInSec();
+  {
+    folly::RWSpinLock::ReadHolder holder(statsLock_);
+    auto iter = statsCache_.find(spaceId);
+    if (iter != statsCache_.end() &&
+        (iter->second.fetching || now - iter->second.fetchedTime < FLAGS_stats_cache_ttl_secs)) {
+      return iter->second.stats;
+    }
+  }
+
+  std::shared_ptr<const cpp2::StatsItem> stats;
+  {
+    folly::RWSpinLock::WriteHolder holder(statsLock_);
+    auto& cached = statsCache_[spaceId];
+    if (cached.fetching || now - cached.fetchedTime < FLAGS_stats_cache_ttl_secs) {
+      return cached.stats;
+    }
+    cached.fetching = true;
+    stats = cached.stats;
+  }
+  getStats(spaceId).thenTry([this, spaceId](folly::Try<StatusOr<cpp2::StatsItem>>&& t) {
+    std::shared_ptr<const cpp2::StatsItem> fetched;
+    if (t.hasValue() && t.value().ok() &&
+        t.value().value().get_status() == cpp2::JobStatus::FINISHED) {
+      fetched = std::make_shared<const cpp2::StatsItem>(std::move(t).value().value());
+    } else {
+      VLOG(1) << "No stats of space " << spaceId << " to cache";
+    }
+    folly::RWSpinLock::WriteHolder holder(statsLock_);
+    auto& cached = statsCache_[spaceId];
+    // Keep the old stats if a new stats job is not finished
+    if (fetched != nullptr) {
+      cached.stats = std::move(fetched);
+    }
+    cached.fetchedTime = time::WallClock::fastNowInSec();
+    cached.fetching = false;
+  });
+  return stats;
+}
+
 folly::Future<StatusOr<nebula::cpp2::ErrorCode>> MetaClient::reportTaskFinish(
     int32_t jobId,
     int32_t taskId,
@@ -102,6 +102,23 @@ using SpaceEdgeTypeNameMap = std::unordered_map<std::pair<GraphSpaceID, EdgeType
 // get all edgeType edgeName via spaceId
 using SpaceAllEdgeMap = std::unordered_map<GraphSpaceID, std::vector<std::string>>;
 
+// The meta data of the spaces cached by the client. It is immutable once
+// published, readers access it under folly::rcu_reader without any lock, and
+// a reload publishes a new one, sharing the SpaceInfoCache of the spaces not
+// changed.
+struct MetaData {
+  LocalCache localCache_;
+  SpaceNameIdMap spaceIndexByName_;
+  SpaceTagNameIdMap spaceTagIndexByName_;
+  SpaceEdgeNameTypeMap spaceEdgeIndexByName_;
+  SpaceEdgeTypeNameMap spaceEdgeIndexByType_;
+  SpaceTagIdNameMap spaceTagIndexById_;
+  SpaceNewestTagVerMap spaceNewestTagVerMap_;
+  SpaceNewestEdgeVerMap spaceNewestEdgeVerMap_;
+  SpaceAllEdgeMap spaceAllEdgeMap_;
+  std::vector<HostAddr> storageHosts_;
+};
+
 struct LeaderInfo {
   // get leader host via spaceId and partId
   std::unordered_map<std::pair<GraphSpaceID, PartitionID>, HostAddr> leaderMap_;
@@ -609,6 +626,15 @@ class MetaClient {
 
   folly::Future<StatusOr<cpp2::StatsItem>> getStats(GraphSpaceID spaceId);
 
+  // The stats of the space from the last finished stats job, cached for the
+  // optimizer. They are fetched in background if not cached or older than
+  // --stats_cache_ttl_secs, and nullptr is returned until they are fetched.
+  std::shared_ptr<const cpp2::StatsItem> getStatsFromCache(GraphSpaceID spaceId);
+
+  // The time of the last meta change loaded into the local cache, which tells
+  // whether the schemas, the indexes or the roles have been changed
+  int64_t getLocalLastUpdateTime() const { return localLastUpdateTime_.load(); }
+
   folly::Future<StatusOr<nebula::cpp2::ErrorCode>> reportTaskFinish(
       int32_t jobId,
       int32_t taskId,
@@ -629,6 +655,9 @@ class MetaClient {
  protected:
   // Return true if load succeeded.
   bool loadData();
+  // Reload only the spaces changed since the last sync, fall back to
+  // loadData() if metad doesn't know all the changes
+  bool loadChangedData();
   bool loadCfg();
   void heartBeatThreadFunc();
 
@@ -646,6 +675,20 @@ class MetaClient {
                    SpaceNewestEdgeVerMap& newestEdgeVerMap,
                    SpaceAllEdgeMap& allEdgemap);
 
+  // Swap in the new meta data and retire the old one
+  void publishMetaData(std::unique_ptr<MetaData> metadata);
+
+  // Return nullptr if failed
+  std::shared_ptr<SpaceInfoCache> loadSpace(GraphSpaceID spaceId,
+                                            const std::string& spaceName,
+                                            SpaceTagNameIdMap& tagNameIdMap,
+                                            SpaceTagIdNameMap& tagIdNameMap,
+                                            SpaceEdgeNameTypeMap& edgeNameTypeMap,
+                                            SpaceEdgeTypeNameMap& edgeTypeNamemap,
+                                            SpaceNewestTagVerMap& newestTagVerMap,
+                                            SpaceNewestEdgeVerMap& newestEdgeVerMap,
+                                            SpaceAllEdgeMap& allEdgemap);
+
   bool loadUsersAndRoles();
 
   bool loadIndexes(GraphSpaceID spaceId, std::shared_ptr<SpaceInfoCache> cache);
@@ -663,6 +706,8 @@ class MetaClient {
 
   folly::Future<StatusOr<bool>> heartbeat();
 
+  folly::Future<StatusOr<cpp2::GetMetaChangesResp>> getMetaChanges(int64_t since);
+
   std::unordered_map<HostAddr, std::vector<PartitionID>> reverse(const PartsAlloc& parts);
 
   void updateActive() {
@@ -719,16 +764,24 @@ class MetaClient {
   // leaderIdsLock_ is used to protect leaderIds_
   std::unordered_map<GraphSpaceID, std::vector<cpp2::LeaderInfo>> leaderIds_;
   folly::RWSpinLock leaderIdsLock_;
-  int64_t localLastUpdateTime_{0};
+  std::atomic<int64_t> localLastUpdateTime_{0};
   int64_t metadLastUpdateTime_{0};
   int64_t metaServerVersion_{-1};
   static constexpr int64_t EXPECT_META_VERSION = 2;
 
+  struct CachedStats {
+    std::shared_ptr<const cpp2::StatsItem> stats;
+    int64_t fetchedTime{0};
+    bool fetching{false};
+  };
+  // statsLock_ is used to protect statsCache_
+  std::unordered_map<GraphSpaceID, CachedStats> statsCache_;
+  folly::RWSpinLock statsLock_;
+
   // leadersLock_ is used to protect leadersInfo
   folly::RWSpinLock leadersLock_;
   LeaderInfo leadersInfo_;
 
-  LocalCache localCache_;
   std::vector<HostAddr> addrs_;
   // The lock used to protect active_ and leader_.
   folly::RWSpinLock hostLock_;
@@ -737,14 +790,6 @@ class MetaClient {
   HostAddr localHost_;
 
   std::unique_ptr<thread::GenericWorker> bgThread_;
-  SpaceNameIdMap spaceIndexByName_;
-  SpaceTagNameIdMap spaceTagIndexByName_;
-  SpaceEdgeNameTypeMap spaceEdgeIndexByName_;
-  SpaceEdgeTypeNameMap spaceEdgeIndexByType_;
-  SpaceTagIdNameMap spaceTagIndexById_;
-  SpaceNewestTagVerMap spaceNewestTagVerMap_;
-  SpaceNewestEdgeVerMap spaceNewestEdgeVerMap_;
-  SpaceAllEdgeMap spaceAllEdgeMap_;
 
   UserRolesMap userRolesMap_;
   UserPasswordMap userPasswordMap_;
@@ -754,6 +799,8 @@ class MetaClient {
   FulltextClientsList fulltextClientList_;
   FTIndexMap fulltextIndexMap_;
 
+  // The lock used to protect the users and the fulltext indexes, the meta data
+  // of the spaces is in metadata_
   mutable folly::RWSpinLock localCacheLock_;
   // The listener_ is the NebulaStore
   MetaChangedListener* listener_{nullptr};
@@ -770,8 +817,8 @@ class MetaClient {
   std::vector<cpp2::ConfigItem> gflagsDeclared_;
   bool skipConfig_ = false;
   MetaClientOptions options_;
-  std::vector<HostAddr> storageHosts_;
   int64_t heartbeatTime_;
+  std::atomic<MetaData*> metadata_;
   std::atomic<SessionMap*> sessionMap_;
   std::atomic<folly::F14FastSet<std::pair<SessionID, ExecutionPlanID>>*> killedPlans_;
 };
@@ -0,0 +1,125 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "clients/storage/GetNeighborsCoalescer.h"
+
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+namespace nebula {
+namespace storage {
+
+folly::Optional<std::string> GetNeighborsCoalescer::key(
+    const cpp2::GetNeighborsRequest& req) const {
+  if (req.common_ref().has_value() && req.get_common()->profile_detail_ref().value_or(false)) {
+    // The profile of a merged request could not be told apart
+    return folly::none;
+  }
+  std::string key;
+  key.append(reinterpret_cast<const char*>(&req.get_space_id()), sizeof(GraphSpaceID));
+  for (auto& name : req.get_column_names()) {
+    key.append(name).append(1, '\0');
+  }
+  apache::thrift::CompactSerializer::serialize(req.get_traverse_spec(), &key);
+  return key;
+}
+
+size_t GetNeighborsCoalescer::size(const cpp2::GetNeighborsRequest& req) const {
+  size_t size = 0;
+  for (auto& part : req.get_parts()) {
+    size += part.second.size();
+  }
+  return size;
+}
+
+cpp2::GetNeighborsRequest GetNeighborsCoalescer::merge(
+    const std::vector<const cpp2::GetNeighborsRequest*>& reqs) const {
+  DCHECK(!reqs.empty());
+  auto& first = *reqs.front();
+  cpp2::GetNeighborsRequest merged;
+  merged.set_space_id(first.get_space_id());
+  merged.set_column_names(first.get_column_names());
+  merged.set_traverse_spec(first.get_traverse_spec());
+
+  // Keep the session and the plan only if all are from the same one, so that
+  // killing a query doesn't abort the others merged with it
+  auto samePlan = std::all_of(reqs.begin(), reqs.end(), [&first](const auto* req) {
+    return req->get_common() != nullptr && first.get_common() != nullptr &&
+           *req->get_common() == *first.get_common();
+  });
+  merged.set_common(samePlan ? *first.get_common() : cpp2::RequestCommon());
+
+  std::unordered_map<PartitionID, std::vector<Row>> parts;
+  std::unordered_map<PartitionID, std::unordered_set<Value>> vids;
+  for (auto* req : reqs) {
+    for (auto& part : req->get_parts()) {
+      auto& rows = parts[part.first];
+      auto& partVids = vids[part.first];
+      for (auto& row : part.second) {
+        if (partVids.emplace(row.values[0]).second) {
+          rows.emplace_back(row);
+        }
+      }
+    }
+  }
+  merged.set_parts(std::move(parts));
+  return merged;
+}
+
+std::vector<cpp2::GetNeighborsResponse> GetNeighborsCoalescer::split(
+    cpp2::GetNeighborsResponse&& merged,
+    const std::vector<const cpp2::GetNeighborsRequest*>& reqs) const {
+  auto& result = merged.get_result();
+  std::unordered_map<PartitionID, const cpp2::PartitionResult*> failedParts;
+  for (auto& part : result.get_failed_parts()) {
+    failedParts.emplace(part.get_part_id(), &part);
+  }
+  auto* vertices = merged.get_vertices();
+  std::unordered_map<Value, const Row*> rowOfVid;
+  if (vertices != nullptr) {
+    for (auto& row : vertices->rows) {
+      if (!row.values.empty()) {
+        rowOfVid.emplace(row.values[0], &row);
+      }
+    }
+  }
+
+  std::vector<cpp2::GetNeighborsResponse> resps(reqs.size());
+  for (size_t i = 0; i < reqs.size(); ++i) {
+    cpp2::ResponseCommon common;
+    common.set_latency_in_us(result.get_latency_in_us());
+    if (result.latency_detail_us_ref().has_value()) {
+      common.set_latency_detail_us(*result.latency_detail_us_ref());
+    }
+    std::vector<cpp2::PartitionResult> failed;
+    DataSet ds;
+    if (vertices != nullptr) {
+      ds.colNames = vertices->colNames;
+    }
+    for (auto& part : reqs[i]->get_parts()) {
+      auto iter = failedParts.find(part.first);
+      if (iter != failedParts.end()) {
+        failed.emplace_back(*iter->second);
+        continue;
+      }
+      // A vid is returned as many times as it is asked for
+      for (auto& row : part.second) {
+        auto found = rowOfVid.find(row.values[0]);
+        if (found != rowOfVid.end()) {
+          ds.rows.emplace_back(*found->second);
+        }
+      }
+    }
+    common.set_failed_parts(std::move(failed));
+    resps[i].set_result(std::move(common));
+    if (vertices != nullptr) {
+      resps[i].set_vertices(std::move(ds));
+    }
+  }
+  return resps;
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,45 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CLIENTS_STORAGE_GETNEIGHBORSCOALESCER_H_
+#define CLIENTS_STORAGE_GETNEIGHBORSCOALESCER_H_
+
+#include "clients/storage/RequestCoalescer.h"
+#include "common/base/Base.h"
+#include "interface/gen-cpp2/storage_types.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Merge the getNeighbors of the same space, columns and traverse spec.
+ *
+ * Each row of the response belongs to one source vertex, and the limit, the
+ * stats and the filter of the spec all apply to each vertex alone, so the
+ * vertices of the requests are deduplicated into one request, and the rows
+ * are handed back to each request by the vid in the first column.
+ */
+class GetNeighborsCoalescer final
+    : public RequestCoalescer<cpp2::GetNeighborsRequest, cpp2::GetNeighborsResponse> {
+ public:
+  explicit GetNeighborsCoalescer(size_t maxVertices) : RequestCoalescer(maxVertices) {}
+
+ protected:
+  folly::Optional<std::string> key(const cpp2::GetNeighborsRequest& req) const override;
+
+  size_t size(const cpp2::GetNeighborsRequest& req) const override;
+
+  cpp2::GetNeighborsRequest merge(
+      const std::vector<const cpp2::GetNeighborsRequest*>& reqs) const override;
+
+  std::vector<cpp2::GetNeighborsResponse> split(
+      cpp2::GetNeighborsResponse&& merged,
+      const std::vector<const cpp2::GetNeighborsRequest*>& reqs) const override;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // CLIENTS_STORAGE_GETNEIGHBORSCOALESCER_H_
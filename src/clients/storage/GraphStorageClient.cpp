@@ -7,6 +7,14 @@
 
 #include "common/base/Base.h"
 
+DEFINE_bool(storage_client_coalesce_get_neighbors,
+            false,
+            "Merge the getNeighbors of the same traverse spec to the same storage host, "
+            "which are issued while another one is in flight");
+DEFINE_uint32(storage_client_coalesce_max_vertices,
+              10000,
+              "The max number of vertices of a merged getNeighbors");
+
 using nebula::cpp2::PropertyType;
 using nebula::storage::cpp2::ExecResponse;
 using nebula::storage::cpp2::GetNeighborsResponse;
@@ -105,7 +113,8 @@ StorageRpcRespFuture<cpp2::GetNeighborsResponse> GraphStorageClient::getNeighbor
       std::move(requests),
       [](cpp2::GraphStorageServiceAsyncClient* client, const cpp2::GetNeighborsRequest& r) {
         return client->future_getNeighbors(r);
-      });
+      },
+      FLAGS_storage_client_coalesce_get_neighbors ? &neighborsCoalescer_ : nullptr);
 }
 
 StorageRpcRespFuture<cpp2::ExecResponse> GraphStorageClient::addVertices(
@@ -488,7 +497,8 @@ StorageRpcRespFuture<cpp2::LookupIndexResp> GraphStorageClient::lookupIndex(
     bool isEdge,
     int32_t tagOrEdge,
     const std::vector<std::string>& returnCols,
-    int64_t limit) {
+    int64_t limit,
+    const std::vector<cpp2::StatProp>* statProps) {
   // TODO(sky) : instead of isEdge and tagOrEdge to nebula::cpp2::SchemaID for graph layer.
   auto space = param.space;
   auto status = getHostParts(space);
@@ -519,6 +529,9 @@ StorageRpcRespFuture<cpp2::LookupIndexResp> GraphStorageClient::lookupIndex(
     req.set_indices(spec);
     req.set_common(common);
     req.set_limit(limit);
+    if (statProps != nullptr) {
+      req.set_stat_columns(*statProps);
+    }
   }
 
   return collectResponse(
@@ -591,6 +604,61 @@ folly::Future<StatusOr<cpp2::ScanVertexResponse>> GraphStorageClient::scanVertex
                         const cpp2::ScanVertexRequest& r) { return client->future_scanVertex(r); });
 }
 
+StorageRpcRespFuture<cpp2::ScanEdgeResponse> GraphStorageClient::scanEdgeParts(
+    const cpp2::ScanEdgeRequest& req, folly::EventBase* evb) {
+  auto status = splitScanRequest(req);
+  if (!status.ok()) {
+    return folly::makeFuture<StorageRpcResponse<cpp2::ScanEdgeResponse>>(
+        std::runtime_error(status.status().toString()));
+  }
+  return collectResponse(
+      evb,
+      std::move(status).value(),
+      [](cpp2::GraphStorageServiceAsyncClient* client, const cpp2::ScanEdgeRequest& r) {
+        return client->future_scanEdge(r);
+      });
+}
+
+StorageRpcRespFuture<cpp2::ScanVertexResponse> GraphStorageClient::scanVertexParts(
+    const cpp2::ScanVertexRequest& req, folly::EventBase* evb) {
+  auto status = splitScanRequest(req);
+  if (!status.ok()) {
+    return folly::makeFuture<StorageRpcResponse<cpp2::ScanVertexResponse>>(
+        std::runtime_error(status.status().toString()));
+  }
+  return collectResponse(
+      evb,
+      std::move(status).value(),
+      [](cpp2::GraphStorageServiceAsyncClient* client, const cpp2::ScanVertexRequest& r) {
+        return client->future_scanVertex(r);
+      });
+}
+
+template <class Request>
+StatusOr<std::unordered_map<HostAddr, Request>> GraphStorageClient::splitScanRequest(
+    const Request& req) const {
+  if (req.get_parts() == nullptr) {
+    return Status::Error("No part to scan");
+  }
+  std::unordered_map<HostAddr, std::unordered_map<PartitionID, cpp2::ScanCursor>> hostParts;
+  for (const auto& [partId, cursor] : *req.get_parts()) {
+    auto host = getLeader(req.get_space_id(), partId);
+    if (!host.ok()) {
+      return host.status();
+    }
+    hostParts[host.value()].emplace(partId, cursor);
+  }
+
+  auto common = req;
+  common.set_parts({});
+  std::unordered_map<HostAddr, Request> requests;
+  for (auto& [host, parts] : hostParts) {
+    auto& r = requests.emplace(host, common).first->second;
+    r.set_parts(std::move(parts));
+  }
+  return requests;
+}
+
 StatusOr<std::function<const VertexID&(const Row&)>> GraphStorageClient::getIdFromRow(
     GraphSpaceID space, bool isEdgeProps) const {
   auto vidTypeStatus = metaClient_->getSpaceVidType(space);
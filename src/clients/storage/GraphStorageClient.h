@@ -8,10 +8,13 @@
 
 #include <gtest/gtest_prod.h>
 
+#include "clients/storage/GetNeighborsCoalescer.h"
 #include "clients/storage/StorageClientBase.h"
 #include "common/base/Base.h"
 #include "interface/gen-cpp2/GraphStorageServiceAsyncClient.h"
 
+DECLARE_uint32(storage_client_coalesce_max_vertices);
+
 namespace nebula {
 namespace storage {
 
@@ -47,7 +50,8 @@ class GraphStorageClient : public StorageClientBase<cpp2::GraphStorageServiceAsy
 
   GraphStorageClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool,
                      meta::MetaClient* metaClient)
-      : StorageClientBase<cpp2::GraphStorageServiceAsyncClient>(ioThreadPool, metaClient) {}
+      : StorageClientBase<cpp2::GraphStorageServiceAsyncClient>(ioThreadPool, metaClient),
+        neighborsCoalescer_(FLAGS_storage_client_coalesce_max_vertices) {}
   virtual ~GraphStorageClient() {}
 
   StorageRpcRespFuture<cpp2::GetNeighborsResponse> getNeighbors(
@@ -125,7 +129,8 @@ class GraphStorageClient : public StorageClientBase<cpp2::GraphStorageServiceAsy
       bool isEdge,
       int32_t tagOrEdge,
       const std::vector<std::string>& returnCols,
-      int64_t limit);
+      int64_t limit,
+      const std::vector<cpp2::StatProp>* statProps = nullptr);
 
   StorageRpcRespFuture<cpp2::GetNeighborsResponse> lookupAndTraverse(
       const CommonRequestParam& param, cpp2::IndexSpec indexSpec, cpp2::TraverseSpec traverseSpec);
@@ -136,6 +141,14 @@ class GraphStorageClient : public StorageClientBase<cpp2::GraphStorageServiceAsy
   folly::Future<StatusOr<cpp2::ScanVertexResponse>> scanVertex(cpp2::ScanVertexRequest req,
                                                                folly::EventBase* evb = nullptr);
 
+  // Scan the `parts' of the request by one request to the leader of each,
+  // which scans its parts in parallel
+  StorageRpcRespFuture<cpp2::ScanEdgeResponse> scanEdgeParts(const cpp2::ScanEdgeRequest& req,
+                                                             folly::EventBase* evb = nullptr);
+
+  StorageRpcRespFuture<cpp2::ScanVertexResponse> scanVertexParts(
+      const cpp2::ScanVertexRequest& req, folly::EventBase* evb = nullptr);
+
  private:
   StatusOr<std::function<const VertexID&(const Row&)>> getIdFromRow(GraphSpaceID space,
                                                                     bool isEdgeProps) const;
@@ -146,6 +159,10 @@ class GraphStorageClient : public StorageClientBase<cpp2::GraphStorageServiceAsy
   StatusOr<std::function<const VertexID&(const cpp2::NewEdge&)>> getIdFromNewEdge(
       GraphSpaceID space) const;
 
+  // Split the `parts' of a scan request by their leaders
+  template <class Request>
+  StatusOr<std::unordered_map<HostAddr, Request>> splitScanRequest(const Request& req) const;
+
   StatusOr<std::function<const VertexID&(const cpp2::EdgeKey&)>> getIdFromEdgeKey(
       GraphSpaceID space) const;
 
@@ -153,6 +170,9 @@ class GraphStorageClient : public StorageClientBase<cpp2::GraphStorageServiceAsy
 
   StatusOr<std::function<const VertexID&(const cpp2::DelTags&)>> getIdFromDelTags(
       GraphSpaceID space) const;
+
+  // Used if --storage_client_coalesce_get_neighbors
+  GetNeighborsCoalescer neighborsCoalescer_;
 };
 
 }  // namespace storage
@@ -0,0 +1,161 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CLIENTS_STORAGE_REQUESTCOALESCER_H_
+#define CLIENTS_STORAGE_REQUESTCOALESCER_H_
+
+#include <folly/Function.h>
+#include <folly/Optional.h>
+#include <folly/futures/Future.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/HostAddr.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Coalesce the compatible requests to the same storage host into one rpc.
+ *
+ * At most one merged request of a key is in flight to a host. A request is
+ * sent at once if there is none, otherwise it waits for the one in flight to
+ * return, and all the requests queued meanwhile are merged into the next
+ * rpc. So the batching window follows the latency of the storage: nothing
+ * waits when it is idle, and the requests are merged more when it is busy.
+ *
+ * The subclasses tell which requests could be merged, how to merge them and
+ * how to split the response of a merged one back to each of them.
+ */
+template <class Request, class Response>
+class RequestCoalescer {
+ public:
+  using SendFunc = folly::Function<folly::Future<Response>(const Request&)>;
+
+  explicit RequestCoalescer(size_t maxBatchSize) : maxBatchSize_(maxBatchSize) {}
+
+  virtual ~RequestCoalescer() = default;
+
+  // The request must be kept until the future is fulfilled. The `sendFunc' of
+  // the first request of a batch is used to send the merged one.
+  folly::Future<Response> send(const HostAddr& host, const Request& req, SendFunc sendFunc) {
+    auto queueKey = key(req);
+    if (!queueKey.has_value()) {
+      return sendFunc(req);
+    }
+    folly::Promise<Response> promise;
+    auto future = promise.getFuture();
+    {
+      std::lock_guard<std::mutex> g(lock_);
+      auto& queue = queues_[host][*queueKey];
+      queue.pending.emplace_back(Pending{&req, std::move(sendFunc), std::move(promise)});
+      if (queue.inFlight) {
+        return future;
+      }
+      queue.inFlight = true;
+    }
+    flush(host, std::move(queueKey).value());
+    return future;
+  }
+
+ protected:
+  // Requests of the same key could be merged, none if the request should be
+  // sent alone
+  virtual folly::Optional<std::string> key(const Request& req) const = 0;
+
+  // The size counted against the max size of a batch
+  virtual size_t size(const Request& req) const = 0;
+
+  virtual Request merge(const std::vector<const Request*>& reqs) const = 0;
+
+  // Return one response for each of the merged requests, in the same order
+  virtual std::vector<Response> split(Response&& merged,
+                                      const std::vector<const Request*>& reqs) const = 0;
+
+ private:
+  struct Pending {
+    const Request* req;
+    SendFunc sendFunc;
+    folly::Promise<Response> promise;
+  };
+
+  struct Queue {
+    std::deque<Pending> pending;
+    bool inFlight{false};
+  };
+
+  // Send the queued requests of the key, or mark the key idle if none
+  void flush(const HostAddr& host, std::string queueKey) {
+    std::vector<Pending> batch;
+    {
+      std::lock_guard<std::mutex> g(lock_);
+      auto& hostQueues = queues_[host];
+      auto iter = hostQueues.find(queueKey);
+      DCHECK(iter != hostQueues.end());
+      auto& pending = iter->second.pending;
+      if (pending.empty()) {
+        hostQueues.erase(iter);
+        if (hostQueues.empty()) {
+          queues_.erase(host);
+        }
+        return;
+      }
+      size_t batchSize = 0;
+      while (!pending.empty()) {
+        auto reqSize = size(*pending.front().req);
+        if (!batch.empty() && batchSize + reqSize > maxBatchSize_) {
+          break;
+        }
+        batchSize += reqSize;
+        batch.emplace_back(std::move(pending.front()));
+        pending.pop_front();
+      }
+    }
+
+    std::vector<const Request*> reqs;
+    reqs.reserve(batch.size());
+    for (auto& p : batch) {
+      reqs.emplace_back(p.req);
+    }
+    std::shared_ptr<Request> merged;
+    folly::Future<Response> future = folly::Future<Response>::makeEmpty();
+    if (batch.size() == 1) {
+      future = batch.front().sendFunc(*reqs.front());
+    } else {
+      VLOG(3) << "Merged " << batch.size() << " requests to " << host;
+      merged = std::make_shared<Request>(merge(reqs));
+      future = batch.front().sendFunc(*merged);
+    }
+    std::move(future).thenTry([this,
+                               host,
+                               queueKey = std::move(queueKey),
+                               batch = std::move(batch),
+                               reqs = std::move(reqs),
+                               merged = std::move(merged)](folly::Try<Response>&& t) mutable {
+      if (t.hasException()) {
+        for (auto& p : batch) {
+          p.promise.setException(t.exception());
+        }
+      } else if (batch.size() == 1) {
+        batch.front().promise.setValue(std::move(t).value());
+      } else {
+        auto resps = split(std::move(t).value(), reqs);
+        DCHECK_EQ(resps.size(), batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+          batch[i].promise.setValue(std::move(resps[i]));
+        }
+      }
+      flush(host, std::move(queueKey));
+    });
+  }
+
+  const size_t maxBatchSize_;
+  std::mutex lock_;
+  std::unordered_map<HostAddr, std::unordered_map<std::string, Queue>> queues_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // CLIENTS_STORAGE_REQUESTCOALESCER_H_
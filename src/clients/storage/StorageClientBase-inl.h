@@ -114,7 +114,8 @@ template <class Request, class RemoteFunc, class Response>
 folly::SemiFuture<StorageRpcResponse<Response>> StorageClientBase<ClientType>::collectResponse(
     folly::EventBase* evb,
     std::unordered_map<HostAddr, Request> requests,
-    RemoteFunc&& remoteFunc) {
+    RemoteFunc&& remoteFunc,
+    RequestCoalescer<Request, Response>* coalescer) {
   auto context = std::make_shared<ResponseContext<Request, RemoteFunc, Response>>(
       requests.size(), std::move(remoteFunc));
 
@@ -127,12 +128,23 @@ folly::SemiFuture<StorageRpcResponse<Response>> StorageClientBase<ClientType>::c
     DCHECK(res.second);
     evb = ioThreadPool_->getEventBase();
     // Invoke the remote method
-    folly::via(evb, [this, evb, context, host, spaceId, res]() mutable {
+    folly::via(evb, [this, evb, context, host, spaceId, res, coalescer]() mutable {
       auto client = clientsMan_->client(host, evb, false, FLAGS_storage_client_timeout_ms);
       // Result is a pair of <Request&, bool>
       auto start = time::WallClock::fastNowInMicroSec();
-      context
-          ->serverMethod(client.get(), *res.first)
+      auto future = folly::Future<Response>::makeEmpty();
+      if (coalescer == nullptr) {
+        future = context->serverMethod(client.get(), *res.first);
+      } else {
+        // The merged request may be sent from another thread, while the client
+        // must be used in its own event base
+        future = coalescer->send(host, *res.first, [evb, context, client](const Request& r) {
+          return folly::via(evb, [context, client, &r] {
+            return context->serverMethod(client.get(), r);
+          });
+        });
+      }
+      std::move(future)
           // Future process code will be executed on the IO thread
           // Since all requests are sent using the same eventbase, all
           // then-callback will be executed on the same IO thread
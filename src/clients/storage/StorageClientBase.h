@@ -10,6 +10,7 @@
 #include <folly/futures/Future.h>
 
 #include "clients/meta/MetaClient.h"
+#include "clients/storage/RequestCoalescer.h"
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
 #include "common/meta/Common.h"
@@ -132,10 +133,13 @@ class StorageClientBase {
             class RemoteFunc,
             class Response =
                 typename std::result_of<RemoteFunc(ClientType*, const Request&)>::type::value_type>
+  // The requests are merged with the compatible ones to the same host by
+  // `coalescer' if given
   folly::SemiFuture<StorageRpcResponse<Response>> collectResponse(
       folly::EventBase* evb,
       std::unordered_map<HostAddr, Request> requests,
-      RemoteFunc&& remoteFunc);
+      RemoteFunc&& remoteFunc,
+      RequestCoalescer<Request, Response>* coalescer = nullptr);
 
   template <class Request,
             class RemoteFunc,
@@ -0,0 +1,35 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "codec/RowProjection.h"
+
+namespace nebula {
+
+RowProjection::RowProjection(const meta::SchemaProviderIf* schema,
+                             const std::vector<std::string>& props)
+    : schema_(schema) {
+  CHECK_NOTNULL(schema_);
+  size_t numNullables = schema_->getNumNullableFields();
+  if (numNullables > 0) {
+    numNullBytes_ = ((numNullables - 1) >> 3) + 1;
+  }
+
+  columns_.reserve(props.size());
+  for (const auto& prop : props) {
+    Column col;
+    col.index = schema_->getFieldIndex(prop);
+    if (col.index >= 0) {
+      auto field = schema_->field(col.index);
+      col.type = field->type();
+      col.offset = field->offset();
+      col.size = field->size();
+      col.nullable = field->nullable();
+      col.nullFlagPos = field->nullFlagPos();
+    }
+    columns_.emplace_back(std::move(col));
+  }
+}
+
+}  // namespace nebula
@@ -0,0 +1,52 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CODEC_ROWPROJECTION_H_
+#define CODEC_ROWPROJECTION_H_
+
+#include "common/base/Base.h"
+#include "common/meta/SchemaProviderIf.h"
+
+namespace nebula {
+
+/**
+ * A list of properties of a schema resolved once into the indexes, types,
+ * offsets and null flags of the fields, so that the rows of the schema could
+ * be decoded by RowReader::getValues without looking up the properties by
+ * name and the fields in the schema for each row.
+ *
+ * It is built for one version of a schema and must not outlive it.
+ */
+class RowProjection final {
+ public:
+  struct Column {
+    // The index of the field, -1 if the schema doesn't have the property
+    int64_t index{-1};
+    nebula::cpp2::PropertyType type{nebula::cpp2::PropertyType::UNKNOWN};
+    // The offset of the field after the header and the null flags
+    size_t offset{0};
+    size_t size{0};
+    bool nullable{false};
+    size_t nullFlagPos{0};
+  };
+
+  RowProjection(const meta::SchemaProviderIf* schema, const std::vector<std::string>& props);
+
+  const meta::SchemaProviderIf* schema() const { return schema_; }
+
+  const std::vector<Column>& columns() const { return columns_; }
+
+  size_t size() const { return columns_.size(); }
+
+  size_t numNullBytes() const { return numNullBytes_; }
+
+ private:
+  const meta::SchemaProviderIf* schema_;
+  std::vector<Column> columns_;
+  size_t numNullBytes_{0};
+};
+
+}  // namespace nebula
+#endif  // CODEC_ROWPROJECTION_H_
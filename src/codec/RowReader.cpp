@@ -54,4 +54,11 @@ bool RowReader::resetImpl(meta::SchemaProviderIf const* schema, folly::StringPie
   return true;
 }
 
+void RowReader::getValues(const RowProjection& projection, Value* values) const noexcept {
+  DCHECK_EQ(projection.schema(), schema_);
+  for (const auto& col : projection.columns()) {
+    *values++ = getValueByIndex(col.index);
+  }
+}
+
 }  // namespace nebula
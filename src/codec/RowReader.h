@@ -7,6 +7,7 @@
 #define CODEC_ROWREADER_H_
 
 #include "codec/Common.h"
+#include "codec/RowProjection.h"
 #include "common/base/Base.h"
 #include "common/datatypes/Value.h"
 #include "common/meta/SchemaManager.h"
@@ -65,6 +66,10 @@ class RowReader {
   virtual Value getValueByIndex(const int64_t index) const noexcept = 0;
   virtual int64_t getTimestamp() const noexcept = 0;
 
+  // Decode the columns of the projection, which must be built on the schema
+  // of the row, into `values', which must have room for all of them
+  virtual void getValues(const RowProjection& projection, Value* values) const noexcept;
+
   virtual int32_t readerVer() const noexcept = 0;
 
   // Return the number of bytes used for the header info
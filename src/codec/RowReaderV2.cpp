@@ -61,8 +61,27 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const noexcept {
   if (field->nullable() && isNull(field->nullFlagPos())) {
     return NullType::__NULL__;
   }
+  return readField(field->type(), offset, field->size());
+}
+
+void RowReaderV2::getValues(const RowProjection& projection, Value* values) const noexcept {
+  DCHECK_EQ(projection.schema(), schema_);
+  DCHECK_EQ(projection.numNullBytes(), numNullBytes_);
+  size_t fieldsStart = headerLen_ + numNullBytes_;
+  for (const auto& col : projection.columns()) {
+    if (col.index < 0) {
+      *values = Value(NullType::UNKNOWN_PROP);
+    } else if (col.nullable && isNull(col.nullFlagPos)) {
+      *values = NullType::__NULL__;
+    } else {
+      *values = readField(col.type, fieldsStart + col.offset, col.size);
+    }
+    ++values;
+  }
+}
 
-  switch (field->type()) {
+Value RowReaderV2::readField(PropertyType type, size_t offset, size_t size) const noexcept {
+  switch (type) {
     case PropertyType::BOOL: {
       if (data_[offset]) {
         return true;
@@ -115,7 +134,7 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const noexcept {
       return std::string(&data_[strOffset], strLen);
     }
     case PropertyType::FIXED_STRING: {
-      return std::string(&data_[offset], field->size());
+      return std::string(&data_[offset], size);
     }
     case PropertyType::TIMESTAMP: {
       Timestamp ts;
@@ -30,6 +30,7 @@ class RowReaderV2 : public RowReader {
 
   Value getValueByName(const std::string& prop) const noexcept override;
   Value getValueByIndex(const int64_t index) const noexcept override;
+  void getValues(const RowProjection& projection, Value* values) const noexcept override;
   int64_t getTimestamp() const noexcept override;
 
   int32_t readerVer() const noexcept override { return 2; }
@@ -47,6 +48,9 @@ class RowReaderV2 : public RowReader {
 
   // Check whether the flag at the given position is set or not
   bool isNull(size_t pos) const;
+
+  // Decode the field of the type at the offset from the beginning of the row
+  Value readField(nebula::cpp2::PropertyType type, size_t offset, size_t size) const noexcept;
 };
 
 }  // namespace nebula
@@ -95,6 +95,11 @@ class RowReaderWrapper : public RowReader {
     return currReader_->getValueByIndex(index);
   }
 
+  void getValues(const RowProjection& projection, Value* values) const noexcept override {
+    DCHECK(!!currReader_);
+    currReader_->getValues(projection, values);
+  }
+
   int64_t getTimestamp() const noexcept override {
     DCHECK(!!currReader_);
     return currReader_->getTimestamp();
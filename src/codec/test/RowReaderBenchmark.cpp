@@ -12,6 +12,7 @@
 #include "codec/test/SchemaWriter.h"
 #include "common/base/Base.h"
 
+using nebula::RowProjection;
 using nebula::RowReader;
 using nebula::RowReaderWrapper;
 using nebula::RowWriterV1;
@@ -30,6 +31,9 @@ std::string dataLongV2;   // NOLINT
 std::vector<size_t> shortRandom;
 std::vector<size_t> longRandom;
 
+std::vector<std::string> shortProps;  // NOLINT
+std::vector<std::string> longProps;   // NOLINT
+
 const double e = 2.71828182845904523536028747135266249775724709369995;
 const float pi = 3.14159265358979;
 const std::string str = "Hello world!";  // NOLINT
@@ -120,6 +124,54 @@ void randomRead(SchemaWriter* schema,
   }
 }
 
+// Read some of the props by name, the way the storage collects the props
+std::vector<std::string> generateProps(SchemaWriter* schema) {
+  std::vector<std::string> props;
+  for (size_t i = 0; i < schema->getNumFields(); i += 3) {
+    props.emplace_back(schema->getFieldName(i));
+  }
+  return props;
+}
+
+void readByName(SchemaWriter* schema,
+                const std::string& encoded,
+                const std::vector<std::string>& props,
+                size_t iters) {
+  auto reader = RowReaderWrapper::getRowReader(schema, encoded);
+  std::vector<nebula::Value> values(props.size());
+  for (size_t i = 0; i < iters; i++) {
+    for (size_t j = 0; j < props.size(); j++) {
+      values[j] = reader->getValueByName(props[j]);
+    }
+    folly::doNotOptimizeAway(values);
+  }
+}
+
+void readByProjection(SchemaWriter* schema,
+                      const std::string& encoded,
+                      const std::vector<std::string>& props,
+                      size_t iters) {
+  auto reader = RowReaderWrapper::getRowReader(schema, encoded);
+  RowProjection projection(schema, props);
+  std::vector<nebula::Value> values(props.size());
+  for (size_t i = 0; i < iters; i++) {
+    reader->getValues(projection, values.data());
+    folly::doNotOptimizeAway(values);
+  }
+}
+
+void projectionTest(SchemaWriter* schema,
+                    const std::string& encoded,
+                    const std::vector<std::string>& props) {
+  auto reader = RowReaderWrapper::getRowReader(schema, encoded);
+  RowProjection projection(schema, props);
+  std::vector<nebula::Value> values(props.size());
+  reader->getValues(projection, values.data());
+  for (size_t i = 0; i < props.size(); i++) {
+    EXPECT_EQ(reader->getValueByName(props[i]), values[i]);
+  }
+}
+
 void sequentialTest(SchemaWriter* schema,
                     const std::string& encodedV1,
                     const std::string& encodedV2) {
@@ -161,6 +213,16 @@ TEST(RowReader, SequentialLong) { sequentialTest(&schemaLong, dataLongV1, dataLo
 TEST(RowReader, RandomShort) { randomTest(&schemaShort, dataShortV1, dataShortV2, shortRandom); }
 
 TEST(RowReader, RandomLong) { randomTest(&schemaLong, dataLongV1, dataLongV2, longRandom); }
+
+TEST(RowReader, ProjectionShort) {
+  projectionTest(&schemaShort, dataShortV1, shortProps);
+  projectionTest(&schemaShort, dataShortV2, shortProps);
+}
+
+TEST(RowReader, ProjectionLong) {
+  projectionTest(&schemaLong, dataLongV1, longProps);
+  projectionTest(&schemaLong, dataLongV2, longProps);
+}
 /*************************
  * End of Tests
  ************************/
@@ -191,6 +253,20 @@ BENCHMARK(random_read_long_v1, iters) { randomRead(&schemaLong, dataLongV1, long
 BENCHMARK_RELATIVE(random_read_long_v2, iters) {
   randomRead(&schemaLong, dataLongV2, longRandom, iters);
 }
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(by_name_short_v2, iters) { readByName(&schemaShort, dataShortV2, shortProps, iters); }
+BENCHMARK_RELATIVE(by_projection_short_v2, iters) {
+  readByProjection(&schemaShort, dataShortV2, shortProps, iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(by_name_long_v2, iters) { readByName(&schemaLong, dataLongV2, longProps, iters); }
+BENCHMARK_RELATIVE(by_projection_long_v2, iters) {
+  readByProjection(&schemaLong, dataLongV2, longProps, iters);
+}
 /*************************
  * End of benchmarks
  ************************/
@@ -211,6 +287,9 @@ int main(int argc, char** argv) {
   shortRandom = generateRandom(&schemaShort);
   longRandom = generateRandom(&schemaLong);
 
+  shortProps = generateProps(&schemaShort);
+  longProps = generateProps(&schemaLong);
+
   if (FLAGS_benchmark) {
     folly::runBenchmarks();
     return 0;
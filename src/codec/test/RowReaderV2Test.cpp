@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
 #include "codec/test/SchemaWriter.h"
 #include "common/base/Base.h"
 #include "common/datatypes/Value.h"
@@ -348,6 +349,44 @@ TEST(RowReaderV2, iterator) {
   EXPECT_EQ(64, index);
 }
 
+TEST(RowReaderV2, projection) {
+  SchemaWriter schema;
+  schema.appendCol("Col01", PropertyType::BOOL);
+  schema.appendCol("Col02", PropertyType::INT64, 0, true);
+  schema.appendCol("Col03", PropertyType::STRING);
+  schema.appendCol("Col04", PropertyType::FIXED_STRING, 12);
+  schema.appendCol("Col05", PropertyType::DOUBLE, 0, true);
+  schema.appendCol("Col06", PropertyType::DATE);
+
+  RowWriterV2 writer(&schema);
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(0, true));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.setNull(1));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(2, std::string("Hello")));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(3, std::string("World")));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(4, 3.14));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.set(5, Date(2021, 10, 1)));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+  std::string encoded = writer.moveEncodedStr();
+
+  std::vector<std::string> props = {
+      "Col06", "Col02", "NotExist", "Col04", "Col01", "Col05", "Col03"};
+  RowProjection projection(&schema, props);
+  ASSERT_EQ(props.size(), projection.size());
+  EXPECT_EQ(-1, projection.columns()[2].index);
+
+  auto reader = RowReaderWrapper::getRowReader(&schema, encoded);
+  ASSERT_TRUE(!!reader);
+  std::vector<Value> values(projection.size());
+  reader->getValues(projection, values.data());
+  for (size_t i = 0; i < props.size(); i++) {
+    EXPECT_EQ(reader->getValueByName(props[i]), values[i]) << props[i];
+  }
+  ASSERT_TRUE(values[1].isNull());
+  EXPECT_EQ(NullType::__NULL__, values[1].getNull());
+  ASSERT_TRUE(values[2].isNull());
+  EXPECT_EQ(NullType::UNKNOWN_PROP, values[2].getNull());
+}
+
 }  // namespace nebula
 
 int main(int argc, char** argv) {
@@ -47,6 +47,19 @@ class ObjectPool final : private cpp::NonCopyable, private cpp::NonMovable {
 
   bool empty() const { return objects_.empty(); }
 
+  size_t size() const {
+    folly::SpinLockGuard g(lock_);
+    return objects_.size();
+  }
+
+  // Release the objects added after the first `size' ones
+  void truncate(size_t size) {
+    folly::SpinLockGuard g(lock_);
+    while (objects_.size() > size) {
+      objects_.pop_back();
+    }
+  }
+
  private:
   // Holder the ownership of the any object
   class OwnershipHolder {
@@ -64,7 +77,7 @@ class ObjectPool final : private cpp::NonCopyable, private cpp::NonMovable {
 
   std::list<OwnershipHolder> objects_;
 
-  folly::SpinLock lock_;
+  mutable folly::SpinLock lock_;
 };
 
 }  // namespace nebula
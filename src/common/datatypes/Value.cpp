@@ -124,7 +124,7 @@ Value::Value(Value&& rhs) noexcept : type_(Value::Type::__EMPTY__) {
       break;
     }
     case Type::STRING: {
-      setS(std::move(rhs.value_.sVal));
+      stealS(rhs.value_.sVal);
       break;
     }
     case Type::DATE: {
@@ -204,7 +204,7 @@ Value::Value(const Value& rhs) : type_(Value::Type::__EMPTY__) {
       break;
     }
     case Type::STRING: {
-      setS(*rhs.value_.sVal);
+      shareS(rhs.value_.sVal);
       break;
     }
     case Type::DATE: {
@@ -652,7 +652,7 @@ const double& Value::getFloat() const {
 
 const std::string& Value::getStr() const {
   CHECK_EQ(type_, Type::STRING);
-  return *value_.sVal;
+  return value_.sVal->str;
 }
 
 const Date& Value::getDate() const {
@@ -772,7 +772,9 @@ double& Value::mutableFloat() {
 
 std::string& Value::mutableStr() {
   CHECK_EQ(type_, Type::STRING);
-  return *value_.sVal;
+  detachS();
+  value_.sVal->shareable = false;
+  return value_.sVal->str;
 }
 
 Date& Value::mutableDate() {
@@ -860,7 +862,8 @@ double Value::moveFloat() {
 
 std::string Value::moveStr() {
   CHECK_EQ(type_, Type::STRING);
-  std::string v = std::move(*value_.sVal);
+  detachS();
+  std::string v = std::move(value_.sVal->str);
   clear();
   return v;
 }
@@ -964,7 +967,7 @@ void Value::clear() {
       break;
     }
     case Type::STRING: {
-      destruct(value_.sVal);
+      releaseS();
       break;
     }
     case Type::DATE: {
@@ -1041,7 +1044,7 @@ Value& Value::operator=(Value&& rhs) noexcept {
       break;
     }
     case Type::STRING: {
-      setS(std::move(rhs.value_.sVal));
+      stealS(rhs.value_.sVal);
       break;
     }
     case Type::DATE: {
@@ -1123,7 +1126,7 @@ Value& Value::operator=(const Value& rhs) {
       break;
     }
     case Type::STRING: {
-      setS(*rhs.value_.sVal);
+      shareS(rhs.value_.sVal);
       break;
     }
     case Type::DATE: {
@@ -1219,24 +1222,56 @@ void Value::setF(double&& v) {
   new (std::addressof(value_.fVal)) double(std::move(v));  // NOLINT
 }
 
-void Value::setS(std::unique_ptr<std::string> v) {
-  type_ = Type::STRING;
-  new (std::addressof(value_.sVal)) std::unique_ptr<std::string>(std::move(v));
-}
-
 void Value::setS(const std::string& v) {
   type_ = Type::STRING;
-  new (std::addressof(value_.sVal)) std::unique_ptr<std::string>(new std::string(v));
+  value_.sVal = new StrBox(v);
 }
 
 void Value::setS(std::string&& v) {
   type_ = Type::STRING;
-  new (std::addressof(value_.sVal)) std::unique_ptr<std::string>(new std::string(std::move(v)));
+  value_.sVal = new StrBox(std::move(v));
 }
 
 void Value::setS(const char* v) {
   type_ = Type::STRING;
-  new (std::addressof(value_.sVal)) std::unique_ptr<std::string>(new std::string(v));
+  value_.sVal = new StrBox(v);
+}
+
+void Value::shareS(StrBox* v) {
+  type_ = Type::STRING;
+  if (!v->shareable) {
+    value_.sVal = new StrBox(v->str);
+    return;
+  }
+  v->refs.fetch_add(1, std::memory_order_relaxed);
+  value_.sVal = v;
+}
+
+void Value::stealS(StrBox*& v) {
+  type_ = Type::STRING;
+  value_.sVal = v;
+  v = nullptr;
+}
+
+void Value::releaseS() {
+  auto* box = value_.sVal;
+  // A moved-from string value holds no box
+  if (box != nullptr && box->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete box;
+  }
+  value_.sVal = nullptr;
+}
+
+void Value::detachS() {
+  auto* box = value_.sVal;
+  DCHECK(box != nullptr);
+  if (box->refs.load(std::memory_order_acquire) == 1) {
+    return;
+  }
+  value_.sVal = new StrBox(box->str);
+  if (box->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete box;
+  }
 }
 
 void Value::setD(const Date& v) {
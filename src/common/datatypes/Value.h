@@ -8,6 +8,7 @@
 
 #include <folly/dynamic.h>
 
+#include <atomic>
 #include <memory>
 
 #include "common/datatypes/Date.h"
@@ -294,6 +295,21 @@ struct Value {
   Value equal(const Value& v) const;
 
  private:
+  // Strings are kept in a reference counted box which is shared by all copies
+  // of a Value, so copying a string value (e.g. copying DataSet rows) never
+  // allocates. The box is cloned lazily when a shared string is mutated.
+  struct StrBox {
+    explicit StrBox(const std::string& v) : str(v) {}
+    explicit StrBox(std::string&& v) : str(std::move(v)) {}
+    explicit StrBox(const char* v) : str(v) {}
+
+    std::atomic<uint32_t> refs{1};
+    // Cleared once a mutable reference to the string is handed out, which
+    // could still write it later, so the copies made after that clone it
+    bool shareable{true};
+    std::string str;
+  };
+
   Type type_;
 
   union Storage {
@@ -301,7 +317,7 @@ struct Value {
     bool bVal;
     int64_t iVal;
     double fVal;
-    std::unique_ptr<std::string> sVal;
+    StrBox* sVal;
     Date dVal;
     Time tVal;
     DateTime dtVal;
@@ -339,7 +355,14 @@ struct Value {
   void setS(const std::string& v);
   void setS(std::string&& v);
   void setS(const char* v);
-  void setS(std::unique_ptr<std::string> v);
+  // Share the box of another string value
+  void shareS(StrBox* v);
+  // Take over the box of another string value
+  void stealS(StrBox*& v);
+  // Drop the reference to the string box
+  void releaseS();
+  // Make sure the string box is owned exclusively before mutating it
+  void detachS();
   // Date value
   void setD(const Date& v);
   void setD(Date&& v);
@@ -316,8 +316,10 @@ void Cpp2Ops<nebula::Value>::read(Protocol* proto, nebula::Value* obj) {
       }
       case 5: {
         if (readState.fieldType == apache::thrift::protocol::T_STRING) {
-          obj->setStr("");
-          proto->readBinary(obj->mutableStr());
+          // Not by mutableStr(), which keeps the string from being shared
+          std::string str;
+          proto->readBinary(str);
+          obj->setStr(std::move(str));
         } else {
           proto->skip(readState.fieldType);
         }
@@ -4,20 +4,48 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/init/Init.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
 #include "common/base/Base.h"
+#include "common/datatypes/DataSet.h"
 #include "common/datatypes/Edge.h"
 #include "common/datatypes/Value.h"
 #include "common/datatypes/Vertex.h"
 
+using nebula::DataSet;
 using nebula::Edge;
+using nebula::List;
+using nebula::Row;
 using nebula::Value;
 using nebula::Vertex;
 
+// Count the heap allocations to show how many of them a string value costs
+static std::atomic<uint64_t> gAllocations{0};
+
+void* operator new(size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  void* p = std::malloc(size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  std::free(p);
+}
+
 static const int seed = folly::randomNumberSeed();
 using RandomT = std::mt19937;
 static RandomT rng(seed);
@@ -111,7 +139,71 @@ BENCHMARK(HashIntValue, n) {
   }
 }
 
-int main() {
+BENCHMARK_DRAW_LINE();
+
+// A DataSet shaped like the result of GO with string vids: _src, _dst, prop
+DataSet makeDataSet(size_t rows, size_t vidLen) {
+  DataSet ds({"_src", "_dst", "name"});
+  for (size_t i = 0; i < rows; i++) {
+    ds.emplace_back(Row({randomString(vidLen), randomString(vidLen), randomString(vidLen)}));
+  }
+  return ds;
+}
+
+BENCHMARK(CopyShortStrDataSet, n) {
+  DataSet ds;
+  BENCHMARK_SUSPEND {
+    ds = makeDataSet(1000, 8);
+  }
+  for (size_t i = 0; i < n; i++) {
+    DataSet copy = ds;
+    folly::doNotOptimizeAway(copy);
+  }
+}
+
+BENCHMARK(CopyLongStrDataSet, n) {
+  DataSet ds;
+  BENCHMARK_SUSPEND {
+    ds = makeDataSet(1000, 32);
+  }
+  for (size_t i = 0; i < n; i++) {
+    DataSet copy = ds;
+    folly::doNotOptimizeAway(copy);
+  }
+}
+
+BENCHMARK(HashStrDataSetRows, n) {
+  DataSet ds;
+  BENCHMARK_SUSPEND {
+    ds = makeDataSet(1000, 32);
+  }
+  for (size_t i = 0; i < n; i++) {
+    std::unordered_set<List> set;
+    set.reserve(ds.rowSize());
+    for (const auto &row : ds.rows) {
+      set.emplace(row);
+    }
+    folly::doNotOptimizeAway(set);
+  }
+}
+
+static void printAllocations(const char *name, size_t vidLen) {
+  auto ds = makeDataSet(1000, vidLen);
+  auto before = gAllocations.load();
+  DataSet copy = ds;
+  auto copyAllocs = gAllocations.load() - before;
+  before = gAllocations.load();
+  auto moved = ds.rows.back().values.back().moveStr();
+  auto moveAllocs = gAllocations.load() - before;
+  LOG(INFO) << name << ": " << copyAllocs << " allocations to copy " << copy.rowSize()
+            << " rows, " << moveAllocs << " allocations to move out a string of "
+            << moved.size() << " bytes";
+}
+
+int main(int argc, char **argv) {
+  folly::init(&argc, &argv, true);
+  printAllocations("Short string DataSet", 8);
+  printAllocations("Long string DataSet", 32);
   folly::runBenchmarks();
   return 0;
 }
@@ -127,3 +219,4 @@ int main() {
 // HashInt                                                    485.02ns    2.06M
 // HashIntValue                                               632.23ns    1.58M
 // ============================================================================
+
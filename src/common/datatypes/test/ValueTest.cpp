@@ -1188,6 +1188,64 @@ TEST(Value, Ctor) {
   // Value v2(&tmp);
 }
 
+TEST(Value, SharedString) {
+  const std::string str(64, 'a');
+  Value v1(str);
+  Value v2 = v1;
+  // Copies share the same string
+  EXPECT_EQ(&v1.getStr(), &v2.getStr());
+  EXPECT_EQ(v1, v2);
+
+  // Mutation detaches the string from other copies
+  v2.mutableStr().append("b");
+  EXPECT_NE(&v1.getStr(), &v2.getStr());
+  EXPECT_EQ(str, v1.getStr());
+  EXPECT_EQ(str + "b", v2.getStr());
+
+  Value v3;
+  v3 = v1;
+  EXPECT_EQ(&v1.getStr(), &v3.getStr());
+  auto moved = v3.moveStr();
+  EXPECT_EQ(str, moved);
+  EXPECT_TRUE(v3.empty());
+  EXPECT_EQ(str, v1.getStr());
+
+  Value v4(std::move(v1));
+  EXPECT_EQ(str, v4.getStr());
+  v4 = v2;
+  // The string of v2 has been handed out for mutation, so it is not shared
+  EXPECT_NE(&v2.getStr(), &v4.getStr());
+  v2.clear();
+  EXPECT_EQ(str + "b", v4.getStr());
+}
+
+TEST(Value, MutableStrNotShared) {
+  const std::string str(64, 'a');
+  Value v1(str);
+  // Keep the mutable reference across the copy
+  auto& mutableStr = v1.mutableStr();
+  Value v2 = v1;
+  Value v3;
+  v3 = v1;
+  mutableStr.append("b");
+  EXPECT_EQ(str + "b", v1.getStr());
+  EXPECT_EQ(str, v2.getStr());
+  EXPECT_EQ(str, v3.getStr());
+  EXPECT_NE(&v1.getStr(), &v2.getStr());
+}
+
+TEST(Value, DecodedStringShared) {
+  const std::string str(64, 'a');
+  std::string buf;
+  serializer::serialize(Value(str), &buf);
+  Value decoded;
+  serializer::deserialize(buf, decoded);
+  ASSERT_EQ(str, decoded.getStr());
+  // The decoded string could be shared by copies just as a constructed one
+  Value copy = decoded;
+  EXPECT_EQ(&decoded.getStr(), &copy.getStr());
+}
+
 }  // namespace nebula
 
 int main(int argc, char** argv) {
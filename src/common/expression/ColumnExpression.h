@@ -33,6 +33,8 @@ class ColumnExpression final : public Expression {
 
   bool operator==(const Expression& expr) const override;
 
+  int32_t index() const { return index_; }
+
  private:
   explicit ColumnExpression(ObjectPool* pool, int32_t index = 0)
       : Expression(pool, Kind::kColumn), index_(index) {}
@@ -997,7 +997,7 @@ FunctionManager::FunctionManager() {
     auto &attr = functions_["rand"];
     attr.minArity_ = 0;
     attr.maxArity_ = 0;
-    attr.isPure_ = true;
+    attr.isPure_ = false;
     attr.body_ = [](const auto &args) -> Value {
       UNUSED(args);
       return folly::Random::randDouble01();
@@ -6,6 +6,8 @@
 #ifndef COMMON_UTILS_LOGITERATOR_H_
 #define COMMON_UTILS_LOGITERATOR_H_
 
+#include <folly/io/IOBuf.h>
+
 #include "common/base/Base.h"
 #include "common/thrift/ThriftTypes.h"
 
@@ -24,6 +26,12 @@ class LogIterator {
   virtual TermID logTerm() const = 0;
   virtual ClusterID logSource() const = 0;
   virtual folly::StringPiece logMsg() const = 0;
+
+  // The message which stays valid after the iterator moves on, a copy by
+  // default
+  virtual folly::IOBuf logMsgBuf() const {
+    return folly::IOBuf(folly::IOBuf::COPY_BUFFER, logMsg().data(), logMsg().size());
+  }
 };
 
 }  // namespace nebula
@@ -25,7 +25,8 @@ static const std::unordered_map<std::string, std::pair<std::string, bool>> syste
     {"groups", {"__groups__", true}},
     {"zones", {"__zones__", true}},
     {"ft_service", {"__ft_service__", false}},
-    {"sessions", {"__sessions__", true}}};
+    {"sessions", {"__sessions__", true}},
+    {"change_log", {"__change_log__", false}}};
 
 // SystemInfo will always be backuped
 static const std::unordered_map<std::string, std::pair<std::string, bool>> systemInfoMaps{
@@ -86,6 +87,7 @@ const std::string kSessionsTable = systemTableMaps.at("sessions").first;
 
 const std::string kIdKey = systemInfoMaps.at("autoIncrementId").first;                // NOLINT
 const std::string kLastUpdateTimeTable = systemInfoMaps.at("lastUpdateTime").first;   // NOLINT
+const std::string kChangeLogTable = systemTableMaps.at("change_log").first;             // NOLINT
 
 // clang-format on
 
@@ -121,6 +123,61 @@ std::string MetaKeyUtils::lastUpdateTimeVal(const int64_t timeInMilliSec) {
   return val;
 }
 
+std::string MetaKeyUtils::changeLogKey(const int64_t timeInMilliSec) {
+  // Big endian, so the entries are sorted by time
+  auto time = folly::Endian::big(timeInMilliSec);
+  std::string key;
+  key.reserve(kChangeLogTable.size() + sizeof(int64_t));
+  key.append(kChangeLogTable.data(), kChangeLogTable.size())
+      .append(reinterpret_cast<const char*>(&time), sizeof(int64_t));
+  return key;
+}
+
+const std::string& MetaKeyUtils::changeLogPrefix() { return kChangeLogTable; }
+
+int64_t MetaKeyUtils::parseChangeLogTime(folly::StringPiece key) {
+  auto time = *reinterpret_cast<const int64_t*>(key.data() + kChangeLogTable.size());
+  return folly::Endian::big(time);
+}
+
+std::string MetaKeyUtils::changeLogVal(bool full, const std::vector<GraphSpaceID>& spaces) {
+  std::string val;
+  val.reserve(sizeof(bool) + spaces.size() * sizeof(GraphSpaceID));
+  val.append(reinterpret_cast<const char*>(&full), sizeof(bool));
+  for (auto space : spaces) {
+    val.append(reinterpret_cast<const char*>(&space), sizeof(GraphSpaceID));
+  }
+  return val;
+}
+
+std::vector<GraphSpaceID> MetaKeyUtils::parseChangeLogVal(folly::StringPiece val, bool* full) {
+  *full = *reinterpret_cast<const bool*>(val.data());
+  std::vector<GraphSpaceID> spaces;
+  for (auto offset = sizeof(bool); offset + sizeof(GraphSpaceID) <= val.size();
+       offset += sizeof(GraphSpaceID)) {
+    spaces.emplace_back(*reinterpret_cast<const GraphSpaceID*>(val.data() + offset));
+  }
+  return spaces;
+}
+
+GraphSpaceID MetaKeyUtils::parseSpaceOfKey(folly::StringPiece key) {
+  // The tables whose keys start with the space id, and are loaded into the
+  // per space cache of the clients
+  static const std::vector<const std::string*> tables = {&kSpacesTable,
+                                                         &kPartsTable,
+                                                         &kTagsTable,
+                                                         &kEdgesTable,
+                                                         &kIndexesTable,
+                                                         &kListenerTable,
+                                                         &kLeaderTermsTable};
+  for (const auto* table : tables) {
+    if (key.size() >= table->size() + sizeof(GraphSpaceID) && key.startsWith(*table)) {
+      return *reinterpret_cast<const GraphSpaceID*>(key.data() + table->size());
+    }
+  }
+  return -1;
+}
+
 std::string MetaKeyUtils::spaceKey(GraphSpaceID spaceId) {
   std::string key;
   key.reserve(kSpacesTable.size() + sizeof(GraphSpaceID));
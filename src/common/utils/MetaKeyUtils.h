@@ -72,6 +72,19 @@ class MetaKeyUtils final {
 
   static std::string lastUpdateTimeVal(const int64_t timeInMilliSec);
 
+  static std::string changeLogKey(const int64_t timeInMilliSec);
+
+  static const std::string& changeLogPrefix();
+
+  static int64_t parseChangeLogTime(folly::StringPiece key);
+
+  static std::string changeLogVal(bool full, const std::vector<GraphSpaceID>& spaces);
+
+  static std::vector<GraphSpaceID> parseChangeLogVal(folly::StringPiece val, bool* full);
+
+  // The space whose cached meta data would be changed by the key, -1 if none
+  static GraphSpaceID parseSpaceOfKey(folly::StringPiece key);
+
   static std::string spaceKey(GraphSpaceID spaceId);
 
   static std::string spaceVal(const meta::cpp2::SpaceDesc& spaceDesc);
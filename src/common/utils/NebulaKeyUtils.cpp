@@ -105,6 +105,23 @@ std::string NebulaKeyUtils::kvKey(PartitionID partId, const folly::StringPiece&
   return key;
 }
 
+// static
+std::string NebulaKeyUtils::degreeKey(size_t vIdLen,
+                                      PartitionID partId,
+                                      const VertexID& vId,
+                                      EdgeType type) {
+  CHECK_GE(vIdLen, vId.size());
+  int32_t item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kDegree);
+
+  std::string key;
+  key.reserve(sizeof(PartitionID) + vIdLen + sizeof(EdgeType));
+  key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
+      .append(vId.data(), vId.size())
+      .append(vIdLen - vId.size(), '\0')
+      .append(reinterpret_cast<const char*>(&type), sizeof(EdgeType));
+  return key;
+}
+
 // static
 std::string NebulaKeyUtils::vertexPrefix(size_t vIdLen,
                                          PartitionID partId,
@@ -143,6 +160,15 @@ std::string NebulaKeyUtils::vertexPrefix(PartitionID partId) {
   return key;
 }
 
+// static
+std::string NebulaKeyUtils::degreePrefix(PartitionID partId) {
+  PartitionID item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kDegree);
+  std::string key;
+  key.reserve(sizeof(PartitionID));
+  key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+  return key;
+}
+
 // static
 std::string NebulaKeyUtils::edgePrefix(size_t vIdLen,
                                        PartitionID partId,
@@ -213,6 +239,7 @@ std::vector<std::string> NebulaKeyUtils::snapshotPrefix(PartitionID partId) {
     result.emplace_back(vertexPrefix(partId));
     result.emplace_back(edgePrefix(partId));
     result.emplace_back(IndexKeyUtils::indexPrefix(partId));
+    result.emplace_back(degreePrefix(partId));
     // kSystem will be written when balance data
     // kOperation will be blocked by jobmanager later
   }
@@ -72,6 +72,15 @@ class NebulaKeyUtils final {
 
   static std::string kvKey(PartitionID partId, const folly::StringPiece& name);
 
+  /**
+   * Generate the key of the number of the edges of a type of a vertex, its
+   * value is an int64_t. It is kept only if --enable_edge_degree
+   * */
+  static std::string degreeKey(size_t vIdLen,
+                               PartitionID partId,
+                               const VertexID& vId,
+                               EdgeType type);
+
   /**
    * Prefix for vertex
    * */
@@ -103,6 +112,8 @@ class NebulaKeyUtils final {
 
   static std::string edgePrefix(PartitionID partId);
 
+  static std::string degreePrefix(PartitionID partId);
+
   static std::string systemPrefix();
 
   static std::vector<std::string> snapshotPrefix(PartitionID partId);
@@ -152,6 +163,15 @@ class NebulaKeyUtils final {
     return isEdge(vIdLen, rawKey, kLockVersion);
   }
 
+  static bool isDegree(size_t vIdLen, const folly::StringPiece& rawKey) {
+    if (rawKey.size() != sizeof(PartitionID) + vIdLen + sizeof(EdgeType)) {
+      return false;
+    }
+    constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
+    auto type = readInt<uint32_t>(rawKey.data(), len) & kTypeMask;
+    return static_cast<NebulaKeyType>(type) == NebulaKeyType::kDegree;
+  }
+
   static bool isSystem(const folly::StringPiece& rawKey) {
     constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
     auto type = readInt<uint32_t>(rawKey.data(), len) & kTypeMask;
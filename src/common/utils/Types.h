@@ -18,6 +18,7 @@ enum class NebulaKeyType : uint32_t {
   kSystem = 0x00000004,
   kOperation = 0x00000005,
   kKeyValue = 0x00000006,
+  kDegree = 0x00000007,
 };
 
 enum class NebulaSystemKeyType : uint32_t {
@@ -0,0 +1,545 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/context/BatchEvaluator.h"
+
+#include <numeric>
+
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "common/function/FunctionManager.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+// Build the bool result of a comparison from `lt(i)' and `eq(i)', which follow
+// the semantics of Value::lessThan and Value::equal on non-null operands
+template <typename LT, typename EQ>
+Column compare(Expression::Kind kind, boost::dynamic_bitset<> nulls, LT lt, EQ eq) {
+  auto n = nulls.size();
+  std::vector<int64_t> res(n);
+  switch (kind) {
+    case Expression::Kind::kRelEQ: {
+      for (size_t i = 0; i < n; ++i) {
+        res[i] = eq(i);
+      }
+      break;
+    }
+    case Expression::Kind::kRelNE: {
+      for (size_t i = 0; i < n; ++i) {
+        res[i] = !eq(i);
+      }
+      break;
+    }
+    case Expression::Kind::kRelLT: {
+      for (size_t i = 0; i < n; ++i) {
+        res[i] = lt(i);
+      }
+      break;
+    }
+    case Expression::Kind::kRelLE: {
+      for (size_t i = 0; i < n; ++i) {
+        res[i] = lt(i) || eq(i);
+      }
+      break;
+    }
+    case Expression::Kind::kRelGT: {
+      for (size_t i = 0; i < n; ++i) {
+        res[i] = !lt(i) && !eq(i);
+      }
+      break;
+    }
+    case Expression::Kind::kRelGE: {
+      for (size_t i = 0; i < n; ++i) {
+        res[i] = !lt(i) || eq(i);
+      }
+      break;
+    }
+    default: {
+      LOG(FATAL) << "Unexpected relational kind: " << kind;
+    }
+  }
+  return Column::makeBool(std::move(res), std::move(nulls));
+}
+
+// Numbers are compared as double once a float is involved, the same as Value
+template <typename L, typename R>
+Column compareNumbers(Expression::Kind kind,
+                      const std::vector<L>& lhs,
+                      const std::vector<R>& rhs,
+                      boost::dynamic_bitset<> nulls) {
+  if constexpr (std::is_integral<L>::value && std::is_integral<R>::value) {
+    return compare(
+        kind,
+        std::move(nulls),
+        [&](size_t i) { return lhs[i] < rhs[i]; },
+        [&](size_t i) { return lhs[i] == rhs[i]; });
+  }
+  return compare(
+      kind,
+      std::move(nulls),
+      [&](size_t i) { return std::abs(lhs[i] - rhs[i]) >= kEpsilon && lhs[i] < rhs[i]; },
+      [&](size_t i) { return std::abs(lhs[i] - rhs[i]) < kEpsilon; });
+}
+
+template <typename L, typename R>
+Column floatArithmetic(Expression::Kind kind,
+                       const std::vector<L>& lhs,
+                       const std::vector<R>& rhs,
+                       boost::dynamic_bitset<> nulls) {
+  auto n = nulls.size();
+  std::vector<double> res(n);
+  switch (kind) {
+    case Expression::Kind::kAdd: {
+      for (size_t i = 0; i < n; ++i) {
+        res[i] = lhs[i] + rhs[i];
+      }
+      break;
+    }
+    case Expression::Kind::kMinus: {
+      for (size_t i = 0; i < n; ++i) {
+        res[i] = lhs[i] - rhs[i];
+      }
+      break;
+    }
+    case Expression::Kind::kMultiply: {
+      for (size_t i = 0; i < n; ++i) {
+        res[i] = lhs[i] * rhs[i];
+      }
+      break;
+    }
+    default: {
+      LOG(FATAL) << "Unexpected arithmetic kind: " << kind;
+    }
+  }
+  return Column::makeFloat(std::move(res), std::move(nulls));
+}
+
+// Return false if any of the non-null elements overflows
+bool intArithmetic(Expression::Kind kind,
+                   const std::vector<int64_t>& lhs,
+                   const std::vector<int64_t>& rhs,
+                   const boost::dynamic_bitset<>& nulls,
+                   std::vector<int64_t>* res) {
+  auto n = nulls.size();
+  res->resize(n);
+  bool overflow = false;
+  switch (kind) {
+    case Expression::Kind::kAdd: {
+      for (size_t i = 0; i < n; ++i) {
+        overflow |= __builtin_add_overflow(lhs[i], rhs[i], &(*res)[i]) && !nulls[i];
+      }
+      break;
+    }
+    case Expression::Kind::kMinus: {
+      for (size_t i = 0; i < n; ++i) {
+        overflow |= __builtin_sub_overflow(lhs[i], rhs[i], &(*res)[i]) && !nulls[i];
+      }
+      break;
+    }
+    case Expression::Kind::kMultiply: {
+      for (size_t i = 0; i < n; ++i) {
+        overflow |= __builtin_mul_overflow(lhs[i], rhs[i], &(*res)[i]) && !nulls[i];
+      }
+      break;
+    }
+    default: {
+      LOG(FATAL) << "Unexpected arithmetic kind: " << kind;
+    }
+  }
+  return !overflow;
+}
+
+Value applyArithmetic(Expression::Kind kind, const Value& lhs, const Value& rhs) {
+  switch (kind) {
+    case Expression::Kind::kAdd:
+      return lhs + rhs;
+    case Expression::Kind::kMinus:
+      return lhs - rhs;
+    case Expression::Kind::kMultiply:
+      return lhs * rhs;
+    case Expression::Kind::kDivision:
+      return lhs / rhs;
+    case Expression::Kind::kMod:
+      return lhs % rhs;
+    default:
+      LOG(FATAL) << "Unexpected arithmetic kind: " << kind;
+  }
+}
+
+// Only bool or plain NULL columns could be combined with the typed logic
+bool isLogicalTyped(const Column& col) {
+  return col.kind() == Column::Kind::kBool || col.isAllNull();
+}
+
+}  // namespace
+
+BatchEvaluator::BatchEvaluator(QueryExpressionContext* ctx,
+                               SequentialIter* iter,
+                               size_t begin,
+                               size_t end)
+    : ctx_(ctx), iter_(iter), begin_(begin), end_(end) {
+  DCHECK_LE(begin_, end_);
+  DCHECK_LE(end_, iter_->size());
+}
+
+std::vector<size_t> BatchEvaluator::selectAll() const {
+  std::vector<size_t> sel(end_ - begin_);
+  std::iota(sel.begin(), sel.end(), begin_);
+  return sel;
+}
+
+Column BatchEvaluator::eval(Expression* expr, const std::vector<size_t>& sel) {
+  switch (expr->kind()) {
+    case Expression::Kind::kInputProperty:
+    case Expression::Kind::kVarProperty:
+    case Expression::Kind::kColumn: {
+      auto& colIndices = iter_->getColIndices();
+      auto idx = ColumnBatch::inputColumnIndex(expr, colIndices, colIndices.size());
+      if (idx < 0) {
+        break;
+      }
+      return evalInput(idx, sel);
+    }
+    case Expression::Kind::kConstant: {
+      return evalConstant(static_cast<ConstantExpression*>(expr)->value(), sel.size());
+    }
+    case Expression::Kind::kRelEQ:
+    case Expression::Kind::kRelNE:
+    case Expression::Kind::kRelLT:
+    case Expression::Kind::kRelLE:
+    case Expression::Kind::kRelGT:
+    case Expression::Kind::kRelGE: {
+      return evalRelational(static_cast<RelationalExpression*>(expr), sel);
+    }
+    case Expression::Kind::kLogicalAnd:
+    case Expression::Kind::kLogicalOr:
+    case Expression::Kind::kLogicalXor: {
+      return evalLogical(static_cast<LogicalExpression*>(expr), sel);
+    }
+    case Expression::Kind::kUnaryNot: {
+      return evalNot(static_cast<UnaryExpression*>(expr), sel);
+    }
+    case Expression::Kind::kAdd:
+    case Expression::Kind::kMinus:
+    case Expression::Kind::kMultiply:
+    case Expression::Kind::kDivision:
+    case Expression::Kind::kMod: {
+      return evalArithmetic(static_cast<ArithmeticExpression*>(expr), sel);
+    }
+    case Expression::Kind::kFunctionCall: {
+      return evalFunctionCall(static_cast<FunctionCallExpression*>(expr), sel);
+    }
+    default: {
+      break;
+    }
+  }
+  return evalRows(expr, sel);
+}
+
+StatusOr<std::vector<size_t>> BatchEvaluator::filter(Expression* cond,
+                                                     const std::vector<size_t>& sel) {
+  auto col = eval(cond, sel);
+  std::vector<size_t> selected;
+  selected.reserve(sel.size());
+  switch (col.kind()) {
+    case Column::Kind::kUnknown: {
+      break;
+    }
+    case Column::Kind::kBool: {
+      for (size_t i = 0; i < sel.size(); ++i) {
+        if (!col.isNull(i) && col.getBool(i)) {
+          selected.emplace_back(sel[i]);
+        }
+      }
+      break;
+    }
+    default: {
+      for (size_t i = 0; i < sel.size(); ++i) {
+        auto val = col.value(i);
+        if (val.isBadNull() || (!val.empty() && !val.isBool() && !val.isNull())) {
+          return Status::Error("Wrong type result, the type should be NULL, EMPTY or BOOL");
+        }
+        if (val.isBool() && val.getBool()) {
+          selected.emplace_back(sel[i]);
+        }
+      }
+      break;
+    }
+  }
+  return selected;
+}
+
+Column BatchEvaluator::evalInput(size_t colIdx, const std::vector<size_t>& sel) {
+  auto found = inputs_.find(colIdx);
+  if (found == inputs_.end()) {
+    Column col;
+    col.reserve(end_ - begin_);
+    auto begin = iter_->begin() + begin_;
+    auto end = iter_->begin() + end_;
+    for (auto it = begin; it != end; ++it) {
+      DCHECK_LT(colIdx, it->values.size());
+      col.append(it->values[colIdx]);
+    }
+    found = inputs_.emplace(colIdx, std::move(col)).first;
+  }
+  std::vector<size_t> positions(sel.size());
+  for (size_t i = 0; i < sel.size(); ++i) {
+    DCHECK_GE(sel[i], begin_);
+    positions[i] = sel[i] - begin_;
+  }
+  return found->second.gather(positions);
+}
+
+Column BatchEvaluator::evalConstant(const Value& val, size_t n) {
+  switch (val.type()) {
+    case Value::Type::BOOL: {
+      return Column::makeBool(std::vector<int64_t>(n, val.getBool()), boost::dynamic_bitset<>(n));
+    }
+    case Value::Type::INT: {
+      return Column::makeInt(std::vector<int64_t>(n, val.getInt()), boost::dynamic_bitset<>(n));
+    }
+    case Value::Type::FLOAT: {
+      return Column::makeFloat(std::vector<double>(n, val.getFloat()), boost::dynamic_bitset<>(n));
+    }
+    default: {
+      Column col;
+      col.reserve(n);
+      for (size_t i = 0; i < n; ++i) {
+        col.append(val);
+      }
+      return col;
+    }
+  }
+}
+
+Column BatchEvaluator::evalRelational(RelationalExpression* expr, const std::vector<size_t>& sel) {
+  auto lhs = eval(expr->left(), sel);
+  auto rhs = eval(expr->right(), sel);
+  auto kind = expr->kind();
+  if (!lhs.isTyped() || !rhs.isTyped()) {
+    return evalRows(expr, sel);
+  }
+  // Comparing with NULL always gets NULL
+  if (lhs.isAllNull() || rhs.isAllNull()) {
+    return Column::makeNull(sel.size());
+  }
+  auto nulls = lhs.nulls() | rhs.nulls();
+  auto lKind = lhs.kind();
+  auto rKind = rhs.kind();
+  if (lKind == Column::Kind::kInt && rKind == Column::Kind::kInt) {
+    return compareNumbers(kind, lhs.ints(), rhs.ints(), std::move(nulls));
+  }
+  if (lKind == Column::Kind::kFloat && rKind == Column::Kind::kFloat) {
+    return compareNumbers(kind, lhs.floats(), rhs.floats(), std::move(nulls));
+  }
+  if (lKind == Column::Kind::kInt && rKind == Column::Kind::kFloat) {
+    return compareNumbers(kind, lhs.ints(), rhs.floats(), std::move(nulls));
+  }
+  if (lKind == Column::Kind::kFloat && rKind == Column::Kind::kInt) {
+    return compareNumbers(kind, lhs.floats(), rhs.ints(), std::move(nulls));
+  }
+  if (lKind == Column::Kind::kBool && rKind == Column::Kind::kBool) {
+    auto& l = lhs.ints();
+    auto& r = rhs.ints();
+    return compare(
+        kind,
+        std::move(nulls),
+        [&](size_t i) { return l[i] < r[i]; },
+        [&](size_t i) { return l[i] == r[i]; });
+  }
+  if (lKind == Column::Kind::kString && rKind == Column::Kind::kString) {
+    // The null slots hold NULL values, so don't touch them
+    return compare(
+        kind,
+        nulls,
+        [&](size_t i) { return !nulls[i] && lhs.getStr(i) < rhs.getStr(i); },
+        [&](size_t i) { return !nulls[i] && lhs.getStr(i) == rhs.getStr(i); });
+  }
+  return evalRows(expr, sel);
+}
+
+Column BatchEvaluator::evalLogical(LogicalExpression* expr, const std::vector<size_t>& sel) {
+  auto kind = expr->kind();
+  auto& operands = expr->operands();
+  DCHECK_GE(operands.size(), 2UL);
+  auto n = sel.size();
+
+  if (kind == Expression::Kind::kLogicalXor) {
+    // Any NULL gets NULL, otherwise the parity of the trues
+    std::vector<int64_t> res(n, 0);
+    boost::dynamic_bitset<> nulls(n);
+    for (auto* operand : operands) {
+      auto col = eval(operand, sel);
+      if (!isLogicalTyped(col)) {
+        return evalRows(expr, sel);
+      }
+      nulls |= col.nulls();
+      if (!col.isAllNull()) {
+        auto& vals = col.ints();
+        for (size_t i = 0; i < n; ++i) {
+          res[i] ^= vals[i];
+        }
+      }
+    }
+    return Column::makeBool(std::move(res), std::move(nulls));
+  }
+
+  // AND: any false gets false, otherwise any NULL gets NULL, otherwise true.
+  // OR is the same with true and false swapped. Each operand is only
+  // evaluated on the rows whose result is still undecided.
+  bool isAnd = kind == Expression::Kind::kLogicalAnd;
+  std::vector<int64_t> res(n, isAnd);
+  boost::dynamic_bitset<> nulls(n);
+  // Positions in `sel' of the undecided rows
+  std::vector<size_t> pending(n);
+  std::iota(pending.begin(), pending.end(), 0);
+  for (auto* operand : operands) {
+    if (pending.empty()) {
+      break;
+    }
+    std::vector<size_t> pendingSel(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+      pendingSel[i] = sel[pending[i]];
+    }
+    auto col = eval(operand, pendingSel);
+    if (!isLogicalTyped(col)) {
+      // Let the expression decide the remaining rows
+      auto rest = evalRows(expr, pendingSel);
+      Column out;
+      out.reserve(n);
+      size_t next = 0;
+      for (size_t i = 0; i < n; ++i) {
+        if (next < pending.size() && pending[next] == i) {
+          out.append(rest.value(next++));
+        } else {
+          out.append(nulls[i] ? Value::kNullValue : Value(res[i] != 0));
+        }
+      }
+      return out;
+    }
+    std::vector<size_t> undecided;
+    undecided.reserve(pending.size());
+    for (size_t i = 0; i < pending.size(); ++i) {
+      auto pos = pending[i];
+      if (col.isNull(i)) {
+        nulls[pos] = true;
+        undecided.emplace_back(pos);
+      } else if (col.getBool(i) != isAnd) {
+        // Short circuit
+        res[pos] = !isAnd;
+        nulls[pos] = false;
+      } else {
+        undecided.emplace_back(pos);
+      }
+    }
+    pending = std::move(undecided);
+  }
+  return Column::makeBool(std::move(res), std::move(nulls));
+}
+
+Column BatchEvaluator::evalNot(UnaryExpression* expr, const std::vector<size_t>& sel) {
+  auto col = eval(expr->operand(), sel);
+  if (col.isAllNull()) {
+    return col;
+  }
+  if (col.kind() != Column::Kind::kBool) {
+    Column out;
+    out.reserve(col.size());
+    for (size_t i = 0; i < col.size(); ++i) {
+      out.append(!col.value(i));
+    }
+    return out;
+  }
+  auto vals = col.ints();
+  for (auto& v : vals) {
+    v = !v;
+  }
+  return Column::makeBool(std::move(vals), col.nulls());
+}
+
+Column BatchEvaluator::evalArithmetic(ArithmeticExpression* expr, const std::vector<size_t>& sel) {
+  auto lhs = eval(expr->left(), sel);
+  auto rhs = eval(expr->right(), sel);
+  auto kind = expr->kind();
+  bool typed = lhs.isNumeric() && rhs.isNumeric() &&
+               (kind == Expression::Kind::kAdd || kind == Expression::Kind::kMinus ||
+                kind == Expression::Kind::kMultiply);
+  if (typed) {
+    auto nulls = lhs.nulls() | rhs.nulls();
+    auto lKind = lhs.kind();
+    auto rKind = rhs.kind();
+    if (lKind == Column::Kind::kInt && rKind == Column::Kind::kInt) {
+      std::vector<int64_t> res;
+      if (intArithmetic(kind, lhs.ints(), rhs.ints(), nulls, &res)) {
+        return Column::makeInt(std::move(res), std::move(nulls));
+      }
+      // Fall through to get the overflow nulls
+    } else if (lKind == Column::Kind::kFloat && rKind == Column::Kind::kFloat) {
+      return floatArithmetic(kind, lhs.floats(), rhs.floats(), std::move(nulls));
+    } else if (lKind == Column::Kind::kInt) {
+      return floatArithmetic(kind, lhs.ints(), rhs.floats(), std::move(nulls));
+    } else {
+      return floatArithmetic(kind, lhs.floats(), rhs.ints(), std::move(nulls));
+    }
+  }
+  // The operators of Value are exactly what ArithmeticExpression evaluates
+  Column out;
+  out.reserve(sel.size());
+  for (size_t i = 0; i < sel.size(); ++i) {
+    out.append(applyArithmetic(kind, lhs.value(i), rhs.value(i)));
+  }
+  return out;
+}
+
+Column BatchEvaluator::evalFunctionCall(FunctionCallExpression* expr,
+                                        const std::vector<size_t>& sel) {
+  auto& args = expr->args()->args();
+  // Resolve the function once per batch
+  auto func = FunctionManager::get(expr->name(), args.size());
+  if (!func.ok()) {
+    return evalRows(expr, sel);
+  }
+  std::vector<Column> argCols;
+  argCols.reserve(args.size());
+  for (auto* arg : args) {
+    argCols.emplace_back(eval(arg, sel));
+  }
+  Column out;
+  out.reserve(sel.size());
+  std::vector<Value> argVals(args.size());
+  std::vector<FunctionManager::ArgType> params;
+  params.reserve(args.size());
+  for (auto& val : argVals) {
+    params.emplace_back(val);
+  }
+  auto& call = func.value();
+  for (size_t i = 0; i < sel.size(); ++i) {
+    for (size_t j = 0; j < argCols.size(); ++j) {
+      argVals[j] = argCols[j].value(i);
+    }
+    out.append(call(params));
+  }
+  return out;
+}
+
+Column BatchEvaluator::evalRows(Expression* expr, const std::vector<size_t>& sel) {
+  Column out;
+  out.reserve(sel.size());
+  for (auto pos : sel) {
+    iter_->reset(pos);
+    out.append(expr->eval((*ctx_)(iter_)));
+  }
+  return out;
+}
+
+}  // namespace graph
+}  // namespace nebula
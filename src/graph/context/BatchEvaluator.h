@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_CONTEXT_BATCHEVALUATOR_H_
+#define GRAPH_CONTEXT_BATCHEVALUATOR_H_
+
+#include "common/base/StatusOr.h"
+#include "common/expression/Expression.h"
+#include "graph/context/ColumnBatch.h"
+#include "graph/context/Iterator.h"
+#include "graph/context/QueryExpressionContext.h"
+
+namespace nebula {
+
+class ArithmeticExpression;
+class FunctionCallExpression;
+class LogicalExpression;
+class RelationalExpression;
+class UnaryExpression;
+
+namespace graph {
+
+// Evaluate the expressions over a range of rows of a SequentialIter at once.
+//
+// The input columns are converted to the columnar format, then the hot
+// expressions (property/column references, constants, relational, logical,
+// arithmetic and function calls) are evaluated column by column with
+// type-specialized loops, instead of walking the expression tree through
+// virtual calls for every row. Everything else, and the typed operations
+// which hit a corner case (e.g. overflow), is evaluated row by row by the
+// expression itself, so the results are always the same as Expression::eval.
+//
+// The rows are addressed by their positions in the iterator, a selection
+// vector picks the rows to evaluate on.
+class BatchEvaluator final {
+ public:
+  // Evaluate on the rows [begin, end) of `iter'
+  BatchEvaluator(QueryExpressionContext* ctx, SequentialIter* iter, size_t begin, size_t end);
+
+  // Select all the rows of the range
+  std::vector<size_t> selectAll() const;
+
+  // Evaluate `expr' on the selected rows, the i-th result belongs to the
+  // row at sel[i]
+  Column eval(Expression* expr, const std::vector<size_t>& sel);
+
+  // Keep the selected rows on which `cond' is true, the order is kept.
+  // Fail if `cond' is evaluated to neither a bool, NULL nor EMPTY.
+  StatusOr<std::vector<size_t>> filter(Expression* cond, const std::vector<size_t>& sel);
+
+ private:
+  Column evalInput(size_t colIdx, const std::vector<size_t>& sel);
+
+  Column evalConstant(const Value& val, size_t n);
+
+  Column evalRelational(RelationalExpression* expr, const std::vector<size_t>& sel);
+
+  Column evalLogical(LogicalExpression* expr, const std::vector<size_t>& sel);
+
+  Column evalNot(UnaryExpression* expr, const std::vector<size_t>& sel);
+
+  Column evalArithmetic(ArithmeticExpression* expr, const std::vector<size_t>& sel);
+
+  Column evalFunctionCall(FunctionCallExpression* expr, const std::vector<size_t>& sel);
+
+  // Evaluate by the expression itself row by row
+  Column evalRows(Expression* expr, const std::vector<size_t>& sel);
+
+  QueryExpressionContext* ctx_;
+  SequentialIter* iter_;
+  size_t begin_;
+  size_t end_;
+  // The input columns of the range which have been converted
+  std::unordered_map<size_t, Column> inputs_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_CONTEXT_BATCHEVALUATOR_H_
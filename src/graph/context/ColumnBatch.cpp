@@ -0,0 +1,424 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/context/ColumnBatch.h"
+
+#include "common/expression/ColumnExpression.h"
+#include "common/expression/PropertyExpression.h"
+
+namespace nebula {
+namespace graph {
+
+// static
+Column Column::makeBool(std::vector<int64_t> vals, boost::dynamic_bitset<> nulls) {
+  DCHECK_EQ(vals.size(), nulls.size());
+  Column col;
+  col.kind_ = Kind::kBool;
+  col.size_ = vals.size();
+  col.ints_ = std::move(vals);
+  col.nulls_ = std::move(nulls);
+  return col;
+}
+
+// static
+Column Column::makeInt(std::vector<int64_t> vals, boost::dynamic_bitset<> nulls) {
+  DCHECK_EQ(vals.size(), nulls.size());
+  Column col;
+  col.kind_ = Kind::kInt;
+  col.size_ = vals.size();
+  col.ints_ = std::move(vals);
+  col.nulls_ = std::move(nulls);
+  return col;
+}
+
+// static
+Column Column::makeFloat(std::vector<double> vals, boost::dynamic_bitset<> nulls) {
+  DCHECK_EQ(vals.size(), nulls.size());
+  Column col;
+  col.kind_ = Kind::kFloat;
+  col.size_ = vals.size();
+  col.floats_ = std::move(vals);
+  col.nulls_ = std::move(nulls);
+  return col;
+}
+
+// static
+Column Column::makeNull(size_t n) {
+  Column col;
+  col.size_ = n;
+  col.nulls_.resize(n, true);
+  return col;
+}
+
+void Column::reserve(size_t n) {
+  reserved_ = n;
+  nulls_.reserve(n);
+  switch (kind_) {
+    case Kind::kUnknown: {
+      // Reserved once the type is known
+      break;
+    }
+    case Kind::kBool:
+    case Kind::kInt: {
+      ints_.reserve(n);
+      break;
+    }
+    case Kind::kFloat: {
+      floats_.reserve(n);
+      break;
+    }
+    default: {
+      boxes_.reserve(n);
+      break;
+    }
+  }
+}
+
+bool Column::typedAppendable(const Value& val) const {
+  switch (val.type()) {
+    case Value::Type::NULLVALUE: {
+      return val.getNull() == NullType::__NULL__;
+    }
+    case Value::Type::BOOL: {
+      return kind_ == Kind::kUnknown || kind_ == Kind::kBool;
+    }
+    case Value::Type::INT: {
+      return kind_ == Kind::kUnknown || kind_ == Kind::kInt;
+    }
+    case Value::Type::FLOAT: {
+      return kind_ == Kind::kUnknown || kind_ == Kind::kFloat;
+    }
+    case Value::Type::STRING: {
+      return kind_ == Kind::kUnknown || kind_ == Kind::kString;
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+void Column::decideKind(const Value& val) {
+  // The first non-null value decides the type, the preceding nulls are padded
+  // into the storage of that type
+  switch (val.type()) {
+    case Value::Type::BOOL: {
+      kind_ = Kind::kBool;
+      break;
+    }
+    case Value::Type::INT: {
+      kind_ = Kind::kInt;
+      break;
+    }
+    case Value::Type::FLOAT: {
+      kind_ = Kind::kFloat;
+      break;
+    }
+    default: {
+      DCHECK(val.isStr());
+      kind_ = Kind::kString;
+      break;
+    }
+  }
+  reserve(std::max(reserved_, size_));
+  switch (kind_) {
+    case Kind::kBool:
+    case Kind::kInt: {
+      ints_.resize(size_, 0);
+      break;
+    }
+    case Kind::kFloat: {
+      floats_.resize(size_, 0.0);
+      break;
+    }
+    default: {
+      boxes_.resize(size_, Value::kNullValue);
+      break;
+    }
+  }
+}
+
+void Column::append(const Value& val) { append(Value(val)); }
+
+void Column::append(Value&& val) {
+  if (kind_ != Kind::kValue && !typedAppendable(val)) {
+    box();
+  }
+  if (kind_ == Kind::kValue) {
+    boxes_.emplace_back(std::move(val));
+    ++size_;
+    return;
+  }
+  bool isNull = val.isNull();
+  if (kind_ == Kind::kUnknown && !isNull) {
+    decideKind(val);
+  }
+  nulls_.push_back(isNull);
+  switch (kind_) {
+    case Kind::kUnknown: {
+      // Only nulls so far, the bitmap is all we need
+      break;
+    }
+    case Kind::kBool: {
+      ints_.emplace_back(isNull ? 0 : static_cast<int64_t>(val.getBool()));
+      break;
+    }
+    case Kind::kInt: {
+      ints_.emplace_back(isNull ? 0 : val.getInt());
+      break;
+    }
+    case Kind::kFloat: {
+      floats_.emplace_back(isNull ? 0.0 : val.getFloat());
+      break;
+    }
+    case Kind::kString: {
+      boxes_.emplace_back(std::move(val));
+      break;
+    }
+    case Kind::kValue: {
+      LOG(FATAL) << "Unexpected boxed column";
+      break;
+    }
+  }
+  ++size_;
+}
+
+void Column::box() {
+  if (kind_ == Kind::kValue) {
+    return;
+  }
+  std::vector<Value> boxes;
+  boxes.reserve(size_);
+  for (size_t i = 0; i < size_; ++i) {
+    boxes.emplace_back(value(i));
+  }
+  boxes_ = std::move(boxes);
+  ints_.clear();
+  floats_.clear();
+  nulls_.clear();
+  kind_ = Kind::kValue;
+}
+
+Value Column::value(size_t i) const {
+  DCHECK_LT(i, size_);
+  if (kind_ == Kind::kValue) {
+    return boxes_[i];
+  }
+  if (nulls_[i]) {
+    return Value::kNullValue;
+  }
+  switch (kind_) {
+    case Kind::kBool: {
+      return Value(ints_[i] != 0);
+    }
+    case Kind::kInt: {
+      return Value(ints_[i]);
+    }
+    case Kind::kFloat: {
+      return Value(floats_[i]);
+    }
+    default: {
+      return boxes_[i];
+    }
+  }
+}
+
+int Column::compare(size_t i, size_t j) const {
+  if (kind_ == Kind::kValue) {
+    const auto& lhs = boxes_[i];
+    const auto& rhs = boxes_[j];
+    if (lhs == rhs) {
+      return 0;
+    }
+    return lhs < rhs ? -1 : 1;
+  }
+  // NULL is bigger than any other value
+  bool lNull = nulls_[i], rNull = nulls_[j];
+  if (lNull || rNull) {
+    return lNull == rNull ? 0 : (lNull ? 1 : -1);
+  }
+  switch (kind_) {
+    case Kind::kBool:
+    case Kind::kInt: {
+      auto l = ints_[i], r = ints_[j];
+      return l == r ? 0 : (l < r ? -1 : 1);
+    }
+    case Kind::kFloat: {
+      auto l = floats_[i], r = floats_[j];
+      if (std::abs(l - r) < kEpsilon) {
+        return 0;
+      }
+      return l < r ? -1 : 1;
+    }
+    case Kind::kString: {
+      auto cmp = boxes_[i].getStr().compare(boxes_[j].getStr());
+      return cmp == 0 ? 0 : (cmp < 0 ? -1 : 1);
+    }
+    default: {
+      // All nulls
+      return 0;
+    }
+  }
+}
+
+Column Column::gather(const std::vector<size_t>& sel) const {
+  Column col;
+  col.kind_ = kind_;
+  col.size_ = sel.size();
+  if (kind_ != Kind::kValue) {
+    col.nulls_.resize(sel.size());
+    for (size_t k = 0; k < sel.size(); ++k) {
+      col.nulls_[k] = nulls_[sel[k]];
+    }
+  }
+  switch (kind_) {
+    case Kind::kBool:
+    case Kind::kInt: {
+      col.ints_.reserve(sel.size());
+      for (auto i : sel) {
+        col.ints_.emplace_back(ints_[i]);
+      }
+      break;
+    }
+    case Kind::kFloat: {
+      col.floats_.reserve(sel.size());
+      for (auto i : sel) {
+        col.floats_.emplace_back(floats_[i]);
+      }
+      break;
+    }
+    default: {
+      col.boxes_.reserve(sel.size());
+      for (auto i : sel) {
+        col.boxes_.emplace_back(boxes_[i]);
+      }
+      break;
+    }
+  }
+  return col;
+}
+
+ColumnBatch::ColumnBatch(std::vector<std::string> colNames) : colNames_(std::move(colNames)) {
+  columns_.resize(colNames_.size());
+}
+
+// static
+ColumnBatch ColumnBatch::fromRows(std::vector<Row>::const_iterator begin,
+                                  std::vector<Row>::const_iterator end,
+                                  const std::vector<std::string>& colNames,
+                                  const std::vector<size_t>& colIdxs) {
+  DCHECK_EQ(colNames.size(), colIdxs.size());
+  ColumnBatch batch(colNames);
+  auto numRows = static_cast<size_t>(std::distance(begin, end));
+  for (size_t c = 0; c < colIdxs.size(); ++c) {
+    auto& col = batch.columns_[c];
+    auto idx = colIdxs[c];
+    col.reserve(numRows);
+    for (auto it = begin; it != end; ++it) {
+      DCHECK_LT(idx, it->values.size());
+      col.append(it->values[idx]);
+    }
+  }
+  batch.numRows_ = numRows;
+  return batch;
+}
+
+// static
+ColumnBatch ColumnBatch::fromDataSet(const DataSet& ds) {
+  std::vector<size_t> colIdxs(ds.colNames.size());
+  for (size_t i = 0; i < colIdxs.size(); ++i) {
+    colIdxs[i] = i;
+  }
+  return fromRows(ds.rows.begin(), ds.rows.end(), ds.colNames, colIdxs);
+}
+
+DataSet ColumnBatch::toDataSet() const {
+  DataSet ds(colNames_);
+  ds.rows.reserve(numRows_);
+  for (size_t r = 0; r < numRows_; ++r) {
+    Row row;
+    row.values.reserve(columns_.size());
+    for (auto& col : columns_) {
+      row.values.emplace_back(col.value(r));
+    }
+    ds.rows.emplace_back(std::move(row));
+  }
+  return ds;
+}
+
+DataSet ColumnBatch::moveToDataSet() && {
+  DataSet ds(std::move(colNames_));
+  ds.rows.resize(numRows_);
+  for (auto& row : ds.rows) {
+    row.values.reserve(columns_.size());
+  }
+  for (auto& col : columns_) {
+    if (col.kind() == Column::Kind::kValue || col.kind() == Column::Kind::kString) {
+      for (size_t r = 0; r < numRows_; ++r) {
+        ds.rows[r].values.emplace_back(std::move(col.boxes_[r]));
+      }
+    } else {
+      for (size_t r = 0; r < numRows_; ++r) {
+        ds.rows[r].values.emplace_back(col.value(r));
+      }
+    }
+  }
+  columns_.clear();
+  numRows_ = 0;
+  return ds;
+}
+
+void ColumnBatch::addColumn(std::string name, Column col) {
+  DCHECK(columns_.empty() || col.size() == numRows_);
+  numRows_ = col.size();
+  colNames_.emplace_back(std::move(name));
+  columns_.emplace_back(std::move(col));
+}
+
+void ColumnBatch::appendRow(const Row& row) {
+  DCHECK_EQ(row.size(), columns_.size());
+  for (size_t c = 0; c < columns_.size(); ++c) {
+    columns_[c].append(row.values[c]);
+  }
+  ++numRows_;
+}
+
+ColumnBatch ColumnBatch::gather(const std::vector<size_t>& sel) const {
+  ColumnBatch batch;
+  batch.colNames_ = colNames_;
+  batch.columns_.reserve(columns_.size());
+  for (auto& col : columns_) {
+    batch.columns_.emplace_back(col.gather(sel));
+  }
+  batch.numRows_ = sel.size();
+  return batch;
+}
+
+// static
+int64_t ColumnBatch::inputColumnIndex(const Expression* expr,
+                                      const std::unordered_map<std::string, size_t>& colIndices,
+                                      size_t numCols) {
+  switch (expr->kind()) {
+    case Expression::Kind::kInputProperty:
+    case Expression::Kind::kVarProperty: {
+      auto& prop = static_cast<const PropertyExpression*>(expr)->prop();
+      auto found = colIndices.find(prop);
+      return found == colIndices.end() ? -1 : static_cast<int64_t>(found->second);
+    }
+    case Expression::Kind::kColumn: {
+      int64_t index = static_cast<const ColumnExpression*>(expr)->index();
+      auto size = static_cast<int64_t>(numCols);
+      if ((index > 0 && index >= size) || (index < 0 && -index > size)) {
+        return -1;
+      }
+      return (size + index) % size;
+    }
+    default: {
+      return -1;
+    }
+  }
+}
+
+}  // namespace graph
+}  // namespace nebula
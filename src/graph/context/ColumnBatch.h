@@ -0,0 +1,178 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_CONTEXT_COLUMNBATCH_H_
+#define GRAPH_CONTEXT_COLUMNBATCH_H_
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+class Expression;
+
+namespace graph {
+
+// One column of a DataSet laid out contiguously by type.
+//
+// A column starts typed: bool, int and float values are kept unboxed and
+// strings are kept as shared string values, NULL is recorded in the null
+// bitmap. Once a value of another type (or a NULL other than __NULL__, or an
+// EMPTY) is appended, the column degrades to boxed Values, so converting a
+// DataSet to columns and back never loses anything.
+class Column final {
+ public:
+  enum class Kind : uint8_t {
+    kUnknown,  // No non-null value has been appended yet
+    kBool,
+    kInt,
+    kFloat,
+    kString,
+    kValue,  // Boxed values of mixed types
+  };
+
+  Column() = default;
+
+  // Build the typed columns directly, `nulls' has the same size as `vals'
+  static Column makeBool(std::vector<int64_t> vals, boost::dynamic_bitset<> nulls);
+  static Column makeInt(std::vector<int64_t> vals, boost::dynamic_bitset<> nulls);
+  static Column makeFloat(std::vector<double> vals, boost::dynamic_bitset<> nulls);
+  // A column of `n' nulls
+  static Column makeNull(size_t n);
+
+  Kind kind() const { return kind_; }
+
+  size_t size() const { return size_; }
+
+  bool isTyped() const { return kind_ != Kind::kValue; }
+
+  bool isAllNull() const { return kind_ == Kind::kUnknown; }
+
+  bool isNumeric() const { return kind_ == Kind::kInt || kind_ == Kind::kFloat; }
+
+  bool isNull(size_t i) const { return kind_ == Kind::kValue ? boxes_[i].isNull() : nulls_[i]; }
+
+  // Only valid for the typed kinds
+  bool getBool(size_t i) const {
+    DCHECK(kind_ == Kind::kBool);
+    return ints_[i] != 0;
+  }
+
+  int64_t getInt(size_t i) const {
+    DCHECK(kind_ == Kind::kInt);
+    return ints_[i];
+  }
+
+  double getFloat(size_t i) const {
+    DCHECK(kind_ == Kind::kFloat);
+    return floats_[i];
+  }
+
+  const std::string& getStr(size_t i) const {
+    DCHECK(kind_ == Kind::kString);
+    return boxes_[i].getStr();
+  }
+
+  const std::vector<int64_t>& ints() const { return ints_; }
+
+  const std::vector<double>& floats() const { return floats_; }
+
+  const boost::dynamic_bitset<>& nulls() const { return nulls_; }
+
+  void reserve(size_t n);
+
+  void append(const Value& val);
+
+  void append(Value&& val);
+
+  // Box the i-th element back into a Value
+  Value value(size_t i) const;
+
+  // Compare the i-th and the j-th element with the semantics of Value's
+  // operator== and operator<, returns -1, 0 or 1
+  int compare(size_t i, size_t j) const;
+
+  // Keep only the elements at the selected positions, in that order
+  Column gather(const std::vector<size_t>& sel) const;
+
+ private:
+  // Convert all the typed values to boxed ones
+  void box();
+
+  bool typedAppendable(const Value& val) const;
+
+  void decideKind(const Value& val);
+
+  friend class ColumnBatch;
+
+  Kind kind_{Kind::kUnknown};
+  size_t size_{0};
+  size_t reserved_{0};
+  boost::dynamic_bitset<> nulls_;
+  // Values of the bool and int columns
+  std::vector<int64_t> ints_;
+  std::vector<double> floats_;
+  // Values of the string columns (or nulls), or all values of a boxed column
+  std::vector<Value> boxes_;
+};
+
+// A batch of rows stored column by column.
+//
+// It's the columnar counterpart of the DataSet, and is converted from/to the
+// DataSet at the boundary of the executors which are able to work on it.
+class ColumnBatch final {
+ public:
+  ColumnBatch() = default;
+
+  explicit ColumnBatch(std::vector<std::string> colNames);
+
+  // Convert the columns at `colIdxs' of rows [begin, end)
+  static ColumnBatch fromRows(std::vector<Row>::const_iterator begin,
+                              std::vector<Row>::const_iterator end,
+                              const std::vector<std::string>& colNames,
+                              const std::vector<size_t>& colIdxs);
+
+  static ColumnBatch fromDataSet(const DataSet& ds);
+
+  DataSet toDataSet() const;
+
+  // Move the values out to build rows
+  DataSet moveToDataSet() &&;
+
+  size_t numRows() const { return numRows_; }
+
+  size_t numColumns() const { return columns_.size(); }
+
+  const std::vector<std::string>& colNames() const { return colNames_; }
+
+  const Column& column(size_t i) const { return columns_[i]; }
+
+  // Append a column which has the same number of rows as this batch
+  void addColumn(std::string name, Column col);
+
+  void appendRow(const Row& row);
+
+  // Keep only the rows at the selected positions, in that order
+  ColumnBatch gather(const std::vector<size_t>& sel) const;
+
+  // Return the input column index if `expr' just references a column of the
+  // input, e.g. $-.col, $var.col or COLUMN[0], otherwise -1
+  static int64_t inputColumnIndex(const Expression* expr,
+                                  const std::unordered_map<std::string, size_t>& colIndices,
+                                  size_t numCols);
+
+ private:
+  std::vector<std::string> colNames_;
+  std::vector<Column> columns_;
+  size_t numRows_{0};
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_CONTEXT_COLUMNBATCH_H_
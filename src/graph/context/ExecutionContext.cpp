@@ -84,5 +84,21 @@ const std::vector<Result>& ExecutionContext::getHistory(const std::string& name)
   }
 }
 
+std::unique_ptr<ExecutionContext> ExecutionContext::clone() const {
+  auto ectx = std::make_unique<ExecutionContext>();
+  for (auto& entry : valueMap_) {
+    auto& hist = ectx->valueMap_[entry.first];
+    hist.reserve(entry.second.size());
+    for (auto& result : entry.second) {
+      auto& core = result.core_;
+      ResultBuilder builder;
+      builder.value(Value(*core.value)).state(core.state).msg(std::string(core.msg));
+      builder.iter(core.iter->kind());
+      hist.emplace_back(builder.build());
+    }
+  }
+  return ectx;
+}
+
 }  // namespace graph
 }  // namespace nebula
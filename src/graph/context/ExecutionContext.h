@@ -66,6 +66,10 @@ class ExecutionContext {
 
   bool exist(const std::string& name) const { return valueMap_.find(name) != valueMap_.end(); }
 
+  // Deep copy all the values with their history, since the executors might
+  // change a value in place through its iterator
+  std::unique_ptr<ExecutionContext> clone() const;
+
  private:
   friend class QueryInstance;
   Value moveValue(const std::string& name);
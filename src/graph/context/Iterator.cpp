@@ -621,6 +621,34 @@ const Value& SequentialIter::getColumn(int32_t index) const {
   return getColumnByIndex(index, iter_);
 }
 
+std::vector<std::string> SequentialIter::colNames() const {
+  std::vector<std::string> names(colIndices_.size());
+  for (auto& kv : colIndices_) {
+    DCHECK_LT(kv.second, names.size());
+    names[kv.second] = kv.first;
+  }
+  return names;
+}
+
+ColumnBatch SequentialIter::toColumnBatch(const std::vector<size_t>& colIdxs) const {
+  auto names = colNames();
+  std::vector<std::string> selected;
+  selected.reserve(colIdxs.size());
+  for (auto idx : colIdxs) {
+    DCHECK_LT(idx, names.size());
+    selected.emplace_back(names[idx]);
+  }
+  return ColumnBatch::fromRows(rows_->begin(), rows_->end(), selected, colIdxs);
+}
+
+ColumnBatch SequentialIter::toColumnBatch() const {
+  std::vector<size_t> colIdxs(colIndices_.size());
+  for (size_t i = 0; i < colIdxs.size(); ++i) {
+    colIdxs[i] = i;
+  }
+  return toColumnBatch(colIdxs);
+}
+
 Value SequentialIter::getVertex(const std::string& name) const { return getColumn(name); }
 
 Value SequentialIter::getEdge() const { return getColumn("EDGE"); }
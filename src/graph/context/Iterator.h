@@ -14,6 +14,7 @@
 #include "common/datatypes/DataSet.h"
 #include "common/datatypes/List.h"
 #include "common/datatypes/Value.h"
+#include "graph/context/ColumnBatch.h"
 #include "parser/TraverseSentences.h"
 
 namespace nebula {
@@ -409,6 +410,15 @@ class SequentialIter : public Iterator {
 
   const std::unordered_map<std::string, size_t>& getColIndices() const { return colIndices_; }
 
+  // Column names ordered by the column index
+  std::vector<std::string> colNames() const;
+
+  // Convert the columns at `colIdxs' of all rows to the columnar format
+  ColumnBatch toColumnBatch(const std::vector<size_t>& colIdxs) const;
+
+  // Convert all rows to the columnar format
+  ColumnBatch toColumnBatch() const;
+
   size_t size() const override { return rows_->size(); }
 
   const Value& getColumn(const std::string& col) const override {
@@ -0,0 +1,143 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/context/JoinHashTable.h"
+
+#include <folly/hash/Hash.h>
+
+#include <numeric>
+
+namespace nebula {
+namespace graph {
+
+void JoinKeys::append(const Row* row) {
+  DCHECK_EQ(values.size(), (rows.size() + 1) * width);
+  hashes.emplace_back(hash(key(rows.size()), width));
+  rows.emplace_back(row);
+}
+
+// static
+size_t JoinKeys::hash(const Value* key, size_t width) {
+  size_t seed = 0;
+  for (size_t i = 0; i < width; ++i) {
+    seed = folly::hash::hash_128_to_64(seed, std::hash<Value>()(key[i]));
+  }
+  // The high bits pick the partition and the low bits pick the slot, mix them
+  // up since the hash of an integer is itself
+  return folly::hash::twang_mix64(seed);
+}
+
+// static
+bool JoinKeys::equal(const Value* lhs, const Value* rhs, size_t width) {
+  for (size_t i = 0; i < width; ++i) {
+    if (!(lhs[i] == rhs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+JoinHashTable::JoinHashTable(JoinKeys keys) : keys_(std::move(keys)) {
+  auto n = keys_.size();
+  DCHECK_LT(n, kNone);
+  while (bits_ < kMaxPartitionBits && (n >> bits_) > kRowsPerPartition) {
+    ++bits_;
+  }
+  size_t numParts = 1UL << bits_;
+
+  // Counting sort the rows by partition, which keeps the order of the rows in
+  // each partition
+  partBegins_.assign(numParts + 1, 0);
+  for (auto h : keys_.hashes) {
+    ++partBegins_[partitionOf(h) + 1];
+  }
+  for (size_t p = 0; p < numParts; ++p) {
+    partBegins_[p + 1] += partBegins_[p];
+  }
+  auto cursors = partBegins_;
+  order_.resize(n);
+  hashes_.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    auto h = keys_.hashes[i];
+    auto pos = cursors[partitionOf(h)]++;
+    order_[pos] = i;
+    hashes_[pos] = h;
+  }
+  next_.assign(n, kNone);
+  last_.assign(n, kNone);
+  slots_.resize(numParts);
+}
+
+void JoinHashTable::buildPartition(size_t part) {
+  auto begin = partBegins_[part];
+  auto end = partBegins_[part + 1];
+  auto& slots = slots_[part];
+  size_t capacity = 1;
+  while (capacity < (end - begin) * 2) {
+    capacity <<= 1;
+  }
+  slots.assign(capacity, kNone);
+  auto mask = capacity - 1;
+  for (auto entry = begin; entry < end; ++entry) {
+    auto h = hashes_[entry];
+    auto* key = keys_.key(order_[entry]);
+    for (auto slot = h & mask;; slot = (slot + 1) & mask) {
+      auto head = slots[slot];
+      if (head == kNone) {
+        slots[slot] = entry;
+        last_[entry] = entry;
+        break;
+      }
+      if (hashes_[head] == h && JoinKeys::equal(keys_.key(order_[head]), key, keys_.width)) {
+        next_[last_[head]] = entry;
+        last_[head] = entry;
+        break;
+      }
+    }
+  }
+}
+
+std::vector<std::vector<uint32_t>> JoinHashTable::partition(const JoinKeys& probe) const {
+  std::vector<std::vector<uint32_t>> parts(numPartitions());
+  if (parts.size() == 1) {
+    parts[0].resize(probe.size());
+    std::iota(parts[0].begin(), parts[0].end(), 0);
+    return parts;
+  }
+  for (size_t i = 0; i < probe.size(); ++i) {
+    parts[partitionOf(probe.hashes[i])].emplace_back(i);
+  }
+  return parts;
+}
+
+void JoinHashTable::probePartition(const JoinKeys& probe,
+                                   size_t part,
+                                   const std::vector<uint32_t>& positions,
+                                   std::vector<uint32_t>* heads) const {
+  for (auto pos : positions) {
+    DCHECK_EQ(partitionOf(probe.hashes[pos]), part);
+    (*heads)[pos] = find(probe.hashes[pos], probe.key(pos));
+  }
+}
+
+uint32_t JoinHashTable::find(size_t hash, const Value* key) const {
+  auto& slots = slots_[partitionOf(hash)];
+  if (slots.empty()) {
+    return kNone;
+  }
+  auto mask = slots.size() - 1;
+  for (auto slot = hash & mask;; slot = (slot + 1) & mask) {
+    auto head = slots[slot];
+    if (head == kNone) {
+      return kNone;
+    }
+    if (hashes_[head] == hash && JoinKeys::equal(keys_.key(order_[head]), key, keys_.width)) {
+      return head;
+    }
+  }
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,118 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_CONTEXT_JOINHASHTABLE_H_
+#define GRAPH_CONTEXT_JOINHASHTABLE_H_
+
+#include <limits>
+
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// The join keys of a sequence of rows, evaluated once and stored
+// contiguously: the `width' key values of the i-th row are at
+// values[i * width, (i + 1) * width).
+struct JoinKeys {
+  explicit JoinKeys(size_t w = 1) : width(w) {}
+
+  size_t size() const { return rows.size(); }
+
+  const Value* key(size_t i) const { return &values[i * width]; }
+
+  void reserve(size_t n) {
+    values.reserve(n * width);
+    hashes.reserve(n);
+    rows.reserve(n);
+  }
+
+  // Append the row whose keys have just been pushed to `values'
+  void append(const Row* row);
+
+  static size_t hash(const Value* key, size_t width);
+
+  static bool equal(const Value* lhs, const Value* rhs, size_t width);
+
+  size_t width;
+  std::vector<Value> values;
+  std::vector<size_t> hashes;
+  std::vector<const Row*> rows;
+};
+
+// The hash table of the hash join.
+//
+// The build rows are radix partitioned by the high bits of the key hashes, so
+// that the table of each partition fits in the cache. Each partition is an
+// open addressing table with linear probing over the entry indices, the key
+// hashes are kept next to the entries so most mismatches never touch the key
+// values. The rows with the same key are chained in the order they were
+// built, so the join results come out in the same order as before.
+//
+// The partitions are independent, they could be built and probed in
+// parallel.
+class JoinHashTable final {
+ public:
+  static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+  explicit JoinHashTable(JoinKeys keys);
+
+  size_t numPartitions() const { return partBegins_.size() - 1; }
+
+  size_t partitionOf(size_t hash) const {
+    return bits_ == 0 ? 0 : hash >> (sizeof(size_t) * 8 - bits_);
+  }
+
+  // Build the table of a partition
+  void buildPartition(size_t part);
+
+  // Radix partition the positions of the probe keys the same way as the
+  // build keys
+  std::vector<std::vector<uint32_t>> partition(const JoinKeys& probe) const;
+
+  // Find the first matched entry of the probe keys at `positions' of the
+  // partition, and store it to `(*heads)[position]'
+  void probePartition(const JoinKeys& probe,
+                      size_t part,
+                      const std::vector<uint32_t>& positions,
+                      std::vector<uint32_t>* heads) const;
+
+  // Return the first entry whose key equals to `key', kNone if none
+  uint32_t find(size_t hash, const Value* key) const;
+
+  // The next entry with the same key, kNone at the end
+  uint32_t next(uint32_t entry) const { return next_[entry]; }
+
+  const Row* row(uint32_t entry) const { return keys_.rows[order_[entry]]; }
+
+  size_t size() const { return order_.size(); }
+
+ private:
+  // About the number of entries which fit in L2 with their slots and hashes
+  static constexpr size_t kRowsPerPartition = 1UL << 14;
+  static constexpr size_t kMaxPartitionBits = 10;
+
+  JoinKeys keys_;
+  size_t bits_{0};
+  // Entries are the build rows ordered by partition, the entry i is the
+  // keys_ at order_[i]. The entries of partition p are in
+  // [partBegins_[p], partBegins_[p + 1])
+  std::vector<uint32_t> order_;
+  std::vector<size_t> partBegins_;
+  // The key hashes of the entries
+  std::vector<size_t> hashes_;
+  // The chain of the entries with the same key
+  std::vector<uint32_t> next_;
+  std::vector<uint32_t> last_;
+  // The open addressing slots of each partition, which hold the first
+  // entries of the keys, or kNone if empty
+  std::vector<std::vector<uint32_t>> slots_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_CONTEXT_JOINHASHTABLE_H_
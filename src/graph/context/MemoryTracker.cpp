@@ -0,0 +1,231 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/context/MemoryTracker.h"
+
+#include <algorithm>
+
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Edge.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Map.h"
+#include "common/datatypes/Path.h"
+#include "common/datatypes/Set.h"
+#include "common/datatypes/Vertex.h"
+#include "graph/service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+constexpr size_t kMaxSamples = 64;
+// About the overhead of a node of the hash containers
+constexpr int64_t kHashNodeBytes = 2 * sizeof(void*);
+
+// Estimate the items by at most kMaxSamples of them evenly spaced
+template <typename T, typename F>
+int64_t estimateSampled(const std::vector<T>& items, F&& estimateItem) {
+  auto n = items.size();
+  if (n == 0) {
+    return 0;
+  }
+  auto stride = std::max<size_t>(1, n / kMaxSamples);
+  int64_t bytes = 0;
+  size_t sampled = 0;
+  for (size_t i = 0; i < n; i += stride, ++sampled) {
+    bytes += estimateItem(items[i]);
+  }
+  return bytes * static_cast<int64_t>(n) / static_cast<int64_t>(sampled);
+}
+
+int64_t estimateProps(const std::unordered_map<std::string, Value>& props) {
+  int64_t bytes = 0;
+  for (auto& kv : props) {
+    bytes += kHashNodeBytes + sizeof(std::string) + kv.first.size() +
+             MemoryTracker::estimate(kv.second);
+  }
+  return bytes;
+}
+
+int64_t estimateVertex(const Vertex& vertex) {
+  int64_t bytes = sizeof(Vertex) + MemoryTracker::estimate(vertex.vid);
+  for (auto& tag : vertex.tags) {
+    bytes += sizeof(Tag) + tag.name.size() + estimateProps(tag.props);
+  }
+  return bytes;
+}
+
+}  // namespace
+
+// static
+std::shared_ptr<MemoryTracker> MemoryTracker::create(std::string name,
+                                                     int64_t limit,
+                                                     std::shared_ptr<MemoryTracker> parent) {
+  std::shared_ptr<MemoryTracker> tracker(
+      new MemoryTracker(std::move(name), limit, std::move(parent)));
+  auto& p = tracker->parent_;
+  if (p != nullptr) {
+    std::lock_guard<std::mutex> guard(p->lock_);
+    auto& children = p->children_;
+    children.erase(std::remove_if(children.begin(),
+                                  children.end(),
+                                  [](const auto& child) { return child.expired(); }),
+                   children.end());
+    children.emplace_back(tracker);
+  }
+  return tracker;
+}
+
+// static
+const std::shared_ptr<MemoryTracker>& MemoryTracker::process() {
+  static const auto tracker =
+      create("process", FLAGS_max_process_query_memory_mb * 1024 * 1024, nullptr);
+  return tracker;
+}
+
+// static
+int64_t MemoryTracker::estimate(const Value& value) {
+  int64_t bytes = sizeof(Value);
+  switch (value.type()) {
+    case Value::Type::STRING:
+      bytes += value.getStr().size();
+      break;
+    case Value::Type::LIST:
+      bytes += sizeof(List) + estimateSampled(value.getList().values, estimate);
+      break;
+    case Value::Type::SET:
+      for (auto& v : value.getSet().values) {
+        bytes += kHashNodeBytes + estimate(v);
+      }
+      bytes += sizeof(Set);
+      break;
+    case Value::Type::MAP:
+      bytes += sizeof(Map) + estimateProps(value.getMap().kvs);
+      break;
+    case Value::Type::VERTEX:
+      bytes += estimateVertex(value.getVertex());
+      break;
+    case Value::Type::EDGE: {
+      auto& edge = value.getEdge();
+      bytes += sizeof(Edge) + estimate(edge.src) + estimate(edge.dst) + edge.name.size() +
+               estimateProps(edge.props);
+      break;
+    }
+    case Value::Type::PATH: {
+      auto& path = value.getPath();
+      bytes += sizeof(Path) + estimateVertex(path.src);
+      for (auto& step : path.steps) {
+        bytes += sizeof(Step) + estimateVertex(step.dst) + step.name.size() +
+                 estimateProps(step.props);
+      }
+      break;
+    }
+    case Value::Type::DATASET: {
+      auto& ds = value.getDataSet();
+      bytes += sizeof(DataSet);
+      for (auto& col : ds.colNames) {
+        bytes += sizeof(std::string) + col.size();
+      }
+      bytes += estimateSampled(ds.rows, [](const Row& row) {
+        int64_t rowBytes = sizeof(Row);
+        for (auto& v : row.values) {
+          rowBytes += estimate(v);
+        }
+        return rowBytes;
+      });
+      break;
+    }
+    default:
+      break;
+  }
+  return bytes;
+}
+
+Status MemoryTracker::consume(int64_t bytes) {
+  for (auto* tracker = this; tracker != nullptr; tracker = tracker->parent_.get()) {
+    auto used = tracker->used_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (tracker->limit_ > 0 && used > tracker->limit_ && bytes > 0) {
+      if (tracker->parent_ == nullptr && FLAGS_kill_biggest_query_on_memory_limit) {
+        auto biggest = tracker->biggestKillable(this);
+        if (biggest != nullptr && biggest->used() > this->used() && biggest->kill()) {
+          // Go on since the memory of the killed query is going to be freed
+          continue;
+        }
+      }
+      for (auto* t = this; t != tracker->parent_.get(); t = t->parent_.get()) {
+        t->used_.fetch_sub(bytes, std::memory_order_relaxed);
+      }
+      return Status::Error("Memory limit of %s exceeded, %ld bytes used, the limit is %ld bytes",
+                           tracker->name_.c_str(),
+                           used,
+                           tracker->limit_);
+    }
+    auto peak = tracker->peak_.load(std::memory_order_relaxed);
+    while (used > peak && !tracker->peak_.compare_exchange_weak(peak, used)) {
+    }
+  }
+  return Status::OK();
+}
+
+void MemoryTracker::release(int64_t bytes) {
+  for (auto* tracker = this; tracker != nullptr; tracker = tracker->parent_.get()) {
+    tracker->used_.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+}
+
+void MemoryTracker::setKiller(std::function<void()> killer) {
+  std::lock_guard<std::mutex> guard(lock_);
+  killer_ = std::move(killer);
+}
+
+std::shared_ptr<MemoryTracker> MemoryTracker::biggestKillable(const MemoryTracker* except) {
+  std::shared_ptr<MemoryTracker> biggest;
+  std::vector<std::shared_ptr<MemoryTracker>> children;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (killer_ && this != except) {
+      biggest = shared_from_this();
+    }
+    for (auto& child : children_) {
+      auto c = child.lock();
+      if (c != nullptr) {
+        children.emplace_back(std::move(c));
+      }
+    }
+  }
+  for (auto& child : children) {
+    auto candidate = child->biggestKillable(except);
+    if (candidate != nullptr && (biggest == nullptr || candidate->used() > biggest->used())) {
+      biggest = std::move(candidate);
+    }
+  }
+  return biggest;
+}
+
+bool MemoryTracker::kill() {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (!killer_) {
+    return false;
+  }
+  LOG(WARNING) << "Kill " << name_ << " which takes " << used() << " bytes of memory";
+  killer_();
+  killer_ = nullptr;
+  return true;
+}
+
+Status MemoryReservation::resize(int64_t bytes) {
+  auto delta = bytes - bytes_;
+  if (delta > 0) {
+    NG_RETURN_IF_ERROR(tracker_->consume(delta));
+  } else {
+    tracker_->release(-delta);
+  }
+  bytes_ = bytes;
+  return Status::OK();
+}
+
+}  // namespace graph
+}  // namespace nebula
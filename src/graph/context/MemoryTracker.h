@@ -0,0 +1,103 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_CONTEXT_MEMORYTRACKER_H_
+#define GRAPH_CONTEXT_MEMORYTRACKER_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "common/base/Status.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// Count the memory taken by the results of the executors.
+//
+// The trackers make up a tree: the process, the sessions and the queries.
+// The bytes charged on a tracker are charged on all its ancestors too, and
+// the charge fails if it exceeds the limit of any of them. When the limit
+// of the process is hit, the biggest query could be killed instead, see
+// --kill_biggest_query_on_memory_limit.
+class MemoryTracker final : public std::enable_shared_from_this<MemoryTracker> {
+ public:
+  // `limit' in bytes, 0 for unlimited
+  static std::shared_ptr<MemoryTracker> create(std::string name,
+                                               int64_t limit,
+                                               std::shared_ptr<MemoryTracker> parent);
+
+  // The root tracker, limited by --max_process_query_memory_mb
+  static const std::shared_ptr<MemoryTracker>& process();
+
+  // Estimate the memory taken by the value. The rows of a big DataSet are
+  // sampled, so it's cheap enough to be called on every result.
+  static int64_t estimate(const Value& value);
+
+  const std::string& name() const { return name_; }
+
+  int64_t used() const { return used_.load(std::memory_order_relaxed); }
+
+  int64_t peak() const { return peak_.load(std::memory_order_relaxed); }
+
+  int64_t limit() const { return limit_; }
+
+  // Charge `bytes', nothing is charged if it fails
+  Status consume(int64_t bytes);
+
+  void release(int64_t bytes);
+
+  // Set the function to kill the owner of this tracker, nullptr to unset it.
+  // It's never called after unset.
+  void setKiller(std::function<void()> killer);
+
+ private:
+  MemoryTracker(std::string name, int64_t limit, std::shared_ptr<MemoryTracker> parent)
+      : name_(std::move(name)), limit_(limit), parent_(std::move(parent)) {}
+
+  // The killable descendant (or this) which takes the most memory, other
+  // than `except'
+  std::shared_ptr<MemoryTracker> biggestKillable(const MemoryTracker* except);
+
+  // Call the killer, return false if it's unset
+  bool kill();
+
+  const std::string name_;
+  const int64_t limit_;
+  const std::shared_ptr<MemoryTracker> parent_;
+  std::atomic<int64_t> used_{0};
+  std::atomic<int64_t> peak_{0};
+
+  // Guard the children and the killer
+  std::mutex lock_;
+  std::vector<std::weak_ptr<MemoryTracker>> children_;
+  std::function<void()> killer_;
+};
+
+// The bytes charged on a tracker for the value of a result, which are
+// released on destruction. It's shared by the results holding the same value.
+class MemoryReservation final {
+ public:
+  explicit MemoryReservation(std::shared_ptr<MemoryTracker> tracker)
+      : tracker_(std::move(tracker)) {}
+
+  ~MemoryReservation() { tracker_->release(bytes_); }
+
+  int64_t bytes() const { return bytes_; }
+
+  // Charge or release the difference to `bytes'
+  Status resize(int64_t bytes);
+
+ private:
+  std::shared_ptr<MemoryTracker> tracker_;
+  int64_t bytes_{0};
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_CONTEXT_MEMORYTRACKER_H_
@@ -5,6 +5,8 @@
 
 #include "graph/context/QueryContext.h"
 
+#include "graph/service/GraphFlags.h"
+
 namespace nebula {
 namespace graph {
 
@@ -25,13 +27,56 @@ QueryContext::QueryContext(RequestContextPtr rctx,
 
 QueryContext::QueryContext() { init(); }
 
+QueryContext::~QueryContext() {
+  // The tracker might outlive this context, and it's going to be killed only
+  // if the killer is still set
+  memoryTracker_->setKiller(nullptr);
+}
+
 void QueryContext::init() {
   objPool_ = std::make_unique<ObjectPool>();
+  executorPool_ = std::make_unique<ObjectPool>();
   ep_ = std::make_unique<ExecutionPlan>();
   ectx_ = std::make_unique<ExecutionContext>();
   idGen_ = std::make_unique<IdGenerator>(0);
   symTable_ = std::make_unique<SymbolTable>(objPool_.get());
   vctx_ = std::make_unique<ValidateContext>(std::make_unique<AnonVarGenerator>(symTable_.get()));
+  freeJobs_ = FLAGS_max_job_size;
+  sortMemoryBudget_ = FLAGS_sort_memory_budget_mb * 1024 * 1024;
+  initMemoryTracker();
+}
+
+void QueryContext::initMemoryTracker() {
+  auto* session = rctx_ == nullptr ? nullptr : rctx_->session();
+  memoryTracker_ = MemoryTracker::create(
+      folly::stringPrintf("query %ld", ep_->id()),
+      FLAGS_max_query_memory_mb * 1024 * 1024,
+      session == nullptr ? MemoryTracker::process() : session->memoryTracker());
+  memoryTracker_->setKiller([this]() { markKilled(); });
+}
+
+void QueryContext::reset(RequestContextPtr rctx, std::unique_ptr<ExecutionContext> ectx) {
+  // The executors refer to the execution context
+  executorPool_->clear();
+  objPool_->truncate(planObjects_);
+  ectx_ = std::move(ectx);
+  rctx_ = std::move(rctx);
+  memoryTracker_->setKiller(nullptr);
+  initMemoryTracker();
+  killed_ = false;
+  freeJobs_ = FLAGS_max_job_size;
+  sortMemoryBudget_ = FLAGS_sort_memory_budget_mb * 1024 * 1024;
+}
+
+size_t QueryContext::acquireJobs(size_t num) {
+  auto free = freeJobs_.load();
+  while (free > 0) {
+    auto granted = std::min(free, static_cast<int64_t>(num));
+    if (freeJobs_.compare_exchange_weak(free, free - granted)) {
+      return granted;
+    }
+  }
+  return 0;
 }
 
 }  // namespace graph
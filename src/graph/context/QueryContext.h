@@ -15,6 +15,7 @@
 #include "common/meta/IndexManager.h"
 #include "common/meta/SchemaManager.h"
 #include "graph/context/ExecutionContext.h"
+#include "graph/context/MemoryTracker.h"
 #include "graph/context/Symbols.h"
 #include "graph/context/ValidateContext.h"
 #include "graph/service/RequestContext.h"
@@ -49,10 +50,20 @@ class QueryContext {
                meta::MetaClient* metaClient,
                CharsetInfo* charsetInfo);
 
-  virtual ~QueryContext() = default;
+  virtual ~QueryContext();
 
   void setRCtx(RequestContextPtr rctx) { rctx_ = std::move(rctx); }
 
+  // Reuse the context with its plan for another run of the same query, starting
+  // with the values in `ectx'. The executors, the objects they added into the
+  // object pool since pinPlan() and the results of the last run are released.
+  void reset(RequestContextPtr rctx, std::unique_ptr<ExecutionContext> ectx);
+
+  // Mark the objects in the object pool so far as the plan, which are kept by
+  // reset(). The ones added later are made by the executors for a single run,
+  // e.g. the expressions cloned for each job.
+  void pinPlan() { planObjects_ = objPool_->size(); }
+
   void setSchemaManager(meta::SchemaManager* sm) { sm_ = sm; }
 
   void setIndexManager(meta::IndexManager* im) { im_ = im; }
@@ -83,6 +94,9 @@ class QueryContext {
 
   ObjectPool* objPool() const { return objPool_.get(); }
 
+  // The pool of the executors, which are created for each run of the plan
+  ObjectPool* executorPool() const { return executorPool_.get(); }
+
   int64_t genId() const { return idGen_->id(); }
 
   SymbolTable* symTable() const { return symTable_.get(); }
@@ -96,10 +110,32 @@ class QueryContext {
 
   bool isKilled() const { return killed_.load(); }
 
+  // Take at most `num' slots from the job budget of this query, return the
+  // number of slots granted which could be 0 if the budget is used up.
+  // The budget is initialized by --max_job_size.
+  size_t acquireJobs(size_t num);
+
+  void releaseJobs(size_t num) { freeJobs_.fetch_add(num); }
+
+  // Track the memory taken by the results of this query, limited by
+  // --max_query_memory_mb
+  const std::shared_ptr<MemoryTracker>& memoryTracker() const { return memoryTracker_; }
+
+  // The max bytes of the rows a Sort of this query sorts in memory, 0 for
+  // unlimited. It's initialized by --sort_memory_budget_mb.
+  int64_t sortMemoryBudget() const { return sortMemoryBudget_; }
+
+  void setSortMemoryBudget(int64_t bytes) { sortMemoryBudget_ = bytes; }
+
  private:
   void init();
 
+  void initMemoryTracker();
+
   RequestContextPtr rctx_;
+  // Declared before the execution context, since its results release the
+  // memory on it
+  std::shared_ptr<MemoryTracker> memoryTracker_;
   std::unique_ptr<ValidateContext> vctx_;
   std::unique_ptr<ExecutionContext> ectx_;
   std::unique_ptr<ExecutionPlan> ep_;
@@ -112,10 +148,16 @@ class QueryContext {
   // The Object Pool holds all internal generated objects.
   // e.g. expressions, plan nodes, executors
   std::unique_ptr<ObjectPool> objPool_;
+  std::unique_ptr<ObjectPool> executorPool_;
+  // The number of objects in the object pool making up the plan
+  size_t planObjects_{0};
   std::unique_ptr<IdGenerator> idGen_;
   std::unique_ptr<SymbolTable> symTable_;
 
   std::atomic<bool> killed_{false};
+  // The number of jobs which could still be started concurrently
+  std::atomic<int64_t> freeJobs_{0};
+  int64_t sortMemoryBudget_{0};
 };
 
 }  // namespace graph
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "graph/context/Iterator.h"
+#include "graph/context/MemoryTracker.h"
 
 namespace nebula {
 namespace graph {
@@ -66,6 +67,7 @@ class Result final {
         msg = c.msg;
         value = c.value;
         iter = c.iter->copy();
+        memory = c.memory;
       }
       return *this;
     }
@@ -75,6 +77,7 @@ class Result final {
     std::string msg;
     std::shared_ptr<Value> value;
     std::unique_ptr<Iterator> iter;
+    std::shared_ptr<MemoryReservation> memory;
   };
 
   explicit Result(Core&& core) : core_(std::move(core)) {}
@@ -0,0 +1,165 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include "common/base/ObjectPool.h"
+#include "common/expression/ArithmeticExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "common/expression/UnaryExpression.h"
+#include "graph/context/BatchEvaluator.h"
+
+namespace nebula {
+namespace graph {
+
+class BatchEvaluatorTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    DataSet ds({"int", "float", "str", "bool", "mixed"});
+    for (auto i = 0; i < 100; ++i) {
+      Row row;
+      row.values.emplace_back(i % 7 == 0 ? Value::kNullValue : Value(i));
+      row.values.emplace_back(i * 0.5);
+      row.values.emplace_back(folly::to<std::string>(i % 10));
+      row.values.emplace_back(i % 3 == 0 ? Value::kNullValue : Value(i % 2 == 0));
+      if (i % 5 == 0) {
+        row.values.emplace_back(Value());
+      } else if (i % 5 == 1) {
+        row.values.emplace_back(std::numeric_limits<int64_t>::max() - 1);
+      } else {
+        row.values.emplace_back(i);
+      }
+      ds.rows.emplace_back(std::move(row));
+    }
+    iter_ = std::make_unique<SequentialIter>(std::make_shared<Value>(std::move(ds)));
+  }
+
+ protected:
+  Expression* input(const std::string& col) { return InputPropertyExpression::make(&pool_, col); }
+
+  Expression* constant(Value val) { return ConstantExpression::make(&pool_, std::move(val)); }
+
+  // The batch results should be the same as evaluating row by row
+  void check(Expression* expr, size_t begin = 0, size_t end = 100) {
+    QueryExpressionContext ctx;
+    BatchEvaluator evaluator(&ctx, iter_.get(), begin, end);
+    auto sel = evaluator.selectAll();
+    // Select every other row
+    std::vector<size_t> half;
+    for (size_t i = 0; i < sel.size(); i += 2) {
+      half.emplace_back(sel[i]);
+    }
+    for (auto* s : {&sel, &half}) {
+      auto col = evaluator.eval(expr, *s);
+      ASSERT_EQ(col.size(), s->size());
+      for (size_t i = 0; i < s->size(); ++i) {
+        iter_->reset((*s)[i]);
+        auto expected = expr->eval(ctx(iter_.get()));
+        auto result = col.value(i);
+        EXPECT_EQ(expected.type(), result.type()) << expr->toString() << " at " << (*s)[i];
+        if (expected.isNull() && result.isNull()) {
+          EXPECT_EQ(expected.getNull(), result.getNull()) << expr->toString();
+        } else {
+          EXPECT_EQ(expected, result) << expr->toString() << " at " << (*s)[i];
+        }
+      }
+    }
+  }
+
+  ObjectPool pool_;
+  std::unique_ptr<SequentialIter> iter_;
+};
+
+TEST_F(BatchEvaluatorTest, Relational) {
+  std::vector<std::string> cols = {"int", "float", "str", "bool", "mixed"};
+  for (auto& l : cols) {
+    for (auto& r : cols) {
+      check(RelationalExpression::makeEQ(&pool_, input(l), input(r)));
+      check(RelationalExpression::makeNE(&pool_, input(l), input(r)));
+      check(RelationalExpression::makeLT(&pool_, input(l), input(r)));
+      check(RelationalExpression::makeLE(&pool_, input(l), input(r)));
+      check(RelationalExpression::makeGT(&pool_, input(l), input(r)));
+      check(RelationalExpression::makeGE(&pool_, input(l), input(r)));
+    }
+  }
+  check(RelationalExpression::makeGT(&pool_, input("int"), constant(50)));
+  check(RelationalExpression::makeLE(&pool_, input("float"), constant(20)));
+  check(RelationalExpression::makeEQ(&pool_, input("str"), constant("3")));
+  check(RelationalExpression::makeEQ(&pool_, input("str"), constant(Value::kNullValue)));
+  check(RelationalExpression::makeIn(
+      &pool_, input("int"), constant(List(std::vector<Value>{1, 2, 3}))));
+}
+
+TEST_F(BatchEvaluatorTest, Logical) {
+  auto* gt = RelationalExpression::makeGT(&pool_, input("int"), constant(20));
+  auto* eq = RelationalExpression::makeEQ(&pool_, input("str"), constant("1"));
+  check(LogicalExpression::makeAnd(&pool_, gt, input("bool")));
+  check(LogicalExpression::makeAnd(&pool_, input("bool"), gt));
+  check(LogicalExpression::makeOr(&pool_, input("bool"), eq));
+  check(LogicalExpression::makeXor(&pool_, input("bool"), eq));
+  check(UnaryExpression::makeNot(&pool_, input("bool")));
+  // Not a bool
+  check(LogicalExpression::makeAnd(&pool_, input("bool"), input("int")));
+  check(LogicalExpression::makeOr(&pool_, input("bool"), input("mixed")));
+  check(UnaryExpression::makeNot(&pool_, input("str")));
+  auto* and3 = LogicalExpression::makeAnd(&pool_, gt, eq);
+  and3->addOperand(input("bool"));
+  check(and3);
+}
+
+TEST_F(BatchEvaluatorTest, Arithmetic) {
+  std::vector<std::string> cols = {"int", "float", "str", "mixed"};
+  for (auto& l : cols) {
+    for (auto& r : cols) {
+      check(ArithmeticExpression::makeAdd(&pool_, input(l), input(r)));
+      check(ArithmeticExpression::makeMinus(&pool_, input(l), input(r)));
+      check(ArithmeticExpression::makeMultiply(&pool_, input(l), input(r)));
+      check(ArithmeticExpression::makeDivision(&pool_, input(l), input(r)));
+      check(ArithmeticExpression::makeMod(&pool_, input(l), input(r)));
+    }
+  }
+  // Overflow
+  check(ArithmeticExpression::makeAdd(&pool_, input("mixed"), constant(10)));
+  check(ArithmeticExpression::makeMultiply(&pool_, input("int"), constant(0.5)));
+}
+
+TEST_F(BatchEvaluatorTest, FunctionCall) {
+  auto* args = ArgumentList::make(&pool_);
+  args->addArgument(ArithmeticExpression::makeMinus(&pool_, constant(50), input("int")));
+  check(FunctionCallExpression::make(&pool_, "abs", args));
+  auto* strArgs = ArgumentList::make(&pool_);
+  strArgs->addArgument(input("str"));
+  check(FunctionCallExpression::make(&pool_, "toInteger", strArgs));
+}
+
+TEST_F(BatchEvaluatorTest, Filter) {
+  QueryExpressionContext ctx;
+  auto* cond = LogicalExpression::makeAnd(
+      &pool_, RelationalExpression::makeGT(&pool_, input("int"), constant(20)), input("bool"));
+  BatchEvaluator evaluator(&ctx, iter_.get(), 10, 60);
+  auto selected = evaluator.filter(cond, evaluator.selectAll());
+  ASSERT_TRUE(selected.ok());
+  std::vector<size_t> expected;
+  for (size_t i = 10; i < 60; ++i) {
+    iter_->reset(i);
+    auto val = cond->eval(ctx(iter_.get()));
+    if (val.isBool() && val.getBool()) {
+      expected.emplace_back(i);
+    }
+  }
+  EXPECT_EQ(expected, selected.value());
+
+  auto wrong = evaluator.filter(input("int"), evaluator.selectAll());
+  EXPECT_FALSE(wrong.ok());
+}
+
+}  // namespace graph
+}  // namespace nebula
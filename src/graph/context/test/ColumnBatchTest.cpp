@@ -0,0 +1,109 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "graph/context/ColumnBatch.h"
+#include "graph/context/Iterator.h"
+
+namespace nebula {
+namespace graph {
+
+TEST(ColumnBatchTest, TypedColumn) {
+  Column col;
+  EXPECT_EQ(col.kind(), Column::Kind::kUnknown);
+  col.append(Value::kNullValue);
+  EXPECT_EQ(col.kind(), Column::Kind::kUnknown);
+  col.append(Value(3));
+  col.append(Value(1));
+  col.append(Value::kNullValue);
+  EXPECT_EQ(col.kind(), Column::Kind::kInt);
+  EXPECT_EQ(col.size(), 4);
+  EXPECT_TRUE(col.isNull(0));
+  EXPECT_EQ(col.getInt(1), 3);
+  EXPECT_EQ(col.getInt(2), 1);
+  EXPECT_TRUE(col.isNull(3));
+  EXPECT_EQ(col.value(0), Value::kNullValue);
+  EXPECT_EQ(col.value(1), Value(3));
+
+  // Null is the biggest
+  EXPECT_EQ(col.compare(1, 2), 1);
+  EXPECT_EQ(col.compare(2, 1), -1);
+  EXPECT_EQ(col.compare(0, 1), 1);
+  EXPECT_EQ(col.compare(0, 3), 0);
+
+  auto gathered = col.gather({2, 1});
+  EXPECT_EQ(gathered.kind(), Column::Kind::kInt);
+  EXPECT_EQ(gathered.size(), 2);
+  EXPECT_EQ(gathered.getInt(0), 1);
+  EXPECT_EQ(gathered.getInt(1), 3);
+
+  Column strCol;
+  strCol.append(Value("b"));
+  strCol.append(Value("a"));
+  EXPECT_EQ(strCol.kind(), Column::Kind::kString);
+  EXPECT_EQ(strCol.getStr(0), "b");
+  EXPECT_EQ(strCol.compare(0, 1), 1);
+}
+
+TEST(ColumnBatchTest, BoxedColumn) {
+  Column col;
+  col.append(Value(1));
+  col.append(Value("a"));
+  col.append(Value::kNullBadType);
+  col.append(Value());
+  EXPECT_EQ(col.kind(), Column::Kind::kValue);
+  EXPECT_EQ(col.size(), 4);
+  EXPECT_EQ(col.value(0), Value(1));
+  EXPECT_EQ(col.value(1), Value("a"));
+  EXPECT_EQ(col.value(2), Value::kNullBadType);
+  EXPECT_TRUE(col.value(3).empty());
+
+  Column floatCol;
+  floatCol.append(Value(1.0));
+  floatCol.append(Value(NullType::NaN));
+  EXPECT_EQ(floatCol.kind(), Column::Kind::kValue);
+  EXPECT_EQ(floatCol.value(0), Value(1.0));
+  EXPECT_EQ(floatCol.value(1), Value(NullType::NaN));
+}
+
+TEST(ColumnBatchTest, DataSet) {
+  DataSet ds({"int", "str", "mixed"});
+  for (auto i = 0; i < 10; ++i) {
+    Row row;
+    row.values.emplace_back(i);
+    row.values.emplace_back(folly::to<std::string>(i));
+    if (i % 2 == 0) {
+      row.values.emplace_back(i);
+    } else {
+      row.values.emplace_back(List({i}));
+    }
+    ds.rows.emplace_back(std::move(row));
+  }
+
+  auto batch = ColumnBatch::fromDataSet(ds);
+  EXPECT_EQ(batch.numRows(), 10);
+  EXPECT_EQ(batch.numColumns(), 3);
+  EXPECT_EQ(batch.column(0).kind(), Column::Kind::kInt);
+  EXPECT_EQ(batch.column(1).kind(), Column::Kind::kString);
+  EXPECT_EQ(batch.column(2).kind(), Column::Kind::kValue);
+  EXPECT_EQ(batch.toDataSet(), ds);
+
+  auto selected = batch.gather({9, 0});
+  EXPECT_EQ(selected.numRows(), 2);
+  EXPECT_EQ(selected.column(0).getInt(0), 9);
+  EXPECT_EQ(selected.column(1).getStr(1), "0");
+  EXPECT_EQ(std::move(batch).moveToDataSet(), ds);
+
+  auto val = std::make_shared<Value>(ds);
+  SequentialIter iter(val);
+  auto strs = iter.toColumnBatch({1});
+  EXPECT_EQ(strs.colNames(), std::vector<std::string>({"str"}));
+  EXPECT_EQ(strs.numRows(), 10);
+  EXPECT_EQ(strs.column(0).getStr(3), "3");
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -59,5 +59,27 @@ TEST(ExecutionContextTest, TestResult) {
   EXPECT_TRUE(result.valuePtr()->isDataSet());
 }
 
+TEST(ExecutionContextTest, Clone) {
+  DataSet ds({"id"});
+  ds.emplace_back(Row({1}));
+  ds.emplace_back(Row({2}));
+  ExecutionContext ctx;
+  ctx.setResult("ds", ResultBuilder().value(Value(std::move(ds))).build());
+  ctx.setValue("v", 1);
+  ctx.setValue("v", 2);
+
+  auto cloned = ctx.clone();
+  ASSERT_EQ(2, cloned->numVersions("v"));
+  EXPECT_EQ(Value(2), cloned->getValue("v"));
+  auto& result = cloned->getResult("ds");
+  EXPECT_EQ(Iterator::Kind::kSequential, result.iter()->kind());
+
+  // Erasing the rows of the original one doesn't change the cloned one
+  auto iter = ctx.getResult("ds").iter();
+  iter->erase();
+  EXPECT_EQ(1, ctx.getResult("ds").value().getDataSet().size());
+  EXPECT_EQ(2, result.value().getDataSet().size());
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -0,0 +1,108 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "graph/context/JoinHashTable.h"
+
+namespace nebula {
+namespace graph {
+
+std::vector<Row> makeRows(size_t num, size_t distinct, bool strKey) {
+  std::vector<Row> rows;
+  rows.reserve(num);
+  for (size_t i = 0; i < num; ++i) {
+    Row row;
+    auto key = (i * 7919) % distinct;
+    if (strKey) {
+      row.values.emplace_back(folly::to<std::string>("vertex_", key));
+    } else {
+      row.values.emplace_back(static_cast<int64_t>(key));
+    }
+    row.values.emplace_back(static_cast<int64_t>(i));
+    rows.emplace_back(std::move(row));
+  }
+  return rows;
+}
+
+// The hash join by std::unordered_map, which is what the join executors did
+size_t unorderedMapJoin(const std::vector<Row>& build, const std::vector<Row>& probe) {
+  std::unordered_map<Value, std::vector<const Row*>> hashTable;
+  hashTable.reserve(build.size());
+  for (auto& row : build) {
+    hashTable[row.values[0]].emplace_back(&row);
+  }
+  size_t matched = 0;
+  for (auto& row : probe) {
+    auto found = hashTable.find(row.values[0]);
+    if (found != hashTable.end()) {
+      matched += found->second.size();
+    }
+  }
+  return matched;
+}
+
+size_t joinHashTableJoin(const std::vector<Row>& build, const std::vector<Row>& probe) {
+  JoinKeys buildKeys(1);
+  buildKeys.reserve(build.size());
+  for (auto& row : build) {
+    buildKeys.values.emplace_back(row.values[0]);
+    buildKeys.append(&row);
+  }
+  JoinKeys probeKeys(1);
+  probeKeys.reserve(probe.size());
+  for (auto& row : probe) {
+    probeKeys.values.emplace_back(row.values[0]);
+    probeKeys.append(&row);
+  }
+  JoinHashTable table(std::move(buildKeys));
+  for (size_t part = 0; part < table.numPartitions(); ++part) {
+    table.buildPartition(part);
+  }
+  std::vector<uint32_t> heads(probeKeys.size(), JoinHashTable::kNone);
+  auto parts = table.partition(probeKeys);
+  for (size_t part = 0; part < parts.size(); ++part) {
+    table.probePartition(probeKeys, part, parts[part], &heads);
+  }
+  size_t matched = 0;
+  for (auto head : heads) {
+    for (auto entry = head; entry != JoinHashTable::kNone; entry = table.next(entry)) {
+      ++matched;
+    }
+  }
+  return matched;
+}
+
+void runJoin(bool useTable, size_t iters, size_t num, bool strKey) {
+  std::vector<Row> build, probe;
+  BENCHMARK_SUSPEND {
+    build = makeRows(num, num / 2, strKey);
+    probe = makeRows(num * 2, num, strKey);
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto matched = useTable ? joinHashTableJoin(build, probe) : unorderedMapJoin(build, probe);
+    folly::doNotOptimizeAway(matched);
+  }
+}
+
+BENCHMARK(UnorderedMapIntKey_100K, iters) { runJoin(false, iters, 100000, false); }
+BENCHMARK_RELATIVE(JoinHashTableIntKey_100K, iters) { runJoin(true, iters, 100000, false); }
+BENCHMARK(UnorderedMapStrKey_100K, iters) { runJoin(false, iters, 100000, true); }
+BENCHMARK_RELATIVE(JoinHashTableStrKey_100K, iters) { runJoin(true, iters, 100000, true); }
+BENCHMARK_DRAW_LINE();
+BENCHMARK(UnorderedMapIntKey_1M, iters) { runJoin(false, iters, 1000000, false); }
+BENCHMARK_RELATIVE(JoinHashTableIntKey_1M, iters) { runJoin(true, iters, 1000000, false); }
+BENCHMARK(UnorderedMapStrKey_1M, iters) { runJoin(false, iters, 1000000, true); }
+BENCHMARK_RELATIVE(JoinHashTableStrKey_1M, iters) { runJoin(true, iters, 1000000, true); }
+
+}  // namespace graph
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "graph/context/JoinHashTable.h"
+
+namespace nebula {
+namespace graph {
+
+// Join the keys of `probe' with `build' by the table, return the matched row
+// pairs in the order of probe rows
+static std::vector<std::pair<const Row*, const Row*>> join(const JoinKeys& build,
+                                                           const JoinKeys& probe) {
+  JoinHashTable table(build);
+  for (size_t part = 0; part < table.numPartitions(); ++part) {
+    table.buildPartition(part);
+  }
+  std::vector<uint32_t> heads(probe.size(), JoinHashTable::kNone);
+  auto parts = table.partition(probe);
+  EXPECT_EQ(parts.size(), table.numPartitions());
+  for (size_t part = 0; part < parts.size(); ++part) {
+    table.probePartition(probe, part, parts[part], &heads);
+  }
+  std::vector<std::pair<const Row*, const Row*>> result;
+  for (size_t i = 0; i < probe.size(); ++i) {
+    for (auto entry = heads[i]; entry != JoinHashTable::kNone; entry = table.next(entry)) {
+      result.emplace_back(probe.rows[i], table.row(entry));
+    }
+  }
+  return result;
+}
+
+// The same join by std::unordered_map
+static std::vector<std::pair<const Row*, const Row*>> expectedJoin(const std::vector<Row>& build,
+                                                                   const std::vector<Row>& probe) {
+  std::unordered_map<List, std::vector<const Row*>> hashTable;
+  for (auto& row : build) {
+    hashTable[List(row.values)].emplace_back(&row);
+  }
+  std::vector<std::pair<const Row*, const Row*>> result;
+  for (auto& row : probe) {
+    auto found = hashTable.find(List(row.values));
+    if (found == hashTable.end()) {
+      continue;
+    }
+    for (auto* buildRow : found->second) {
+      result.emplace_back(&row, buildRow);
+    }
+  }
+  return result;
+}
+
+static JoinKeys makeKeys(const std::vector<Row>& rows, size_t width) {
+  JoinKeys keys(width);
+  keys.reserve(rows.size());
+  for (auto& row : rows) {
+    keys.values.insert(keys.values.end(), row.values.begin(), row.values.end());
+    keys.append(&row);
+  }
+  return keys;
+}
+
+TEST(JoinHashTableTest, SingleKey) {
+  std::vector<Row> build;
+  for (auto i = 0; i < 100; ++i) {
+    build.emplace_back(Row({i % 30 == 0 ? Value::kNullValue : Value(i % 40)}));
+  }
+  std::vector<Row> probe;
+  for (auto i = 0; i < 100; ++i) {
+    probe.emplace_back(Row({i % 7 == 0 ? Value(folly::to<std::string>(i)) : Value(i % 50)}));
+  }
+  auto result = join(makeKeys(build, 1), makeKeys(probe, 1));
+  EXPECT_EQ(result, expectedJoin(build, probe));
+  EXPECT_FALSE(result.empty());
+
+  JoinKeys empty(1);
+  EXPECT_TRUE(join(empty, makeKeys(probe, 1)).empty());
+  EXPECT_TRUE(join(makeKeys(build, 1), empty).empty());
+}
+
+TEST(JoinHashTableTest, MultipleKeys) {
+  std::vector<Row> build;
+  for (auto i = 0; i < 1000; ++i) {
+    build.emplace_back(Row({i % 13, folly::to<std::string>(i % 17)}));
+  }
+  std::vector<Row> probe;
+  for (auto i = 0; i < 500; ++i) {
+    probe.emplace_back(Row({i % 11, folly::to<std::string>(i % 19)}));
+  }
+  auto result = join(makeKeys(build, 2), makeKeys(probe, 2));
+  EXPECT_EQ(result, expectedJoin(build, probe));
+  EXPECT_FALSE(result.empty());
+}
+
+TEST(JoinHashTableTest, Partitions) {
+  std::vector<Row> build;
+  for (auto i = 0; i < 100000; ++i) {
+    build.emplace_back(Row({i % 60000}));
+  }
+  std::vector<Row> probe;
+  for (auto i = 0; i < 50000; ++i) {
+    probe.emplace_back(Row({i * 3}));
+  }
+  auto keys = makeKeys(build, 1);
+  EXPECT_GT(JoinHashTable(keys).numPartitions(), 1);
+  auto result = join(keys, makeKeys(probe, 1));
+  EXPECT_EQ(result, expectedJoin(build, probe));
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,94 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/datatypes/DataSet.h"
+#include "graph/context/MemoryTracker.h"
+#include "graph/service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+TEST(MemoryTrackerTest, Limits) {
+  auto root = MemoryTracker::create("root", 1000, nullptr);
+  auto session = MemoryTracker::create("session", 600, root);
+  auto query1 = MemoryTracker::create("query1", 500, session);
+  auto query2 = MemoryTracker::create("query2", 0, session);
+
+  EXPECT_TRUE(query1->consume(400).ok());
+  EXPECT_EQ(400, session->used());
+  EXPECT_EQ(400, root->used());
+  // The limit of the query
+  EXPECT_FALSE(query1->consume(200).ok());
+  EXPECT_EQ(400, query1->used());
+  EXPECT_EQ(400, root->used());
+  // The limit of the session, nothing is charged
+  EXPECT_FALSE(query2->consume(300).ok());
+  EXPECT_EQ(0, query2->used());
+  EXPECT_EQ(400, session->used());
+  EXPECT_TRUE(query2->consume(200).ok());
+
+  query1->release(400);
+  EXPECT_EQ(0, query1->used());
+  EXPECT_EQ(200, root->used());
+  EXPECT_EQ(600, root->peak());
+}
+
+TEST(MemoryTrackerTest, Reservation) {
+  auto query = MemoryTracker::create("query", 100, nullptr);
+  {
+    auto memory = std::make_shared<MemoryReservation>(query);
+    EXPECT_TRUE(memory->resize(80).ok());
+    EXPECT_EQ(80, query->used());
+    EXPECT_FALSE(memory->resize(120).ok());
+    EXPECT_EQ(80, memory->bytes());
+    EXPECT_TRUE(memory->resize(30).ok());
+    EXPECT_EQ(30, query->used());
+  }
+  EXPECT_EQ(0, query->used());
+}
+
+TEST(MemoryTrackerTest, KillBiggest) {
+  auto killBiggest = FLAGS_kill_biggest_query_on_memory_limit;
+  FLAGS_kill_biggest_query_on_memory_limit = true;
+  auto root = MemoryTracker::create("root", 1000, nullptr);
+  auto session = MemoryTracker::create("session", 0, root);
+  auto big = MemoryTracker::create("big", 0, session);
+  auto small = MemoryTracker::create("small", 0, session);
+  bool bigKilled = false, smallKilled = false;
+  big->setKiller([&bigKilled]() { bigKilled = true; });
+  small->setKiller([&smallKilled]() { smallKilled = true; });
+
+  EXPECT_TRUE(big->consume(800).ok());
+  EXPECT_TRUE(small->consume(100).ok());
+  // Kill the big one instead of failing the small one
+  EXPECT_TRUE(small->consume(200).ok());
+  EXPECT_TRUE(bigKilled);
+  EXPECT_FALSE(smallKilled);
+
+  // Fail the biggest one itself
+  bigKilled = false;
+  big->setKiller([&bigKilled]() { bigKilled = true; });
+  EXPECT_FALSE(big->consume(100).ok());
+  EXPECT_FALSE(bigKilled);
+  EXPECT_FALSE(smallKilled);
+  FLAGS_kill_biggest_query_on_memory_limit = killBiggest;
+}
+
+TEST(MemoryTrackerTest, Estimate) {
+  DataSet ds({"a", "b"});
+  auto small = MemoryTracker::estimate(Value(ds));
+  for (auto i = 0; i < 1000; ++i) {
+    ds.rows.emplace_back(Row({i, std::string(100, 'x')}));
+  }
+  auto big = MemoryTracker::estimate(Value(ds));
+  // All rows are of the same size, so the sampling is exact
+  EXPECT_EQ(big - small, 1000 * (sizeof(Row) + 2 * sizeof(Value) + 100));
+  EXPECT_GT(MemoryTracker::estimate(Value(std::string(100, 'x'))), 100);
+}
+
+}  // namespace graph
+}  // namespace nebula
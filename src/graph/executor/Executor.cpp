@@ -150,7 +150,7 @@ Executor *Executor::makeExecutor(const PlanNode *node,
 
 // static
 Executor *Executor::makeExecutor(QueryContext *qctx, const PlanNode *node) {
-  auto pool = qctx->objPool();
+  auto pool = qctx->executorPool();
   switch (node->kind()) {
     case PlanNode::Kind::kPassThrough: {
       return pool->add(new PassThroughExecutor(node, qctx));
@@ -591,6 +591,21 @@ folly::Future<Status> Executor::start(Status status) const {
   return folly::makeFuture(std::move(status)).via(runner());
 }
 
+size_t Executor::acquireJobs(size_t size) {
+  auto batchSize = std::max<size_t>(FLAGS_min_batch_size, 1);
+  auto wanted = std::min<size_t>((size + batchSize - 1) / batchSize, FLAGS_max_job_size);
+  if (wanted <= 1) {
+    return 1;
+  }
+  return qctx()->acquireJobs(wanted - 1) + 1;
+}
+
+void Executor::releaseJobs(size_t jobs) {
+  if (jobs > 1) {
+    qctx()->releaseJobs(jobs - 1);
+  }
+}
+
 folly::Future<Status> Executor::error(Status status) const {
   return folly::makeFuture<Status>(std::move(status)).via(runner());
 }
@@ -614,7 +629,11 @@ Status Executor::finish(Result &&result) {
       node()->outputVarPtr()->userCount.load(std::memory_order_relaxed) != 0) {
     numRows_ = result.size();
     result.checkMemory(node()->isQueryNode());
+    auto status = trackMemory(&result);
     ectx_->setResult(node()->outputVar(), std::move(result));
+    if (!status.ok()) {
+      return status;
+    }
   } else {
     VLOG(1) << "Drop variable " << node()->outputVar();
   }
@@ -624,6 +643,34 @@ Status Executor::finish(Result &&result) {
   return Status::OK();
 }
 
+Status Executor::trackMemory(Result *result) {
+  if (!node()->isQueryNode()) {
+    return Status::OK();
+  }
+  auto memory = result->memory();
+  if (memory == nullptr) {
+    // The executors which modify the input in place share its reservation
+    for (auto *inputVar : node()->inputVars()) {
+      if (inputVar == nullptr) {
+        continue;
+      }
+      auto &input = ectx_->getResult(inputVar->name);
+      if (input.memory() != nullptr && input.valuePtr() == result->valuePtr()) {
+        memory = input.memory();
+        break;
+      }
+    }
+  }
+  if (memory == nullptr) {
+    memory = std::make_shared<MemoryReservation>(qctx_->memoryTracker());
+  }
+  auto bytes = MemoryTracker::estimate(result->value());
+  otherStats_.emplace("memory", folly::stringPrintf("%ld bytes", bytes));
+  auto status = memory->resize(bytes);
+  result->setMemory(std::move(memory));
+  return status;
+}
+
 Status Executor::finish(Value &&value) {
   return finish(ResultBuilder().value(std::move(value)).iter(Iterator::Kind::kDefault).build());
 }
@@ -8,6 +8,7 @@
 
 #include <folly/futures/Future.h>
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -87,8 +88,28 @@ class Executor : private cpp::NonCopyable, private cpp::NonMovable {
 
   folly::Executor *runner() const;
 
+  // Split the rows [0, size) into morsels and call `scatter(begin, end)' on
+  // them in parallel on the runner, then `gather' is called with the partial
+  // results in the order of the morsels. The number of morsels is limited by
+  // --min_batch_size and the job budget of the query. A single morsel is
+  // processed in the current thread.
+  //
+  // `scatter' is called concurrently, so it must not modify any state shared
+  // by the jobs, e.g. the expressions have to be cloned before evaluated.
+  template <typename ScatterFunc, typename GatherFunc>
+  auto runMultiJobs(size_t size, ScatterFunc &&scatter, GatherFunc &&gather);
+
+  // Return the number of jobs to process `size' rows, the jobs other than the
+  // current one take the slots of the job budget of the query
+  size_t acquireJobs(size_t size);
+
+  void releaseJobs(size_t jobs);
+
   void drop();
 
+  // Charge the memory taken by the value of the result on the query
+  Status trackMemory(Result *result);
+
   // Store the result of this executor to execution context
   Status finish(Result &&result);
   // Store the default result which not used for later executor
@@ -117,6 +138,42 @@ class Executor : private cpp::NonCopyable, private cpp::NonMovable {
   std::unordered_map<std::string, std::string> otherStats_;
 };
 
+template <typename ScatterFunc, typename GatherFunc>
+auto Executor::runMultiJobs(size_t size, ScatterFunc &&scatter, GatherFunc &&gather) {
+  using Partial = std::invoke_result_t<ScatterFunc, size_t, size_t>;
+  auto jobs = acquireJobs(size);
+  if (jobs <= 1) {
+    std::vector<Partial> partials;
+    partials.emplace_back(scatter(0, size));
+    return folly::makeFuture(std::move(partials)).thenValue(std::forward<GatherFunc>(gather));
+  }
+
+  auto batchSize = (size + jobs - 1) / jobs;
+  auto func = std::make_shared<std::decay_t<ScatterFunc>>(std::forward<ScatterFunc>(scatter));
+  std::vector<folly::Future<Partial>> futures;
+  futures.reserve(jobs);
+  for (size_t begin = 0; begin < size; begin += batchSize) {
+    auto end = std::min(size, begin + batchSize);
+    futures.emplace_back(folly::via(runner(), [func, begin, end]() { return (*func)(begin, end); }));
+  }
+  otherStats_.emplace("jobs", std::to_string(futures.size()));
+
+  // Wait for all the jobs even if some of them fail, since they are still
+  // reading the input
+  return folly::collectAll(futures)
+      .via(runner())
+      .thenValue([g = std::forward<GatherFunc>(gather)](
+                     std::vector<folly::Try<Partial>> &&tries) mutable {
+        std::vector<Partial> partials;
+        partials.reserve(tries.size());
+        for (auto &t : tries) {
+          partials.emplace_back(std::move(t).value());
+        }
+        return g(std::move(partials));
+      })
+      .ensure([this, jobs]() { releaseJobs(jobs); });
+}
+
 }  // namespace graph
 }  // namespace nebula
 
@@ -34,9 +34,11 @@ folly::Future<Status> ShowQueriesExecutor::showCurrentSessionQueries() {
                    "Host",
                    "StartTime",
                    "DurationInUSec",
+                   "MemoryInBytes",
                    "Status",
                    "Query"});
   auto* session = qctx()->rctx()->session();
+  session->updateQueryStats();
   auto sessionInMeta = session->getSession();
 
   addQueries(sessionInMeta, dataSet);
@@ -59,6 +61,7 @@ folly::Future<Status> ShowQueriesExecutor::showAllSessionQueries() {
                          "Host",
                          "StartTime",
                          "DurationInUSec",
+                         "MemoryInBytes",
                          "Status",
                          "Query"});
         for (auto& session : sessions) {
@@ -84,6 +87,7 @@ void ShowQueriesExecutor::addQueries(const meta::cpp2::Session& session, DataSet
     dateTime.microsec = query.second.get_start_time() % 1000000;
     row.values.emplace_back(std::move(dateTime));
     row.values.emplace_back(query.second.get_duration());
+    row.values.emplace_back(query.second.get_memory());
     row.values.emplace_back(apache::thrift::util::enumNameSafe(query.second.get_status()));
     row.values.emplace_back(query.second.get_query());
     dataSet.rows.emplace_back(std::move(row));
@@ -12,6 +12,7 @@
 #include "graph/context/Result.h"
 #include "graph/planner/plan/PlanNode.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -23,6 +24,9 @@ folly::Future<Status> AggregateExecutor::execute() {
   auto groupItems = agg->groupItems();
   auto iter = ectx_->getResult(agg->inputVar()).iter();
   DCHECK(!!iter);
+  if (FLAGS_max_job_size > 1 && iter->isSequentialIter() && iter->size() > FLAGS_min_batch_size) {
+    return aggregateSequential(std::move(iter));
+  }
   QueryExpressionContext ctx(ectx_);
 
   std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>> result;
@@ -93,5 +97,128 @@ folly::Future<Status> AggregateExecutor::execute() {
   return finish(ResultBuilder().value(Value(std::move(ds))).build());
 }
 
+folly::Future<Status> AggregateExecutor::aggregateSequential(std::unique_ptr<Iterator> input) {
+  auto* iter = static_cast<SequentialIter*>(input.get());
+  auto numParts = static_cast<size_t>(FLAGS_max_job_size);
+  auto scatter = [this, iter, numParts](size_t begin, size_t end) {
+    return partitionRows(iter, numParts, begin, end);
+  };
+  auto gather = [this, iter, numParts, input = std::move(input)](
+                    std::vector<Morsel>&& partials) mutable -> folly::Future<Status> {
+    // Aggregate the partitions with as many jobs as the morsels
+    auto numJobs = partials.size();
+    auto morsels = std::make_shared<std::vector<Morsel>>(std::move(partials));
+    auto aggregateParts = [this, iter, morsels, numParts, numJobs](size_t job) {
+      std::vector<Row> rows;
+      for (auto part = job; part < numParts; part += numJobs) {
+        auto partRows = aggregatePartition(iter, *morsels, part);
+        std::move(partRows.begin(), partRows.end(), std::back_inserter(rows));
+      }
+      return rows;
+    };
+    std::vector<folly::Future<std::vector<Row>>> futures;
+    futures.reserve(numJobs);
+    if (numJobs == 1) {
+      futures.emplace_back(folly::makeFuture(aggregateParts(0)));
+    } else {
+      for (size_t job = 0; job < numJobs; ++job) {
+        futures.emplace_back(folly::via(runner(), [aggregateParts, job]() {
+          return aggregateParts(job);
+        }));
+      }
+    }
+    return folly::collectAll(futures).via(runner()).thenValue(
+        [this, input = std::move(input)](std::vector<folly::Try<std::vector<Row>>>&& tries) {
+          DataSet ds;
+          ds.colNames = asNode<Aggregate>(node())->colNames();
+          for (auto& t : tries) {
+            auto rows = std::move(t).value();
+            std::move(rows.begin(), rows.end(), std::back_inserter(ds.rows));
+          }
+          return finish(ResultBuilder().value(Value(std::move(ds))).build());
+        });
+  };
+  return runMultiJobs(iter->size(), std::move(scatter), std::move(gather));
+}
+
+AggregateExecutor::Morsel AggregateExecutor::partitionRows(const SequentialIter* iter,
+                                                           size_t numParts,
+                                                           size_t begin,
+                                                           size_t end) {
+  // The expressions keep the evaluation results inside, so each job owns a
+  // copy
+  std::vector<Expression*> groupKeys;
+  for (auto* key : asNode<Aggregate>(node())->groupKeys()) {
+    groupKeys.emplace_back(key->clone());
+  }
+  auto copy = iter->copy();
+  auto* jobIter = static_cast<SequentialIter*>(copy.get());
+  QueryExpressionContext ctx(ectx_);
+  Morsel morsel;
+  morsel.begin = begin;
+  morsel.keys.reserve(end - begin);
+  morsel.parts.resize(numParts);
+  for (auto i = begin; i < end; ++i) {
+    jobIter->reset(i);
+    List list;
+    list.values.reserve(groupKeys.size());
+    for (auto* key : groupKeys) {
+      list.values.emplace_back(key->eval(ctx(jobIter)));
+    }
+    morsel.parts[std::hash<List>()(list) % numParts].emplace_back(i);
+    morsel.keys.emplace_back(std::move(list));
+  }
+  return morsel;
+}
+
+std::vector<Row> AggregateExecutor::aggregatePartition(const SequentialIter* iter,
+                                                       const std::vector<Morsel>& morsels,
+                                                       size_t part) {
+  std::vector<Expression*> groupItems;
+  for (auto* item : asNode<Aggregate>(node())->groupItems()) {
+    groupItems.emplace_back(item->clone());
+  }
+  auto copy = iter->copy();
+  auto* jobIter = static_cast<SequentialIter*>(copy.get());
+  QueryExpressionContext ctx(ectx_);
+
+  std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>> result;
+  for (auto& morsel : morsels) {
+    for (auto pos : morsel.parts[part]) {
+      jobIter->reset(pos);
+      auto& key = morsel.keys[pos - morsel.begin];
+      auto it = result.find(key);
+      if (it == result.end()) {
+        std::vector<std::unique_ptr<AggData>> cols;
+        for (size_t i = 0; i < groupItems.size(); ++i) {
+          cols.emplace_back(new AggData());
+        }
+        it = result.emplace(key, std::move(cols)).first;
+      }
+
+      for (size_t i = 0; i < groupItems.size(); ++i) {
+        auto* item = groupItems[i];
+        if (item->kind() == Expression::Kind::kAggregate) {
+          static_cast<AggregateExpression*>(item)->setAggData(it->second[i].get());
+          item->eval(ctx(jobIter));
+        } else {
+          it->second[i]->setResult(item->eval(ctx(jobIter)));
+        }
+      }
+    }
+  }
+
+  std::vector<Row> rows;
+  rows.reserve(result.size());
+  for (auto& kv : result) {
+    Row row;
+    for (auto& v : kv.second) {
+      row.values.emplace_back(v->result());
+    }
+    rows.emplace_back(std::move(row));
+  }
+  return rows;
+}
+
 }  // namespace graph
 }  // namespace nebula
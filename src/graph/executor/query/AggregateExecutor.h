@@ -6,6 +6,8 @@
 #ifndef GRAPH_EXECUTOR_QUERY_AGGREGATEEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_AGGREGATEEXECUTOR_H_
 
+#include "common/datatypes/List.h"
+#include "graph/context/Iterator.h"
 #include "graph/executor/Executor.h"
 
 namespace nebula {
@@ -17,6 +19,28 @@ class AggregateExecutor final : public Executor {
       : Executor("AggregateExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  // The group keys of the rows in a morsel, and the positions of the rows
+  // partitioned by the hash of their group keys
+  struct Morsel {
+    size_t begin{0};
+    std::vector<List> keys;
+    std::vector<std::vector<size_t>> parts;
+  };
+
+  // Aggregate the sequential input in parallel. The rows are partitioned by
+  // the group keys in parallel morsels first, then the partitions are
+  // aggregated in parallel. Each group lives in a single partition and sees
+  // its rows in the input order, so the results are the same as aggregating
+  // in a single thread.
+  folly::Future<Status> aggregateSequential(std::unique_ptr<Iterator> input);
+
+  Morsel partitionRows(const SequentialIter *iter, size_t numParts, size_t begin, size_t end);
+
+  std::vector<Row> aggregatePartition(const SequentialIter *iter,
+                                      const std::vector<Morsel> &morsels,
+                                      size_t part);
 };
 
 }  // namespace graph
@@ -8,9 +8,11 @@
 #include "common/time/ScopedTimer.h"
 #include "graph/context/QueryExpressionContext.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
+
 folly::Future<Status> DedupExecutor::execute() {
   SCOPED_TIMER(&execTime_);
   auto* dedup = asNode<Dedup>(node());
@@ -27,6 +29,9 @@ folly::Future<Status> DedupExecutor::execute() {
     LOG(ERROR) << e;
     return e;
   }
+  if (FLAGS_max_job_size > 1 && iter->isSequentialIter() && iter->size() > FLAGS_min_batch_size) {
+    return dedupSequential(std::move(result));
+  }
   std::unordered_set<const Row*> unique;
   unique.reserve(iter->size());
   while (iter->valid()) {
@@ -40,5 +45,77 @@ folly::Future<Status> DedupExecutor::execute() {
   return finish(std::move(result));
 }
 
+folly::Future<Status> DedupExecutor::dedupSequential(Result result) {
+  auto* iter = static_cast<SequentialIter*>(result.iterRef());
+  auto numParts = static_cast<size_t>(FLAGS_max_job_size);
+  auto scatter = [this, iter, numParts](size_t begin, size_t end) {
+    return partitionRows(iter, numParts, begin, end);
+  };
+  auto gather = [this, iter, numParts, result = std::move(result)](
+                    std::vector<Partitions>&& partials) mutable -> folly::Future<Status> {
+    auto numJobs = partials.size();
+    auto morsels = std::make_shared<std::vector<Partitions>>(std::move(partials));
+    // Each job only writes the flags of the rows of its own partitions
+    auto duplicated = std::make_shared<std::vector<char>>(iter->size(), false);
+    auto markParts = [iter, morsels, duplicated, numParts, numJobs](size_t job) {
+      for (auto part = job; part < numParts; part += numJobs) {
+        std::unordered_set<const Row*> unique;
+        for (auto& morsel : *morsels) {
+          for (auto pos : morsel[part]) {
+            if (!unique.emplace(&*(iter->begin() + pos)).second) {
+              (*duplicated)[pos] = true;
+            }
+          }
+        }
+      }
+    };
+    std::vector<folly::Future<folly::Unit>> futures;
+    futures.reserve(numJobs);
+    if (numJobs == 1) {
+      markParts(0);
+      futures.emplace_back(folly::makeFuture());
+    } else {
+      for (size_t job = 0; job < numJobs; ++job) {
+        futures.emplace_back(folly::via(runner(), [markParts, job]() { return markParts(job); }));
+      }
+    }
+    return folly::collectAll(futures).via(runner()).thenValue(
+        [this, iter, duplicated, result = std::move(result)](
+            std::vector<folly::Try<folly::Unit>>&& tries) mutable {
+          for (auto& t : tries) {
+            // Rethrow the exception of any job
+            t.value();
+          }
+          auto rows = iter->begin();
+          size_t kept = 0;
+          for (size_t i = 0; i < duplicated->size(); ++i) {
+            if ((*duplicated)[i]) {
+              continue;
+            }
+            if (i != kept) {
+              rows[kept] = std::move(rows[i]);
+            }
+            ++kept;
+          }
+          iter->eraseRange(kept, iter->size());
+          iter->reset();
+          return finish(std::move(result));
+        });
+  };
+  return runMultiJobs(iter->size(), std::move(scatter), std::move(gather));
+}
+
+DedupExecutor::Partitions DedupExecutor::partitionRows(SequentialIter* iter,
+                                                       size_t numParts,
+                                                       size_t begin,
+                                                       size_t end) {
+  Partitions parts(numParts);
+  auto rows = iter->begin();
+  for (auto i = begin; i < end; ++i) {
+    parts[std::hash<const Row*>()(&rows[i]) % numParts].emplace_back(i);
+  }
+  return parts;
+}
+
 }  // namespace graph
 }  // namespace nebula
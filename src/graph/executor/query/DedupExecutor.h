@@ -6,6 +6,7 @@
 #ifndef GRAPH_EXECUTOR_QUERY_DEDUPEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_DEDUPEXECUTOR_H_
 
+#include "graph/context/Iterator.h"
 #include "graph/executor/Executor.h"
 
 namespace nebula {
@@ -16,6 +17,18 @@ class DedupExecutor final : public Executor {
   DedupExecutor(const PlanNode *node, QueryContext *qctx) : Executor("DedupExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  // Dedup the sequential input in parallel. The rows are partitioned by their
+  // hash in parallel morsels first, then the duplicated rows of each partition
+  // are found in parallel. The first one of the same rows is kept and the
+  // order of rows is kept.
+  folly::Future<Status> dedupSequential(Result result);
+
+  // Positions of the rows in a morsel, partitioned by the hash of the rows
+  using Partitions = std::vector<std::vector<size_t>>;
+
+  Partitions partitionRows(SequentialIter *iter, size_t numParts, size_t begin, size_t end);
 };
 
 }  // namespace graph
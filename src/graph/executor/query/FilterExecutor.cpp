@@ -6,8 +6,10 @@
 #include "graph/executor/query/FilterExecutor.h"
 
 #include "common/time/ScopedTimer.h"
+#include "graph/context/BatchEvaluator.h"
 #include "graph/context/QueryExpressionContext.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -27,10 +29,14 @@ folly::Future<Status> FilterExecutor::execute() {
           << ", iterator type: " << static_cast<int16_t>(iter->kind())
           << ", input data size: " << iter->size();
 
+  if (iter->isSequentialIter()) {
+    return filterSequential(std::move(result));
+  }
+
   ResultBuilder builder;
   builder.value(result.valuePtr());
-  QueryExpressionContext ctx(ectx_);
   auto condition = filter->condition();
+  QueryExpressionContext ctx(ectx_);
   while (iter->valid()) {
     auto val = condition->eval(ctx(iter));
     if (val.isBadNull() || (!val.empty() && !val.isBool() && !val.isNull())) {
@@ -52,5 +58,72 @@ folly::Future<Status> FilterExecutor::execute() {
   return finish(builder.build());
 }
 
+folly::Future<Status> FilterExecutor::filterSequential(Result result) {
+  auto* condition = asNode<Filter>(node())->condition();
+  auto* iter = static_cast<SequentialIter*>(result.iterRef());
+  auto scatter = [this, iter, condition](size_t begin, size_t end) {
+    // The expressions keep the evaluation results inside, so each job owns
+    // a copy
+    return selectRows(iter, condition->clone(), begin, end);
+  };
+  // The selected rows are compacted to the front in place, which keeps the
+  // order of rows, so it's good for both the stable and the unstable filter
+  auto gather = [this, iter, result = std::move(result)](
+                    std::vector<StatusOr<std::vector<size_t>>>&& partials) mutable -> Status {
+    auto rows = iter->begin();
+    size_t kept = 0;
+    for (auto& partial : partials) {
+      NG_RETURN_IF_ERROR(partial);
+      for (auto i : partial.value()) {
+        if (i != kept) {
+          rows[kept] = std::move(rows[i]);
+        }
+        ++kept;
+      }
+    }
+    iter->eraseRange(kept, iter->size());
+    iter->reset();
+    ResultBuilder builder;
+    builder.value(result.valuePtr());
+    builder.iter(std::move(result).iter());
+    return finish(builder.build());
+  };
+  return runMultiJobs(iter->size(), std::move(scatter), std::move(gather));
+}
+
+StatusOr<std::vector<size_t>> FilterExecutor::selectRows(const SequentialIter* iter,
+                                                         Expression* condition,
+                                                         size_t begin,
+                                                         size_t end) {
+  auto copy = iter->copy();
+  auto* jobIter = static_cast<SequentialIter*>(copy.get());
+  QueryExpressionContext ctx(ectx_);
+  std::vector<size_t> selected;
+  if (FLAGS_num_rows_per_eval_batch > 0) {
+    auto batchSize = static_cast<size_t>(FLAGS_num_rows_per_eval_batch);
+    for (auto batchBegin = begin; batchBegin < end; batchBegin += batchSize) {
+      auto batchEnd = std::min(end, batchBegin + batchSize);
+      BatchEvaluator evaluator(&ctx, jobIter, batchBegin, batchEnd);
+      auto batchSelected = evaluator.filter(condition, evaluator.selectAll());
+      NG_RETURN_IF_ERROR(batchSelected);
+      auto& positions = batchSelected.value();
+      selected.insert(selected.end(), positions.begin(), positions.end());
+    }
+    return selected;
+  }
+
+  for (auto i = begin; i < end; ++i) {
+    jobIter->reset(i);
+    auto val = condition->eval(ctx(jobIter));
+    if (val.isBadNull() || (!val.empty() && !val.isBool() && !val.isNull())) {
+      return Status::Error("Wrong type result, the type should be NULL, EMPTY or BOOL");
+    }
+    if (val.isBool() && val.getBool()) {
+      selected.emplace_back(i);
+    }
+  }
+  return selected;
+}
+
 }  // namespace graph
 }  // namespace nebula
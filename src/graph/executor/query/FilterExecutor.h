@@ -6,6 +6,8 @@
 #ifndef GRAPH_EXECUTOR_QUERY_FILTEREXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_FILTEREXECUTOR_H_
 
+#include "common/base/StatusOr.h"
+#include "graph/context/Iterator.h"
 #include "graph/executor/Executor.h"
 
 namespace nebula {
@@ -17,6 +19,17 @@ class FilterExecutor final : public Executor {
       : Executor("FilterExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  // Filter the sequential input in parallel morsels, the order of rows is kept
+  folly::Future<Status> filterSequential(Result result);
+
+  // Return the positions of the rows in [begin, end) on which `condition' is
+  // true
+  StatusOr<std::vector<size_t>> selectRows(const SequentialIter *iter,
+                                           Expression *condition,
+                                           size_t begin,
+                                           size_t end);
 };
 
 }  // namespace graph
@@ -25,104 +25,52 @@ Status InnerJoinExecutor::close() {
 
 folly::Future<Status> InnerJoinExecutor::join() {
   auto* join = asNode<Join>(node());
-  auto bucketSize = lhsIter_->size() > rhsIter_->size() ? rhsIter_->size() : lhsIter_->size();
-
   auto& hashKeys = join->hashKeys();
   auto& probeKeys = join->probeKeys();
   DCHECK_EQ(hashKeys.size(), probeKeys.size());
-  DataSet result;
 
   if (lhsIter_->empty() || rhsIter_->empty()) {
+    DataSet result;
     result.colNames = join->colNames();
     return finish(ResultBuilder().value(Value(std::move(result))).build());
   }
 
-  if (hashKeys.size() == 1 && probeKeys.size() == 1) {
-    std::unordered_map<Value, std::vector<const Row*>> hashTable;
-    hashTable.reserve(bucketSize);
-    if (lhsIter_->size() < rhsIter_->size()) {
-      buildSingleKeyHashTable(hashKeys.front(), lhsIter_.get(), hashTable);
-      result = singleKeyProbe(probeKeys.front(), rhsIter_.get(), hashTable);
-    } else {
-      exchange_ = true;
-      buildSingleKeyHashTable(probeKeys.front(), rhsIter_.get(), hashTable);
-      result = singleKeyProbe(hashKeys.front(), lhsIter_.get(), hashTable);
-    }
+  // Build the hash table on the smaller side
+  std::shared_ptr<JoinHashTable> table;
+  std::shared_ptr<JoinKeys> probe;
+  if (lhsIter_->size() < rhsIter_->size()) {
+    table = std::make_shared<JoinHashTable>(evalKeys(hashKeys, lhsIter_.get()));
+    probe = std::make_shared<JoinKeys>(evalKeys(probeKeys, rhsIter_.get()));
   } else {
-    std::unordered_map<List, std::vector<const Row*>> hashTable;
-    hashTable.reserve(bucketSize);
-    if (lhsIter_->size() < rhsIter_->size()) {
-      buildHashTable(join->hashKeys(), lhsIter_.get(), hashTable);
-      result = probe(join->probeKeys(), rhsIter_.get(), hashTable);
-    } else {
-      exchange_ = true;
-      buildHashTable(join->probeKeys(), rhsIter_.get(), hashTable);
-      result = probe(join->hashKeys(), lhsIter_.get(), hashTable);
-    }
+    exchange_ = true;
+    table = std::make_shared<JoinHashTable>(evalKeys(probeKeys, rhsIter_.get()));
+    probe = std::make_shared<JoinKeys>(evalKeys(hashKeys, lhsIter_.get()));
   }
-  result.colNames = join->colNames();
-  return finish(ResultBuilder().value(Value(std::move(result))).build());
-}
-
-DataSet InnerJoinExecutor::probe(
-    const std::vector<Expression*>& probeKeys,
-    Iterator* probeIter,
-    const std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
-  DataSet ds;
-  QueryExpressionContext ctx(ectx_);
-  ds.rows.reserve(probeIter->size());
-  for (; probeIter->valid(); probeIter->next()) {
-    List list;
-    list.values.reserve(probeKeys.size());
-    for (auto& col : probeKeys) {
-      Value val = col->eval(ctx(probeIter));
-      list.values.emplace_back(std::move(val));
+  return buildAndProbe(table, probe).thenValue([this, table, probe](std::vector<uint32_t>&& heads) {
+    DataSet result;
+    result.colNames = asNode<Join>(node())->colNames();
+    result.rows.reserve(probe->size());
+    for (size_t i = 0; i < probe->size(); ++i) {
+      for (auto entry = heads[i]; entry != JoinHashTable::kNone; entry = table->next(entry)) {
+        buildNewRow(*table->row(entry), *probe->rows[i], result);
+      }
     }
-    buildNewRow<List>(hashTable, list, *probeIter->row(), ds);
-  }
-  return ds;
-}
-
-DataSet InnerJoinExecutor::singleKeyProbe(
-    Expression* probeKey,
-    Iterator* probeIter,
-    const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const {
-  DataSet ds;
-  QueryExpressionContext ctx(ectx_);
-  for (; probeIter->valid(); probeIter->next()) {
-    auto& val = probeKey->eval(ctx(probeIter));
-    buildNewRow<Value>(hashTable, val, *probeIter->row(), ds);
-  }
-  return ds;
+    return finish(ResultBuilder().value(Value(std::move(result))).build());
+  });
 }
 
-template <class T>
-void InnerJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
-                                    const T& val,
-                                    const Row& rRow,
-                                    DataSet& ds) const {
-  const auto& range = hashTable.find(val);
-  if (range == hashTable.end()) {
-    return;
-  }
-  for (auto* row : range->second) {
-    auto& lRow = *row;
-    Row newRow;
-    newRow.reserve(lRow.size() + rRow.size());
-    auto& values = newRow.values;
-    if (exchange_) {
-      values.insert(values.end(),
-                    std::make_move_iterator(rRow.values.begin()),
-                    std::make_move_iterator(rRow.values.end()));
-      values.insert(values.end(), lRow.values.begin(), lRow.values.end());
-    } else {
-      values.insert(values.end(), lRow.values.begin(), lRow.values.end());
-      values.insert(values.end(),
-                    std::make_move_iterator(rRow.values.begin()),
-                    std::make_move_iterator(rRow.values.end()));
-    }
-    ds.rows.emplace_back(std::move(newRow));
+void InnerJoinExecutor::buildNewRow(const Row& buildRow, const Row& probeRow, DataSet& ds) const {
+  Row newRow;
+  newRow.reserve(buildRow.size() + probeRow.size());
+  auto& values = newRow.values;
+  if (exchange_) {
+    values.insert(values.end(), probeRow.values.begin(), probeRow.values.end());
+    values.insert(values.end(), buildRow.values.begin(), buildRow.values.end());
+  } else {
+    values.insert(values.end(), buildRow.values.begin(), buildRow.values.end());
+    values.insert(values.end(), probeRow.values.begin(), probeRow.values.end());
   }
+  ds.rows.emplace_back(std::move(newRow));
 }
 }  // namespace graph
 }  // namespace nebula
@@ -23,19 +23,7 @@ class InnerJoinExecutor final : public JoinExecutor {
  private:
   folly::Future<Status> join();
 
-  DataSet probe(const std::vector<Expression*>& probeKeys,
-                Iterator* probeIter,
-                const std::unordered_map<List, std::vector<const Row*>>& hashTable) const;
-
-  DataSet singleKeyProbe(Expression* probeKey,
-                         Iterator* probeIter,
-                         const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const;
-
-  template <class T>
-  void buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
-                   const T& val,
-                   const Row& rRow,
-                   DataSet& ds) const;
+  void buildNewRow(const Row& buildRow, const Row& probeRow, DataSet& ds) const;
 
  private:
   bool exchange_{false};
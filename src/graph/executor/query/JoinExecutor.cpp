@@ -34,35 +34,69 @@ Status JoinExecutor::checkInputDataSets() {
   return Status::OK();
 }
 
-void JoinExecutor::buildHashTable(
-    const std::vector<Expression*>& hashKeys,
-    Iterator* iter,
-    std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
+JoinKeys JoinExecutor::evalKeys(const std::vector<Expression*>& keys, Iterator* iter) const {
+  JoinKeys joinKeys(keys.size());
+  joinKeys.reserve(iter->size());
   QueryExpressionContext ctx(ectx_);
   for (; iter->valid(); iter->next()) {
-    List list;
-    list.values.reserve(hashKeys.size());
-    for (auto& col : hashKeys) {
-      Value val = col->eval(ctx(iter));
-      list.values.emplace_back(std::move(val));
+    for (auto* key : keys) {
+      joinKeys.values.emplace_back(key->eval(ctx(iter)));
     }
-
-    auto& vals = hashTable[list];
-    vals.emplace_back(iter->row());
+    joinKeys.append(iter->row());
   }
+  return joinKeys;
 }
 
-void JoinExecutor::buildSingleKeyHashTable(
-    Expression* hashKey,
-    Iterator* iter,
-    std::unordered_map<Value, std::vector<const Row*>>& hashTable) const {
-  QueryExpressionContext ctx(ectx_);
-  for (; iter->valid(); iter->next()) {
-    auto& val = hashKey->eval(ctx(iter));
+folly::Future<std::vector<uint32_t>> JoinExecutor::buildAndProbe(
+    std::shared_ptr<JoinHashTable> table, std::shared_ptr<const JoinKeys> probe) {
+  auto numParts = table->numPartitions();
+  auto size = table->size() + probe->size();
+  return forEachPartition(numParts, size, [table](size_t part) { table->buildPartition(part); })
+      .thenValue([this, table, probe, numParts, size](folly::Unit) {
+        auto parts =
+            std::make_shared<std::vector<std::vector<uint32_t>>>(table->partition(*probe));
+        // Each partition only writes the heads of its own probe rows
+        auto heads = std::make_shared<std::vector<uint32_t>>(probe->size(), JoinHashTable::kNone);
+        return forEachPartition(numParts,
+                                size,
+                                [table, probe, parts, heads](size_t part) {
+                                  table->probePartition(*probe, part, (*parts)[part], heads.get());
+                                })
+            .thenValue([heads](folly::Unit) { return std::move(*heads); });
+      });
+}
+
+folly::Future<folly::Unit> JoinExecutor::forEachPartition(size_t numParts,
+                                                          size_t size,
+                                                          std::function<void(size_t)> func) {
+  auto granted = acquireJobs(size);
+  auto jobs = std::min(granted, numParts);
+  if (jobs <= 1) {
+    for (size_t part = 0; part < numParts; ++part) {
+      func(part);
+    }
+    releaseJobs(granted);
+    return folly::makeFuture();
+  }
 
-    auto& vals = hashTable[val];
-    vals.emplace_back(iter->row());
+  std::vector<folly::Future<folly::Unit>> futures;
+  futures.reserve(jobs);
+  for (size_t job = 0; job < jobs; ++job) {
+    futures.emplace_back(folly::via(runner(), [func, job, jobs, numParts]() {
+      for (auto part = job; part < numParts; part += jobs) {
+        func(part);
+      }
+    }));
   }
+  return folly::collectAll(futures)
+      .via(runner())
+      .thenValue([](std::vector<folly::Try<folly::Unit>>&& tries) {
+        for (auto& t : tries) {
+          // Rethrow the exception of any job
+          t.value();
+        }
+      })
+      .ensure([this, granted]() { releaseJobs(granted); });
 }
 
 }  // namespace graph
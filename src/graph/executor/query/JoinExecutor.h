@@ -6,6 +6,7 @@
 #ifndef GRAPH_EXECUTOR_QUERY_JOINEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_JOINEXECUTOR_H_
 
+#include "graph/context/JoinHashTable.h"
 #include "graph/executor/Executor.h"
 
 namespace nebula {
@@ -18,16 +19,20 @@ class JoinExecutor : public Executor {
 
   Status checkInputDataSets();
 
-  void buildHashTable(const std::vector<Expression*>& hashKeys, Iterator* iter);
-
  protected:
-  void buildHashTable(const std::vector<Expression*>& hashKeys,
-                      Iterator* iter,
-                      std::unordered_map<List, std::vector<const Row*>>& hashTable) const;
-
-  void buildSingleKeyHashTable(Expression* hashKey,
-                               Iterator* iter,
-                               std::unordered_map<Value, std::vector<const Row*>>& hashTable) const;
+  // Evaluate the join keys of all the rows of `iter'
+  JoinKeys evalKeys(const std::vector<Expression*>& keys, Iterator* iter) const;
+
+  // Build the partitions of `table', then find the first matched entry of
+  // each probe row, kNone if no match. The partitions are built and probed
+  // in parallel if the job budget of the query allows.
+  folly::Future<std::vector<uint32_t>> buildAndProbe(std::shared_ptr<JoinHashTable> table,
+                                                     std::shared_ptr<const JoinKeys> probe);
+
+  // Call `func(part)' for each partition, on `size' rows in total
+  folly::Future<folly::Unit> forEachPartition(size_t numParts,
+                                              size_t size,
+                                              std::function<void(size_t)> func);
 
   std::unique_ptr<Iterator> lhsIter_;
   std::unique_ptr<Iterator> rhsIter_;
@@ -28,91 +28,49 @@ folly::Future<Status> LeftJoinExecutor::join() {
   auto& hashKeys = join->hashKeys();
   auto& probeKeys = join->probeKeys();
   DCHECK_EQ(hashKeys.size(), probeKeys.size());
-  DataSet result;
 
-  if (hashKeys.size() == 1 && probeKeys.size() == 1) {
-    std::unordered_map<Value, std::vector<const Row*>> hashTable;
-    hashTable.reserve(rhsIter_->size() == 0 ? 1 : rhsIter_->size());
-    if (!lhsIter_->empty()) {
-      buildSingleKeyHashTable(join->probeKeys().front(), rhsIter_.get(), hashTable);
-      result = singleKeyProbe(join->hashKeys().front(), lhsIter_.get(), hashTable);
-    }
-  } else {
-    std::unordered_map<List, std::vector<const Row*>> hashTable;
-    hashTable.reserve(rhsIter_->size() == 0 ? 1 : rhsIter_->size());
-    if (!lhsIter_->empty()) {
-      buildHashTable(join->probeKeys(), rhsIter_.get(), hashTable);
-      result = probe(join->hashKeys(), lhsIter_.get(), hashTable);
-    }
+  if (lhsIter_->empty()) {
+    DataSet result;
+    result.colNames = join->colNames();
+    return finish(ResultBuilder().value(Value(std::move(result))).build());
   }
 
-  result.colNames = join->colNames();
-  VLOG(2) << node_->toString() << ", result: " << result;
-  return finish(ResultBuilder().value(Value(std::move(result))).build());
-}
-
-DataSet LeftJoinExecutor::probe(
-    const std::vector<Expression*>& probeKeys,
-    Iterator* probeIter,
-    const std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
-  DataSet ds;
-  ds.rows.reserve(probeIter->size());
-  QueryExpressionContext ctx(ectx_);
-  for (; probeIter->valid(); probeIter->next()) {
-    List list;
-    list.values.reserve(probeKeys.size());
-    for (auto& col : probeKeys) {
-      Value val = col->eval(ctx(probeIter));
-      list.values.emplace_back(std::move(val));
+  auto table = std::make_shared<JoinHashTable>(evalKeys(probeKeys, rhsIter_.get()));
+  auto probe = std::make_shared<JoinKeys>(evalKeys(hashKeys, lhsIter_.get()));
+  return buildAndProbe(table, probe).thenValue([this, table, probe](std::vector<uint32_t>&& heads) {
+    DataSet result;
+    result.colNames = asNode<Join>(node())->colNames();
+    result.rows.reserve(probe->size());
+    for (size_t i = 0; i < probe->size(); ++i) {
+      buildNewRow(*table, heads[i], *probe->rows[i], result);
     }
-
-    buildNewRow<List>(hashTable, list, *probeIter->row(), ds);
-  }
-  return ds;
-}
-
-DataSet LeftJoinExecutor::singleKeyProbe(
-    Expression* probeKey,
-    Iterator* probeIter,
-    const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const {
-  DataSet ds;
-  ds.rows.reserve(probeIter->size());
-  QueryExpressionContext ctx(ectx_);
-  for (; probeIter->valid(); probeIter->next()) {
-    auto& val = probeKey->eval(ctx(probeIter));
-    buildNewRow<Value>(hashTable, val, *probeIter->row(), ds);
-  }
-  return ds;
+    VLOG(2) << node_->toString() << ", result: " << result;
+    return finish(ResultBuilder().value(Value(std::move(result))).build());
+  });
 }
 
-template <class T>
-void LeftJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
-                                   const T& val,
+void LeftJoinExecutor::buildNewRow(const JoinHashTable& table,
+                                   uint32_t entry,
                                    const Row& lRow,
                                    DataSet& ds) const {
-  auto range = hashTable.find(val);
-  if (range == hashTable.end()) {
+  if (entry == JoinHashTable::kNone) {
     auto lRowSize = lRow.size();
     Row newRow;
     newRow.reserve(colSize_);
     auto& values = newRow.values;
-    values.insert(values.end(),
-                  std::make_move_iterator(lRow.values.begin()),
-                  std::make_move_iterator(lRow.values.end()));
+    values.insert(values.end(), lRow.values.begin(), lRow.values.end());
     values.insert(values.end(), colSize_ - lRowSize, Value::kEmpty);
     ds.rows.emplace_back(std::move(newRow));
-  } else {
-    for (auto* row : range->second) {
-      auto& rRow = *row;
-      Row newRow;
-      auto& values = newRow.values;
-      values.reserve(lRow.size() + rRow.size());
-      values.insert(values.end(),
-                    std::make_move_iterator(lRow.values.begin()),
-                    std::make_move_iterator(lRow.values.end()));
-      values.insert(values.end(), rRow.values.begin(), rRow.values.end());
-      ds.rows.emplace_back(std::move(newRow));
-    }
+    return;
+  }
+  for (; entry != JoinHashTable::kNone; entry = table.next(entry)) {
+    auto& rRow = *table.row(entry);
+    Row newRow;
+    auto& values = newRow.values;
+    values.reserve(lRow.size() + rRow.size());
+    values.insert(values.end(), lRow.values.begin(), lRow.values.end());
+    values.insert(values.end(), rRow.values.begin(), rRow.values.end());
+    ds.rows.emplace_back(std::move(newRow));
   }
 }
 
@@ -23,17 +23,10 @@ class LeftJoinExecutor final : public JoinExecutor {
  private:
   folly::Future<Status> join();
 
-  DataSet probe(const std::vector<Expression*>& probeKeys,
-                Iterator* probeIter,
-                const std::unordered_map<List, std::vector<const Row*>>& hashTable) const;
-
-  DataSet singleKeyProbe(Expression* probeKey,
-                         Iterator* probeIter,
-                         const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const;
-
-  template <class T>
-  void buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
-                   const T& val,
+  // Join the left row with the matched right rows from `entry', or with
+  // EMPTY values if none
+  void buildNewRow(const JoinHashTable& table,
+                   uint32_t entry,
                    const Row& lRow,
                    DataSet& ds) const;
 
@@ -6,8 +6,10 @@
 #include "graph/executor/query/ProjectExecutor.h"
 
 #include "common/time/ScopedTimer.h"
+#include "graph/context/BatchEvaluator.h"
 #include "graph/context/QueryExpressionContext.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 #include "parser/Clauses.h"
 
 namespace nebula {
@@ -22,6 +24,10 @@ folly::Future<Status> ProjectExecutor::execute() {
   QueryExpressionContext ctx(ectx_);
 
   VLOG(1) << "input: " << project->inputVar();
+  if (iter->isSequentialIter()) {
+    return projectSequential(std::move(iter));
+  }
+
   DataSet ds;
   ds.colNames = project->colNames();
   ds.rows.reserve(iter->size());
@@ -37,5 +43,98 @@ folly::Future<Status> ProjectExecutor::execute() {
   return finish(ResultBuilder().value(Value(std::move(ds))).build());
 }
 
+folly::Future<Status> ProjectExecutor::projectSequential(std::unique_ptr<Iterator> input) {
+  auto* iter = static_cast<SequentialIter*>(input.get());
+  auto scatter = [this, iter](size_t begin, size_t end) { return projectRows(iter, begin, end); };
+  auto gather = [this, input = std::move(input)](std::vector<std::vector<Row>>&& partials) {
+    DataSet ds;
+    ds.colNames = asNode<Project>(node())->colNames();
+    if (partials.size() == 1) {
+      ds.rows = std::move(partials.front());
+    } else {
+      ds.rows.reserve(input->size());
+      for (auto& rows : partials) {
+        std::move(rows.begin(), rows.end(), std::back_inserter(ds.rows));
+      }
+    }
+    return finish(ResultBuilder().value(Value(std::move(ds))).build());
+  };
+  return runMultiJobs(iter->size(), std::move(scatter), std::move(gather));
+}
+
+std::vector<Row> ProjectExecutor::projectRows(const SequentialIter* iter, size_t begin, size_t end) {
+  auto columns = asNode<Project>(node())->columns()->columns();
+  std::vector<Row> rows;
+  rows.reserve(end - begin);
+
+  // Projection which only picks input columns resolves the column indices
+  // once instead of evaluating the expressions for every row
+  auto& colIndices = iter->getColIndices();
+  std::vector<size_t> colIdxs;
+  colIdxs.reserve(columns.size());
+  for (auto& col : columns) {
+    auto idx = ColumnBatch::inputColumnIndex(col->expr(), colIndices, colIndices.size());
+    if (idx < 0) {
+      break;
+    }
+    colIdxs.emplace_back(idx);
+  }
+  auto copy = iter->copy();
+  auto* jobIter = static_cast<SequentialIter*>(copy.get());
+  if (colIdxs.size() == columns.size()) {
+    for (auto it = jobIter->begin() + begin; it != jobIter->begin() + end; ++it) {
+      Row row;
+      row.values.reserve(colIdxs.size());
+      for (auto idx : colIdxs) {
+        row.values.emplace_back(it->values[idx]);
+      }
+      rows.emplace_back(std::move(row));
+    }
+    return rows;
+  }
+
+  // The expressions keep the evaluation results inside, so each job owns a
+  // copy
+  std::vector<Expression*> exprs;
+  exprs.reserve(columns.size());
+  for (auto& col : columns) {
+    exprs.emplace_back(col->expr()->clone());
+  }
+  QueryExpressionContext ctx(ectx_);
+  if (FLAGS_num_rows_per_eval_batch > 0) {
+    // Evaluate each column over a batch of rows at once
+    auto batchSize = static_cast<size_t>(FLAGS_num_rows_per_eval_batch);
+    std::vector<Column> results(exprs.size());
+    for (auto batchBegin = begin; batchBegin < end; batchBegin += batchSize) {
+      auto batchEnd = std::min(end, batchBegin + batchSize);
+      BatchEvaluator evaluator(&ctx, jobIter, batchBegin, batchEnd);
+      auto sel = evaluator.selectAll();
+      for (size_t i = 0; i < exprs.size(); ++i) {
+        results[i] = evaluator.eval(exprs[i], sel);
+      }
+      for (size_t r = 0; r < sel.size(); ++r) {
+        Row row;
+        row.values.reserve(results.size());
+        for (auto& col : results) {
+          row.values.emplace_back(col.value(r));
+        }
+        rows.emplace_back(std::move(row));
+      }
+    }
+    return rows;
+  }
+
+  for (auto i = begin; i < end; ++i) {
+    jobIter->reset(i);
+    Row row;
+    row.values.reserve(exprs.size());
+    for (auto* expr : exprs) {
+      row.values.emplace_back(expr->eval(ctx(jobIter)));
+    }
+    rows.emplace_back(std::move(row));
+  }
+  return rows;
+}
+
 }  // namespace graph
 }  // namespace nebula
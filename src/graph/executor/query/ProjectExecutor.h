@@ -6,6 +6,7 @@
 #ifndef GRAPH_EXECUTOR_QUERY_PROJECTEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_PROJECTEXECUTOR_H_
 
+#include "graph/context/Iterator.h"
 #include "graph/executor/Executor.h"
 
 namespace nebula {
@@ -17,6 +18,12 @@ class ProjectExecutor final : public Executor {
       : Executor("ProjectExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  // Project the sequential input in parallel morsels
+  folly::Future<Status> projectSequential(std::unique_ptr<Iterator> input);
+
+  std::vector<Row> projectRows(const SequentialIter *iter, size_t begin, size_t end);
 };
 
 }  // namespace graph
@@ -5,12 +5,170 @@
 
 #include "graph/executor/query/SortExecutor.h"
 
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <fstream>
+#include <numeric>
+
+#include "common/datatypes/CommonCpp2Ops.h"
+#include "common/fs/TempDir.h"
 #include "common/time/ScopedTimer.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
 
+namespace {
+
+// Merge the sorted runs of the row indices
+template <typename Comparator>
+std::vector<size_t> mergeRuns(std::vector<std::vector<size_t>> &&runs,
+                              const Comparator &comparator) {
+  if (runs.size() == 1) {
+    return std::move(runs.front());
+  }
+
+  // K-way merge with a heap of the heads of the runs, the runs are in the
+  // order of the input so the one with the smaller number wins the ties
+  using Cursor = std::pair<size_t, size_t>;  // (run, position in the run)
+  auto greater = [&runs, &comparator](const Cursor &lhs, const Cursor &rhs) {
+    auto l = runs[lhs.first][lhs.second];
+    auto r = runs[rhs.first][rhs.second];
+    if (comparator(r, l)) {
+      return true;
+    }
+    if (comparator(l, r)) {
+      return false;
+    }
+    return lhs.first > rhs.first;
+  };
+  size_t total = 0;
+  std::vector<Cursor> heap;
+  heap.reserve(runs.size());
+  for (size_t i = 0; i < runs.size(); ++i) {
+    total += runs[i].size();
+    if (!runs[i].empty()) {
+      heap.emplace_back(i, 0);
+    }
+  }
+  std::make_heap(heap.begin(), heap.end(), greater);
+
+  std::vector<size_t> merged;
+  merged.reserve(total);
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), greater);
+    auto &cursor = heap.back();
+    merged.emplace_back(runs[cursor.first][cursor.second]);
+    if (++cursor.second < runs[cursor.first].size()) {
+      std::push_heap(heap.begin(), heap.end(), greater);
+    } else {
+      heap.pop_back();
+    }
+  }
+  return merged;
+}
+
+// Reorder the rows in place so that the i-th row is the one at indices[i]
+// before, `indices' is clobbered
+void permute(std::vector<Row>::iterator rows, std::vector<size_t> *indices) {
+  // Move the rows along the cycles of the permutation, so only one row is
+  // held aside at a time. The moved positions are marked by pointing to
+  // themselves.
+  auto &perm = *indices;
+  for (size_t start = 0; start < perm.size(); ++start) {
+    if (perm[start] == start) {
+      continue;
+    }
+    auto held = std::move(rows[start]);
+    auto pos = start;
+    while (perm[pos] != start) {
+      auto from = perm[pos];
+      rows[pos] = std::move(rows[from]);
+      perm[pos] = pos;
+      pos = from;
+    }
+    rows[pos] = std::move(held);
+    perm[pos] = pos;
+  }
+}
+
+// The sorted runs spilled to the disk are merged in one pass, so their number
+// is bounded to keep the open files in check
+constexpr size_t kMaxSpilledRuns = 256;
+
+// Write the rows to a spilled run, each of which is encoded by the compact
+// protocol and prefixed by its length
+class RunWriter final {
+ public:
+  explicit RunWriter(const std::string &path)
+      : path_(path), out_(path, std::ios::binary | std::ios::trunc) {}
+
+  Status write(const Row &row) {
+    buf_.clear();
+    apache::thrift::CompactSerializer::serialize(row, &buf_);
+    uint32_t len = buf_.size();
+    out_.write(reinterpret_cast<const char *>(&len), sizeof(len));
+    out_.write(buf_.data(), buf_.size());
+    if (!out_) {
+      return Status::Error("Write the sort run `%s' failed", path_.c_str());
+    }
+    return Status::OK();
+  }
+
+  Status close() {
+    out_.close();
+    if (!out_) {
+      return Status::Error("Write the sort run `%s' failed", path_.c_str());
+    }
+    return Status::OK();
+  }
+
+ private:
+  std::string path_;
+  std::ofstream out_;
+  std::string buf_;
+};
+
+// Read back the rows of a spilled run one by one
+class RunReader final {
+ public:
+  explicit RunReader(const std::string &path) : path_(path), in_(path, std::ios::binary) {}
+
+  bool valid() const { return valid_; }
+
+  Row &row() { return row_; }
+
+  // Read the next row, the reader turns invalid at the end of the run
+  Status next() {
+    uint32_t len = 0;
+    if (!in_.read(reinterpret_cast<char *>(&len), sizeof(len))) {
+      if (in_.eof() && in_.gcount() == 0) {
+        valid_ = false;
+        return Status::OK();
+      }
+      return Status::Error("Read the sort run `%s' failed", path_.c_str());
+    }
+    buf_.resize(len);
+    if (!in_.read(&buf_[0], len)) {
+      return Status::Error("Read the sort run `%s' failed", path_.c_str());
+    }
+    row_ = Row();
+    apache::thrift::CompactSerializer::deserialize(buf_, row_);
+    valid_ = true;
+    return Status::OK();
+  }
+
+ private:
+  std::string path_;
+  std::ifstream in_;
+  std::string buf_;
+  Row row_;
+  bool valid_{false};
+};
+
+}  // namespace
+
 folly::Future<Status> SortExecutor::execute() {
   SCOPED_TIMER(&execTime_);
 
@@ -28,26 +186,153 @@ folly::Future<Status> SortExecutor::execute() {
   }
 
   auto &factors = sort->factors();
-  auto comparator = [&factors](const Row &lhs, const Row &rhs) {
-    for (auto &item : factors) {
-      auto index = item.first;
-      auto orderType = item.second;
-      if (lhs[index] == rhs[index]) {
+  auto seqIter = static_cast<SequentialIter *>(iter);
+  auto budget = qctx()->sortMemoryBudget();
+  if (budget > 0 && seqIter->size() > 1) {
+    auto bytes = MemoryTracker::estimate(result.value());
+    if (bytes > budget) {
+      // Sort the runs of the rows fitting in the budget
+      auto runSize = static_cast<size_t>(static_cast<double>(seqIter->size()) * budget / bytes);
+      NG_RETURN_IF_ERROR(externalSort(seqIter, std::max<size_t>(runSize, 1)));
+      seqIter->reset();
+      return finish(
+          ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+    }
+  }
+
+  // Compare on the columnar sort keys to avoid chasing the row pointers and
+  // dispatching on the value type for every comparison
+  std::vector<size_t> keyIdxs;
+  keyIdxs.reserve(factors.size());
+  for (auto &item : factors) {
+    keyIdxs.emplace_back(item.first);
+  }
+  auto keys = std::make_shared<ColumnBatch>(seqIter->toColumnBatch(keyIdxs));
+  auto comparator = [&factors, keys](size_t lhs, size_t rhs) {
+    for (size_t i = 0; i < factors.size(); ++i) {
+      auto cmp = keys->column(i).compare(lhs, rhs);
+      if (cmp == 0) {
         continue;
       }
 
+      auto orderType = factors[i].second;
       if (orderType == OrderFactor::OrderType::ASCEND) {
-        return lhs[index] < rhs[index];
+        return cmp < 0;
       } else if (orderType == OrderFactor::OrderType::DESCEND) {
-        return lhs[index] > rhs[index];
+        return cmp > 0;
       }
     }
     return false;
   };
 
-  auto seqIter = static_cast<SequentialIter *>(iter);
-  std::sort(seqIter->begin(), seqIter->end(), comparator);
-  return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+  // Sort the runs of the rows in parallel, then merge them
+  auto scatter = [comparator](size_t begin, size_t end) {
+    std::vector<size_t> run(end - begin);
+    std::iota(run.begin(), run.end(), begin);
+    std::sort(run.begin(), run.end(), comparator);
+    return run;
+  };
+  auto gather = [this, comparator, seqIter, result = std::move(result)](
+                    std::vector<std::vector<size_t>> &&runs) mutable {
+    auto indices = mergeRuns(std::move(runs), comparator);
+    permute(seqIter->begin(), &indices);
+    seqIter->reset();
+    return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
+  };
+  return runMultiJobs(seqIter->size(), std::move(scatter), std::move(gather));
+}
+
+Status SortExecutor::externalSort(SequentialIter *seqIter, size_t runSize) {
+  auto &factors = asNode<Sort>(node())->factors();
+  auto less = [&factors](const Row &lhs, const Row &rhs) {
+    for (auto &item : factors) {
+      auto &l = lhs[item.first];
+      auto &r = rhs[item.first];
+      if (l == r) {
+        continue;
+      }
+      if (item.second == OrderFactor::OrderType::ASCEND) {
+        return l < r;
+      } else if (item.second == OrderFactor::OrderType::DESCEND) {
+        return l > r;
+      }
+    }
+    return false;
+  };
+
+  fs::TempDir dir(FLAGS_sort_spill_dir.c_str(), "nebula_sort.XXXXXX");
+  if (dir.path() == nullptr || *dir.path() == '\0') {
+    return Status::Error("Create the sort spill directory in `%s' failed",
+                         FLAGS_sort_spill_dir.c_str());
+  }
+
+  // The runs grow past the budget if the input is too big to be sorted in
+  // kMaxSpilledRuns runs under it
+  auto size = seqIter->size();
+  runSize = std::max(runSize, (size + kMaxSpilledRuns - 1) / kMaxSpilledRuns);
+  auto rows = seqIter->begin();
+  std::vector<std::string> paths;
+  for (size_t begin = 0; begin < size; begin += runSize) {
+    auto end = std::min(begin + runSize, size);
+    std::vector<size_t> indices(end - begin);
+    std::iota(indices.begin(), indices.end(), begin);
+    std::stable_sort(indices.begin(), indices.end(), [&rows, &less](size_t lhs, size_t rhs) {
+      return less(rows[lhs], rows[rhs]);
+    });
+
+    paths.emplace_back(fs::FileUtils::joinPath(dir.path(), std::to_string(paths.size())));
+    RunWriter writer(paths.back());
+    for (auto i : indices) {
+      NG_RETURN_IF_ERROR(writer.write(rows[i]));
+    }
+    NG_RETURN_IF_ERROR(writer.close());
+    // Free the spilled rows
+    for (auto i = begin; i < end; ++i) {
+      rows[i] = Row();
+    }
+  }
+
+  // K-way merge the runs back into the rows, the run with the smaller number
+  // wins the ties to keep the sort stable
+  std::vector<RunReader> readers;
+  readers.reserve(paths.size());
+  std::vector<size_t> heap;
+  for (auto &path : paths) {
+    readers.emplace_back(path);
+    NG_RETURN_IF_ERROR(readers.back().next());
+    if (readers.back().valid()) {
+      heap.emplace_back(readers.size() - 1);
+    }
+  }
+  auto greater = [&readers, &less](size_t lhs, size_t rhs) {
+    if (less(readers[rhs].row(), readers[lhs].row())) {
+      return true;
+    }
+    if (less(readers[lhs].row(), readers[rhs].row())) {
+      return false;
+    }
+    return lhs > rhs;
+  };
+  std::make_heap(heap.begin(), heap.end(), greater);
+  size_t merged = 0;
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), greater);
+    auto &reader = readers[heap.back()];
+    if (merged >= size) {
+      return Status::Error("Internal error: more rows are merged than sorted");
+    }
+    rows[merged++] = std::move(reader.row());
+    NG_RETURN_IF_ERROR(reader.next());
+    if (reader.valid()) {
+      std::push_heap(heap.begin(), heap.end(), greater);
+    } else {
+      heap.pop_back();
+    }
+  }
+  if (merged != size) {
+    return Status::Error("Internal error: %zu rows are merged out of %zu", merged, size);
+  }
+  return Status::OK();
 }
 
 }  // namespace graph
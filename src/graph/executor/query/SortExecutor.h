@@ -16,6 +16,11 @@ class SortExecutor final : public Executor {
   SortExecutor(const PlanNode *node, QueryContext *qctx) : Executor("SortExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  // Sort the rows by runs of `runSize' rows spilled to --sort_spill_dir, and
+  // merge the runs back in place
+  Status externalSort(SequentialIter *seqIter, size_t runSize);
 };
 
 }  // namespace graph
@@ -5,6 +5,8 @@
 
 #include "graph/executor/query/TopNExecutor.h"
 
+#include <numeric>
+
 #include "common/time/ScopedTimer.h"
 #include "graph/planner/plan/Query.h"
 
@@ -27,18 +29,26 @@ folly::Future<Status> TopNExecutor::execute() {
   }
 
   auto &factors = topn->factors();
-  comparator_ = [&factors](const Row &lhs, const Row &rhs) {
-    for (auto &item : factors) {
-      auto index = item.first;
-      auto orderType = item.second;
-      if (lhs[index] == rhs[index]) {
+  // Compare on the columnar sort keys, and pick the row indices instead of
+  // copying the rows around
+  std::vector<size_t> keyIdxs;
+  keyIdxs.reserve(factors.size());
+  for (auto &item : factors) {
+    keyIdxs.emplace_back(item.first);
+  }
+  keys_ = static_cast<SequentialIter *>(iter)->toColumnBatch(keyIdxs);
+  comparator_ = [&factors, this](size_t lhs, size_t rhs) {
+    for (size_t i = 0; i < factors.size(); ++i) {
+      auto cmp = keys_.column(i).compare(lhs, rhs);
+      if (cmp == 0) {
         continue;
       }
 
+      auto orderType = factors[i].second;
       if (orderType == OrderFactor::OrderType::ASCEND) {
-        return lhs[index] < rhs[index];
+        return cmp < 0;
       } else if (orderType == OrderFactor::OrderType::DESCEND) {
-        return lhs[index] > rhs[index];
+        return cmp > 0;
       }
     }
     return false;
@@ -70,24 +80,42 @@ folly::Future<Status> TopNExecutor::execute() {
 template <typename U>
 void TopNExecutor::executeTopN(Iterator *iter) {
   auto uIter = static_cast<U *>(iter);
-  std::vector<Row> heap(uIter->begin(), uIter->begin() + heapSize_);
-  std::make_heap(heap.begin(), heap.end(), comparator_);
-  auto it = uIter->begin() + heapSize_;
-  while (it != uIter->end()) {
-    if (comparator_(*it, heap[0])) {
-      std::pop_heap(heap.begin(), heap.end(), comparator_);
-      heap.pop_back();
-      heap.push_back(*it);
-      std::push_heap(heap.begin(), heap.end(), comparator_);
+  auto size = uIter->size();
+  std::vector<size_t> indices;
+  if (static_cast<size_t>(heapSize_) * kMaxHeapRatio < size) {
+    // Keep the first heapSize_ rows in a bounded heap
+    indices.resize(heapSize_);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::make_heap(indices.begin(), indices.end(), comparator_);
+    for (size_t i = heapSize_; i < size; ++i) {
+      if (comparator_(i, indices[0])) {
+        std::pop_heap(indices.begin(), indices.end(), comparator_);
+        indices.back() = i;
+        std::push_heap(indices.begin(), indices.end(), comparator_);
+      }
+    }
+    std::sort_heap(indices.begin(), indices.end(), comparator_);
+  } else {
+    // The heap would hold a large part of the rows when the offset is big,
+    // select the rows after the offset instead, so the skipped rows are
+    // never sorted
+    indices.resize(size);
+    std::iota(indices.begin(), indices.end(), 0);
+    auto first = indices.begin() + offset_;
+    if (offset_ > 0) {
+      std::nth_element(indices.begin(), first, indices.end(), comparator_);
     }
-    ++it;
+    std::partial_sort(first, first + maxCount_, indices.end(), comparator_);
   }
-  std::sort_heap(heap.begin(), heap.end(), comparator_);
 
   auto beg = uIter->begin();
-  for (int i = 0; i < maxCount_; ++i) {
-    beg[i] = heap[offset_ + i];
+  std::vector<Row> rows;
+  rows.reserve(maxCount_);
+  for (int64_t i = 0; i < maxCount_; ++i) {
+    rows.emplace_back(std::move(beg[indices[offset_ + i]]));
   }
+  std::move(rows.begin(), rows.end(), beg);
+  keys_ = ColumnBatch();
 }
 
 }  // namespace graph
@@ -6,6 +6,7 @@
 #ifndef GRAPH_EXECUTOR_QUERY_TOPNEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_TOPNEXECUTOR_H_
 
+#include "graph/context/ColumnBatch.h"
 #include "graph/executor/Executor.h"
 
 namespace nebula {
@@ -21,10 +22,16 @@ class TopNExecutor final : public Executor {
   template <typename U>
   void executeTopN(Iterator *iter);
 
+  // Use the bounded heap only if it holds less than 1/kMaxHeapRatio of the
+  // rows
+  static constexpr size_t kMaxHeapRatio = 4;
+
   int64_t offset_;
   int64_t maxCount_;
   int64_t heapSize_;
-  std::function<bool(const Row &, const Row &)> comparator_;
+  // The sort keys of the input rows
+  ColumnBatch keys_;
+  std::function<bool(size_t, size_t)> comparator_;
 };
 
 }  // namespace graph
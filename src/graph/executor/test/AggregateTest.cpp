@@ -8,6 +8,7 @@
 #include "graph/context/QueryContext.h"
 #include "graph/executor/query/AggregateExecutor.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -2177,5 +2178,47 @@ TEST_F(AggregateTest, BitXor) {
     TEST_AGG_4("BIT_XOR", "bit_xor", true)
   }
 }
+
+TEST_F(AggregateTest, Parallel) {
+  DataSet ds;
+  ds.colNames = {"key", "val"};
+  for (auto i = 0; i < 1000; ++i) {
+    Row row;
+    row.values.emplace_back(i % 37 == 0 ? Value::kNullValue : Value(i % 37));
+    row.values.emplace_back(i);
+    ds.rows.emplace_back(std::move(row));
+  }
+  auto aggregate = [&ds]() {
+    auto qctx = std::make_unique<QueryContext>();
+    auto* pool = qctx->objPool();
+    qctx->symTable()->newVariable("input_parallel");
+    qctx->ectx()->setResult("input_parallel", ResultBuilder().value(Value(ds)).build());
+    std::vector<Expression*> groupKeys = {InputPropertyExpression::make(pool, "key")};
+    std::vector<Expression*> groupItems = {
+        AggregateExpression::make(pool, "", InputPropertyExpression::make(pool, "key"), false),
+        AggregateExpression::make(pool, "COLLECT", InputPropertyExpression::make(pool, "val"), false),
+        AggregateExpression::make(pool, "SUM", InputPropertyExpression::make(pool, "val"), false),
+        AggregateExpression::make(pool, "AVG", InputPropertyExpression::make(pool, "val"), true)};
+    auto* agg = Aggregate::make(qctx.get(), nullptr, std::move(groupKeys), std::move(groupItems));
+    agg->setInputVar("input_parallel");
+    agg->setColNames({"key", "collect", "sum", "avg"});
+    auto aggExe = std::make_unique<AggregateExecutor>(agg, qctx.get());
+    EXPECT_TRUE(aggExe->execute().get().ok());
+    DataSet result = qctx->ectx()->getResult(agg->outputVar()).value().getDataSet();
+    std::sort(result.rows.begin(), result.rows.end(), RowCmp());
+    return result;
+  };
+
+  auto expected = aggregate();
+  EXPECT_EQ(expected.rowSize(), 37);
+  auto maxJobSize = FLAGS_max_job_size;
+  auto minBatchSize = FLAGS_min_batch_size;
+  FLAGS_max_job_size = 4;
+  FLAGS_min_batch_size = 100;
+  EXPECT_EQ(aggregate(), expected);
+  FLAGS_max_job_size = maxJobSize;
+  FLAGS_min_batch_size = minBatchSize;
+}
+
 }  // namespace graph
 }  // namespace nebula
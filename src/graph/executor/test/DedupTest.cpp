@@ -9,6 +9,7 @@
 #include "graph/executor/query/ProjectExecutor.h"
 #include "graph/executor/test/QueryTestBase.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -73,5 +74,37 @@ TEST_F(DedupTest, WrongTypeIterator) {
   DEDUP_RESUTL_CHECK(
       "input_neighbor", "dedup_sequential", "YIELD DISTINCT $-.v_dst as name", expected);
 }
+
+TEST_F(DedupTest, Parallel) {
+  auto maxJobSize = FLAGS_max_job_size;
+  auto minBatchSize = FLAGS_min_batch_size;
+  FLAGS_max_job_size = 4;
+  FLAGS_min_batch_size = 100;
+  auto qctx = std::make_unique<QueryContext>();
+  DataSet ds({"col"});
+  for (auto i = 0; i < 1000; ++i) {
+    ds.emplace_back(Row({i % 50}));
+  }
+  qctx->symTable()->newVariable("input_parallel");
+  qctx->ectx()->setResult("input_parallel", ResultBuilder().value(Value(std::move(ds))).build());
+  auto* dedupNode = Dedup::make(qctx.get(), nullptr);
+  dedupNode->setInputVar("input_parallel");
+  auto dedupExec = std::make_unique<DedupExecutor>(dedupNode, qctx.get());
+  EXPECT_TRUE(dedupExec->execute().get().ok());
+
+  // The first ones of the same rows are kept in order
+  DataSet expected({"col"});
+  for (auto i = 0; i < 50; ++i) {
+    expected.emplace_back(Row({i}));
+  }
+  auto iter = qctx->ectx()->getResult(dedupNode->outputVar()).iter();
+  DataSet result({"col"});
+  for (; iter->valid(); iter->next()) {
+    result.emplace_back(*iter->row());
+  }
+  EXPECT_EQ(result, expected);
+  FLAGS_max_job_size = maxJobSize;
+  FLAGS_min_batch_size = minBatchSize;
+}
 }  // namespace graph
 }  // namespace nebula
@@ -84,5 +84,37 @@ TEST_F(FilterTest, TestEmpty) {
                       "YIELD $^.person.name AS name WHERE study.start_year >= 2010",
                       expected);
 }
+
+TEST_F(FilterTest, TestRerun) {
+  auto* yieldSentence = getYieldSentence(
+      "YIELD $-.e_start_year + 1 AS year WHERE $-.e_start_year >= 2010", qctx_.get());
+  auto* filterNode = Filter::make(qctx_.get(), nullptr, yieldSentence->where()->filter());
+  filterNode->setInputVar("input_sequential");
+  auto* project = Project::make(qctx_.get(), filterNode, yieldSentence->yieldColumns());
+  project->setInputVar(filterNode->outputVar());
+  project->setColNames(std::vector<std::string>{"year"});
+
+  // Run the plan as a cached one does, the expressions cloned by the
+  // executors in each run are released before the next one
+  auto values = qctx_->ectx()->clone();
+  qctx_->pinPlan();
+  auto planObjects = qctx_->objPool()->size();
+  DataSet expected({"year"});
+  expected.emplace_back(Row({2011}));
+  expected.emplace_back(Row({2011}));
+  for (auto i = 0; i < 3; ++i) {
+    {
+      auto filterExec = std::make_unique<FilterExecutor>(filterNode, qctx_.get());
+      ASSERT_TRUE(filterExec->execute().get().ok());
+      auto proExe = std::make_unique<ProjectExecutor>(project, qctx_.get());
+      ASSERT_TRUE(proExe->execute().get().ok());
+      auto& proResult = qctx_->ectx()->getResult(project->outputVar());
+      EXPECT_EQ(proResult.value().getDataSet(), expected);
+      EXPECT_GT(qctx_->objPool()->size(), planObjects);
+    }
+    qctx_->reset(nullptr, values->clone());
+    EXPECT_EQ(planObjects, qctx_->objPool()->size());
+  }
+}
 }  // namespace graph
 }  // namespace nebula
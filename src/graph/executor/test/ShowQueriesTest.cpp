@@ -28,6 +28,7 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
     desc.set_start_time(123);
     desc.set_status(meta::cpp2::QueryStatus::RUNNING);
     desc.set_duration(100);
+    desc.set_memory(1024);
     desc.set_query("");
     desc.set_graph_addr(HostAddr("127.0.0.1", 9669));
 
@@ -38,6 +39,7 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
     desc.set_start_time(123);
     desc.set_status(meta::cpp2::QueryStatus::RUNNING);
     desc.set_duration(200);
+    desc.set_memory(2048);
     desc.set_query("");
     desc.set_graph_addr(HostAddr("127.0.0.1", 9669));
 
@@ -50,6 +52,7 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
                    "Host",
                    "StartTime",
                    "DurationInUSec",
+                   "MemoryInBytes",
                    "Status",
                    "Query"});
   DataSet expected = dataSet;
@@ -63,6 +66,7 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
     dateTime.microsec = 123;
     row.emplace_back(std::move(dateTime));
     row.emplace_back(100);
+    row.emplace_back(1024);
     row.emplace_back("RUNNING");
     row.emplace_back("");
     expected.rows.emplace_back(std::move(row));
@@ -77,6 +81,7 @@ TEST_F(ShowQueriesTest, TestAddQueryAndTopN) {
     dateTime.microsec = 123;
     row.emplace_back(std::move(dateTime));
     row.emplace_back(200);
+    row.emplace_back(2048);
     row.emplace_back("RUNNING");
     row.emplace_back("");
     expected.rows.emplace_back(std::move(row));
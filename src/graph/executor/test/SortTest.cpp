@@ -11,6 +11,7 @@
 #include "graph/executor/test/QueryTestBase.h"
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -130,5 +131,84 @@ TEST_F(SortTest, sortTwoColDesDes_union) {
   factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::DESCEND));
   SORT_RESUTL_CHECK("union_sequential", "union_sort_two_cols_des_des", true, factors, expected);
 }
+
+TEST_F(SortTest, Parallel) {
+  DataSet ds({"key", "val"});
+  for (auto i = 0; i < 1000; ++i) {
+    Row row;
+    row.values.emplace_back(i % 41 == 0 ? Value::kNullValue : Value(i * 7919 % 113));
+    row.values.emplace_back(i);
+    ds.rows.emplace_back(std::move(row));
+  }
+  auto sort = [&ds]() {
+    auto qctx = std::make_unique<QueryContext>();
+    qctx->symTable()->newVariable("input_parallel");
+    qctx->ectx()->setResult("input_parallel", ResultBuilder().value(Value(ds)).build());
+    std::vector<std::pair<size_t, OrderFactor::OrderType>> factors = {
+        {0, OrderFactor::OrderType::DESCEND}, {1, OrderFactor::OrderType::ASCEND}};
+    auto* sortNode = Sort::make(qctx.get(), nullptr, factors);
+    sortNode->setInputVar("input_parallel");
+    auto sortExec = std::make_unique<SortExecutor>(sortNode, qctx.get());
+    EXPECT_TRUE(sortExec->execute().get().ok());
+    return qctx->ectx()->getResult(sortNode->outputVar()).value().getDataSet();
+  };
+
+  auto expected = sort();
+  ASSERT_EQ(expected.rowSize(), 1000);
+  EXPECT_TRUE(expected.rows.front()[0].isNull());
+  auto maxJobSize = FLAGS_max_job_size;
+  auto minBatchSize = FLAGS_min_batch_size;
+  FLAGS_max_job_size = 4;
+  FLAGS_min_batch_size = 100;
+  EXPECT_EQ(sort(), expected);
+  FLAGS_max_job_size = maxJobSize;
+  FLAGS_min_batch_size = minBatchSize;
+}
+
+TEST_F(SortTest, Spill) {
+  DataSet ds({"key", "val"});
+  for (auto i = 0; i < 1000; ++i) {
+    Row row;
+    row.values.emplace_back(i % 41 == 0 ? Value::kNullValue : Value(i * 7919 % 113));
+    row.values.emplace_back(folly::stringPrintf("%d", i));
+    ds.rows.emplace_back(std::move(row));
+  }
+  auto sort = [&ds](int64_t budget) {
+    auto qctx = std::make_unique<QueryContext>();
+    qctx->setSortMemoryBudget(budget);
+    qctx->symTable()->newVariable("input_spill");
+    qctx->ectx()->setResult("input_spill", ResultBuilder().value(Value(ds)).build());
+    std::vector<std::pair<size_t, OrderFactor::OrderType>> factors = {
+        {0, OrderFactor::OrderType::ASCEND}, {1, OrderFactor::OrderType::DESCEND}};
+    auto* sortNode = Sort::make(qctx.get(), nullptr, factors);
+    sortNode->setInputVar("input_spill");
+    auto sortExec = std::make_unique<SortExecutor>(sortNode, qctx.get());
+    auto status = sortExec->execute().get();
+    EXPECT_TRUE(status.ok()) << status;
+    return qctx->ectx()->getResult(sortNode->outputVar()).value().getDataSet();
+  };
+
+  auto expected = sort(0);
+  ASSERT_EQ(expected.rowSize(), 1000);
+  EXPECT_TRUE(expected.rows.back()[0].isNull());
+  // Spilled in the most runs allowed, and in a few big runs
+  EXPECT_EQ(sort(1), expected);
+  EXPECT_EQ(sort(MemoryTracker::estimate(Value(ds)) / 3), expected);
+}
+
+TEST_F(SortTest, SpillDirMissing) {
+  auto spillDir = FLAGS_sort_spill_dir;
+  FLAGS_sort_spill_dir = "/path/not/existing";
+  qctx_->setSortMemoryBudget(1);
+  std::vector<std::pair<size_t, OrderFactor::OrderType>> factors = {
+      {0, OrderFactor::OrderType::ASCEND}};
+  auto* sortNode = Sort::make(qctx_.get(), nullptr, factors);
+  sortNode->setInputVar("input_sequential");
+  auto sortExec = std::make_unique<SortExecutor>(sortNode, qctx_.get());
+  EXPECT_FALSE(sortExec->execute().get().ok());
+  qctx_->setSortMemoryBudget(0);
+  FLAGS_sort_spill_dir = spillDir;
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -112,5 +112,29 @@ TEST_F(TopNTest, topnTwoColDesAsc) {
   factors.emplace_back(std::make_pair(4, OrderFactor::OrderType::ASCEND));
   TOPN_RESUTL_CHECK("input_sequential", "topn_two_cols_des_asc", true, factors, 1, 9, expected);
 }
+
+TEST_F(TopNTest, BigOffset) {
+  DataSet ds({"key"});
+  for (auto i = 0; i < 100; ++i) {
+    ds.rows.emplace_back(Row({i * 37 % 100}));
+  }
+  qctx_->symTable()->newVariable("input_big_offset");
+  qctx_->ectx()->setResult("input_big_offset", ResultBuilder().value(Value(ds)).build());
+  std::vector<std::pair<size_t, OrderFactor::OrderType>> factors = {
+      {0, OrderFactor::OrderType::ASCEND}};
+  // The bounded heap and the selection
+  for (auto offset : {2, 80}) {
+    auto* topnNode = TopN::make(qctx_.get(), nullptr, factors, offset, 10);
+    topnNode->setInputVar("input_big_offset");
+    auto topnExec = Executor::create(topnNode, qctx_.get());
+    EXPECT_TRUE(topnExec->execute().get().ok());
+    DataSet expected({"key"});
+    for (auto i = offset; i < std::min(offset + 10, 100); ++i) {
+      expected.rows.emplace_back(Row({i}));
+    }
+    EXPECT_EQ(qctx_->ectx()->getResult(topnNode->outputVar()).value().getDataSet(), expected);
+  }
+}
+
 }  // namespace graph
 }  // namespace nebula
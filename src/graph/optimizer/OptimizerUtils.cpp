@@ -947,6 +947,9 @@ void OptimizerUtils::copyIndexScanData(const nebula::graph::IndexScan* from,
   to->setOrderBy(from->orderBy());
   to->setLimit(from->limit());
   to->setFilter(from->filter() == nullptr ? nullptr : from->filter()->clone());
+  if (from->statProps() != nullptr) {
+    to->setStatProps(std::make_unique<std::vector<storage::cpp2::StatProp>>(*from->statProps()));
+  }
 }
 
 }  // namespace graph
@@ -0,0 +1,254 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushAggregateDownIndexScanRule.h"
+
+#include <thrift/lib/cpp/util/EnumUtils.h>
+
+#include <limits>
+#include <optional>
+
+#include "common/expression/AggregateExpression.h"
+#include "common/expression/ColumnExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+
+using nebula::graph::Aggregate;
+using nebula::graph::IndexScan;
+using nebula::graph::PlanNode;
+using nebula::graph::Project;
+using nebula::storage::cpp2::StatProp;
+using nebula::storage::cpp2::StatType;
+
+using Kind = nebula::graph::PlanNode::Kind;
+
+namespace nebula {
+namespace opt {
+
+namespace {
+
+// The aggregate to be pushed down, with the storage columns of the group keys and the stats
+struct PushedAggregate {
+  std::vector<std::string> groupColumns;
+  std::vector<StatProp> stats;
+  // The index of the group key or the stat of each group item
+  std::vector<std::pair<bool, size_t>> items;
+};
+
+// Get the storage column of a column of the project on the index scan, or empty if it's not a
+// column returned by the index scan
+std::string storageColumn(const IndexScan *scan, const Expression *expr) {
+  const auto &returnCols = scan->returnColumns();
+  const auto &colNames = scan->colNames();
+  switch (expr->kind()) {
+    case Expression::Kind::kColumn: {
+      auto index = static_cast<const ColumnExpression *>(expr)->index();
+      if (index >= 0 && static_cast<size_t>(index) < returnCols.size()) {
+        return returnCols[index];
+      }
+      return "";
+    }
+    case Expression::Kind::kTagProperty:
+    case Expression::Kind::kEdgeProperty: {
+      auto propExpr = static_cast<const PropertyExpression *>(expr);
+      auto colName = propExpr->sym() + "." + propExpr->prop();
+      auto found = std::find(colNames.begin(), colNames.end(), colName);
+      if (found != colNames.end() && colNames.size() == returnCols.size()) {
+        return returnCols[found - colNames.begin()];
+      }
+      return "";
+    }
+    default:
+      return "";
+  }
+}
+
+// Get the storage column of a `$-.col' on the project, or empty
+std::string inputColumn(const Project *project, const IndexScan *scan, const Expression *expr) {
+  if (expr->kind() != Expression::Kind::kInputProperty) {
+    return "";
+  }
+  const auto &name = static_cast<const InputPropertyExpression *>(expr)->prop();
+  const auto &colNames = project->colNames();
+  auto found = std::find(colNames.begin(), colNames.end(), name);
+  if (found == colNames.end()) {
+    return "";
+  }
+  auto *column = project->columns()->columns()[found - colNames.begin()];
+  return storageColumn(scan, column->expr());
+}
+
+std::optional<PushedAggregate> pushedAggregate(const Aggregate *agg,
+                                               const Project *project,
+                                               const IndexScan *scan) {
+  PushedAggregate pushed;
+  const auto &groupKeys = agg->groupKeys();
+  for (auto *key : groupKeys) {
+    auto col = inputColumn(project, scan, key);
+    if (col.empty()) {
+      return std::nullopt;
+    }
+    pushed.groupColumns.emplace_back(std::move(col));
+  }
+  for (auto *item : agg->groupItems()) {
+    auto key = std::find_if(
+        groupKeys.begin(), groupKeys.end(), [item](auto *k) { return *k == *item; });
+    if (key != groupKeys.end()) {
+      pushed.items.emplace_back(true, key - groupKeys.begin());
+      continue;
+    }
+    if (item->kind() != Expression::Kind::kAggregate) {
+      return std::nullopt;
+    }
+    auto *aggExpr = static_cast<AggregateExpression *>(item);
+    if (aggExpr->distinct()) {
+      return std::nullopt;
+    }
+    auto name = aggExpr->name();
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+    StatProp stat;
+    if (name == "COUNT") {
+      stat.set_stat(StatType::COUNT);
+    } else if (name == "SUM") {
+      stat.set_stat(StatType::SUM);
+    } else if (name == "MIN") {
+      stat.set_stat(StatType::MIN);
+    } else if (name == "MAX") {
+      stat.set_stat(StatType::MAX);
+    } else {
+      return std::nullopt;
+    }
+    auto *arg = aggExpr->arg();
+    if (name == "COUNT" && arg->kind() == Expression::Kind::kConstant &&
+        static_cast<const ConstantExpression *>(arg)->value() == Value("*")) {
+      stat.set_prop("");
+    } else {
+      auto col = inputColumn(project, scan, arg);
+      if (col.empty()) {
+        return std::nullopt;
+      }
+      stat.set_prop(std::move(col));
+    }
+    stat.set_alias("__stat_" + folly::to<std::string>(pushed.stats.size()));
+    pushed.items.emplace_back(false, pushed.stats.size());
+    pushed.stats.emplace_back(std::move(stat));
+  }
+  return pushed;
+}
+
+std::string groupColumnName(size_t index) { return "__group_" + folly::to<std::string>(index); }
+
+}  // namespace
+
+std::vector<std::unique_ptr<OptRule>> PushAggregateDownIndexScanRule::kInstances = [] {
+  std::vector<std::unique_ptr<OptRule>> instances;
+  for (auto kind : {Kind::kTagIndexFullScan,
+                    Kind::kTagIndexPrefixScan,
+                    Kind::kTagIndexRangeScan,
+                    Kind::kEdgeIndexFullScan,
+                    Kind::kEdgeIndexPrefixScan,
+                    Kind::kEdgeIndexRangeScan}) {
+    instances.emplace_back(new PushAggregateDownIndexScanRule(kind));
+  }
+  return instances;
+}();
+
+PushAggregateDownIndexScanRule::PushAggregateDownIndexScanRule(PlanNode::Kind scanKind)
+    : scanKind_(scanKind),
+      pattern_(Pattern::create(Kind::kAggregate,
+                               {Pattern::create(Kind::kProject, {Pattern::create(scanKind)})})) {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushAggregateDownIndexScanRule::pattern() const { return pattern_; }
+
+bool PushAggregateDownIndexScanRule::match(OptContext *ctx, const MatchedResult &matched) const {
+  if (!OptRule::match(ctx, matched)) {
+    return false;
+  }
+  auto agg = static_cast<const Aggregate *>(matched.planNode());
+  auto project = static_cast<const Project *>(matched.planNode({0, 0}));
+  auto scan = static_cast<const IndexScan *>(matched.planNode({0, 0, 0}));
+  // The rows of the scan are limited, or the aggregate is pushed down already
+  if (scan->isEmptyResultSet() || scan->statProps() != nullptr || scan->dedup() ||
+      (scan->limit() >= 0 && scan->limit() != std::numeric_limits<int64_t>::max())) {
+    return false;
+  }
+  return pushedAggregate(agg, project, scan).has_value();
+}
+
+StatusOr<OptRule::TransformResult> PushAggregateDownIndexScanRule::transform(
+    OptContext *ctx, const MatchedResult &matched) const {
+  auto aggGroupNode = matched.node;
+  auto scanGroupNode = matched.dependencies.front().dependencies.front().node;
+  auto agg = static_cast<const Aggregate *>(aggGroupNode->node());
+  auto project = static_cast<const Project *>(matched.planNode({0, 0}));
+  auto scan = static_cast<const IndexScan *>(scanGroupNode->node());
+  auto pushed = pushedAggregate(agg, project, scan);
+  if (!pushed.has_value()) {
+    return TransformResult::noTransform();
+  }
+  auto qctx = ctx->qctx();
+  auto pool = qctx->objPool();
+
+  // The scan returns a row of the group columns and the stats for each group of each part
+  auto newScan = static_cast<IndexScan *>(scan->clone());
+  std::vector<std::string> colNames;
+  for (size_t i = 0; i < pushed->groupColumns.size(); ++i) {
+    colNames.emplace_back(groupColumnName(i));
+  }
+  for (auto &stat : pushed->stats) {
+    colNames.emplace_back(stat.get_alias());
+  }
+  newScan->setReturnCols(std::move(pushed->groupColumns));
+  newScan->setStatProps(std::make_unique<std::vector<StatProp>>(std::move(pushed->stats)));
+  newScan->setColNames(std::move(colNames));
+  auto newScanGroup = OptGroup::create(ctx);
+  auto newScanGroupNode = newScanGroup->makeGroupNode(newScan);
+  for (auto dep : scanGroupNode->dependencies()) {
+    newScanGroupNode->dependsOn(dep);
+  }
+
+  // Merge the partial aggregates of the parts
+  std::vector<Expression *> groupKeys;
+  for (size_t i = 0; i < agg->groupKeys().size(); ++i) {
+    groupKeys.emplace_back(InputPropertyExpression::make(pool, groupColumnName(i)));
+  }
+  std::vector<Expression *> groupItems;
+  const auto &stats = *newScan->statProps();
+  for (auto &item : pushed->items) {
+    if (item.first) {
+      groupItems.emplace_back(InputPropertyExpression::make(pool, groupColumnName(item.second)));
+      continue;
+    }
+    auto &stat = stats[item.second];
+    auto arg = InputPropertyExpression::make(pool, stat.get_alias());
+    auto func = stat.get_stat() == StatType::COUNT
+                    ? std::string("SUM")
+                    : apache::thrift::util::enumNameSafe(stat.get_stat());
+    groupItems.emplace_back(AggregateExpression::make(pool, func, arg, false));
+  }
+  auto newAgg = Aggregate::make(qctx, newScan, std::move(groupKeys), std::move(groupItems));
+  newAgg->setOutputVar(agg->outputVar());
+  newAgg->setColNames(agg->colNames());
+  auto newAggGroupNode = OptGroupNode::create(ctx, newAgg, aggGroupNode->group());
+  newAggGroupNode->dependsOn(newScanGroup);
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newAggGroupNode);
+  return result;
+}
+
+std::string PushAggregateDownIndexScanRule::toString() const {
+  return folly::stringPrintf("PushAggregateDown%sRule", PlanNode::toString(scanKind_));
+}
+
+}  // namespace opt
+}  // namespace nebula
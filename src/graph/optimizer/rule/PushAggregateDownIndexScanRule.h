@@ -0,0 +1,46 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_PUSHAGGREGATEDOWNINDEXSCANRULE_H_
+#define GRAPH_OPTIMIZER_RULE_PUSHAGGREGATEDOWNINDEXSCANRULE_H_
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Push the aggregate of a LOOKUP down to the storage, e.g.
+//    LOOKUP ON t WHERE t.c > 1 YIELD t.c AS c | GROUP BY $-.c YIELD $-.c, count(*)
+//  Before:
+//    Aggregate(group by $-.c, count(*)) -> Project(t.c AS c) -> TagIndexRangeScan
+//  After:
+//    Aggregate(group by $-.__group_0, sum($-.__stat_0)) -> TagIndexRangeScan(count(*) by c)
+//  The storage returns the partial aggregates of each part instead of all the rows, which are
+//  merged by the graph: the COUNTs are summed, the SUMs, MINs and MAXs are merged by themselves.
+//  Only the COUNT, SUM, MIN and MAX which are not DISTINCT are pushed down, and the group keys
+//  and the arguments must be the columns returned by the index scan.
+class PushAggregateDownIndexScanRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  bool match(OptContext *ctx, const MatchedResult &matched) const override;
+  StatusOr<TransformResult> transform(OptContext *ctx, const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  explicit PushAggregateDownIndexScanRule(graph::PlanNode::Kind scanKind);
+
+  const graph::PlanNode::Kind scanKind_;
+  const Pattern pattern_;
+
+  // One for each kind of the index scans
+  static std::vector<std::unique_ptr<OptRule>> kInstances;
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_RULE_PUSHAGGREGATEDOWNINDEXSCANRULE_H_
@@ -247,5 +247,15 @@ StatusOr<SubPlan> LabelIndexSeek::transformEdge(EdgeContext* edgeCtx) {
   return indexIds;
 }
 
+folly::Optional<double> LabelIndexSeek::estimateNode(NodeContext* nodeCtx,
+                                                     const MatchCostModel& model) {
+  return model.tagVertices(nodeCtx->scanInfo.schemaNames.back());
+}
+
+folly::Optional<double> LabelIndexSeek::estimateEdge(EdgeContext* edgeCtx,
+                                                     const MatchCostModel& model) {
+  return model.edges(edgeCtx->scanInfo.schemaNames.back());
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -32,6 +32,10 @@ class LabelIndexSeek final : public StartVidFinder {
 
   StatusOr<SubPlan> transformEdge(EdgeContext* edgeCtx) override;
 
+  folly::Optional<double> estimateNode(NodeContext* nodeCtx, const MatchCostModel& model) override;
+
+  folly::Optional<double> estimateEdge(EdgeContext* edgeCtx, const MatchCostModel& model) override;
+
   static StatusOr<std::vector<IndexID>> pickTagIndex(const NodeContext* nodeCtx);
 
   static StatusOr<std::vector<IndexID>> pickEdgeIndex(const EdgeContext* edgeCtx);
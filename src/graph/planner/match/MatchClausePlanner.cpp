@@ -12,6 +12,7 @@
 #include "graph/planner/match/StartVidFinder.h"
 #include "graph/planner/match/WhereClausePlanner.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
 #include "graph/util/ExpressionUtils.h"
 #include "graph/visitor/RewriteVisitor.h"
 
@@ -44,6 +45,20 @@ Status MatchClausePlanner::findStarts(MatchClauseContext* matchClauseCtx,
                                       bool& startFromEdge,
                                       size_t& startIndex,
                                       SubPlan& matchClausePlan) {
+  if (FLAGS_enable_match_cost_model) {
+    auto* metaClient = matchClauseCtx->qctx->getMetaClient();
+    auto stats = metaClient->getStatsFromCache(matchClauseCtx->space.id);
+    if (stats != nullptr) {
+      MatchCostModel model(std::move(stats));
+      auto found =
+          findStartsByCost(matchClauseCtx, model, startFromEdge, startIndex, matchClausePlan);
+      NG_RETURN_IF_ERROR(found);
+      if (found.value()) {
+        return Status::OK();
+      }
+    }
+  }
+
   auto& nodeInfos = matchClauseCtx->nodeInfos;
   auto& edgeInfos = matchClauseCtx->edgeInfos;
   auto& startVidFinders = StartVidFinder::finders();
@@ -97,6 +112,87 @@ Status MatchClausePlanner::findStarts(MatchClauseContext* matchClauseCtx,
   return Status::OK();
 }
 
+StatusOr<bool> MatchClausePlanner::findStartsByCost(MatchClauseContext* matchClauseCtx,
+                                                    const MatchCostModel& model,
+                                                    bool& startFromEdge,
+                                                    size_t& startIndex,
+                                                    SubPlan& matchClausePlan) {
+  auto& nodeInfos = matchClauseCtx->nodeInfos;
+  auto& edgeInfos = matchClauseCtx->edgeInfos;
+  auto& startVidFinders = StartVidFinder::finders();
+
+  // The finder, whether from an edge and the index of the cheapest start. The
+  // earlier one is kept if the costs are the same, so it falls back to the
+  // order of the finders.
+  size_t bestFinder = 0;
+  bool bestFromEdge = false;
+  size_t bestIndex = 0;
+  double minCost = std::numeric_limits<double>::max();
+  bool found = false;
+  bool unknown = false;
+  auto evaluate = [&](PatternContext* patternCtx, size_t f, bool fromEdge, size_t i) {
+    auto finder = startVidFinders[f]();
+    if (!finder->match(patternCtx)) {
+      return;
+    }
+    auto rows = finder->estimate(patternCtx, model);
+    if (!rows.hasValue()) {
+      unknown = true;
+      return;
+    }
+    auto cost = model.cost(edgeInfos, i, rows.value());
+    VLOG(1) << "Start from " << (fromEdge ? "edge " : "node ") << i << " by finder " << f
+            << ", estimated rows: " << rows.value() << ", cost: " << cost;
+    if (cost < minCost) {
+      minCost = cost;
+      bestFinder = f;
+      bestFromEdge = fromEdge;
+      bestIndex = i;
+      found = true;
+    }
+  };
+  for (size_t f = 0; f < startVidFinders.size() && !unknown; ++f) {
+    for (size_t i = 0; i < nodeInfos.size() && !unknown; ++i) {
+      auto nodeCtx = NodeContext(matchClauseCtx, &nodeInfos[i]);
+      evaluate(&nodeCtx, f, false, i);
+      if (i != nodeInfos.size() - 1) {
+        auto edgeCtx = EdgeContext(matchClauseCtx, &edgeInfos[i]);
+        evaluate(&edgeCtx, f, true, i);
+      }
+    }
+  }
+  if (!found || unknown) {
+    return false;
+  }
+
+  auto finder = startVidFinders[bestFinder]();
+  if (bestFromEdge) {
+    auto edgeCtx = EdgeContext(matchClauseCtx, &edgeInfos[bestIndex]);
+    if (!finder->match(&edgeCtx)) {
+      return Status::Error("Failed to match the start edge %lu", bestIndex);
+    }
+    auto plan = finder->transform(&edgeCtx);
+    NG_RETURN_IF_ERROR(plan);
+    matchClausePlan = std::move(plan).value();
+    initialExpr_ = edgeCtx.initialExpr->clone();
+  } else {
+    auto nodeCtx = NodeContext(matchClauseCtx, &nodeInfos[bestIndex]);
+    if (!finder->match(&nodeCtx)) {
+      return Status::Error("Failed to match the start node %lu", bestIndex);
+    }
+    auto plan = finder->transform(&nodeCtx);
+    NG_RETURN_IF_ERROR(plan);
+    matchClausePlan = std::move(plan).value();
+    initialExpr_ = nodeCtx.initialExpr->clone();
+  }
+  startFromEdge = bestFromEdge;
+  startIndex = bestIndex;
+  VLOG(1) << "Find starts by cost: " << startIndex << ", Pattern has " << edgeInfos.size()
+          << " edges, root: " << matchClausePlan.root->outputVar()
+          << ", colNames: " << folly::join(",", matchClausePlan.root->colNames());
+  return true;
+}
+
 Status MatchClausePlanner::expand(const std::vector<NodeInfo>& nodeInfos,
                                   const std::vector<EdgeInfo>& edgeInfos,
                                   MatchClauseContext* matchClauseCtx,
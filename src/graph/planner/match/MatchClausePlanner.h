@@ -7,6 +7,7 @@
 #define GRAPH_PLANNER_MATCH_MATCHCLAUSEPLANNER_H_
 
 #include "graph/planner/match/CypherClausePlanner.h"
+#include "graph/planner/match/MatchCostModel.h"
 
 namespace nebula {
 namespace graph {
@@ -25,6 +26,14 @@ class MatchClausePlanner final : public CypherClausePlanner {
                     size_t& startIndex,
                     SubPlan& matchClausePlan);
 
+  // Find the start with the fewest rows estimated by the model, false if any
+  // of the candidates could not be estimated
+  StatusOr<bool> findStartsByCost(MatchClauseContext* matchClauseCtx,
+                                  const MatchCostModel& model,
+                                  bool& startFromEdge,
+                                  size_t& startIndex,
+                                  SubPlan& matchClausePlan);
+
   Status expand(const std::vector<NodeInfo>& nodeInfos,
                 const std::vector<EdgeInfo>& edgeInfos,
                 MatchClauseContext* matchClauseCtx,
@@ -0,0 +1,139 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/planner/match/MatchCostModel.h"
+
+#include "common/expression/ContainerExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/RelationalExpression.h"
+
+namespace nebula {
+namespace graph {
+
+// The guessed selectivities of the operators, the same as the ones of the
+// classic System R
+static constexpr double kEqualSelectivity = 0.1;
+static constexpr double kRangeSelectivity = 1.0 / 3;
+static constexpr double kDefaultSelectivity = 0.5;
+
+folly::Optional<double> MatchCostModel::tagVertices(const std::string& tag) const {
+  const auto& tags = stats_->get_tag_vertices();
+  auto iter = tags.find(tag);
+  if (iter == tags.end()) {
+    return folly::none;
+  }
+  return static_cast<double>(iter->second);
+}
+
+folly::Optional<double> MatchCostModel::edges(const std::string& edge) const {
+  const auto& edges = stats_->get_edges();
+  auto iter = edges.find(edge);
+  if (iter == edges.end()) {
+    return folly::none;
+  }
+  return static_cast<double>(iter->second);
+}
+
+// static
+double MatchCostModel::selectivity(const Expression* filter) {
+  if (filter == nullptr) {
+    return 1.0;
+  }
+  switch (filter->kind()) {
+    case Expression::Kind::kLogicalAnd: {
+      double sel = 1.0;
+      for (const auto* operand : static_cast<const LogicalExpression*>(filter)->operands()) {
+        sel *= selectivity(operand);
+      }
+      return sel;
+    }
+    case Expression::Kind::kLogicalOr: {
+      double sel = 0.0;
+      for (const auto* operand : static_cast<const LogicalExpression*>(filter)->operands()) {
+        sel += selectivity(operand);
+      }
+      return std::min(sel, 1.0);
+    }
+    case Expression::Kind::kRelEQ:
+      return kEqualSelectivity;
+    case Expression::Kind::kRelIn: {
+      auto* right = static_cast<const RelationalExpression*>(filter)->right();
+      if (right->kind() == Expression::Kind::kList) {
+        auto size = static_cast<const ListExpression*>(right)->items().size();
+        return std::min(kEqualSelectivity * size, 1.0);
+      }
+      return kDefaultSelectivity;
+    }
+    case Expression::Kind::kRelLT:
+    case Expression::Kind::kRelLE:
+    case Expression::Kind::kRelGT:
+    case Expression::Kind::kRelGE:
+      return kRangeSelectivity;
+    default:
+      return kDefaultSelectivity;
+  }
+}
+
+double MatchCostModel::degree(const EdgeInfo& edge) const {
+  auto vertices = stats_->get_space_vertices();
+  if (vertices <= 0) {
+    return 0.0;
+  }
+  double numEdges = 0.0;
+  if (edge.types.empty()) {
+    numEdges = stats_->get_space_edges();
+  } else {
+    for (const auto& type : edge.types) {
+      numEdges += edges(type).value_or(0.0);
+    }
+  }
+  // Each edge is an out edge of one vertex and an in edge of another
+  double factor = edge.direction == MatchEdge::Direction::BOTH ? 2.0 : 1.0;
+  return factor * numEdges / vertices;
+}
+
+double MatchCostModel::expand(const EdgeInfo& edge, double rows) const {
+  auto d = degree(edge);
+  int64_t minSteps = 1;
+  int64_t maxSteps = 1;
+  if (edge.range != nullptr) {
+    minSteps = edge.range->min();
+    maxSteps = std::min(edge.range->max(), kMaxEstimatedSteps);
+  }
+  double result = 0.0;
+  double stepRows = rows;
+  for (int64_t step = 1; step <= maxSteps; ++step) {
+    stepRows *= d;
+    if (step >= minSteps) {
+      result += stepRows;
+    }
+  }
+  if (minSteps == 0) {
+    result += rows;
+  }
+  return result;
+}
+
+double MatchCostModel::cost(const std::vector<EdgeInfo>& edgeInfos,
+                            size_t startIndex,
+                            double startRows) const {
+  double total = startRows;
+  // Pattern: (start)-[]-...-()
+  double rows = startRows;
+  for (size_t i = startIndex; i < edgeInfos.size(); ++i) {
+    rows = expand(edgeInfos[i], rows);
+    total += rows;
+  }
+  // Pattern: ()-[]-...-(start)
+  rows = startRows;
+  for (size_t i = startIndex; i > 0; --i) {
+    rows = expand(edgeInfos[i - 1], rows);
+    total += rows;
+  }
+  return total;
+}
+
+}  // namespace graph
+}  // namespace nebula
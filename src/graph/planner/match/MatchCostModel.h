@@ -0,0 +1,60 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_PLANNER_MATCH_MATCHCOSTMODEL_H_
+#define GRAPH_PLANNER_MATCH_MATCHCOSTMODEL_H_
+
+#include "common/base/Base.h"
+#include "graph/context/ast/CypherAstContext.h"
+#include "interface/gen-cpp2/meta_types.h"
+
+namespace nebula {
+namespace graph {
+
+/*
+ * The MatchCostModel estimates the number of rows of a pattern by the stats of
+ * the space collected by the last stats job, to choose the start of the
+ * pattern which produces the fewest rows.
+ *
+ * The average degree of an edge type is its number of edges divided by the
+ * number of vertices in the space. The selectivity of a filter is guessed by
+ * its operators since there are no histograms of the props.
+ */
+class MatchCostModel final {
+ public:
+  explicit MatchCostModel(std::shared_ptr<const meta::cpp2::StatsItem> stats)
+      : stats_(std::move(stats)) {
+    DCHECK(stats_ != nullptr);
+  }
+
+  // The number of vertices with the tag, none if it's not in the stats
+  folly::Optional<double> tagVertices(const std::string& tag) const;
+
+  // The number of edges of the edge type, none if it's not in the stats
+  folly::Optional<double> edges(const std::string& edge) const;
+
+  // The fraction of rows passing the filter
+  static double selectivity(const Expression* filter);
+
+  // The estimated number of rows produced by expanding the pattern from the
+  // node at startIndex, with the number of rows of the start
+  double cost(const std::vector<EdgeInfo>& edgeInfos, size_t startIndex, double startRows) const;
+
+ private:
+  // The average number of neighbors reached by one step of the edge
+  double degree(const EdgeInfo& edge) const;
+
+  // The number of rows after expanding the rows along the edge
+  double expand(const EdgeInfo& edge, double rows) const;
+
+  // The steps of a variable length edge more than it are not counted
+  static constexpr int64_t kMaxEstimatedSteps = 5;
+
+  std::shared_ptr<const meta::cpp2::StatsItem> stats_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_PLANNER_MATCH_MATCHCOSTMODEL_H_
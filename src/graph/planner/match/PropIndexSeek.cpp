@@ -171,5 +171,23 @@ StatusOr<SubPlan> PropIndexSeek::transformNode(NodeContext* nodeCtx) {
   return plan;
 }
 
+folly::Optional<double> PropIndexSeek::estimateNode(NodeContext* nodeCtx,
+                                                    const MatchCostModel& model) {
+  auto vertices = model.tagVertices(nodeCtx->scanInfo.schemaNames.back());
+  if (!vertices.hasValue()) {
+    return folly::none;
+  }
+  return vertices.value() * MatchCostModel::selectivity(nodeCtx->scanInfo.filter);
+}
+
+folly::Optional<double> PropIndexSeek::estimateEdge(EdgeContext* edgeCtx,
+                                                    const MatchCostModel& model) {
+  auto edges = model.edges(edgeCtx->scanInfo.schemaNames.back());
+  if (!edges.hasValue()) {
+    return folly::none;
+  }
+  return edges.value() * MatchCostModel::selectivity(edgeCtx->scanInfo.filter);
+}
+
 }  // namespace graph
 }  // namespace nebula
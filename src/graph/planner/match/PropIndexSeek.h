@@ -28,6 +28,10 @@ class PropIndexSeek final : public StartVidFinder {
 
   StatusOr<SubPlan> transformEdge(EdgeContext* edgeCtx) override;
 
+  folly::Optional<double> estimateNode(NodeContext* nodeCtx, const MatchCostModel& model) override;
+
+  folly::Optional<double> estimateEdge(EdgeContext* edgeCtx, const MatchCostModel& model) override;
+
  private:
   PropIndexSeek() = default;
 };
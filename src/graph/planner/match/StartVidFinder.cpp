@@ -35,5 +35,20 @@ StatusOr<SubPlan> StartVidFinder::transform(PatternContext* patternCtx) {
   return Status::Error("Unknown pattern kind.");
 }
 
+folly::Optional<double> StartVidFinder::estimate(PatternContext* patternCtx,
+                                                 const MatchCostModel& model) {
+  if (patternCtx->kind == PatternKind::kNode) {
+    auto* nodeCtx = static_cast<NodeContext*>(patternCtx);
+    return estimateNode(nodeCtx, model);
+  }
+
+  if (patternCtx->kind == PatternKind::kEdge) {
+    auto* edgeCtx = static_cast<EdgeContext*>(patternCtx);
+    return estimateEdge(edgeCtx, model);
+  }
+
+  return folly::none;
+}
+
 }  // namespace graph
 }  // namespace nebula
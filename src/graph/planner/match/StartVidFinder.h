@@ -8,6 +8,7 @@
 
 #include "graph/context/ast/CypherAstContext.h"
 #include "graph/planner/Planner.h"
+#include "graph/planner/match/MatchCostModel.h"
 
 namespace nebula {
 namespace graph {
@@ -36,6 +37,18 @@ class StartVidFinder {
 
   virtual StatusOr<SubPlan> transformEdge(EdgeContext* edgeCtx) = 0;
 
+  // The estimated number of the starts found for the matched pattern, none if
+  // it could not be estimated
+  folly::Optional<double> estimate(PatternContext* patternCtx, const MatchCostModel& model);
+
+  virtual folly::Optional<double> estimateNode(NodeContext*, const MatchCostModel&) {
+    return folly::none;
+  }
+
+  virtual folly::Optional<double> estimateEdge(EdgeContext*, const MatchCostModel&) {
+    return folly::none;
+  }
+
  protected:
   StartVidFinder() = default;
 };
@@ -31,6 +31,10 @@ class VertexIdSeek final : public StartVidFinder {
 
   StatusOr<SubPlan> transformEdge(EdgeContext* edgeCtx) override;
 
+  folly::Optional<double> estimateNode(NodeContext* nodeCtx, const MatchCostModel&) override {
+    return static_cast<double>(nodeCtx->ids.size());
+  }
+
   std::pair<std::string, Expression*> listToAnnoVarVid(QueryContext* qctx, const List& list);
 
   std::pair<std::string, Expression*> constToAnnoVarVid(QueryContext* qctx, const Value& v);
@@ -169,6 +169,9 @@ std::unique_ptr<PlanNodeDescription> IndexScan::explain() const {
   addDescription("isEdge", util::toJson(isEdge_), desc.get());
   addDescription("returnCols", folly::toJson(util::toJson(returnCols_)), desc.get());
   addDescription("indexCtx", folly::toJson(util::toJson(contexts_)), desc.get());
+  if (statProps_) {
+    addDescription("statProps", folly::toJson(util::toJson(*statProps_)), desc.get());
+  }
   return desc;
 }
 
@@ -186,6 +189,9 @@ void IndexScan::cloneMembers(const IndexScan& g) {
   isEdge_ = g.isEdge();
   schemaId_ = g.schemaId();
   isEmptyResultSet_ = g.isEmptyResultSet();
+  if (g.statProps_) {
+    setStatProps(std::make_unique<std::vector<StatProp>>(*g.statProps_));
+  }
 }
 
 Filter::Filter(QueryContext* qctx, PlanNode* input, Expression* condition, bool needStableFilter)
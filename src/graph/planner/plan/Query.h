@@ -429,6 +429,13 @@ class IndexScan : public Explore {
 
   void setIsEdge(bool isEdge) { isEdge_ = isEdge; }
 
+  // The stats aggregated by the storage for each part, grouped by the return columns
+  const std::vector<StatProp>* statProps() const { return statProps_.get(); }
+
+  void setStatProps(std::unique_ptr<std::vector<StatProp>> statProps) {
+    statProps_ = std::move(statProps);
+  }
+
   PlanNode* clone() const override;
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
@@ -461,6 +468,7 @@ class IndexScan : public Explore {
   std::vector<std::string> returnCols_;
   bool isEdge_;
   int32_t schemaId_;
+  std::unique_ptr<std::vector<StatProp>> statProps_;
 
   // TODO(yee): Generate special plan for this scenario
   bool isEmptyResultSet_{false};
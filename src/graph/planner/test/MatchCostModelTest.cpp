@@ -0,0 +1,101 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/init/Init.h>
+#include <gtest/gtest.h>
+
+#include "common/base/ObjectPool.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/RelationalExpression.h"
+#include "graph/planner/match/MatchCostModel.h"
+
+namespace nebula {
+namespace graph {
+
+class MatchCostModelTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    auto stats = std::make_shared<meta::cpp2::StatsItem>();
+    // 1000 players and 10 teams, each player serves 2 teams and likes 5
+    // players
+    stats->set_space_vertices(1010);
+    stats->set_space_edges(7000);
+    std::unordered_map<std::string, int64_t> tags = {{"player", 1000}, {"team", 10}};
+    std::unordered_map<std::string, int64_t> edges = {{"serve", 2000}, {"like", 5000}};
+    stats->set_tag_vertices(std::move(tags));
+    stats->set_edges(std::move(edges));
+    stats->set_status(meta::cpp2::JobStatus::FINISHED);
+    model_ = std::make_unique<MatchCostModel>(std::move(stats));
+  }
+
+ protected:
+  EdgeInfo makeEdge(const std::string& type, MatchEdge::Direction direction) {
+    EdgeInfo edge;
+    edge.types.emplace_back(type);
+    edge.direction = direction;
+    return edge;
+  }
+
+  ObjectPool pool_;
+  std::unique_ptr<MatchCostModel> model_;
+};
+
+TEST_F(MatchCostModelTest, Count) {
+  EXPECT_EQ(1000.0, model_->tagVertices("player").value());
+  EXPECT_EQ(10.0, model_->tagVertices("team").value());
+  EXPECT_FALSE(model_->tagVertices("coach").hasValue());
+  EXPECT_EQ(2000.0, model_->edges("serve").value());
+  EXPECT_FALSE(model_->edges("teammate").hasValue());
+}
+
+TEST_F(MatchCostModelTest, Selectivity) {
+  auto* eq = RelationalExpression::makeEQ(
+      &pool_, ConstantExpression::make(&pool_, 1), ConstantExpression::make(&pool_, 1));
+  auto* gt = RelationalExpression::makeGT(
+      &pool_, ConstantExpression::make(&pool_, 1), ConstantExpression::make(&pool_, 1));
+  EXPECT_DOUBLE_EQ(1.0, MatchCostModel::selectivity(nullptr));
+  EXPECT_DOUBLE_EQ(0.1, MatchCostModel::selectivity(eq));
+  EXPECT_DOUBLE_EQ(1.0 / 3, MatchCostModel::selectivity(gt));
+  EXPECT_DOUBLE_EQ(0.1 / 3,
+                   MatchCostModel::selectivity(LogicalExpression::makeAnd(&pool_, eq, gt)));
+  EXPECT_DOUBLE_EQ(0.1 + 1.0 / 3,
+                   MatchCostModel::selectivity(LogicalExpression::makeOr(&pool_, eq, gt)));
+}
+
+TEST_F(MatchCostModelTest, Cost) {
+  // (p:player)-[:serve]->(t:team)
+  std::vector<EdgeInfo> edges = {makeEdge("serve", MatchEdge::Direction::OUT_EDGE)};
+  auto fromPlayer = model_->cost(edges, 0, 1000);
+  auto fromTeam = model_->cost(edges, 1, 10);
+  EXPECT_LT(fromTeam, fromPlayer);
+
+  // (a:player)-[:like]-(b:player)-[:serve]->(t:team)
+  edges = {makeEdge("like", MatchEdge::Direction::BOTH),
+           makeEdge("serve", MatchEdge::Direction::OUT_EDGE)};
+  auto fromA = model_->cost(edges, 0, 1000);
+  auto fromT = model_->cost(edges, 2, 10);
+  EXPECT_LT(fromT, fromA);
+  // Start from the 10 teams, 10 * 2000 / 1010 servers, then their likes
+  double served = 10 * 2000.0 / 1010;
+  EXPECT_DOUBLE_EQ(10 + served + served * 2 * 5000.0 / 1010, fromT);
+
+  // A variable length edge expands all the steps in the range
+  MatchStepRange range(1, 2);
+  edges = {makeEdge("like", MatchEdge::Direction::OUT_EDGE)};
+  edges[0].range = &range;
+  double degree = 5000.0 / 1010;
+  EXPECT_DOUBLE_EQ(1 + degree + degree * degree, model_->cost(edges, 0, 1));
+}
+
+}  // namespace graph
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
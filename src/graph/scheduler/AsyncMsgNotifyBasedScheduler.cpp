@@ -266,10 +266,16 @@ folly::Future<Status> AsyncMsgNotifyBasedScheduler::execute(Executor* executor)
   if (!status.ok()) {
     return executor->error(std::move(status));
   }
-  return executor->execute().thenValue([executor](Status s) {
-    NG_RETURN_IF_ERROR(s);
-    return executor->close();
-  });
+  // The running executor holds a slot of the job budget of the query, so the
+  // executors splitting their input into morsels only fan out with the slots
+  // left by the executors running side by side
+  auto slots = qctx_->acquireJobs(1);
+  return executor->execute()
+      .thenValue([executor](Status s) {
+        NG_RETURN_IF_ERROR(s);
+        return executor->close();
+      })
+      .ensure([this, slots]() { qctx_->releaseJobs(slots); });
 }
 
 }  // namespace graph
@@ -54,6 +54,17 @@ DEFINE_int64(max_allowed_connections,
 
 DEFINE_bool(enable_optimizer, false, "Whether to enable optimizer");
 
+DEFINE_bool(enable_match_cost_model,
+            false,
+            "Whether to choose the start of a MATCH pattern by the stats of the space, "
+            "which are collected by the stats job");
+
+DEFINE_bool(enable_plan_cache,
+            false,
+            "Whether to reuse the plans of the read-only queries run again by the same "
+            "user in the same space, until the meta data is changed");
+DEFINE_uint32(plan_cache_capacity, 1024, "The max number of the plans kept in the plan cache");
+
 DEFINE_uint32(ft_request_retry_times, 3, "Retry times if fulltext request failed");
 
 DEFINE_bool(accept_partial_success, false, "Whether to accept partial success, default false");
@@ -71,3 +82,42 @@ DEFINE_string(client_white_list,
               "A white list for different client versions, seperate with colon.");
 
 DEFINE_int32(num_rows_to_check_memory, 1024, "number rows to check memory");
+
+DEFINE_int32(num_rows_per_eval_batch,
+             1024,
+             "Number of rows evaluated together by the batch expression evaluation in "
+             "Filter and Project, 0 to evaluate row by row");
+
+DEFINE_uint32(max_job_size,
+              1,
+              "The max number of jobs running concurrently for a query, which includes both "
+              "the executors running side by side and the morsels which an executor splits "
+              "its input into, 1 to run each executor in a single thread");
+
+DEFINE_uint32(min_batch_size,
+              8192,
+              "The min number of rows of a morsel when an executor splits its input to "
+              "process in parallel");
+
+DEFINE_int64(sort_memory_budget_mb,
+             0,
+             "The default max memory in MB of the rows which a Sort of a query sorts in "
+             "memory, the bigger input is sorted in runs spilled to --sort_spill_dir, "
+             "0 to always sort in memory");
+DEFINE_string(sort_spill_dir, "/tmp", "The scratch directory where Sort spills its sorted runs");
+
+DEFINE_int64(max_query_memory_mb,
+             0,
+             "The max memory in MB taken by the results of a query, 0 for unlimited");
+DEFINE_int64(max_session_memory_mb,
+             0,
+             "The max memory in MB taken by the results of all queries of a session, "
+             "0 for unlimited");
+DEFINE_int64(max_process_query_memory_mb,
+             0,
+             "The max memory in MB taken by the results of all queries in this graphd, "
+             "0 for unlimited");
+DEFINE_bool(kill_biggest_query_on_memory_limit,
+            false,
+            "Kill the query taking the most memory when the limit of this graphd is hit, "
+            "instead of failing the query which hits it");
@@ -39,6 +39,11 @@ DECLARE_uint32(max_allowed_statements);
 
 // optimizer
 DECLARE_bool(enable_optimizer);
+DECLARE_bool(enable_match_cost_model);
+
+// plan cache
+DECLARE_bool(enable_plan_cache);
+DECLARE_uint32(plan_cache_capacity);
 
 DECLARE_int64(max_allowed_connections);
 
@@ -51,4 +56,17 @@ DECLARE_string(client_white_list);
 
 DECLARE_int32(num_rows_to_check_memory);
 
+DECLARE_int32(num_rows_per_eval_batch);
+
+DECLARE_uint32(max_job_size);
+DECLARE_uint32(min_batch_size);
+
+DECLARE_int64(sort_memory_budget_mb);
+DECLARE_string(sort_spill_dir);
+
+DECLARE_int64(max_query_memory_mb);
+DECLARE_int64(max_session_memory_mb);
+DECLARE_int64(max_process_query_memory_mb);
+DECLARE_bool(kill_biggest_query_on_memory_limit);
+
 #endif  // GRAPH_GRAPHFLAGS_H_
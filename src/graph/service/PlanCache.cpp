@@ -0,0 +1,225 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/PlanCache.h"
+
+#include "common/function/FunctionManager.h"
+#include "graph/service/QueryInstance.h"
+#include "graph/util/ExpressionUtils.h"
+#include "parser/SequentialSentences.h"
+#include "parser/TraverseSentences.h"
+
+namespace nebula {
+namespace graph {
+
+PlanCache::PlanCache(size_t capacity) : capacity_(capacity) {}
+
+PlanCache::~PlanCache() = default;
+
+// static
+std::string PlanCache::makeKey(RequestContext<ExecutionResponse>* rctx) {
+  auto* session = rctx->session();
+  return folly::to<std::string>(
+      session->user(), '\n', session->space().id, '\n', normalize(rctx->query()));
+}
+
+// static
+std::string PlanCache::normalize(folly::StringPiece query) {
+  std::string result;
+  result.reserve(query.size());
+  char quote = '\0';
+  bool blank = false;
+  for (size_t i = 0; i < query.size(); ++i) {
+    auto c = query[i];
+    if (quote != '\0') {
+      result.push_back(c);
+      if (c == '\\' && i + 1 < query.size()) {
+        result.push_back(query[++i]);
+      } else if (c == quote) {
+        quote = '\0';
+      }
+      continue;
+    }
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      blank = true;
+      continue;
+    }
+    if (blank && !result.empty()) {
+      result.push_back(' ');
+    }
+    blank = false;
+    if (c == '"' || c == '\'' || c == '`') {
+      quote = c;
+    }
+    result.push_back(c);
+  }
+  return result;
+}
+
+// static
+bool PlanCache::isCacheable(const Sentence* sentence, folly::StringPiece query) {
+  return isCacheableSentence(sentence) && !hasImpureFunction(query);
+}
+
+// static
+bool PlanCache::isCacheableSentence(const Sentence* sentence) {
+  switch (sentence->kind()) {
+    case Sentence::Kind::kSequential: {
+      for (auto* s : static_cast<const SequentialSentences*>(sentence)->sentences()) {
+        if (!isCacheableSentence(s)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case Sentence::Kind::kPipe: {
+      auto* piped = static_cast<const PipedSentence*>(sentence);
+      return isCacheableSentence(piped->left()) && isCacheableSentence(piped->right());
+    }
+    case Sentence::Kind::kSet: {
+      auto* set = const_cast<SetSentence*>(static_cast<const SetSentence*>(sentence));
+      return isCacheableSentence(set->left()) && isCacheableSentence(set->right());
+    }
+    case Sentence::Kind::kAssignment: {
+      return isCacheableSentence(static_cast<const AssignmentSentence*>(sentence)->sentence());
+    }
+    case Sentence::Kind::kLookup: {
+      auto* where = static_cast<const LookupSentence*>(sentence)->whereClause();
+      return where == nullptr || where->filter() == nullptr ||
+             !ExpressionUtils::hasAny(where->filter(),
+                                      {Expression::Kind::kTSPrefix,
+                                       Expression::Kind::kTSWildcard,
+                                       Expression::Kind::kTSRegexp,
+                                       Expression::Kind::kTSFuzzy});
+    }
+    case Sentence::Kind::kGo:
+    case Sentence::Kind::kMatch:
+    case Sentence::Kind::kFetchVertices:
+    case Sentence::Kind::kFetchEdges:
+    case Sentence::Kind::kFindPath:
+    case Sentence::Kind::kGetSubgraph:
+    case Sentence::Kind::kYield:
+    case Sentence::Kind::kOrderBy:
+    case Sentence::Kind::kLimit:
+    case Sentence::Kind::kGroupBy:
+    case Sentence::Kind::kReturn:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// static
+bool PlanCache::hasImpureFunction(folly::StringPiece query) {
+  // The arity of a call is not known without parsing its arguments, so a
+  // function is taken as impure if it's impure with any arity up to this.
+  static constexpr size_t kMaxArity = 3;
+  char quote = '\0';
+  size_t i = 0;
+  while (i < query.size()) {
+    auto c = query[i];
+    if (quote != '\0') {
+      if (c == '\\') {
+        ++i;
+      } else if (c == quote) {
+        quote = '\0';
+      }
+      ++i;
+      continue;
+    }
+    if (c == '"' || c == '\'' || c == '`') {
+      quote = c;
+      ++i;
+      continue;
+    }
+    if (!std::isalpha(static_cast<unsigned char>(c)) && c != '_') {
+      ++i;
+      continue;
+    }
+    auto start = i;
+    while (i < query.size() &&
+           (std::isalnum(static_cast<unsigned char>(query[i])) || query[i] == '_')) {
+      ++i;
+    }
+    auto next = i;
+    while (next < query.size() && std::isspace(static_cast<unsigned char>(query[next]))) {
+      ++next;
+    }
+    if (next == query.size() || query[next] != '(') {
+      continue;
+    }
+    auto name = query.subpiece(start, i - start).str();
+    for (size_t arity = 0; arity <= kMaxArity; ++arity) {
+      auto pure = FunctionManager::getIsPure(name, arity);
+      if (pure.ok() && !pure.value()) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+std::unique_ptr<QueryInstance> PlanCache::take(const std::string& key, int64_t metaVersion) {
+  std::unique_ptr<QueryInstance> instance;
+  // Released out of the lock
+  std::vector<std::unique_ptr<QueryInstance>> stale;
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    auto found = index_.find(key);
+    if (found == index_.end()) {
+      return nullptr;
+    }
+    auto& iters = found->second;
+    while (!iters.empty() && instance == nullptr) {
+      auto iter = iters.back();
+      iters.pop_back();
+      if (iter->metaVersion == metaVersion) {
+        instance = std::move(iter->instance);
+      } else {
+        stale.emplace_back(std::move(iter->instance));
+      }
+      entries_.erase(iter);
+    }
+    if (iters.empty()) {
+      index_.erase(found);
+    }
+  }
+  return instance;
+}
+
+void PlanCache::put(const std::string& key,
+                    int64_t metaVersion,
+                    std::unique_ptr<QueryInstance> instance) {
+  // Released out of the lock
+  std::list<Entry> evicted;
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    entries_.emplace_front(Entry{key, metaVersion, std::move(instance)});
+    index_[key].emplace_back(entries_.begin());
+    while (entries_.size() > capacity_) {
+      auto last = std::prev(entries_.end());
+      unindex(last);
+      evicted.splice(evicted.end(), entries_, last);
+    }
+  }
+}
+
+size_t PlanCache::size() {
+  std::lock_guard<std::mutex> g(lock_);
+  return entries_.size();
+}
+
+void PlanCache::unindex(std::list<Entry>::iterator iter) {
+  auto found = index_.find(iter->key);
+  DCHECK(found != index_.end());
+  auto& iters = found->second;
+  iters.erase(std::remove(iters.begin(), iters.end(), iter), iters.end());
+  if (iters.empty()) {
+    index_.erase(found);
+  }
+}
+
+}  // namespace graph
+}  // namespace nebula
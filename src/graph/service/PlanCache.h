@@ -0,0 +1,81 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_PLANCACHE_H_
+#define GRAPH_SERVICE_PLANCACHE_H_
+
+#include "common/base/Base.h"
+#include "graph/service/RequestContext.h"
+#include "parser/Sentence.h"
+
+namespace nebula {
+namespace graph {
+
+class QueryInstance;
+
+/**
+ * An LRU cache of the query instances whose plans could be run again, to skip
+ * the parser, the validator, the planner and the optimizer when the same query
+ * comes again.
+ *
+ * An instance runs one query at a time, so it's taken out of the cache by the
+ * query reusing it, and put back after the query succeeds. There might be many
+ * idle instances of the same query if it was run concurrently, each of them
+ * counts against the capacity.
+ *
+ * The instances are keyed by the query text with the blanks collapsed, the user
+ * and the space, since the plan is validated against them. Each one is tagged
+ * with the version of the meta data it's planned on, and dropped once the
+ * schemas, the indexes or the roles are changed.
+ */
+class PlanCache final {
+ public:
+  explicit PlanCache(size_t capacity);
+
+  ~PlanCache();
+
+  static std::string makeKey(RequestContext<ExecutionResponse>* rctx);
+
+  // Collapse the blanks out of the quotes, and trim the query
+  static std::string normalize(folly::StringPiece query);
+
+  // Only the read-only queries are cached, which don't call any function giving
+  // a different result for the same arguments, e.g. now(), since it might be
+  // evaluated once while validated. A LOOKUP on the fulltext index isn't cached
+  // either, since it's rewritten by the result of the fulltext search.
+  static bool isCacheable(const Sentence* sentence, folly::StringPiece query);
+
+  // Take an idle instance of the key planned on the meta version, or nullptr
+  std::unique_ptr<QueryInstance> take(const std::string& key, int64_t metaVersion);
+
+  void put(const std::string& key, int64_t metaVersion, std::unique_ptr<QueryInstance> instance);
+
+  size_t size();
+
+ private:
+  struct Entry {
+    std::string key;
+    int64_t metaVersion;
+    std::unique_ptr<QueryInstance> instance;
+  };
+
+  static bool isCacheableSentence(const Sentence* sentence);
+
+  static bool hasImpureFunction(folly::StringPiece query);
+
+  // Remove the entry from the index of its key
+  void unindex(std::list<Entry>::iterator iter);
+
+  const size_t capacity_;
+  std::mutex lock_;
+  // The most recently used ones are at the front
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::vector<std::list<Entry>::iterator>> index_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_SERVICE_PLANCACHE_H_
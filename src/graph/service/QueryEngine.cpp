@@ -14,6 +14,7 @@
 #include "graph/planner/PlannersRegister.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/service/QueryInstance.h"
+#include "graph/stats/StatsDef.h"
 #include "version/Version.h"
 
 DECLARE_bool(local_config);
@@ -40,10 +41,24 @@ Status QueryEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor
   }
   optimizer_ = std::make_unique<opt::Optimizer>(rulesets);
 
+  if (FLAGS_enable_plan_cache) {
+    planCache_ = std::make_unique<PlanCache>(FLAGS_plan_cache_capacity);
+  }
+
   return setupMemoryMonitorThread();
 }
 
 void QueryEngine::execute(RequestContextPtr rctx) {
+  std::string cacheKey;
+  if (planCache_ != nullptr) {
+    cacheKey = PlanCache::makeKey(rctx.get());
+    auto cached = planCache_->take(cacheKey, metaClient_->getLocalLastUpdateTime());
+    if (cached != nullptr) {
+      stats::StatsManager::addValue(kNumPlanCacheHits);
+      cached.release()->rerun(std::move(rctx));
+      return;
+    }
+  }
   auto qctx = std::make_unique<QueryContext>(std::move(rctx),
                                              schemaManager_.get(),
                                              indexManager_.get(),
@@ -51,6 +66,9 @@ void QueryEngine::execute(RequestContextPtr rctx) {
                                              metaClient_,
                                              charsetInfo_);
   auto* instance = new QueryInstance(std::move(qctx), optimizer_.get());
+  if (planCache_ != nullptr) {
+    instance->setPlanCache(planCache_.get(), std::move(cacheKey));
+  }
   instance->execute();
 }
 
@@ -16,6 +16,7 @@
 #include "common/meta/SchemaManager.h"
 #include "common/network/NetworkUtils.h"
 #include "graph/optimizer/Optimizer.h"
+#include "graph/service/PlanCache.h"
 #include "graph/service/RequestContext.h"
 #include "interface/gen-cpp2/GraphService.h"
 
@@ -24,8 +25,9 @@ namespace graph {
 
 /**
  * QueryEngine is responsible to create and manage ExecutionPlan.
- * For the time being, we don't have the execution plan cache support,
- * instead we create a plan for each query, and destroy it upon finish.
+ * A plan is created for each query and destroyed upon finish, unless the plan
+ * cache is enabled by --enable_plan_cache, which keeps the plans of the
+ * read-only queries to run them again.
  */
 class QueryEngine final : public cpp::NonCopyable, public cpp::NonMovable {
  public:
@@ -50,6 +52,8 @@ class QueryEngine final : public cpp::NonCopyable, public cpp::NonMovable {
   std::unique_ptr<thread::GenericWorker> memoryMonitorThread_;
   meta::MetaClient* metaClient_{nullptr};
   CharsetInfo* charsetInfo_{nullptr};
+  // Declared last to release the cached plans before the managers they use
+  std::unique_ptr<PlanCache> planCache_;
 };
 
 }  // namespace graph
@@ -45,6 +45,17 @@ void QueryInstance::execute() {
     return;
   }
 
+  schedule();
+}
+
+void QueryInstance::rerun(QueryContext::RequestContextPtr rctx) {
+  DCHECK(values_ != nullptr);
+  qctx_->reset(std::move(rctx), values_->clone());
+  qctx_->rctx()->session()->addQuery(qctx_.get());
+  schedule();
+}
+
+void QueryInstance::schedule() {
   scheduler_->schedule()
       .thenValue([this](Status s) {
         if (s.ok()) {
@@ -61,14 +72,27 @@ void QueryInstance::execute() {
 
 Status QueryInstance::validateAndOptimize() {
   auto *rctx = qctx()->rctx();
+  if (planCache_ != nullptr) {
+    // Read before planning, so the plan is dropped if the meta data is changed
+    // meanwhile
+    metaVersion_ = qctx_->getMetaClient()->getLocalLastUpdateTime();
+  }
   VLOG(1) << "Parsing query: " << rctx->query();
   auto result = GQLParser(qctx()).parse(rctx->query());
   NG_RETURN_IF_ERROR(result);
   sentence_ = std::move(result).value();
+  // Checked before the validator which might rewrite the sentence
+  auto cacheable =
+      planCache_ != nullptr && PlanCache::isCacheable(sentence_.get(), rctx->query());
 
   NG_RETURN_IF_ERROR(Validator::validate(sentence_.get(), qctx()));
   NG_RETURN_IF_ERROR(findBestPlan());
 
+  if (cacheable) {
+    stats::StatsManager::addValue(kNumPlanCacheMisses);
+    values_ = qctx_->ectx()->clone();
+    qctx_->pinPlan();
+  }
   return Status::OK();
 }
 
@@ -96,6 +120,12 @@ void QueryInstance::onFinish() {
   rctx->finish();
 
   rctx->session()->deleteQuery(qctx_.get());
+  if (values_ != nullptr) {
+    // Release the request and the results, keep the plan for the next run
+    qctx_->reset(nullptr, std::make_unique<ExecutionContext>());
+    planCache_->put(cacheKey_, metaVersion_, std::unique_ptr<QueryInstance>(this));
+    return;
+  }
   // The `QueryInstance' is the root node holding all resources during the
   // execution. When the whole query process is done, it's safe to release this
   // object, as long as no other contexts have chances to access these resources
@@ -11,6 +11,7 @@
 #include "graph/context/QueryContext.h"
 #include "graph/optimizer/Optimizer.h"
 #include "graph/scheduler/Scheduler.h"
+#include "graph/service/PlanCache.h"
 #include "parser/GQLParser.h"
 
 /**
@@ -29,6 +30,17 @@ class QueryInstance final : public cpp::NonCopyable, public cpp::NonMovable {
 
   void execute();
 
+  // Put this instance into the plan cache after the query succeeds, if its plan
+  // could be run again
+  void setPlanCache(PlanCache* planCache, std::string cacheKey) {
+    planCache_ = planCache;
+    cacheKey_ = std::move(cacheKey);
+  }
+
+  // Run the plan again for another request of the same query, skipping the
+  // parser, the validator and the optimizer
+  void rerun(QueryContext::RequestContextPtr rctx);
+
   QueryContext* qctx() const { return qctx_.get(); }
 
  private:
@@ -47,6 +59,7 @@ class QueryInstance final : public cpp::NonCopyable, public cpp::NonMovable {
   void onError(Status);
 
   Status validateAndOptimize();
+  void schedule();
   // return true if continue to execute
   bool explainOrContinue();
   void addSlowQueryStats(uint64_t latency) const;
@@ -57,6 +70,15 @@ class QueryInstance final : public cpp::NonCopyable, public cpp::NonMovable {
   std::unique_ptr<QueryContext> qctx_;
   std::unique_ptr<Scheduler> scheduler_;
   opt::Optimizer* optimizer_{nullptr};
+
+  PlanCache* planCache_{nullptr};
+  std::string cacheKey_;
+  // The version of the meta data the plan is made on
+  int64_t metaVersion_{0};
+  // The values set by the validator and the planner, e.g. the start vids of a
+  // GO, which are changed by the executors, thus restored before each run.
+  // Only kept if the plan could be run again.
+  std::unique_ptr<ExecutionContext> values_;
 };
 
 }  // namespace graph
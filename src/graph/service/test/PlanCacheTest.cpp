@@ -0,0 +1,160 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/init/Init.h>
+#include <gtest/gtest.h>
+
+#include "graph/optimizer/Optimizer.h"
+#include "graph/service/PlanCache.h"
+#include "graph/service/QueryInstance.h"
+#include "parser/GQLParser.h"
+
+namespace nebula {
+namespace graph {
+
+class PlanCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    meta::cpp2::Session session;
+    session.set_session_id(0);
+    session.set_user_name("root");
+    session_ = ClientSession::create(std::move(session), nullptr);
+    SpaceInfo spaceInfo;
+    spaceInfo.name = "test_space";
+    spaceInfo.id = 1;
+    spaceInfo.spaceDesc.set_space_name("test_space");
+    session_->setSpace(std::move(spaceInfo));
+  }
+
+  std::unique_ptr<RequestContext<ExecutionResponse>> makeRequest(const std::string& query) {
+    auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+    rctx->setSession(session_);
+    rctx->setQuery(query);
+    return rctx;
+  }
+
+  std::string makeKey(const std::string& query) {
+    return PlanCache::makeKey(makeRequest(query).get());
+  }
+
+  std::unique_ptr<QueryInstance> makeInstance(const std::string& query) {
+    auto qctx = std::make_unique<QueryContext>();
+    qctx->setRCtx(makeRequest(query));
+    return std::make_unique<QueryInstance>(std::move(qctx), &optimizer_);
+  }
+
+  bool isCacheable(const std::string& query) {
+    QueryContext qctx;
+    auto result = GQLParser(&qctx).parse(query);
+    CHECK(result.ok()) << result.status();
+    return PlanCache::isCacheable(result.value().get(), query);
+  }
+
+  std::shared_ptr<ClientSession> session_;
+  opt::Optimizer optimizer_{std::vector<const opt::RuleSet*>{}};
+};
+
+TEST_F(PlanCacheTest, Normalize) {
+  EXPECT_EQ("GO FROM \"a\" OVER like",
+            PlanCache::normalize("  GO  FROM\t\"a\"\n OVER   like  "));
+  // The blanks in the quotes are kept
+  EXPECT_EQ("YIELD \"a  b\", 'c\\'  d', `e  f`",
+            PlanCache::normalize("YIELD  \"a  b\",  'c\\'  d',  `e  f`"));
+}
+
+TEST_F(PlanCacheTest, LiteralsNotMerged) {
+  EXPECT_EQ(makeKey("GO FROM \"a\" OVER like"), makeKey(" GO  FROM \"a\"  OVER like "));
+  EXPECT_NE(makeKey("GO FROM \"a\" OVER like"), makeKey("GO FROM \"b\" OVER like"));
+  EXPECT_NE(makeKey("YIELD 1"), makeKey("YIELD 2"));
+  EXPECT_NE(makeKey("YIELD 1.0"), makeKey("YIELD 1"));
+  EXPECT_NE(makeKey("YIELD \"a b\""), makeKey("YIELD \"a  b\""));
+  EXPECT_NE(makeKey("YIELD \"a\" + \" b\""), makeKey("YIELD \"a \" + \"b\""));
+
+  // Nor the same query of other spaces
+  auto key = makeKey("YIELD 1");
+  SpaceInfo spaceInfo;
+  spaceInfo.name = "other_space";
+  spaceInfo.id = 2;
+  spaceInfo.spaceDesc.set_space_name("other_space");
+  session_->setSpace(std::move(spaceInfo));
+  EXPECT_NE(key, makeKey("YIELD 1"));
+
+  PlanCache cache(16);
+  auto instance = makeInstance("YIELD 1");
+  auto* ptr = instance.get();
+  cache.put(key, 1, std::move(instance));
+  EXPECT_EQ(nullptr, cache.take(makeKey("YIELD 2"), 1));
+  EXPECT_EQ(nullptr, cache.take(makeKey("YIELD 1"), 1));
+  auto taken = cache.take(key, 1);
+  EXPECT_EQ(ptr, taken.get());
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(PlanCacheTest, Cacheable) {
+  EXPECT_TRUE(isCacheable("GO FROM \"a\" OVER like YIELD like._dst"));
+  EXPECT_TRUE(isCacheable("FETCH PROP ON person \"a\" YIELD person.name"));
+  EXPECT_TRUE(isCacheable("MATCH (v:person) RETURN v LIMIT 3"));
+  EXPECT_TRUE(isCacheable("$a = GO FROM \"a\" OVER like YIELD like._dst AS id; YIELD $a.id"));
+
+  // The writes and the schema changes
+  EXPECT_FALSE(isCacheable("INSERT VERTEX person(name) VALUES \"a\":(\"b\")"));
+  EXPECT_FALSE(isCacheable("DELETE VERTEX \"a\""));
+  EXPECT_FALSE(isCacheable("CREATE TAG t(name string)"));
+  EXPECT_FALSE(isCacheable("USE test_space"));
+  EXPECT_FALSE(isCacheable("GO FROM \"a\" OVER like YIELD like._dst AS id | DELETE VERTEX $-.id"));
+  EXPECT_FALSE(isCacheable("YIELD 1; DELETE VERTEX \"a\""));
+
+  // The functions giving a different result each time
+  EXPECT_FALSE(isCacheable("YIELD rand()"));
+  EXPECT_FALSE(isCacheable("YIELD now() + 1"));
+  EXPECT_TRUE(isCacheable("YIELD \"now()\""));
+}
+
+TEST_F(PlanCacheTest, Evict) {
+  PlanCache cache(2);
+  cache.put("a", 1, makeInstance("YIELD 1"));
+  cache.put("b", 1, makeInstance("YIELD 2"));
+  // The taken one turns the most recently used one when it's put back
+  auto a = cache.take("a", 1);
+  ASSERT_NE(nullptr, a);
+  cache.put("a", 1, std::move(a));
+  cache.put("c", 1, makeInstance("YIELD 3"));
+  EXPECT_EQ(2, cache.size());
+  EXPECT_EQ(nullptr, cache.take("b", 1));
+  EXPECT_NE(nullptr, cache.take("a", 1));
+  EXPECT_NE(nullptr, cache.take("c", 1));
+  EXPECT_EQ(0, cache.size());
+
+  // Each idle instance of the same query counts
+  cache.put("a", 1, makeInstance("YIELD 1"));
+  cache.put("a", 1, makeInstance("YIELD 1"));
+  cache.put("a", 1, makeInstance("YIELD 1"));
+  EXPECT_EQ(2, cache.size());
+}
+
+TEST_F(PlanCacheTest, MetaVersionChanged) {
+  PlanCache cache(16);
+  cache.put("a", 1, makeInstance("YIELD 1"));
+  cache.put("a", 1, makeInstance("YIELD 1"));
+  cache.put("b", 1, makeInstance("YIELD 2"));
+  // The stale instances are dropped once the meta data changes
+  EXPECT_EQ(nullptr, cache.take("a", 2));
+  EXPECT_EQ(1, cache.size());
+
+  cache.put("a", 2, makeInstance("YIELD 1"));
+  EXPECT_EQ(nullptr, cache.take("a", 1));
+  EXPECT_NE(nullptr, cache.take("b", 1));
+  EXPECT_EQ(0, cache.size());
+}
+
+}  // namespace graph
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
@@ -7,13 +7,23 @@
 
 #include "common/time/WallClock.h"
 #include "graph/context/QueryContext.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
 
+ClientSession::ClientSession() {
+  memoryTracker_ = MemoryTracker::create(
+      "session", FLAGS_max_session_memory_mb * 1024 * 1024, MemoryTracker::process());
+}
+
 ClientSession::ClientSession(meta::cpp2::Session&& session, meta::MetaClient* metaClient) {
   session_ = std::move(session);
   metaClient_ = metaClient;
+  memoryTracker_ =
+      MemoryTracker::create(folly::stringPrintf("session %ld", session_.get_session_id()),
+                            FLAGS_max_session_memory_mb * 1024 * 1024,
+                            MemoryTracker::process());
 }
 
 std::shared_ptr<ClientSession> ClientSession::create(meta::cpp2::Session&& session,
@@ -32,6 +42,18 @@ uint64_t ClientSession::idleSeconds() {
   return idleDuration_.elapsedInSec();
 }
 
+void ClientSession::updateQueryStats() {
+  auto now = time::WallClock::fastNowInMicroSec();
+  folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
+  for (auto& query : *session_.queries_ref()) {
+    query.second.set_duration(now - query.second.get_start_time());
+    auto context = contexts_.find(query.first);
+    if (context != contexts_.end()) {
+      query.second.set_memory(context->second->memoryTracker()->used());
+    }
+  }
+}
+
 void ClientSession::addQuery(QueryContext* qctx) {
   auto epId = qctx->plan()->id();
   meta::cpp2::QueryDesc queryDesc;
@@ -7,6 +7,7 @@
 
 #include "clients/meta/MetaClient.h"
 #include "common/time/Duration.h"
+#include "graph/context/MemoryTracker.h"
 #include "interface/gen-cpp2/meta_types.h"
 
 namespace nebula {
@@ -129,6 +130,13 @@ class ClientSession final {
     session_.set_space_name(spaceName);
   }
 
+  // Track the memory taken by the queries of this session, limited by
+  // --max_session_memory_mb
+  const std::shared_ptr<MemoryTracker>& memoryTracker() const { return memoryTracker_; }
+
+  // Update the duration and the memory usage of the running queries
+  void updateQueryStats();
+
   void addQuery(QueryContext* qctx);
 
   void deleteQuery(QueryContext* qctx);
@@ -140,7 +148,7 @@ class ClientSession final {
   void markAllQueryKilled();
 
  private:
-  ClientSession() = default;
+  ClientSession();
 
   explicit ClientSession(meta::cpp2::Session&& session, meta::MetaClient* metaClient);
 
@@ -157,6 +165,7 @@ class ClientSession final {
    */
   std::unordered_map<GraphSpaceID, meta::cpp2::RoleType> roles_;
   std::unordered_map<ExecutionPlanID, QueryContext*> contexts_;
+  std::shared_ptr<MemoryTracker> memoryTracker_;
 };
 
 }  // namespace graph
@@ -191,12 +191,8 @@ void GraphSessionManager::updateSessionsToMeta() {
 
     for (auto& ses : activeSessions_) {
       VLOG(3) << "Add Update session id: " << ses.second->getSession().get_session_id();
-      auto sessionCopy = ses.second->getSession();
-      for (auto& query : *sessionCopy.queries_ref()) {
-        query.second.set_duration(time::WallClock::fastNowInMicroSec() -
-                                  query.second.get_start_time());
-      }
-      sessions.emplace_back(std::move(sessionCopy));
+      ses.second->updateQueryStats();
+      sessions.emplace_back(ses.second->getSession());
     }
   }
 
@@ -18,6 +18,8 @@ extern stats::CounterId kNumSlowQueries;
 extern stats::CounterId kNumQueryErrors;
 extern stats::CounterId kQueryLatencyUs;
 extern stats::CounterId kSlowQueryLatencyUs;
+extern stats::CounterId kNumPlanCacheHits;
+extern stats::CounterId kNumPlanCacheMisses;
 
 void initCounters();
 
@@ -540,6 +540,21 @@ struct HBResp {
     5: i32              meta_version,
 }
 
+struct GetMetaChangesReq {
+    // The last update time the client has synced to
+    1: i64              since_in_ms,
+}
+
+struct GetMetaChangesResp {
+    1: common.ErrorCode code,
+    2: common.HostAddr  leader,
+    3: i64              last_update_time_in_ms,
+    // The changes since then are not all recorded, the client should reload all
+    4: bool             full,
+    // The spaces changed since then, including the dropped ones
+    5: list<common.GraphSpaceID> spaces,
+}
+
 enum HostRole {
     GRAPH       = 0x00,
     META        = 0x01,
@@ -1064,6 +1079,8 @@ struct QueryDesc {
     // The session might transfer between query engines, but the query do not, we must
     // record which query engine the query belongs to
     5: common.HostAddr graph_addr,
+    // The memory in bytes taken by the results of the query
+    6: i64 memory,
 }
 
 struct Session {
@@ -1222,6 +1239,7 @@ service MetaService {
     ExecResp changePassword(1: ChangePasswordReq req);
 
     HBResp           heartBeat(1: HBReq req);
+    GetMetaChangesResp getMetaChanges(1: GetMetaChangesReq req);
     BalanceResp      balance(1: BalanceReq req);
     ExecResp         leaderBalance(1: LeaderBalanceReq req);
 
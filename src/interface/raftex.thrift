@@ -6,6 +6,7 @@
 namespace cpp nebula.raftex
 
 cpp_include "common/thrift/ThriftTypes.h"
+cpp_include "folly/io/IOBuf.h"
 
 enum ErrorCode {
     SUCCEEDED = 0;
@@ -41,6 +42,8 @@ typedef i32 (cpp.type = "nebula::PartitionID") PartitionID
 typedef i64 (cpp.type = "nebula::TermID") TermID
 typedef i64 (cpp.type = "nebula::LogID") LogID
 typedef i32 (cpp.type = "nebula::Port") Port
+// The logs are shared with the wal buffer and the rpc buffers, but not copied
+typedef binary (cpp.type = "folly::IOBuf") IOBuf
 
 
 // A request to ask for vote
@@ -63,7 +66,7 @@ struct AskForVoteResponse {
 
 struct LogEntry {
     1: ClusterID cluster;
-    2: binary log_str;
+    2: IOBuf log_str;
 }
 
 
@@ -164,9 +167,32 @@ struct SendSnapshotResponse {
     1: ErrorCode    error_code;
 }
 
+// The heartbeats of many parts to the same peer, the responses are in the
+// same order as the requests
+struct BatchHeartbeatRequest {
+    1: list<HeartbeatRequest> requests;
+}
+
+struct BatchHeartbeatResponse {
+    1: list<HeartbeatResponse> responses;
+}
+
+// The appendLog requests of many parts to the same peer, the responses are in
+// the same order as the requests
+struct BatchAppendLogRequest {
+    1: list<AppendLogRequest> requests;
+}
+
+struct BatchAppendLogResponse {
+    1: list<AppendLogResponse> responses;
+}
+
 service RaftexService {
     AskForVoteResponse askForVote(1: AskForVoteRequest req);
     AppendLogResponse appendLog(1: AppendLogRequest req);
     SendSnapshotResponse sendSnapshot(1: SendSnapshotRequest req);
     HeartbeatResponse heartbeat(1: HeartbeatRequest req) (thread = 'eb');
+
+    BatchHeartbeatResponse batchHeartbeat(1: BatchHeartbeatRequest req) (thread = 'eb');
+    BatchAppendLogResponse batchAppendLog(1: BatchAppendLogRequest req);
 }
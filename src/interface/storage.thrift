@@ -542,6 +542,12 @@ struct LookupIndexRequest {
     5: optional RequestCommon               common,
     // max row count of each partition in this response
     6: optional i64                         limit,
+    // If set, the rows of each partition are aggregated in the storage, grouped by the
+    // return_columns. A row of the return_columns followed by the stats is returned for each
+    // group of each partition, which are partial ones to be merged by the graph. The prop of a
+    // stat is the name of a column like the return_columns, or empty to count the rows. Only
+    // COUNT, SUM, MAX and MIN are supported.
+    7: optional list<StatProp>              stat_columns,
 }
 
 
@@ -560,6 +566,14 @@ struct LookupAndTraverseRequest {
  * End of Index section
  */
 
+struct ScanCursor {
+    1: bool                                 has_next,
+    // next start key of scan, only valid when has_next is true
+    2: optional binary                      next_cursor,
+    // the snapshot which the part is scanned from, only valid when has_next is true
+    3: optional i64                         snapshot_id,
+}
+
 struct ScanVertexRequest {
     1: common.GraphSpaceID                  space_id,
     2: common.PartitionID                   part_id,
@@ -568,7 +582,7 @@ struct ScanVertexRequest {
     4: VertexProp                           return_columns,
     // max row count of tag in this response
     5: i64                                  limit,
-    // only return data in time range [start_time, end_time)
+    // only return data written in time range [start_time, end_time), in microseconds
     6: optional i64                         start_time,
     7: optional i64                         end_time,
     8: optional binary                      filter,
@@ -578,6 +592,13 @@ struct ScanVertexRequest {
     // if set to false, forbid follower read
     10: bool                                enable_read_from_follower = true,
     11: optional RequestCommon              common,
+    // Scan these parts in parallel from their cursors instead of part_id and cursor,
+    // at most limit rows from each part
+    12: optional map<common.PartitionID, ScanCursor>
+        (cpp.template = "std::unordered_map") parts,
+    // Scan each part of parts from a snapshot taken by its first batch, so that all
+    // the batches of a part see the same data
+    13: bool                                use_snapshot = false,
 }
 
 struct ScanVertexResponse {
@@ -589,6 +610,9 @@ struct ScanVertexResponse {
     3: bool                                 has_next,
     // next start key of scan, only valid when has_next is true
     4: optional binary                      next_cursor,
+    // the cursors to go on scanning the parts of the request
+    5: optional map<common.PartitionID, ScanCursor>
+        (cpp.template = "std::unordered_map") cursors,
 }
 
 struct ScanEdgeRequest {
@@ -599,7 +623,7 @@ struct ScanEdgeRequest {
     4: EdgeProp                             return_columns,
     // max row count of edge in this response
     5: i64                                  limit,
-    // only return data in time range [start_time, end_time)
+    // only return data written in time range [start_time, end_time), in microseconds
     6: optional i64                         start_time,
     7: optional i64                         end_time,
     8: optional binary                      filter,
@@ -609,6 +633,13 @@ struct ScanEdgeRequest {
     // if set to false, forbid follower read
     10: bool                                enable_read_from_follower = true,
     11: optional RequestCommon              common,
+    // Scan these parts in parallel from their cursors instead of part_id and cursor,
+    // at most limit rows from each part
+    12: optional map<common.PartitionID, ScanCursor>
+        (cpp.template = "std::unordered_map") parts,
+    // Scan each part of parts from a snapshot taken by its first batch, so that all
+    // the batches of a part see the same data
+    13: bool                                use_snapshot = false,
 }
 
 struct ScanEdgeResponse {
@@ -620,6 +651,9 @@ struct ScanEdgeResponse {
     3: bool                                 has_next,
     // next start key of scan, only valid when has_next is true
     4: optional binary                      next_cursor,
+    // the cursors to go on scanning the parts of the request
+    5: optional map<common.PartitionID, ScanCursor>
+        (cpp.template = "std::unordered_map") cursors,
 }
 
 struct TaskPara {
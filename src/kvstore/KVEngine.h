@@ -66,10 +66,18 @@ class KVEngine {
   virtual nebula::cpp2::ErrorCode prefix(const std::string& prefix,
                                          std::unique_ptr<KVIterator>* iter) = 0;
 
-  // Get all results with 'prefix' str as prefix starting form 'start'
+  // Get all results with 'prefix' str as prefix starting form 'start', read
+  // from the snapshot if it is not null
   virtual nebula::cpp2::ErrorCode rangeWithPrefix(const std::string& start,
                                                   const std::string& prefix,
-                                                  std::unique_ptr<KVIterator>* iter) = 0;
+                                                  std::unique_ptr<KVIterator>* iter,
+                                                  const void* snapshot = nullptr) = 0;
+
+  // Pin a point in time view of the engine, the reads from it see none of
+  // the later writes until it is released. Return null if not supported.
+  virtual const void* getSnapshot() = 0;
+
+  virtual void releaseSnapshot(const void* snapshot) = 0;
 
   virtual nebula::cpp2::ErrorCode scan(std::unique_ptr<KVIterator>* storageIter) = 0;
 
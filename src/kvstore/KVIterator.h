@@ -24,6 +24,13 @@ class KVIterator {
   virtual folly::StringPiece key() const = 0;
 
   virtual folly::StringPiece val() const = 0;
+
+  // Position at the first key not less than `target', which is still bounded by
+  // the range of the iterator. Return false if not supported.
+  virtual bool seek(folly::StringPiece target) {
+    UNUSED(target);
+    return false;
+  }
 };
 
 }  // namespace kvstore
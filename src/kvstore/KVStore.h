@@ -17,6 +17,7 @@
 #include "kvstore/CompactionFilter.h"
 #include "kvstore/KVIterator.h"
 #include "kvstore/PartManager.h"
+#include "kvstore/ReadCache.h"
 #include "kvstore/raftex/RaftPart.h"
 
 namespace nebula {
@@ -48,6 +49,10 @@ struct KVOptions {
 
   // Custom CompactionFilter used in compaction.
   std::unique_ptr<CompactionFilterFactoryBuilder> cffBuilder_{nullptr};
+
+  // Cache of the tag rows and adjacency lists shared by all parts, nullptr
+  // if disabled.
+  std::shared_ptr<ReadCache> readCache_{nullptr};
 };
 
 struct StoreCapability {
@@ -125,13 +130,21 @@ class KVStore {
                                          std::unique_ptr<KVIterator>* iter,
                                          bool canReadFromFollower = false) = delete;
 
-  // Get all results with prefix starting from start
+  // Get all results with prefix starting from start, read from the snapshot
+  // of the part if it is not null
   virtual nebula::cpp2::ErrorCode rangeWithPrefix(GraphSpaceID spaceId,
                                                   PartitionID partId,
                                                   const std::string& start,
                                                   const std::string& prefix,
                                                   std::unique_ptr<KVIterator>* iter,
-                                                  bool canReadFromFollower = false) = 0;
+                                                  bool canReadFromFollower = false,
+                                                  const void* snapshot = nullptr) = 0;
+
+  // Pin a snapshot of the engine of the part, see KVEngine::getSnapshot
+  virtual ErrorOr<nebula::cpp2::ErrorCode, const void*> getSnapshot(
+      GraphSpaceID spaceId, PartitionID partId, bool canReadFromFollower = false) = 0;
+
+  virtual void releaseSnapshot(GraphSpaceID spaceId, PartitionID partId, const void* snapshot) = 0;
 
   // To forbid to pass rvalue via the `rangeWithPrefix' parameter.
   virtual nebula::cpp2::ErrorCode rangeWithPrefix(GraphSpaceID spaceId,
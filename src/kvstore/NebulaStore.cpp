@@ -7,6 +7,8 @@
 
 #include <folly/Likely.h>
 #include <folly/ScopeGuard.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <sys/stat.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
 #include <algorithm>
@@ -24,6 +26,10 @@ DEFINE_int32(custom_filter_interval_secs,
 DEFINE_int32(num_workers, 4, "Number of worker threads");
 DEFINE_int32(clean_wal_interval_secs, 600, "inerval to trigger clean expired wal");
 DEFINE_bool(auto_remove_invalid_space, false, "whether remove data of invalid space when restart");
+DEFINE_uint32(num_commit_threads_per_disk,
+              2,
+              "Number of threads writing the large raft commits of the parts on a disk, "
+              "0 to write them in the raft threads");
 
 DECLARE_bool(rocksdb_disable_wal);
 DECLARE_int32(rocksdb_backup_interval_secs);
@@ -347,6 +353,8 @@ std::shared_ptr<Part> NebulaStore::newPart(GraphSpaceID spaceId,
                                      clientMan_,
                                      diskMan_,
                                      getSpaceVidLen(spaceId));
+  part->setReadCache(options_.readCache_);
+  part->setCommitPool(commitPool(engine));
   std::vector<HostAddr> peers;
   if (defaultPeers.empty()) {
     // pull the information from meta
@@ -390,6 +398,7 @@ void NebulaStore::removeSpace(GraphSpaceID spaceId, bool isListener) {
       for (auto& engine : engines) {
         auto parts = engine->allParts();
         for (auto& partId : parts) {
+          releasePartSnapshots(spaceId, partId);
           engine->removePart(partId);
         }
         CHECK_EQ(0, engine->totalPartsNum());
@@ -433,6 +442,7 @@ void NebulaStore::removePart(GraphSpaceID spaceId, PartitionID partId) {
       diskMan_->removePartFromPath(spaceId, partId, e->getDataRoot());
       partIt->second->resetPart();
       spaceIt->second->parts_.erase(partId);
+      releasePartSnapshots(spaceId, partId);
       e->removePart(partId);
     }
   }
@@ -464,6 +474,27 @@ void NebulaStore::addListener(GraphSpaceID spaceId,
   return;
 }
 
+std::shared_ptr<folly::Executor> NebulaStore::commitPool(KVEngine* engine) {
+  if (FLAGS_num_commit_threads_per_disk == 0) {
+    return nullptr;
+  }
+  struct stat st;
+  dev_t dev = 0;
+  if (::stat(engine->getDataRoot(), &st) == 0) {
+    dev = st.st_dev;
+  } else {
+    LOG(WARNING) << "stat \"" << engine->getDataRoot() << "\" failed, error: " << strerror(errno);
+  }
+  std::lock_guard<std::mutex> g(commitPoolsLock_);
+  auto& pool = commitPools_[dev];
+  if (pool == nullptr) {
+    pool = std::make_shared<folly::CPUThreadPoolExecutor>(
+        FLAGS_num_commit_threads_per_disk,
+        std::make_shared<folly::NamedThreadFactory>("raft-commit"));
+  }
+  return pool;
+}
+
 std::shared_ptr<Listener> NebulaStore::newListener(GraphSpaceID spaceId,
                                                    PartitionID partId,
                                                    meta::cpp2::ListenerType type,
@@ -576,7 +607,28 @@ nebula::cpp2::ErrorCode NebulaStore::get(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->get(key, value);
+  auto* cache = part->readCache();
+  if (cache == nullptr || !ReadCache::isCachedKey(part->vIdLen(), key)) {
+    return part->engine()->get(key, value);
+  }
+
+  auto cached = cache->get(spaceId, key);
+  if (cached.hasValue()) {
+    if (cached.value()->empty()) {
+      return nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND;
+    }
+    *value = cached.value()->front().second;
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  auto version = cache->version(spaceId, key);
+  auto code = part->engine()->get(key, value);
+  if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    auto rows = std::make_shared<ReadCache::Rows>(1, std::make_pair(key, *value));
+    cache->put(spaceId, key, std::move(rows), version);
+  } else if (code == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    cache->put(spaceId, key, std::make_shared<ReadCache::Rows>(), version);
+  }
+  return code;
 }
 
 std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> NebulaStore::multiGet(
@@ -633,7 +685,43 @@ nebula::cpp2::ErrorCode NebulaStore::prefix(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->prefix(prefix, iter);
+  auto* cache = part->readCache();
+  if (cache == nullptr || !ReadCache::isCachedPrefix(part->vIdLen(), prefix)) {
+    return part->engine()->prefix(prefix, iter);
+  }
+
+  auto cached = cache->get(spaceId, prefix);
+  if (cached.hasValue()) {
+    if (cached.value() == nullptr) {
+      // Too big to be cached
+      return part->engine()->prefix(prefix, iter);
+    }
+    *iter = std::make_unique<CachedRowsIter>(std::move(cached).value());
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  // Read the whole adjacency list, and give up caching once it's too big
+  auto version = cache->version(spaceId, prefix);
+  std::unique_ptr<KVIterator> engineIter;
+  auto code = part->engine()->prefix(prefix, &engineIter);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  auto rows = std::make_shared<ReadCache::Rows>();
+  size_t bytes = 0;
+  for (; engineIter->valid(); engineIter->next()) {
+    auto key = engineIter->key();
+    auto val = engineIter->val();
+    bytes += key.size() + val.size();
+    if (cache->tooBig(bytes)) {
+      cache->put(spaceId, prefix, nullptr, version);
+      return part->engine()->prefix(prefix, iter);
+    }
+    rows->emplace_back(key.str(), val.str());
+  }
+  cache->put(spaceId, prefix, rows, version);
+  *iter = std::make_unique<CachedRowsIter>(std::move(rows));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
 nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
@@ -641,7 +729,30 @@ nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
                                                      const std::string& start,
                                                      const std::string& prefix,
                                                      std::unique_ptr<KVIterator>* iter,
-                                                     bool canReadFromFollower) {
+                                                     bool canReadFromFollower,
+                                                     const void* snapshot) {
+  auto ret = part(spaceId, partId);
+  if (!ok(ret)) {
+    return error(ret);
+  }
+  auto part = nebula::value(ret);
+  if (!checkLeader(part, canReadFromFollower)) {
+    return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
+  }
+  if (snapshot != nullptr) {
+    // The snapshot is released if the part has been removed since it is taken
+    std::lock_guard<std::mutex> g(snapshotsLock_);
+    auto it = snapshots_.find(std::make_pair(spaceId, partId));
+    if (it == snapshots_.end() || it->second.count(snapshot) == 0) {
+      return nebula::cpp2::ErrorCode::E_SCAN_SNAPSHOT_EXPIRED;
+    }
+  }
+  return part->engine()->rangeWithPrefix(start, prefix, iter, snapshot);
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, const void*> NebulaStore::getSnapshot(GraphSpaceID spaceId,
+                                                                       PartitionID partId,
+                                                                       bool canReadFromFollower) {
   auto ret = part(spaceId, partId);
   if (!ok(ret)) {
     return error(ret);
@@ -650,7 +761,53 @@ nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->rangeWithPrefix(start, prefix, iter);
+  auto* engine = part->engine();
+  auto* snapshot = engine->getSnapshot();
+  if (snapshot != nullptr) {
+    std::lock_guard<std::mutex> g(snapshotsLock_);
+    snapshots_[std::make_pair(spaceId, partId)].emplace(snapshot, engine);
+  }
+  return snapshot;
+}
+
+void NebulaStore::releaseSnapshot(GraphSpaceID spaceId, PartitionID partId, const void* snapshot) {
+  KVEngine* engine = nullptr;
+  {
+    std::lock_guard<std::mutex> g(snapshotsLock_);
+    auto it = snapshots_.find(std::make_pair(spaceId, partId));
+    if (it == snapshots_.end()) {
+      // Released along with the part
+      return;
+    }
+    auto snapshotIt = it->second.find(snapshot);
+    if (snapshotIt == it->second.end()) {
+      return;
+    }
+    engine = snapshotIt->second;
+    it->second.erase(snapshotIt);
+    if (it->second.empty()) {
+      snapshots_.erase(it);
+    }
+  }
+  engine->releaseSnapshot(snapshot);
+}
+
+void NebulaStore::releasePartSnapshots(GraphSpaceID spaceId, PartitionID partId) {
+  std::unordered_map<const void*, KVEngine*> snapshots;
+  {
+    std::lock_guard<std::mutex> g(snapshotsLock_);
+    auto it = snapshots_.find(std::make_pair(spaceId, partId));
+    if (it == snapshots_.end()) {
+      return;
+    }
+    snapshots = std::move(it->second);
+    snapshots_.erase(it);
+  }
+  LOG(INFO) << "Release " << snapshots.size() << " snapshots of space " << spaceId << ", part "
+            << partId;
+  for (auto& entry : snapshots) {
+    entry.second->releaseSnapshot(entry.first);
+  }
 }
 
 nebula::cpp2::ErrorCode NebulaStore::sync(GraphSpaceID spaceId, PartitionID partId) {
@@ -789,7 +946,13 @@ nebula::cpp2::ErrorCode NebulaStore::ingest(GraphSpaceID spaceId) {
       auto files = nebula::fs::FileUtils::listAllFilesInDir(path.c_str(), true, "*.sst");
       for (auto file : files) {
         LOG(INFO) << "Ingesting extra file: " << file;
+        if (options_.readCache_ != nullptr) {
+          options_.readCache_->invalidateAll();
+        }
         auto code = engine->ingest(std::vector<std::string>({file}));
+        if (options_.readCache_ != nullptr) {
+          options_.readCache_->invalidateAll();
+        }
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           return code;
         }
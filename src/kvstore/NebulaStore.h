@@ -8,6 +8,7 @@
 
 #include <folly/RWSpinLock.h>
 #include <folly/concurrency/ConcurrentHashMap.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest_prod.h>
 
 #include "common/base/Base.h"
@@ -52,6 +53,7 @@ class NebulaStore : public KVStore, public Handler {
   FRIEND_TEST(NebulaStoreTest, CheckpointTest);
   FRIEND_TEST(NebulaStoreTest, ThreeCopiesCheckpointTest);
   FRIEND_TEST(NebulaStoreTest, RemoveInvalidSpaceTest);
+  FRIEND_TEST(NebulaStoreTest, ReleaseSnapshotOfRemovedPartTest);
   friend class ListenerBasicTest;
 
  public:
@@ -156,7 +158,13 @@ class NebulaStore : public KVStore, public Handler {
                                           const std::string& start,
                                           const std::string& prefix,
                                           std::unique_ptr<KVIterator>* iter,
-                                          bool canReadFromFollower = false) override;
+                                          bool canReadFromFollower = false,
+                                          const void* snapshot = nullptr) override;
+
+  ErrorOr<nebula::cpp2::ErrorCode, const void*> getSnapshot(
+      GraphSpaceID spaceId, PartitionID partId, bool canReadFromFollower = false) override;
+
+  void releaseSnapshot(GraphSpaceID spaceId, PartitionID partId, const void* snapshot) override;
 
   // Delete the overloading with a rvalue `prefix'
   nebula::cpp2::ErrorCode rangeWithPrefix(GraphSpaceID spaceId,
@@ -306,6 +314,9 @@ class NebulaStore : public KVStore, public Handler {
                                 bool asLearner,
                                 const std::vector<HostAddr>& defaultPeers);
 
+  // The pool writing the commits of the parts on the same disk as the engine
+  std::shared_ptr<folly::Executor> commitPool(KVEngine* engine);
+
   std::shared_ptr<Listener> newListener(GraphSpaceID spaceId,
                                         PartitionID partId,
                                         meta::cpp2::ListenerType type,
@@ -321,6 +332,10 @@ class NebulaStore : public KVStore, public Handler {
 
   void removeSpaceDir(const std::string& dir);
 
+  // Release the snapshots of the part which are not released yet, before its
+  // data is gone
+  void releasePartSnapshots(GraphSpaceID spaceId, PartitionID partId);
+
  private:
   // The lock used to protect spaces_
   folly::RWSpinLock lock_;
@@ -341,6 +356,15 @@ class NebulaStore : public KVStore, public Handler {
   std::shared_ptr<DiskManager> diskMan_;
   folly::ConcurrentHashMap<std::string, std::function<void(std::shared_ptr<Part>&)>>
       onNewPartAdded_;
+  // The commit pools by the device of the data path
+  std::mutex commitPoolsLock_;
+  std::unordered_map<dev_t, std::shared_ptr<folly::CPUThreadPoolExecutor>> commitPools_;
+  // The snapshots handed out by getSnapshot, with the engine they are taken
+  // from, so that they could be released after their part is gone
+  std::mutex snapshotsLock_;
+  std::unordered_map<std::pair<GraphSpaceID, PartitionID>,
+                     std::unordered_map<const void*, KVEngine*>>
+      snapshots_;
 };
 
 }  // namespace kvstore
@@ -5,6 +5,10 @@
 
 #include "kvstore/Part.h"
 
+#include <folly/ScopeGuard.h>
+#include <folly/futures/Future.h>
+
+#include "common/stats/StatsManager.h"
 #include "common/utils/IndexKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "common/utils/OperationKeyUtils.h"
@@ -12,12 +16,29 @@
 #include "kvstore/RocksEngineConfig.h"
 
 DEFINE_int32(cluster_id, 0, "A unique id for each cluster");
+DEFINE_uint32(raft_commit_batch_bytes,
+              4 * 1024 * 1024,
+              "The logs of a large commit are written by batches of this size, the next "
+              "batch is decoded while the previous one is being written, 0 to write the "
+              "logs of a commit in one batch");
 
 namespace nebula {
 namespace kvstore {
 
 using nebula::raftex::AppendLogResult;
 
+namespace {
+
+// The number of the logs in the wal not applied yet after a commit, of all
+// the parts on this host
+const stats::CounterId& applyLagLogs() {
+  static const stats::CounterId id =
+      stats::StatsManager::registerStats("raft_apply_lag_logs", "avg, max");
+  return id;
+}
+
+}  // namespace
+
 Part::Part(GraphSpaceID spaceId,
            PartitionID partId,
            HostAddr localAddr,
@@ -45,7 +66,10 @@ Part::Part(GraphSpaceID spaceId,
       partId_(partId),
       walPath_(walPath),
       engine_(engine),
-      vIdLen_(vIdLen) {}
+      vIdLen_(vIdLen) {
+  // Registered ahead of the first commit
+  applyLagLogs();
+}
 
 std::pair<LogID, TermID> Part::lastCommittedLogId() {
   std::string val;
@@ -214,6 +238,25 @@ void Part::onDiscoverNewLeader(HostAddr nLeader) {
 
 cpp2::ErrorCode Part::commitLogs(std::unique_ptr<LogIterator> iter, bool wait) {
   auto batch = engine_->startBatchWrite();
+  // The cache entries touched by the batch
+  std::vector<std::string> cacheEntries;
+  bool invalidateCache = false;
+  // The size of the logs in the batch, and the previous batch being written
+  size_t batchBytes = 0;
+  auto writing = folly::makeFuture(nebula::cpp2::ErrorCode::SUCCEEDED);
+  SCOPE_EXIT {
+    if (writing.valid()) {
+      writing.wait();
+    }
+  };
+  auto touch = [this, &cacheEntries](folly::StringPiece key) {
+    if (readCache_ != nullptr) {
+      auto entry = ReadCache::entryOf(vIdLen_, key);
+      if (!entry.empty()) {
+        cacheEntries.emplace_back(entry.str());
+      }
+    }
+  };
   LogID lastId = -1;
   TermID lastTerm = -1;
   while (iter->valid()) {
@@ -225,12 +268,14 @@ cpp2::ErrorCode Part::commitLogs(std::unique_ptr<LogIterator> iter, bool wait) {
       ++(*iter);
       continue;
     }
+    batchBytes += log.size();
     DCHECK_GE(log.size(), sizeof(int64_t) + 1 + sizeof(uint32_t));
     // Skip the timestamp (type of int64_t)
     switch (log[sizeof(int64_t)]) {
       case OP_PUT: {
         auto pieces = decodeMultiValues(log);
         DCHECK_EQ(2, pieces.size());
+        touch(pieces[0]);
         auto code = batch->put(pieces[0], pieces[1]);
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           LOG(ERROR) << idStr_ << "Failed to call WriteBatch::put()";
@@ -245,6 +290,7 @@ cpp2::ErrorCode Part::commitLogs(std::unique_ptr<LogIterator> iter, bool wait) {
         for (size_t i = 0; i < kvs.size(); i += 2) {
           VLOG(1) << "OP_MULTI_PUT " << folly::hexlify(kvs[i])
                   << ", val = " << folly::hexlify(kvs[i + 1]);
+          touch(kvs[i]);
           auto code = batch->put(kvs[i], kvs[i + 1]);
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             LOG(ERROR) << idStr_ << "Failed to call WriteBatch::put()";
@@ -255,6 +301,7 @@ cpp2::ErrorCode Part::commitLogs(std::unique_ptr<LogIterator> iter, bool wait) {
       }
       case OP_REMOVE: {
         auto key = decodeSingleValue(log);
+        touch(key);
         auto code = batch->remove(key);
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           LOG(ERROR) << idStr_ << "Failed to call WriteBatch::remove()";
@@ -265,6 +312,7 @@ cpp2::ErrorCode Part::commitLogs(std::unique_ptr<LogIterator> iter, bool wait) {
       case OP_MULTI_REMOVE: {
         auto keys = decodeMultiValues(log);
         for (auto k : keys) {
+          touch(k);
           auto code = batch->remove(k);
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             LOG(ERROR) << idStr_ << "Failed to call WriteBatch::remove()";
@@ -276,6 +324,7 @@ cpp2::ErrorCode Part::commitLogs(std::unique_ptr<LogIterator> iter, bool wait) {
       case OP_REMOVE_RANGE: {
         auto range = decodeMultiValues(log);
         DCHECK_EQ(2, range.size());
+        invalidateCache = true;
         auto code = batch->removeRange(range[0], range[1]);
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           LOG(ERROR) << idStr_ << "Failed to call WriteBatch::removeRange()";
@@ -290,10 +339,13 @@ cpp2::ErrorCode Part::commitLogs(std::unique_ptr<LogIterator> iter, bool wait) {
                   << ", val=" << folly::hexlify(op.second.second);
           auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
           if (op.first == BatchLogType::OP_BATCH_PUT) {
+            touch(op.second.first);
             code = batch->put(op.second.first, op.second.second);
           } else if (op.first == BatchLogType::OP_BATCH_REMOVE) {
+            touch(op.second.first);
             code = batch->remove(op.second.first);
           } else if (op.first == BatchLogType::OP_BATCH_REMOVE_RANGE) {
+            invalidateCache = true;
             code = batch->removeRange(op.second.first, op.second.second);
           }
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -337,17 +389,81 @@ cpp2::ErrorCode Part::commitLogs(std::unique_ptr<LogIterator> iter, bool wait) {
     }
 
     ++(*iter);
+
+    if (commitPool_ != nullptr && FLAGS_raft_commit_batch_bytes > 0 &&
+        batchBytes >= FLAGS_raft_commit_batch_bytes && iter->valid()) {
+      // Hand the batch over to the pool, and decode the next one meanwhile.
+      // Each batch carries its own commit msg, so the logs are applied up to
+      // the last written batch if the commit stops halfway, and the rest are
+      // applied again by the next commit.
+      auto code = std::move(writing).get();
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
+      code = putCommitMsg(batch.get(), lastId, lastTerm);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        LOG(ERROR) << idStr_ << "Commit msg failed";
+        return code;
+      }
+      auto write = [this,
+                    batch = std::move(batch),
+                    cacheEntries = std::move(cacheEntries),
+                    invalidateCache,
+                    wait]() mutable {
+        return writeBatch(std::move(batch), cacheEntries, invalidateCache, wait);
+      };
+      writing = folly::via(commitPool_.get(), std::move(write));
+      batch = engine_->startBatchWrite();
+      cacheEntries.clear();
+      invalidateCache = false;
+      batchBytes = 0;
+    }
   }
 
+  auto code = std::move(writing).get();
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
   if (lastId >= 0) {
-    auto code = putCommitMsg(batch.get(), lastId, lastTerm);
+    code = putCommitMsg(batch.get(), lastId, lastTerm);
     if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
       LOG(ERROR) << idStr_ << "Commit msg failed";
       return code;
     }
   }
-  return engine_->commitBatchWrite(
+  code = writeBatch(std::move(batch), cacheEntries, invalidateCache, wait);
+  if (code == nebula::cpp2::ErrorCode::SUCCEEDED && lastId >= 0) {
+    stats::StatsManager::addValue(applyLagLogs(), wal()->lastLogId() - lastId);
+  }
+  return code;
+}
+
+nebula::cpp2::ErrorCode Part::writeBatch(std::unique_ptr<WriteBatch> batch,
+                                         const std::vector<std::string>& cacheEntries,
+                                         bool invalidateCache,
+                                         bool wait) {
+  if (readCache_ == nullptr) {
+    return engine_->commitBatchWrite(
+        std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, wait);
+  }
+
+  // Invalidate the cache around the write in the commit order, see ReadCache.
+  // The followers apply the same logs, so the cache of a new leader is never
+  // stale.
+  auto invalidate = [&](auto&& func) {
+    if (invalidateCache) {
+      readCache_->invalidateAll();
+    } else {
+      for (auto& entry : cacheEntries) {
+        func(entry);
+      }
+    }
+  };
+  invalidate([this](const std::string& entry) { readCache_->beforeWrite(spaceId_, entry); });
+  auto code = engine_->commitBatchWrite(
       std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, wait);
+  invalidate([this](const std::string& entry) { readCache_->afterWrite(spaceId_, entry); });
+  return code;
 }
 
 std::pair<int64_t, int64_t> Part::commitSnapshot(const std::vector<std::string>& rows,
@@ -373,9 +489,15 @@ std::pair<int64_t, int64_t> Part::commitSnapshot(const std::vector<std::string>&
       return std::make_pair(0, 0);
     }
   }
+  if (readCache_ != nullptr) {
+    readCache_->invalidateAll();
+  }
   // For snapshot, we open the rocksdb's wal to avoid loss data if crash.
   auto code = engine_->commitBatchWrite(
       std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, true);
+  if (readCache_ != nullptr) {
+    readCache_->invalidateAll();
+  }
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     LOG(ERROR) << idStr_ << "Put failed in commit";
     return std::make_pair(0, 0);
@@ -456,7 +578,12 @@ bool Part::preProcessLog(LogID logId, TermID termId, ClusterID clusterId, const
 
 void Part::cleanup() {
   LOG(INFO) << idStr_ << "Clean rocksdb part data";
-  // Remove the vertex, edge, index, systemCommitKey, operation data under the part
+  SCOPE_EXIT {
+    if (readCache_ != nullptr) {
+      readCache_->invalidateAll();
+    }
+  };
+  // Remove the vertex, edge, index, degree, systemCommitKey, operation data under the part
   const auto& vertexPre = NebulaKeyUtils::vertexPrefix(partId_);
   auto ret = engine_->removeRange(NebulaKeyUtils::firstKey(vertexPre, vIdLen_),
                                   NebulaKeyUtils::lastKey(vertexPre, vIdLen_));
@@ -483,6 +610,15 @@ void Part::cleanup() {
     return;
   }
 
+  const auto& degreePre = NebulaKeyUtils::degreePrefix(partId_);
+  ret = engine_->removeRange(NebulaKeyUtils::firstKey(degreePre, vIdLen_ + sizeof(EdgeType)),
+                             NebulaKeyUtils::lastKey(degreePre, vIdLen_ + sizeof(EdgeType)));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    LOG(ERROR) << idStr_ << "Remove the part degree data failed, error "
+               << static_cast<int32_t>(ret);
+    return;
+  }
+
   const auto& operationPre = OperationKeyUtils::operationPrefix(partId_);
   ret = engine_->removeRange(NebulaKeyUtils::firstKey(operationPre, sizeof(int64_t)),
                              NebulaKeyUtils::lastKey(operationPre, sizeof(int64_t)));
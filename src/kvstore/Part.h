@@ -10,6 +10,7 @@
 #include "common/utils/NebulaKeyUtils.h"
 #include "kvstore/Common.h"
 #include "kvstore/KVEngine.h"
+#include "kvstore/ReadCache.h"
 #include "kvstore/raftex/SnapshotManager.h"
 #include "kvstore/wal/FileBasedWal.h"
 #include "raftex/RaftPart.h"
@@ -40,6 +41,19 @@ class Part : public raftex::RaftPart {
 
   KVEngine* engine() { return engine_; }
 
+  int32_t vIdLen() const { return vIdLen_; }
+
+  // The cache is invalidated when the logs are committed, so it must be set
+  // before the part is started
+  void setReadCache(std::shared_ptr<ReadCache> cache) { readCache_ = std::move(cache); }
+
+  ReadCache* readCache() const { return readCache_.get(); }
+
+  // The large commits are written by batches in the pool, while the next batch
+  // is being built, see --raft_commit_batch_bytes. It must be set before the
+  // part is started
+  void setCommitPool(std::shared_ptr<folly::Executor> pool) { commitPool_ = std::move(pool); }
+
   void asyncPut(folly::StringPiece key, folly::StringPiece value, KVCallback cb);
   void asyncMultiPut(const std::vector<KV>& keyValues, KVCallback cb);
 
@@ -104,6 +118,12 @@ class Part : public raftex::RaftPart {
                                        LogID committedLogId,
                                        TermID committedLogTerm);
 
+  // Write the batch of the logs, and invalidate the cache entries it touches
+  nebula::cpp2::ErrorCode writeBatch(std::unique_ptr<WriteBatch> batch,
+                                     const std::vector<std::string>& cacheEntries,
+                                     bool invalidateCache,
+                                     bool wait);
+
   void cleanup() override;
 
   nebula::cpp2::ErrorCode toResultCode(raftex::AppendLogResult res);
@@ -131,6 +151,8 @@ class Part : public raftex::RaftPart {
  private:
   KVEngine* engine_ = nullptr;
   int32_t vIdLen_;
+  std::shared_ptr<ReadCache> readCache_;
+  std::shared_ptr<folly::Executor> commitPool_;
 };
 
 }  // namespace kvstore
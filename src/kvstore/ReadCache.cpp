@@ -0,0 +1,166 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/ReadCache.h"
+
+#include "common/utils/NebulaKeyUtils.h"
+
+namespace nebula {
+namespace kvstore {
+
+namespace {
+// About the memory taken by an entry besides the key and the rows
+constexpr size_t kEntryOverhead = 96;
+}  // namespace
+
+ReadCache::ReadCache(size_t capacity, uint32_t shardsExp)
+    : shardCapacity_(capacity >> shardsExp),
+      // An entry takes at most 1/8 of a shard, so that a big adjacency list
+      // won't evict all the others
+      maxEntryBytes_(shardCapacity_ / 8),
+      shards_(new Shard[1UL << shardsExp]),
+      mask_((1UL << shardsExp) - 1) {
+  numHits_ = stats::StatsManager::registerStats("num_read_cache_hits", "rate, sum");
+  numMisses_ = stats::StatsManager::registerStats("num_read_cache_misses", "rate, sum");
+}
+
+// static
+bool ReadCache::isCachedKey(size_t vIdLen, folly::StringPiece key) {
+  return NebulaKeyUtils::isVertex(vIdLen, key);
+}
+
+// static
+bool ReadCache::isCachedPrefix(size_t vIdLen, folly::StringPiece prefix) {
+  if (prefix.size() != sizeof(PartitionID) + vIdLen + sizeof(EdgeType)) {
+    return false;
+  }
+  auto type = readInt<uint32_t>(prefix.data(), sizeof(NebulaKeyType)) & kTypeMask;
+  return static_cast<NebulaKeyType>(type) == NebulaKeyType::kEdge;
+}
+
+// static
+folly::StringPiece ReadCache::entryOf(size_t vIdLen, folly::StringPiece key) {
+  if (NebulaKeyUtils::isVertex(vIdLen, key)) {
+    return key;
+  }
+  if (NebulaKeyUtils::isEdge(vIdLen, key) || NebulaKeyUtils::isLock(vIdLen, key)) {
+    return key.subpiece(0, sizeof(PartitionID) + vIdLen + sizeof(EdgeType));
+  }
+  return folly::StringPiece();
+}
+
+// static
+std::string ReadCache::cacheKey(GraphSpaceID spaceId, folly::StringPiece key) {
+  std::string ck;
+  ck.reserve(sizeof(GraphSpaceID) + key.size());
+  ck.append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID));
+  ck.append(key.data(), key.size());
+  return ck;
+}
+
+ReadCache::Shard& ReadCache::shardOf(folly::StringPiece cacheKey) const {
+  return shards_[folly::hasher<folly::StringPiece>()(cacheKey) & mask_];
+}
+
+uint64_t ReadCache::version(GraphSpaceID spaceId, folly::StringPiece key) const {
+  return shardOf(cacheKey(spaceId, key)).version.load();
+}
+
+folly::Optional<std::shared_ptr<const ReadCache::Rows>> ReadCache::get(GraphSpaceID spaceId,
+                                                                       folly::StringPiece key) {
+  auto ck = cacheKey(spaceId, key);
+  auto& shard = shardOf(ck);
+  folly::Optional<std::shared_ptr<const Rows>> rows;
+  {
+    std::lock_guard<std::mutex> guard(shard.lock);
+    auto it = shard.index.find(ck);
+    if (it != shard.index.end()) {
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+      rows = it->second->rows;
+    }
+  }
+  stats::StatsManager::addValue(rows.hasValue() ? numHits_ : numMisses_);
+  return rows;
+}
+
+void ReadCache::put(GraphSpaceID spaceId,
+                    folly::StringPiece key,
+                    std::shared_ptr<const Rows> rows,
+                    uint64_t version) {
+  auto ck = cacheKey(spaceId, key);
+  size_t bytes = kEntryOverhead + ck.size();
+  if (rows != nullptr) {
+    for (auto& row : *rows) {
+      bytes += row.first.size() + row.second.size();
+    }
+    if (tooBig(bytes)) {
+      rows = nullptr;
+      bytes = kEntryOverhead + ck.size();
+    }
+  }
+
+  auto& shard = shardOf(ck);
+  std::lock_guard<std::mutex> guard(shard.lock);
+  if (shard.version.load() != version) {
+    // Written since the rows were read
+    return;
+  }
+  auto it = shard.index.find(ck);
+  if (it != shard.index.end()) {
+    shard.erase(it->second);
+  }
+  shard.lru.push_front(Shard::Entry{std::move(ck), std::move(rows), bytes});
+  shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+  shard.bytes += bytes;
+  while (shard.bytes > shardCapacity_ && shard.lru.size() > 1) {
+    shard.erase(std::prev(shard.lru.end()));
+  }
+}
+
+void ReadCache::beforeWrite(GraphSpaceID spaceId, folly::StringPiece entry) {
+  shardOf(cacheKey(spaceId, entry)).version.fetch_add(1);
+}
+
+void ReadCache::afterWrite(GraphSpaceID spaceId, folly::StringPiece entry) {
+  auto ck = cacheKey(spaceId, entry);
+  auto& shard = shardOf(ck);
+  std::lock_guard<std::mutex> guard(shard.lock);
+  // Bumped again, a reader which took the version after beforeWrite() might
+  // have read the engine before the write landed
+  shard.version.fetch_add(1);
+  auto it = shard.index.find(ck);
+  if (it != shard.index.end()) {
+    shard.erase(it->second);
+  }
+}
+
+void ReadCache::invalidateAll() {
+  for (size_t i = 0; i <= mask_; ++i) {
+    auto& shard = shards_[i];
+    shard.version.fetch_add(1);
+    std::lock_guard<std::mutex> guard(shard.lock);
+    shard.index.clear();
+    shard.lru.clear();
+    shard.bytes = 0;
+  }
+}
+
+size_t ReadCache::size() const {
+  size_t size = 0;
+  for (size_t i = 0; i <= mask_; ++i) {
+    std::lock_guard<std::mutex> guard(shards_[i].lock);
+    size += shards_[i].lru.size();
+  }
+  return size;
+}
+
+void ReadCache::Shard::erase(std::list<Entry>::iterator it) {
+  bytes -= it->bytes;
+  index.erase(it->key);
+  lru.erase(it);
+}
+
+}  // namespace kvstore
+}  // namespace nebula
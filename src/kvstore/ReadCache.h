@@ -0,0 +1,141 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_READCACHE_H_
+#define KVSTORE_READCACHE_H_
+
+#include <folly/Optional.h>
+#include <folly/hash/Hash.h>
+
+#include <list>
+
+#include "common/base/Base.h"
+#include "common/stats/StatsManager.h"
+#include "kvstore/KVIterator.h"
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * A memory bounded cache of the rows read from the engines, for the hot
+ * vertices which are read again and again. It caches the tag rows by their
+ * keys, and the whole adjacency list of an edge type by the edge prefix
+ * (part, vid, edgeType).
+ *
+ * The cache is invalidated by Part in the order the logs are committed: the
+ * versions of the shards touched by a batch are bumped both before and after
+ * the batch is written, and the entries are evicted after it's written. A
+ * reader takes the version before reading the engine, and fills the cache
+ * only if the version is still the same, so the rows read before a commit
+ * are never cached after it.
+ */
+class ReadCache final {
+ public:
+  using Rows = std::vector<std::pair<std::string, std::string>>;
+
+  // `capacity' in bytes, split evenly by 2^shardsExp shards
+  explicit ReadCache(size_t capacity, uint32_t shardsExp = 6);
+
+  // Whether the key is a tag row which could be cached
+  static bool isCachedKey(size_t vIdLen, folly::StringPiece key);
+
+  // Whether the prefix is an adjacency list which could be cached
+  static bool isCachedPrefix(size_t vIdLen, folly::StringPiece prefix);
+
+  // The entry to invalidate when `key' is written, which is the key itself
+  // for a tag row, or the adjacency list it belongs to for an edge, or empty
+  // if the key is never cached
+  static folly::StringPiece entryOf(size_t vIdLen, folly::StringPiece key);
+
+  // The version to pass to put(), which must be taken before reading the
+  // engine
+  uint64_t version(GraphSpaceID spaceId, folly::StringPiece key) const;
+
+  // Return folly::none if missed. The rows of a cached entry are empty if
+  // the tag row or the adjacency list doesn't exist, or nullptr if they're
+  // too big to be cached, in which case the engine should be read instead.
+  folly::Optional<std::shared_ptr<const Rows>> get(GraphSpaceID spaceId, folly::StringPiece key);
+
+  // Cache the rows if the version is not changed since `version', nullptr
+  // to remember the rows are too big
+  void put(GraphSpaceID spaceId,
+           folly::StringPiece key,
+           std::shared_ptr<const Rows> rows,
+           uint64_t version);
+
+  // Whether the rows are too big to be cached
+  bool tooBig(size_t bytes) const { return bytes > maxEntryBytes_; }
+
+  // Called before writing the key to the engine
+  void beforeWrite(GraphSpaceID spaceId, folly::StringPiece entry);
+
+  // Called after the key is written to the engine
+  void afterWrite(GraphSpaceID spaceId, folly::StringPiece entry);
+
+  // Invalidate everything, e.g. when a range is removed or a snapshot is
+  // received. Call it both before and after writing.
+  void invalidateAll();
+
+  size_t size() const;
+
+ private:
+  struct Shard {
+    struct Entry {
+      std::string key;
+      std::shared_ptr<const Rows> rows;
+      size_t bytes;
+    };
+
+    mutable std::mutex lock;
+    std::atomic<uint64_t> version{0};
+    // The front is the most recently used
+    std::list<Entry> lru;
+    std::unordered_map<folly::StringPiece,
+                       std::list<Entry>::iterator,
+                       folly::hasher<folly::StringPiece>>
+        index;
+    size_t bytes{0};
+
+    void erase(std::list<Entry>::iterator it);
+  };
+
+  static std::string cacheKey(GraphSpaceID spaceId, folly::StringPiece key);
+
+  Shard& shardOf(folly::StringPiece cacheKey) const;
+
+  size_t shardCapacity_;
+  size_t maxEntryBytes_;
+  std::unique_ptr<Shard[]> shards_;
+  size_t mask_;
+
+  stats::CounterId numHits_;
+  stats::CounterId numMisses_;
+};
+
+// Iterate over the cached rows
+class CachedRowsIter final : public KVIterator {
+ public:
+  explicit CachedRowsIter(std::shared_ptr<const ReadCache::Rows> rows) : rows_(std::move(rows)) {}
+
+  bool valid() const override { return pos_ < rows_->size(); }
+
+  void next() override { ++pos_; }
+
+  void prev() override { --pos_; }
+
+  folly::StringPiece key() const override { return (*rows_)[pos_].first; }
+
+  folly::StringPiece val() const override { return (*rows_)[pos_].second; }
+
+ private:
+  std::shared_ptr<const ReadCache::Rows> rows_;
+  // Wraps around to be invalid if prev() at the beginning
+  size_t pos_{0};
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+
+#endif  // KVSTORE_READCACHE_H_
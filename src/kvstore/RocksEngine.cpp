@@ -248,10 +248,14 @@ nebula::cpp2::ErrorCode RocksEngine::prefixWithoutExtractor(
 
 nebula::cpp2::ErrorCode RocksEngine::rangeWithPrefix(const std::string& start,
                                                      const std::string& prefix,
-                                                     std::unique_ptr<KVIterator>* storageIter) {
+                                                     std::unique_ptr<KVIterator>* storageIter,
+                                                     const void* snapshot) {
   rocksdb::ReadOptions options;
   // prefix_same_as_start is false by default
   options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
+  if (snapshot != nullptr) {
+    options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
+  }
   rocksdb::Iterator* iter = db_->NewIterator(options);
   if (iter) {
     iter->Seek(rocksdb::Slice(start));
@@ -260,6 +264,12 @@ nebula::cpp2::ErrorCode RocksEngine::rangeWithPrefix(const std::string& start,
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+const void* RocksEngine::getSnapshot() { return db_->GetSnapshot(); }
+
+void RocksEngine::releaseSnapshot(const void* snapshot) {
+  db_->ReleaseSnapshot(reinterpret_cast<const rocksdb::Snapshot*>(snapshot));
+}
+
 nebula::cpp2::ErrorCode RocksEngine::scan(std::unique_ptr<KVIterator>* storageIter) {
   rocksdb::ReadOptions options;
   options.total_order_seek = true;
@@ -42,6 +42,14 @@ class RocksRangeIter : public KVIterator {
     return folly::StringPiece(iter_->value().data(), iter_->value().size());
   }
 
+  bool seek(folly::StringPiece target) override {
+    if (!iter_) {
+      return false;
+    }
+    iter_->Seek(rocksdb::Slice(target.data(), target.size()));
+    return true;
+  }
+
  private:
   std::unique_ptr<rocksdb::Iterator> iter_;
   rocksdb::Slice start_;
@@ -150,7 +158,12 @@ class RocksEngine : public KVEngine {
 
   nebula::cpp2::ErrorCode rangeWithPrefix(const std::string& start,
                                           const std::string& prefix,
-                                          std::unique_ptr<KVIterator>* iter) override;
+                                          std::unique_ptr<KVIterator>* iter,
+                                          const void* snapshot = nullptr) override;
+
+  const void* getSnapshot() override;
+
+  void releaseSnapshot(const void* snapshot) override;
 
   nebula::cpp2::ErrorCode prefixWithExtractor(const std::string& prefix,
                                               std::unique_ptr<KVIterator>* storageIter);
@@ -393,7 +393,7 @@ std::shared_ptr<cpp2::AppendLogRequest> Host::prepareAppendLogRequest() {
          ++(*it), ++cnt) {
       cpp2::LogEntry le;
       le.set_cluster(it->logSource());
-      le.set_log_str(it->logMsg().toString());
+      le.set_log_str(it->logMsgBuf());
       logs.emplace_back(std::move(le));
     }
     req->set_log_str_list(std::move(logs));
@@ -446,6 +446,9 @@ folly::Future<cpp2::AppendLogResponse> Host::sendAppendLogRequest(
                                  << req->get_committed_log_id() << ", last_log_term_sent"
                                  << req->get_last_log_term_sent() << ", last_log_id_sent "
                                  << req->get_last_log_id_sent();
+  if (part_->batcher_ != nullptr) {
+    return part_->batcher_->appendLog(part_->clientMan_, eb, addr_, *req);
+  }
   // Get client connection
   auto client = part_->clientMan_->client(addr_, eb, false, FLAGS_raft_rpc_timeout_ms);
   return client->future_appendLog(*req);
@@ -508,6 +511,9 @@ folly::Future<cpp2::HeartbeatResponse> Host::sendHeartbeatRequest(
                                  << req->get_committed_log_id() << ", last_log_term_sent "
                                  << req->get_last_log_term_sent() << ", last_log_id_sent "
                                  << req->get_last_log_id_sent();
+  if (part_->batcher_ != nullptr) {
+    return part_->batcher_->heartbeat(part_->clientMan_, eb, addr_, *req);
+  }
   // Get client connection
   auto client = part_->clientMan_->client(addr_, eb, false, FLAGS_raft_rpc_timeout_ms);
   return client->future_heartbeat(*req);
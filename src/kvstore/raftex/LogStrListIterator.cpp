@@ -13,8 +13,8 @@ namespace raftex {
 
 LogStrListIterator::LogStrListIterator(LogID firstLogId,
                                        TermID term,
-                                       std::vector<cpp2::LogEntry> logEntries)
-    : firstLogId_(firstLogId), term_(term), logEntries_(std::move(logEntries)) {
+                                       const std::vector<cpp2::LogEntry>& logEntries)
+    : firstLogId_(firstLogId), term_(term), logEntries_(logEntries) {
   idx_ = 0;
 }
 
@@ -42,7 +42,13 @@ ClusterID LogStrListIterator::logSource() const {
 
 folly::StringPiece LogStrListIterator::logMsg() const {
   DCHECK(valid());
-  return logEntries_.at(idx_).get_log_str();
+  auto* buf = &logEntries_.at(idx_).get_log_str();
+  if (buf->isChained()) {
+    // The log is split across the buffers read from the socket
+    coalesced_ = buf->cloneCoalescedAsValue();
+    buf = &coalesced_;
+  }
+  return folly::StringPiece(reinterpret_cast<const char*>(buf->data()), buf->length());
 }
 
 }  // namespace raftex
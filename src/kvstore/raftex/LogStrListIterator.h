@@ -15,7 +15,10 @@ namespace raftex {
 
 class LogStrListIterator final : public LogIterator {
  public:
-  LogStrListIterator(LogID firstLogId, TermID term, std::vector<cpp2::LogEntry> logEntries);
+  // The entries must be kept until the iterator is destroyed
+  LogStrListIterator(LogID firstLogId,
+                     TermID term,
+                     const std::vector<cpp2::LogEntry>& logEntries);
 
   LogIterator& operator++() override;
 
@@ -30,7 +33,9 @@ class LogStrListIterator final : public LogIterator {
   const LogID firstLogId_;
   const TermID term_;
   size_t idx_;
-  std::vector<cpp2::LogEntry> logEntries_;
+  const std::vector<cpp2::LogEntry>& logEntries_;
+  // The current log if it is not in one buffer
+  mutable folly::IOBuf coalesced_;
 };
 
 }  // namespace raftex
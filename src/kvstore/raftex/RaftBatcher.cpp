@@ -0,0 +1,222 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/raftex/RaftBatcher.h"
+
+#include <folly/futures/Future.h>
+#include <folly/io/async/EventBase.h>
+#include <thrift/lib/cpp/TApplicationException.h>
+
+#include "common/time/WallClock.h"
+
+DEFINE_uint32(raft_max_batch_requests,
+              256,
+              "The max number of requests of different parts to the same peer "
+              "in each batched heartbeat or appendLog RPC");
+DEFINE_uint32(raft_max_inflight_batches,
+              4,
+              "The max number of batches of the same kind in flight to the same peer");
+DEFINE_uint32(raft_batch_reprobe_interval_secs,
+              60,
+              "How long to send the plain RPCs to a peer which doesn't know the "
+              "batched ones, before trying the batched ones again");
+DEFINE_uint32(raft_heartbeat_batch_window_ms,
+              20,
+              "How long a heartbeat waits for the ones of other parts to the "
+              "same peer before they are sent in one RPC");
+
+DECLARE_int32(raft_rpc_timeout_ms);
+
+namespace nebula {
+namespace raftex {
+
+struct RaftBatcher::HeartbeatTraits {
+  using Req = cpp2::HeartbeatRequest;
+  using Resp = cpp2::HeartbeatResponse;
+  using BatchReq = cpp2::BatchHeartbeatRequest;
+  using BatchResp = cpp2::BatchHeartbeatResponse;
+
+  static uint32_t windowMs() { return FLAGS_raft_heartbeat_batch_window_ms; }
+
+  static folly::Future<Resp> send(cpp2::RaftexServiceAsyncClient* client, const Req& req) {
+    return client->future_heartbeat(req);
+  }
+
+  static folly::Future<BatchResp> sendBatch(cpp2::RaftexServiceAsyncClient* client,
+                                            const BatchReq& req) {
+    return client->future_batchHeartbeat(req);
+  }
+};
+
+struct RaftBatcher::AppendLogTraits {
+  using Req = cpp2::AppendLogRequest;
+  using Resp = cpp2::AppendLogResponse;
+  using BatchReq = cpp2::BatchAppendLogRequest;
+  using BatchResp = cpp2::BatchAppendLogResponse;
+
+  static uint32_t windowMs() { return 0; }
+
+  static folly::Future<Resp> send(cpp2::RaftexServiceAsyncClient* client, const Req& req) {
+    return client->future_appendLog(req);
+  }
+
+  static folly::Future<BatchResp> sendBatch(cpp2::RaftexServiceAsyncClient* client,
+                                            const BatchReq& req) {
+    return client->future_batchAppendLog(req);
+  }
+};
+
+namespace {
+
+template <typename Traits>
+bool batchSupported(const RaftBatcher::Queue<Traits>& queue) {
+  auto since = queue.unsupportedSince.load();
+  return since == 0 || time::WallClock::fastNowInMilliSec() - since >=
+                           static_cast<int64_t>(FLAGS_raft_batch_reprobe_interval_secs) * 1000;
+}
+
+// Send the pending requests of the queue, and then the ones queued meanwhile
+// until there is none
+template <typename Traits>
+void flush(std::shared_ptr<RaftBatcher::Queue<Traits>> queue,
+           std::shared_ptr<RaftBatcher::ClientManager> clientMan,
+           folly::EventBase* eb,
+           HostAddr addr) {
+  using Pending = typename RaftBatcher::Queue<Traits>::Pending;
+  std::vector<Pending> batch;
+  {
+    std::lock_guard<std::mutex> g(queue->lock);
+    if (queue->pending.empty()) {
+      --queue->inFlight;
+      return;
+    }
+    auto& pending = queue->pending;
+    auto n = std::min<size_t>(pending.size(), std::max(FLAGS_raft_max_batch_requests, 1U));
+    batch.reserve(n);
+    std::move(pending.begin(), pending.begin() + n, std::back_inserter(batch));
+    pending.erase(pending.begin(), pending.begin() + n);
+  }
+
+  auto client = clientMan->client(addr, eb, false, FLAGS_raft_rpc_timeout_ms);
+  auto next = [queue, clientMan, eb, addr]() mutable {
+    flush<Traits>(std::move(queue), std::move(clientMan), eb, std::move(addr));
+  };
+
+  if (batch.size() == 1 || !batchSupported(*queue)) {
+    std::vector<folly::Future<folly::Unit>> futures;
+    futures.reserve(batch.size());
+    for (auto& pending : batch) {
+      futures.emplace_back(
+          Traits::send(client.get(), pending.first)
+              .via(eb)
+              .thenTry([promise = std::move(pending.second)](
+                           folly::Try<typename Traits::Resp>&& t) mutable {
+                promise.setTry(std::move(t));
+              }));
+    }
+    folly::collectAll(futures).via(eb).thenValue([next = std::move(next)](auto&&) mutable {
+      next();
+    });
+    return;
+  }
+
+  typename Traits::BatchReq req;
+  std::vector<typename Traits::Req> requests;
+  requests.reserve(batch.size());
+  for (auto& pending : batch) {
+    requests.emplace_back(std::move(pending.first));
+  }
+  req.set_requests(std::move(requests));
+  Traits::sendBatch(client.get(), req)
+      .via(eb)
+      .thenTry([queue, batch = std::move(batch), next = std::move(next)](
+                   folly::Try<typename Traits::BatchResp>&& t) mutable {
+        if (t.hasException()) {
+          if (t.exception().template is_compatible_with<apache::thrift::TApplicationException>()) {
+            LOG(WARNING) << "The peer doesn't support the batched raft RPCs, send one by one";
+            queue->unsupportedSince = time::WallClock::fastNowInMilliSec();
+          }
+          for (auto& pending : batch) {
+            pending.second.setException(t.exception());
+          }
+        } else {
+          queue->unsupportedSince = 0;
+          auto& responses = t.value().get_responses();
+          for (size_t i = 0; i < batch.size(); ++i) {
+            if (i < responses.size()) {
+              batch[i].second.setValue(responses[i]);
+            } else {
+              batch[i].second.setException(std::runtime_error("Missing response in the batch"));
+            }
+          }
+        }
+        next();
+      });
+}
+
+}  // namespace
+
+template <typename Traits>
+folly::Future<typename Traits::Resp> RaftBatcher::enqueue(Queues<Traits>* queues,
+                                                          std::shared_ptr<ClientManager> clientMan,
+                                                          folly::EventBase* eb,
+                                                          const HostAddr& addr,
+                                                          typename Traits::Req req) {
+  std::shared_ptr<Queue<Traits>> queue;
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    auto& q = (*queues)[addr];
+    if (q == nullptr) {
+      q = std::make_shared<Queue<Traits>>();
+    }
+    queue = q;
+  }
+
+  folly::Promise<typename Traits::Resp> promise;
+  auto future = promise.getFuture();
+  bool send = false;
+  {
+    std::lock_guard<std::mutex> g(queue->lock);
+    queue->pending.emplace_back(std::move(req), std::move(promise));
+    if (queue->inFlight < std::max(FLAGS_raft_max_inflight_batches, 1U)) {
+      ++queue->inFlight;
+      send = true;
+    }
+  }
+  if (send) {
+    auto window = Traits::windowMs();
+    if (window == 0) {
+      flush<Traits>(std::move(queue), std::move(clientMan), eb, addr);
+    } else {
+      eb->runInEventBaseThread([queue, clientMan, eb, addr, window]() mutable {
+        eb->runAfterDelay(
+            [queue, clientMan, eb, addr]() mutable {
+              flush<Traits>(std::move(queue), std::move(clientMan), eb, std::move(addr));
+            },
+            window);
+      });
+    }
+  }
+  return future;
+}
+
+folly::Future<cpp2::HeartbeatResponse> RaftBatcher::heartbeat(
+    std::shared_ptr<ClientManager> clientMan,
+    folly::EventBase* eb,
+    const HostAddr& addr,
+    cpp2::HeartbeatRequest req) {
+  return enqueue<HeartbeatTraits>(&heartbeats_, std::move(clientMan), eb, addr, std::move(req));
+}
+
+folly::Future<cpp2::AppendLogResponse> RaftBatcher::appendLog(
+    std::shared_ptr<ClientManager> clientMan,
+    folly::EventBase* eb,
+    const HostAddr& addr,
+    cpp2::AppendLogRequest req) {
+  return enqueue<AppendLogTraits>(&appendLogs_, std::move(clientMan), eb, addr, std::move(req));
+}
+
+}  // namespace raftex
+}  // namespace nebula
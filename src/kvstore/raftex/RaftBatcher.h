@@ -0,0 +1,86 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef RAFTEX_RAFTBATCHER_H_
+#define RAFTEX_RAFTBATCHER_H_
+
+#include <folly/futures/Future.h>
+
+#include "common/base/Base.h"
+#include "common/thrift/ThriftClientManager.h"
+#include "interface/gen-cpp2/RaftexServiceAsyncClient.h"
+#include "interface/gen-cpp2/raftex_types.h"
+
+namespace folly {
+class EventBase;
+}  // namespace folly
+
+namespace nebula {
+namespace raftex {
+
+/**
+ * Multiplex the heartbeats and the appendLog requests of all the parts on
+ * this host to the same peer, so that a host with thousands of parts sends a
+ * few RPCs instead of thousands.
+ *
+ * For each peer, at most --raft_max_inflight_batches batches of each kind are
+ * in flight. A request is sent at once if there are fewer, otherwise it waits
+ * in the queue and is sent with the others when a batch in flight returns.
+ * The heartbeats wait for another --raft_heartbeat_batch_window_ms in
+ * addition, since they are not latency sensitive. A batch of a single request
+ * is sent by the plain RPC. A peer which doesn't know the batched RPCs is only
+ * sent the plain ones, until --raft_batch_reprobe_interval_secs later, when
+ * it is tried again in case it has been upgraded.
+ */
+class RaftBatcher final {
+ public:
+  using ClientManager = thrift::ThriftClientManager<cpp2::RaftexServiceAsyncClient>;
+
+  folly::Future<cpp2::HeartbeatResponse> heartbeat(std::shared_ptr<ClientManager> clientMan,
+                                                   folly::EventBase* eb,
+                                                   const HostAddr& addr,
+                                                   cpp2::HeartbeatRequest req);
+
+  folly::Future<cpp2::AppendLogResponse> appendLog(std::shared_ptr<ClientManager> clientMan,
+                                                   folly::EventBase* eb,
+                                                   const HostAddr& addr,
+                                                   cpp2::AppendLogRequest req);
+
+  // Per peer queue of the requests of one kind
+  template <typename Traits>
+  struct Queue {
+    using Pending = std::pair<typename Traits::Req, folly::Promise<typename Traits::Resp>>;
+
+    std::mutex lock;
+    std::vector<Pending> pending;
+    uint32_t inFlight{0};
+    // When the peer was found not to know the batched RPC, 0 if it does
+    std::atomic<int64_t> unsupportedSince{0};
+  };
+
+ private:
+  template <typename Traits>
+  using Queues = std::unordered_map<HostAddr, std::shared_ptr<Queue<Traits>>>;
+
+  template <typename Traits>
+  folly::Future<typename Traits::Resp> enqueue(Queues<Traits>* queues,
+                                               std::shared_ptr<ClientManager> clientMan,
+                                               folly::EventBase* eb,
+                                               const HostAddr& addr,
+                                               typename Traits::Req req);
+
+  struct HeartbeatTraits;
+  struct AppendLogTraits;
+
+  // Guard the queues, but not the content of each queue
+  std::mutex lock_;
+  Queues<HeartbeatTraits> heartbeats_;
+  Queues<AppendLogTraits> appendLogs_;
+};
+
+}  // namespace raftex
+}  // namespace nebula
+
+#endif  // RAFTEX_RAFTBATCHER_H_
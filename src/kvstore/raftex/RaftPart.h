@@ -18,6 +18,7 @@
 #include "interface/gen-cpp2/raftex_types.h"
 #include "kvstore/Common.h"
 #include "kvstore/DiskManager.h"
+#include "kvstore/raftex/RaftBatcher.h"
 #include "kvstore/raftex/SnapshotManager.h"
 
 namespace folly {
@@ -125,6 +126,10 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
 
   std::shared_ptr<wal::FileBasedWal> wal() const { return wal_; }
 
+  // Send the heartbeats and logs through the batcher shared with the other
+  // parts, must be called before start()
+  void setBatcher(std::shared_ptr<RaftBatcher> batcher) { batcher_ = std::move(batcher); }
+
   void addLearner(const HostAddr& learner);
 
   void commitTransLeader(const HostAddr& target);
@@ -564,6 +569,8 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
   std::shared_ptr<SnapshotManager> snapshot_;
 
   std::shared_ptr<thrift::ThriftClientManager<cpp2::RaftexServiceAsyncClient>> clientMan_;
+  // nullptr to send the heartbeats and logs one by one
+  std::shared_ptr<RaftBatcher> batcher_;
   // Used in snapshot, record the last total count and total size received from
   // request
   int64_t lastTotalCount_ = 0;
@@ -11,6 +11,10 @@
 #include "common/ssl/SSLConfig.h"
 #include "kvstore/raftex/RaftPart.h"
 
+DEFINE_bool(enable_raft_batch,
+            false,
+            "Whether to send the heartbeats and logs of the parts to the same peer in batches");
+
 namespace nebula {
 namespace raftex {
 
@@ -29,6 +33,9 @@ std::shared_ptr<RaftexService> RaftexService::createService(
   svc->server_ = std::make_unique<apache::thrift::ThriftServer>();
   CHECK(svc->server_ != nullptr) << "Failed to create a thrift server";
   svc->server_->setInterface(svc);
+  if (FLAGS_enable_raft_batch) {
+    svc->batcher_ = std::make_shared<RaftBatcher>();
+  }
 
   svc->initThriftServer(pool, workers, port);
   return svc;
@@ -146,6 +153,7 @@ void RaftexService::waitUntilStop() {
 void RaftexService::addPartition(std::shared_ptr<RaftPart> part) {
   // todo(doodle): If we need to start both listener and normal replica on same
   // hosts, this class need to be aware of type.
+  part->setBatcher(batcher_);
   folly::RWSpinLock::WriteHolder wh(partsLock_);
   parts_.emplace(std::make_pair(part->spaceId(), part->partitionId()), part);
 }
@@ -209,16 +217,67 @@ void RaftexService::async_eb_heartbeat(
     std::unique_ptr<apache::thrift::HandlerCallback<cpp2::HeartbeatResponse>> callback,
     const cpp2::HeartbeatRequest& req) {
   cpp2::HeartbeatResponse resp;
+  processHeartbeat(resp, req);
+  callback->result(resp);
+}
+
+void RaftexService::processHeartbeat(cpp2::HeartbeatResponse& resp,
+                                     const cpp2::HeartbeatRequest& req) {
   auto part = findPart(req.get_space(), req.get_part());
   if (!part) {
     // Not found
     resp.set_error_code(cpp2::ErrorCode::E_UNKNOWN_PART);
-    callback->result(resp);
     return;
   }
   part->processHeartbeatRequest(req, resp);
+}
+
+void RaftexService::async_eb_batchHeartbeat(
+    std::unique_ptr<apache::thrift::HandlerCallback<cpp2::BatchHeartbeatResponse>> callback,
+    const cpp2::BatchHeartbeatRequest& req) {
+  cpp2::BatchHeartbeatResponse resp;
+  std::vector<cpp2::HeartbeatResponse> responses(req.get_requests().size());
+  for (size_t i = 0; i < responses.size(); ++i) {
+    processHeartbeat(responses[i], req.get_requests()[i]);
+  }
+  resp.set_responses(std::move(responses));
   callback->result(resp);
 }
 
+folly::Future<cpp2::BatchAppendLogResponse> RaftexService::future_batchAppendLog(
+    const cpp2::BatchAppendLogRequest& req) {
+  // The requests of different parts are independent, so process them
+  // concurrently on the workers, then the batch costs as long as the slowest
+  // one instead of the sum of them
+  auto* workers = getThreadManager().get();
+  std::vector<folly::Future<cpp2::AppendLogResponse>> futures;
+  futures.reserve(req.get_requests().size());
+  for (const auto& request : req.get_requests()) {
+    futures.emplace_back(folly::via(workers, [this, request]() {
+      cpp2::AppendLogResponse resp;
+      appendLog(resp, request);
+      return resp;
+    }));
+  }
+  return folly::collectAll(futures).thenValue(
+      [](std::vector<folly::Try<cpp2::AppendLogResponse>>&& tries) {
+        cpp2::BatchAppendLogResponse resp;
+        std::vector<cpp2::AppendLogResponse> responses;
+        responses.reserve(tries.size());
+        for (auto& t : tries) {
+          if (t.hasValue()) {
+            responses.emplace_back(std::move(t).value());
+          } else {
+            LOG(ERROR) << "Failed to append the log: " << t.exception().what();
+            cpp2::AppendLogResponse failed;
+            failed.set_error_code(cpp2::ErrorCode::E_EXCEPTION);
+            responses.emplace_back(std::move(failed));
+          }
+        }
+        resp.set_responses(std::move(responses));
+        return resp;
+      });
+}
+
 }  // namespace raftex
 }  // namespace nebula
@@ -11,6 +11,7 @@
 
 #include "common/base/Base.h"
 #include "interface/gen-cpp2/RaftexService.h"
+#include "kvstore/raftex/RaftBatcher.h"
 
 namespace nebula {
 namespace raftex {
@@ -47,12 +48,21 @@ class RaftexService : public cpp2::RaftexServiceSvIf {
       std::unique_ptr<apache::thrift::HandlerCallback<cpp2::HeartbeatResponse>> callback,
       const cpp2::HeartbeatRequest& req) override;
 
+  void async_eb_batchHeartbeat(
+      std::unique_ptr<apache::thrift::HandlerCallback<cpp2::BatchHeartbeatResponse>> callback,
+      const cpp2::BatchHeartbeatRequest& req) override;
+
+  folly::Future<cpp2::BatchAppendLogResponse> future_batchAppendLog(
+      const cpp2::BatchAppendLogRequest& req) override;
+
   void addPartition(std::shared_ptr<RaftPart> part);
   void removePartition(std::shared_ptr<RaftPart> part);
 
   std::shared_ptr<RaftPart> findPart(GraphSpaceID spaceId, PartitionID partId);
 
  private:
+  void processHeartbeat(cpp2::HeartbeatResponse& resp, const cpp2::HeartbeatRequest& req);
+
   void initThriftServer(std::shared_ptr<folly::IOThreadPoolExecutor> pool,
                         std::shared_ptr<folly::Executor> workers,
                         uint16_t port = 0);
@@ -72,6 +82,10 @@ class RaftexService : public cpp2::RaftexServiceSvIf {
   enum RaftServiceStatus { STATUS_NOT_RUNNING = 0, STATUS_SETUP_FAILED = 1, STATUS_RUNNING = 2 };
   std::atomic_int status_{STATUS_NOT_RUNNING};
 
+  // Shared by all the parts to send the heartbeats and logs in batches,
+  // nullptr if --enable_raft_batch is off
+  std::shared_ptr<RaftBatcher> batcher_;
+
   folly::RWSpinLock partsLock_;
   std::unordered_map<std::pair<GraphSpaceID, PartitionID>, std::shared_ptr<RaftPart>> parts_;
 };
@@ -0,0 +1,101 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/thrift/ThriftClientManager.h"
+#include "kvstore/raftex/RaftBatcher.h"
+#include "kvstore/raftex/RaftexService.h"
+
+namespace nebula {
+namespace raftex {
+
+class RaftBatcherTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    service_ = RaftexService::createService(nullptr, nullptr);
+    ASSERT_TRUE(service_->start());
+    addr_ = HostAddr("127.0.0.1", service_->getServerPort());
+    pool_ = std::make_shared<folly::IOThreadPoolExecutor>(2);
+    clientMan_ = std::make_shared<RaftBatcher::ClientManager>(false);
+  }
+
+  void TearDown() override {
+    clientMan_.reset();
+    pool_.reset();
+    service_->stop();
+    service_->waitUntilStop();
+  }
+
+  std::shared_ptr<RaftexService> service_;
+  HostAddr addr_;
+  std::shared_ptr<folly::IOThreadPoolExecutor> pool_;
+  std::shared_ptr<RaftBatcher::ClientManager> clientMan_;
+};
+
+TEST_F(RaftBatcherTest, Heartbeat) {
+  RaftBatcher batcher;
+  std::vector<folly::Future<cpp2::HeartbeatResponse>> futures;
+  for (PartitionID part = 1; part <= 100; ++part) {
+    cpp2::HeartbeatRequest req;
+    req.set_space(1);
+    req.set_part(part);
+    futures.emplace_back(batcher.heartbeat(clientMan_, pool_->getEventBase(), addr_, req));
+  }
+  auto responses = folly::collectAll(futures).get();
+  ASSERT_EQ(100, responses.size());
+  for (auto& resp : responses) {
+    ASSERT_TRUE(resp.hasValue());
+    // No part is added to the service
+    EXPECT_EQ(cpp2::ErrorCode::E_UNKNOWN_PART, resp.value().get_error_code());
+  }
+}
+
+TEST_F(RaftBatcherTest, AppendLog) {
+  RaftBatcher batcher;
+  std::vector<folly::Future<cpp2::AppendLogResponse>> futures;
+  for (PartitionID part = 1; part <= 100; ++part) {
+    cpp2::AppendLogRequest req;
+    req.set_space(1);
+    req.set_part(part);
+    futures.emplace_back(batcher.appendLog(clientMan_, pool_->getEventBase(), addr_, req));
+  }
+  auto responses = folly::collectAll(futures).get();
+  ASSERT_EQ(100, responses.size());
+  for (auto& resp : responses) {
+    ASSERT_TRUE(resp.hasValue());
+    EXPECT_EQ(cpp2::ErrorCode::E_UNKNOWN_PART, resp.value().get_error_code());
+  }
+}
+
+TEST_F(RaftBatcherTest, Demultiplex) {
+  auto* eb = pool_->getEventBase();
+  auto client = clientMan_->client(addr_, eb);
+  cpp2::BatchHeartbeatRequest req;
+  std::vector<cpp2::HeartbeatRequest> requests(10);
+  for (size_t i = 0; i < requests.size(); ++i) {
+    requests[i].set_space(1);
+    requests[i].set_part(i + 1);
+  }
+  req.set_requests(std::move(requests));
+  auto resp = folly::via(eb, [&] { return client->future_batchHeartbeat(req); }).get();
+  ASSERT_EQ(10, resp.get_responses().size());
+  for (auto& r : resp.get_responses()) {
+    EXPECT_EQ(cpp2::ErrorCode::E_UNKNOWN_PART, r.get_error_code());
+  }
+}
+
+}  // namespace raftex
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
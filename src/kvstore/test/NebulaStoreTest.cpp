@@ -3,6 +3,7 @@
  * This source code is licensed under Apache 2.0 License.
  */
 
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 #include <rocksdb/db.h>
 #include <thrift/lib/cpp/concurrency/ThreadManager.h>
@@ -23,6 +24,7 @@
 
 DECLARE_uint32(raft_heartbeat_interval_secs);
 DECLARE_bool(auto_remove_invalid_space);
+DECLARE_uint32(raft_commit_batch_bytes);
 const int32_t kDefaultVidLen = 8;
 using nebula::meta::PartHosts;
 
@@ -246,6 +248,67 @@ TEST(NebulaStoreTest, PartsTest) {
   ASSERT_TRUE(store->spaces_.find(0) == store->spaces_.end());
 }
 
+TEST(NebulaStoreTest, PipelinedCommitTest) {
+  // Write the commits by many small batches
+  FLAGS_raft_commit_batch_bytes = 128;
+  SCOPE_EXIT { FLAGS_raft_commit_batch_bytes = 4 * 1024 * 1024; };
+  auto partMan = std::make_unique<MemPartManager>();
+  auto ioThreadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+  partMan->partsMap_[1][0] = PartHosts();
+
+  fs::TempDir rootPath("/tmp/nebula_store_test.XXXXXX");
+  std::vector<std::string> paths;
+  paths.emplace_back(folly::stringPrintf("%s/disk1", rootPath.path()));
+
+  KVOptions options;
+  options.dataPaths_ = std::move(paths);
+  options.partMan_ = std::move(partMan);
+  HostAddr local = {"", 0};
+  auto store =
+      std::make_unique<NebulaStore>(std::move(options), ioThreadPool, local, getHandlers());
+  store->init();
+  sleep(FLAGS_raft_heartbeat_interval_secs);
+
+  // Many concurrent puts, so that a commit has many logs
+  std::string prefix = "prefix";
+  std::atomic<int32_t> count{0};
+  folly::Baton<true, std::atomic> baton;
+  for (auto i = 0; i < 100; i++) {
+    std::vector<KV> data;
+    for (auto j = 0; j < 10; j++) {
+      auto k = i * 10 + j;
+      data.emplace_back(prefix + std::string(reinterpret_cast<const char*>(&k), sizeof(int32_t)),
+                        folly::stringPrintf("val_%d", k));
+    }
+    store->asyncMultiPut(1, 0, std::move(data), [&](nebula::cpp2::ErrorCode code) {
+      EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, code);
+      if (++count == 100) {
+        baton.post();
+      }
+    });
+  }
+  baton.wait();
+
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, store->prefix(1, 0, prefix, &iter));
+  std::set<int32_t> keys;
+  while (iter->valid()) {
+    auto key = *reinterpret_cast<const int32_t*>(iter->key().data() + prefix.size());
+    EXPECT_EQ(folly::stringPrintf("val_%d", key), iter->val());
+    keys.emplace(key);
+    iter->next();
+  }
+  EXPECT_EQ(1000, keys.size());
+
+  // The commit msg is the one of the last log
+  auto part = nebula::value(store->part(1, 0));
+  std::string val;
+  ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            part->engine()->get(NebulaKeyUtils::systemCommitKey(0), &val));
+  ASSERT_EQ(sizeof(LogID) + sizeof(TermID), val.size());
+  EXPECT_EQ(part->wal()->lastLogId(), *reinterpret_cast<const LogID*>(val.data()));
+}
+
 TEST(NebulaStoreTest, ThreeCopiesTest) {
   fs::TempDir rootPath("/tmp/nebula_store_test.XXXXXX");
   auto initNebulaStore = [](const std::vector<HostAddr>& peers,
@@ -904,6 +967,49 @@ TEST(NebulaStoreTest, RemoveInvalidSpaceTest) {
   CHECK(boost::filesystem::exists(space2));
 }
 
+TEST(NebulaStoreTest, ReleaseSnapshotOfRemovedPartTest) {
+  auto partMan = std::make_unique<MemPartManager>();
+  auto ioThreadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+  for (auto partId = 1; partId <= 2; partId++) {
+    partMan->partsMap_[1][partId] = PartHosts();
+  }
+
+  fs::TempDir rootPath("/tmp/nebula_store_test.XXXXXX");
+  KVOptions options;
+  options.dataPaths_ = {rootPath.path()};
+  options.partMan_ = std::move(partMan);
+  HostAddr local = {"", 0};
+  auto store =
+      std::make_unique<NebulaStore>(std::move(options), ioThreadPool, local, getHandlers());
+  store->init();
+  sleep(1);
+
+  auto ret1 = store->getSnapshot(1, 1, true);
+  auto ret2 = store->getSnapshot(1, 2, true);
+  ASSERT_TRUE(ok(ret1));
+  ASSERT_TRUE(ok(ret2));
+  auto* snapshot1 = value(ret1);
+  auto* snapshot2 = value(ret2);
+  ASSERT_NE(nullptr, snapshot1);
+  ASSERT_NE(nullptr, snapshot2);
+  EXPECT_EQ(2, store->snapshots_.size());
+
+  // The snapshot of a removed part is released along with it
+  store->removePart(1, 1);
+  EXPECT_EQ(1, store->snapshots_.size());
+  store->releaseSnapshot(1, 1, snapshot1);
+
+  std::string prefix;
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            store->rangeWithPrefix(1, 2, prefix, prefix, &iter, true, snapshot2));
+  store->releaseSnapshot(1, 2, snapshot2);
+  EXPECT_EQ(0, store->snapshots_.size());
+  // A released snapshot is not read any more
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_SCAN_SNAPSHOT_EXPIRED,
+            store->rangeWithPrefix(1, 2, prefix, prefix, &iter, true, snapshot2));
+}
+
 TEST(NebulaStoreTest, BackupRestoreTest) {
   GraphSpaceID spaceId = 1;
   PartitionID partId = 1;
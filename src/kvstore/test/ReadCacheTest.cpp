@@ -0,0 +1,157 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/ReadCache.h"
+
+namespace nebula {
+namespace kvstore {
+
+constexpr size_t kVIdLen = 8;
+constexpr GraphSpaceID kSpace = 1;
+
+TEST(ReadCacheTest, Keys) {
+  auto vertex = NebulaKeyUtils::vertexKey(kVIdLen, 1, "v1", 3);
+  auto edge = NebulaKeyUtils::edgeKey(kVIdLen, 1, "v1", 5, 0, "v2");
+  auto prefix = NebulaKeyUtils::edgePrefix(kVIdLen, 1, "v1", 5);
+  EXPECT_TRUE(ReadCache::isCachedKey(kVIdLen, vertex));
+  EXPECT_FALSE(ReadCache::isCachedKey(kVIdLen, edge));
+  EXPECT_TRUE(ReadCache::isCachedPrefix(kVIdLen, prefix));
+  EXPECT_FALSE(ReadCache::isCachedPrefix(kVIdLen, NebulaKeyUtils::edgePrefix(kVIdLen, 1, "v1")));
+  EXPECT_FALSE(ReadCache::isCachedPrefix(kVIdLen, NebulaKeyUtils::vertexPrefix(kVIdLen, 1, "v1")));
+
+  EXPECT_EQ(vertex, ReadCache::entryOf(kVIdLen, vertex));
+  EXPECT_EQ(prefix, ReadCache::entryOf(kVIdLen, edge));
+  EXPECT_TRUE(ReadCache::entryOf(kVIdLen, NebulaKeyUtils::systemCommitKey(1)).empty());
+}
+
+TEST(ReadCacheTest, GetAndPut) {
+  ReadCache cache(1024 * 1024, 2);
+  auto key = NebulaKeyUtils::vertexKey(kVIdLen, 1, "v1", 3);
+  EXPECT_FALSE(cache.get(kSpace, key).hasValue());
+
+  auto version = cache.version(kSpace, key);
+  cache.put(kSpace,
+            key,
+            std::make_shared<ReadCache::Rows>(1, std::make_pair(key, std::string("val"))),
+            version);
+  auto rows = cache.get(kSpace, key);
+  ASSERT_TRUE(rows.hasValue());
+  ASSERT_EQ(1, rows.value()->size());
+  EXPECT_EQ("val", rows.value()->front().second);
+  // The spaces don't share the entries
+  EXPECT_FALSE(cache.get(kSpace + 1, key).hasValue());
+
+  // Not found is cached too
+  auto other = NebulaKeyUtils::vertexKey(kVIdLen, 1, "v2", 3);
+  cache.put(kSpace, other, std::make_shared<ReadCache::Rows>(), cache.version(kSpace, other));
+  rows = cache.get(kSpace, other);
+  ASSERT_TRUE(rows.hasValue());
+  EXPECT_TRUE(rows.value()->empty());
+  EXPECT_EQ(2, cache.size());
+}
+
+TEST(ReadCacheTest, Invalidate) {
+  ReadCache cache(1024 * 1024, 2);
+  auto key = NebulaKeyUtils::vertexKey(kVIdLen, 1, "v1", 3);
+  auto version = cache.version(kSpace, key);
+  cache.put(kSpace, key, std::make_shared<ReadCache::Rows>(), version);
+  ASSERT_TRUE(cache.get(kSpace, key).hasValue());
+
+  cache.beforeWrite(kSpace, key);
+  cache.afterWrite(kSpace, key);
+  EXPECT_FALSE(cache.get(kSpace, key).hasValue());
+
+  // The rows read before the write are not cached
+  cache.put(kSpace, key, std::make_shared<ReadCache::Rows>(), version);
+  EXPECT_FALSE(cache.get(kSpace, key).hasValue());
+
+  version = cache.version(kSpace, key);
+  cache.put(kSpace, key, std::make_shared<ReadCache::Rows>(), version);
+  EXPECT_TRUE(cache.get(kSpace, key).hasValue());
+  cache.invalidateAll();
+  EXPECT_FALSE(cache.get(kSpace, key).hasValue());
+  cache.put(kSpace, key, std::make_shared<ReadCache::Rows>(), version);
+  EXPECT_EQ(0, cache.size());
+}
+
+TEST(ReadCacheTest, ReadDuringWrite) {
+  ReadCache cache(1024 * 1024, 2);
+  auto key = NebulaKeyUtils::vertexKey(kVIdLen, 1, "v1", 3);
+  cache.beforeWrite(kSpace, key);
+  // A reader takes the version during the write, and reads the engine before
+  // the write lands
+  auto version = cache.version(kSpace, key);
+  cache.afterWrite(kSpace, key);
+  // The row read before the write is not cached after it
+  cache.put(kSpace,
+            key,
+            std::make_shared<ReadCache::Rows>(1, std::make_pair(key, std::string("old"))),
+            version);
+  EXPECT_FALSE(cache.get(kSpace, key).hasValue());
+  EXPECT_EQ(0, cache.size());
+
+  // The readers after the write fill the cache
+  version = cache.version(kSpace, key);
+  cache.put(kSpace,
+            key,
+            std::make_shared<ReadCache::Rows>(1, std::make_pair(key, std::string("new"))),
+            version);
+  auto rows = cache.get(kSpace, key);
+  ASSERT_TRUE(rows.hasValue());
+  EXPECT_EQ("new", rows.value()->front().second);
+}
+
+TEST(ReadCacheTest, Capacity) {
+  // A single shard of 8KB, an entry takes at most 1KB
+  ReadCache cache(8 * 1024, 0);
+  auto prefix = NebulaKeyUtils::edgePrefix(kVIdLen, 1, "v1", 5);
+  auto rows = std::make_shared<ReadCache::Rows>();
+  rows->emplace_back(prefix, std::string(2048, 'x'));
+  EXPECT_TRUE(cache.tooBig(2048));
+  cache.put(kSpace, prefix, rows, cache.version(kSpace, prefix));
+  auto cached = cache.get(kSpace, prefix);
+  ASSERT_TRUE(cached.hasValue());
+  EXPECT_EQ(nullptr, cached.value());
+
+  // The least recently used ones are evicted
+  std::vector<std::string> keys;
+  for (auto i = 0; i < 64; ++i) {
+    auto key = NebulaKeyUtils::vertexKey(kVIdLen, 1, folly::to<std::string>(i), 3);
+    auto val = std::make_shared<ReadCache::Rows>(1, std::make_pair(key, std::string(512, 'x')));
+    cache.put(kSpace, key, std::move(val), cache.version(kSpace, key));
+    keys.emplace_back(std::move(key));
+  }
+  EXPECT_LT(cache.size(), 64);
+  EXPECT_FALSE(cache.get(kSpace, keys.front()).hasValue());
+  EXPECT_TRUE(cache.get(kSpace, keys.back()).hasValue());
+}
+
+TEST(ReadCacheTest, Iterator) {
+  auto rows = std::make_shared<ReadCache::Rows>();
+  rows->emplace_back("k1", "v1");
+  rows->emplace_back("k2", "v2");
+  CachedRowsIter iter(rows);
+  std::vector<std::string> vals;
+  for (; iter.valid(); iter.next()) {
+    vals.emplace_back(iter.val().str());
+  }
+  EXPECT_EQ((std::vector<std::string>{"v1", "v2"}), vals);
+  EXPECT_FALSE(CachedRowsIter(std::make_shared<ReadCache::Rows>()).valid());
+}
+
+}  // namespace kvstore
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
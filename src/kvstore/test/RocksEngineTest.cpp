@@ -116,6 +116,38 @@ TEST_P(RocksEngineTest, PrefixTest) {
   checkPrefix("c", 20, 20);
 }
 
+TEST_P(RocksEngineTest, SnapshotTest) {
+  fs::TempDir rootPath("/tmp/rocksdb_engine_SnapshotTest.XXXXXX");
+  auto engine = std::make_unique<RocksEngine>(0, kDefaultVIdLen, rootPath.path());
+  std::vector<KV> data;
+  for (int32_t i = 0; i < 10; i++) {
+    data.emplace_back(folly::stringPrintf("key_%d", i), folly::stringPrintf("val_%d", i));
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+
+  auto* snapshot = engine->getSnapshot();
+  ASSERT_NE(nullptr, snapshot);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->removeRange("key_0", "key_5"));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put("key_9", "new_val"));
+
+  auto count = [&](const void* snap) {
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              engine->rangeWithPrefix("key_", "key_", &iter, snap));
+    int32_t num = 0;
+    for (; iter->valid(); iter->next()) {
+      if (iter->key() == "key_9") {
+        EXPECT_EQ(snap == nullptr ? "new_val" : "val_9", iter->val());
+      }
+      num++;
+    }
+    return num;
+  };
+  EXPECT_EQ(10, count(snapshot));
+  EXPECT_EQ(5, count(nullptr));
+  engine->releaseSnapshot(snapshot);
+}
+
 TEST_P(RocksEngineTest, RemoveTest) {
   fs::TempDir rootPath("/tmp/rocksdb_engine_RemoveTest.XXXXXX");
   auto engine = std::make_unique<RocksEngine>(0, kDefaultVIdLen, rootPath.path());
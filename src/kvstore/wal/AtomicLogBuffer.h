@@ -6,6 +6,7 @@
 #ifndef WAL_ATOMICLOGBUFFER_H_
 #define WAL_ATOMICLOGBUFFER_H_
 
+#include <folly/io/IOBuf.h>
 #include <folly/lang/Aligned.h>
 #include <gtest/gtest_prod.h>
 
@@ -16,6 +17,8 @@ namespace nebula {
 namespace wal {
 
 constexpr int32_t kMaxLength = 64;
+// The smaller logs are copied out, cheaper than referring to them
+constexpr size_t kMinSharedMsgSize = 1024;
 
 struct Record {
   Record() = default;
@@ -87,6 +90,8 @@ struct Node {
  * */
 class AtomicLogBuffer : public std::enable_shared_from_this<AtomicLogBuffer> {
   FRIEND_TEST(AtomicLogBufferTest, ResetThenPushExceedLimit);
+  FRIEND_TEST(AtomicLogBufferTest, SharedLogMsgTest);
+  FRIEND_TEST(AtomicLogBufferTest, CopyLogMsgWhenGcPendingTest);
 
  public:
   /**
@@ -140,6 +145,30 @@ class AtomicLogBuffer : public std::enable_shared_from_this<AtomicLogBuffer> {
 
     folly::StringPiece logMsg() const override { return record()->msg_; }
 
+    // Refer to the record instead of copying it if it is large. The nodes are
+    // only collected when no one refers to the buffer, so once there are
+    // enough of them to collect, copy the record as well to let the
+    // references drain, otherwise a lagging follower keeps the buffer
+    // growing under steady writes.
+    folly::IOBuf logMsgBuf() const override {
+      auto& msg = record()->msg_;
+      if (msg.size() < kMinSharedMsgSize || logBuffer_->gcPending()) {
+        return folly::IOBuf(folly::IOBuf::COPY_BUFFER, msg.data(), msg.size());
+      }
+      logBuffer_->addRef();
+      auto* holder = new std::shared_ptr<AtomicLogBuffer>(logBuffer_);
+      return folly::IOBuf(
+          folly::IOBuf::TAKE_OWNERSHIP,
+          const_cast<char*>(msg.data()),
+          msg.size(),
+          [](void*, void* userData) {
+            auto* buffer = static_cast<std::shared_ptr<AtomicLogBuffer>*>(userData);
+            (*buffer)->releaseRef();
+            delete buffer;
+          },
+          holder);
+    }
+
    private:
     // Iterator could only be acquired by AtomicLogBuffer::iterator interface.
     Iterator(std::shared_ptr<AtomicLogBuffer> logBuffer, LogID start, LogID end)
@@ -333,6 +362,11 @@ class AtomicLogBuffer : public std::enable_shared_from_this<AtomicLogBuffer> {
     return p->markDeleted_ ? nullptr : p;
   }
 
+  // Whether there are enough nodes marked deleted to be collected
+  bool gcPending() const {
+    return dirtyNodes_.load(std::memory_order_acquire) > dirtyNodesLimit_;
+  }
+
   int32_t addRef() { return refs_.fetch_add(1, std::memory_order_relaxed); }
 
   void releaseRef() {
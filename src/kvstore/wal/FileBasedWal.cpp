@@ -5,17 +5,24 @@
 
 #include "kvstore/wal/FileBasedWal.h"
 
+#include <folly/ScopeGuard.h>
+#include <sys/uio.h>
 #include <utime.h>
 
 #include "common/base/Base.h"
 #include "common/fs/FileUtils.h"
 #include "common/time/WallClock.h"
 #include "kvstore/wal/WalFileIterator.h"
+#include "kvstore/wal/WalSyncer.h"
 
 DEFINE_int32(wal_ttl, 14400, "Default wal ttl");
 DEFINE_int64(wal_file_size, 16 * 1024 * 1024, "Default wal file size");
 DEFINE_int32(wal_buffer_size, 8 * 1024 * 1024, "Default wal buffer size");
 DEFINE_bool(wal_sync, false, "Whether fsync needs to be called every write");
+DEFINE_bool(wal_group_commit,
+            false,
+            "Whether the synced wals on the same device are synced by a shared thread in "
+            "batches, only works with wal_sync. Mostly useful with wal_group_commit_syncfs");
 
 namespace nebula {
 namespace wal {
@@ -57,6 +64,9 @@ FileBasedWal::FileBasedWal(const folly::StringPiece dir,
   }
 
   logBuffer_ = AtomicLogBuffer::instance(policy_.bufferSize);
+  if (policy_.sync && FLAGS_wal_group_commit) {
+    syncer_ = WalSyncer::get(dir_);
+  }
   scanAllWalFiles();
   if (!walFiles_.empty()) {
     firstLogId_ = walFiles_.begin()->second->firstId();
@@ -267,10 +277,10 @@ void FileBasedWal::closeCurrFile() {
     return;
   }
 
-  if (!policy_.sync) {
-    if (::fsync(currFd_) == -1) {
-      LOG(WARNING) << "sync wal \"" << currInfo_->path() << "\" failed, error: " << strerror(errno);
-    }
+  // The logs appended since the last sync are synced here, even if the sync
+  // policy is on
+  if (::fsync(currFd_) == -1) {
+    LOG(WARNING) << "sync wal \"" << currInfo_->path() << "\" failed, error: " << strerror(errno);
   }
 
   // Close the file
@@ -366,6 +376,7 @@ void FileBasedWal::rollbackInFile(WalFileInfoPtr info, LogID logId) {
   }
   info->setLastId(id);
   info->setLastTerm(term);
+  info->truncateIndex(id);
   close(fd);
 }
 
@@ -420,6 +431,7 @@ void FileBasedWal::scanLastWal(WalFileInfoPtr info, LogID firstId) {
 
     info->setLastTerm(term);
     info->setLastId(id);
+    info->addIndex(id, pos);
 
     // Move to the next log
     pos += sizeof(LogID) + sizeof(TermID) + sizeof(ClusterID) + sizeof(int32_t) + head +
@@ -457,22 +469,31 @@ bool FileBasedWal::appendLogInternal(LogID id, TermID term, ClusterID cluster, s
     return false;
   }
 
-  // Write to the WAL file first
-  std::string strBuf;
-  strBuf.reserve(sizeof(LogID) + sizeof(TermID) + sizeof(ClusterID) + msg.size() +
-                 2 * sizeof(int32_t));
-  strBuf.append(reinterpret_cast<char*>(&id), sizeof(LogID));
-  strBuf.append(reinterpret_cast<char*>(&term), sizeof(TermID));
+  // Write to the WAL file first. The head and the foot are written with the
+  // message by one writev, not to copy the message into one buffer
+  char head[sizeof(LogID) + sizeof(TermID) + sizeof(int32_t) + sizeof(ClusterID)];
   int32_t len = msg.size();
-  strBuf.append(reinterpret_cast<char*>(&len), sizeof(int32_t));
-  strBuf.append(reinterpret_cast<char*>(&cluster), sizeof(ClusterID));
-  strBuf.append(reinterpret_cast<const char*>(msg.data()), msg.size());
-  strBuf.append(reinterpret_cast<char*>(&len), sizeof(int32_t));
+  char* pos = head;
+  memcpy(pos, &id, sizeof(LogID));
+  pos += sizeof(LogID);
+  memcpy(pos, &term, sizeof(TermID));
+  pos += sizeof(TermID);
+  memcpy(pos, &len, sizeof(int32_t));
+  pos += sizeof(int32_t);
+  memcpy(pos, &cluster, sizeof(ClusterID));
+  struct iovec iov[3];
+  iov[0].iov_base = head;
+  iov[0].iov_len = sizeof(head);
+  iov[1].iov_base = const_cast<char*>(msg.data());
+  iov[1].iov_len = msg.size();
+  iov[2].iov_base = &len;
+  iov[2].iov_len = sizeof(int32_t);
+  size_t logSize = sizeof(head) + msg.size() + sizeof(int32_t);
 
   // Prepare the WAL file if it's not opened
   if (currFd_ < 0) {
     prepareNewFile(id);
-  } else if (currInfo_->size() + strBuf.size() > policy_.fileSize) {
+  } else if (currInfo_->size() + logSize > policy_.fileSize) {
     // Need to roll over
     closeCurrFile();
 
@@ -480,16 +501,14 @@ bool FileBasedWal::appendLogInternal(LogID id, TermID term, ClusterID cluster, s
     prepareNewFile(id);
   }
 
-  ssize_t bytesWritten = write(currFd_, strBuf.data(), strBuf.size());
-  if (bytesWritten != (ssize_t)strBuf.size()) {
-    LOG(FATAL) << idStr_ << "bytesWritten:" << bytesWritten << ", expected:" << strBuf.size()
+  ssize_t bytesWritten = ::writev(currFd_, iov, 3);
+  if (bytesWritten != static_cast<ssize_t>(logSize)) {
+    LOG(FATAL) << idStr_ << "bytesWritten:" << bytesWritten << ", expected:" << logSize
                << ", error:" << strerror(errno);
   }
 
-  if (policy_.sync && ::fsync(currFd_) == -1) {
-    LOG(WARNING) << "sync wal \"" << currInfo_->path() << "\" failed, error: " << strerror(errno);
-  }
-  currInfo_->setSize(currInfo_->size() + strBuf.size());
+  currInfo_->addIndex(id, currInfo_->size());
+  currInfo_->setSize(currInfo_->size() + logSize);
   currInfo_->setLastId(id);
   currInfo_->setLastTerm(term);
 
@@ -512,6 +531,7 @@ bool FileBasedWal::appendLog(LogID id, TermID term, ClusterID cluster, std::stri
     LOG(ERROR) << "Failed to append log for logId " << id;
     return false;
   }
+  syncCurrFile();
   return true;
 }
 
@@ -520,6 +540,8 @@ bool FileBasedWal::appendLogs(LogIterator& iter) {
     LOG_EVERY_N(WARNING, 100) << idStr_ << "Failed to appendLogs because of no more space";
     return false;
   }
+  // Sync once for all the logs
+  SCOPE_EXIT { syncCurrFile(); };
   for (; iter.valid(); ++iter) {
     if (!appendLogInternal(
             iter.logId(), iter.logTerm(), iter.logSource(), iter.logMsg().toString())) {
@@ -531,6 +553,23 @@ bool FileBasedWal::appendLogs(LogIterator& iter) {
   return true;
 }
 
+void FileBasedWal::syncCurrFile() {
+  if (!policy_.sync || currFd_ < 0) {
+    return;
+  }
+  if (syncer_ != nullptr) {
+    // The logs are acked only after they are synced, so wait for the batch
+    // this one joins
+    if (!syncer_->sync(currFd_).get()) {
+      LOG(WARNING) << "sync wal \"" << currInfo_->path() << "\" failed";
+    }
+    return;
+  }
+  if (::fdatasync(currFd_) == -1) {
+    LOG(WARNING) << "sync wal \"" << currInfo_->path() << "\" failed, error: " << strerror(errno);
+  }
+}
+
 std::unique_ptr<LogIterator> FileBasedWal::iterator(LogID firstLogId, LogID lastLogId) {
   auto iter = logBuffer_->iterator(firstLogId, lastLogId);
   if (iter->valid()) {
@@ -577,7 +616,9 @@ bool FileBasedWal::rollbackToLog(LogID id) {
     return false;
   }
 
-  folly::RWSpinLock::WriteHolder holder(rollbackLock_);
+  // Wait for the iterators on the files, reading a mapped file beyond the end
+  // it is truncated to raises SIGBUS
+  folly::SharedMutex::WriteHolder holder(rollbackLock_);
   //-----------------------
   // 1. Roll back WAL files
   //-----------------------
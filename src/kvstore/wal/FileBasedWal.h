@@ -7,6 +7,7 @@
 #define WAL_FILEBASEDWAL_H_
 
 #include <folly/Function.h>
+#include <folly/SharedMutex.h>
 #include <gtest/gtest_prod.h>
 
 #include "common/base/Base.h"
@@ -15,6 +16,7 @@
 #include "kvstore/wal/AtomicLogBuffer.h"
 #include "kvstore/wal/Wal.h"
 #include "kvstore/wal/WalFileInfo.h"
+#include "kvstore/wal/WalSyncer.h"
 
 namespace nebula {
 namespace wal {
@@ -27,7 +29,8 @@ struct FileBasedWalPolicy {
   // Size of each buffer (in byte)
   size_t bufferSize = 8 * 1024L * 1024L;
 
-  // Whether fsync needs to be called every write
+  // Whether fsync needs to be called every write, the logs appended by the
+  // same call are synced once
   bool sync = false;
 };
 
@@ -142,6 +145,9 @@ class FileBasedWal final : public Wal, public std::enable_shared_from_this<FileB
   // Implementation of appendLog()
   bool appendLogInternal(LogID id, TermID term, ClusterID cluster, std::string msg);
 
+  // Sync the current file if the sync policy is on
+  void syncCurrFile();
+
  private:
   using WalFiles = std::map<LogID, WalFileInfoPtr>;
 
@@ -180,7 +186,12 @@ class FileBasedWal final : public Wal, public std::enable_shared_from_this<FileB
 
   std::shared_ptr<kvstore::DiskManager> diskMan_;
 
-  folly::RWSpinLock rollbackLock_;
+  // Sync with the other wals on the same device, nullptr to sync by itself
+  std::shared_ptr<WalSyncer> syncer_;
+
+  // Shared by the iterators reading the wal files for their lifetime, since
+  // the files they map could be truncated by the rollback
+  folly::SharedMutex rollbackLock_;
 };
 
 }  // namespace wal
@@ -13,6 +13,9 @@
 namespace nebula {
 namespace wal {
 
+// One log of every kWalIndexInterval ones is indexed
+constexpr LogID kWalIndexInterval = 64;
+
 class WalFileInfo final {
  public:
   WalFileInfo(std::string path, LogID firstId)
@@ -39,6 +42,39 @@ class WalFileInfo final {
   size_t size() const { return size_; }
   void setSize(size_t size) { size_ = size; }
 
+  // The logs must be indexed in order, the ones already indexed or not on the
+  // interval are ignored
+  void addIndex(LogID id, size_t offset) {
+    if ((id - firstLogId_) % kWalIndexInterval != 0) {
+      return;
+    }
+    std::lock_guard<std::mutex> g(indexLock_);
+    if (static_cast<size_t>((id - firstLogId_) / kWalIndexInterval) == offsets_.size()) {
+      offsets_.emplace_back(offset);
+    }
+  }
+
+  // Return the nearest indexed log not after `id' and its offset, which is
+  // the first log of the file if nothing indexed yet
+  std::pair<LogID, size_t> seekIndex(LogID id) const {
+    std::lock_guard<std::mutex> g(indexLock_);
+    if (id < firstLogId_ || offsets_.empty()) {
+      return {firstLogId_, 0};
+    }
+    auto idx = std::min(static_cast<size_t>((id - firstLogId_) / kWalIndexInterval),
+                        offsets_.size() - 1);
+    return {firstLogId_ + idx * kWalIndexInterval, offsets_[idx]};
+  }
+
+  // Drop the index of the logs after `id'
+  void truncateIndex(LogID id) {
+    std::lock_guard<std::mutex> g(indexLock_);
+    auto count = id < firstLogId_ ? 0 : (id - firstLogId_) / kWalIndexInterval + 1;
+    if (static_cast<size_t>(count) < offsets_.size()) {
+      offsets_.resize(count);
+    }
+  }
+
  private:
   const std::string fullpath_;
   const LogID firstLogId_;
@@ -46,6 +82,12 @@ class WalFileInfo final {
   TermID lastLogTerm_;
   time_t mtime_;
   size_t size_;
+
+  // The sparse index of the logs in the file, offsets_[i] is the offset of the
+  // log firstLogId_ + i * kWalIndexInterval. It is built when the logs are
+  // appended, or by the iterators reading the file after a restart.
+  mutable std::mutex indexLock_;
+  std::vector<size_t> offsets_;
 };
 
 using WalFileInfoPtr = std::shared_ptr<WalFileInfo>;
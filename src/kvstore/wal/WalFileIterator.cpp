@@ -5,15 +5,26 @@
 
 #include "kvstore/wal/WalFileIterator.h"
 
+#include <folly/ScopeGuard.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include "common/base/Base.h"
 #include "kvstore/wal/FileBasedWal.h"
-#include "kvstore/wal/WalFileInfo.h"
+
+DEFINE_uint32(wal_readahead_kb,
+              2048,
+              "How much of a wal file is read ahead from the log an iterator "
+              "starts at, in KB");
 
 namespace nebula {
 namespace wal {
 
+static constexpr int64_t kHeadSize =
+    sizeof(LogID) + sizeof(TermID) + sizeof(int32_t) + sizeof(ClusterID);
+
 WalFileIterator::WalFileIterator(std::shared_ptr<FileBasedWal> wal, LogID startId, LogID lastId)
-    : wal_(wal), currId_(startId) {
+    : wal_(wal), rollbackHolder_(wal_->rollbackLock_), currId_(startId) {
   if (lastId >= 0 && lastId <= wal_->lastLogId()) {
     lastId_ = lastId;
   } else {
@@ -33,16 +44,9 @@ WalFileIterator::WalFileIterator(std::shared_ptr<FileBasedWal> wal, LogID startI
     return;
   }
 
-  // We need to read from the WAL files
+  // We need to read from the WAL files, which are mapped when being read
   wal_->accessAllWalInfo([this](WalFileInfoPtr info) {
-    int fd = open(info->path(), O_RDONLY);
-    if (fd < 0) {
-      LOG(ERROR) << "Failed to open wal file \"" << info->path() << "\" (" << errno
-                 << "): " << strerror(errno);
-      currId_ = lastId_ + 1;
-      return false;
-    }
-    fds_.push_front(fd);
+    infos_.push_front(info);
     idRanges_.push_front(std::make_pair(info->firstId(), info->lastId()));
 
     if (info->firstId() <= currId_) {
@@ -67,40 +71,39 @@ WalFileIterator::WalFileIterator(std::shared_ptr<FileBasedWal> wal, LogID startI
                << lastId_ << ", nextFirstId_ " << nextFirstId_;
   }
 
-  if (!idRanges_.empty()) {
-    // Find the correct position in the first WAL file
-    currPos_ = 0;
-    while (true) {
-      LogID logId;
-      // Read the logID
-      int fd = fds_.front();
-      CHECK_EQ(pread(fd, reinterpret_cast<char*>(&logId), sizeof(LogID), currPos_),
-               static_cast<ssize_t>(sizeof(LogID)));
-      // Read the termID
-      CHECK_EQ(
-          pread(fd, reinterpret_cast<char*>(&currTerm_), sizeof(TermID), currPos_ + sizeof(LogID)),
-          static_cast<ssize_t>(sizeof(TermID)));
-      // Read the log length
-      CHECK_EQ(pread(fd,
-                     reinterpret_cast<char*>(&currMsgLen_),
-                     sizeof(int32_t),
-                     currPos_ + sizeof(LogID) + sizeof(TermID)),
-               static_cast<ssize_t>(sizeof(int32_t)));
-      if (logId == currId_) {
-        break;
-      }
-      currPos_ +=
-          sizeof(LogID) + sizeof(TermID) + sizeof(int32_t) * 2 + currMsgLen_ + sizeof(ClusterID);
+  if (!mapFile()) {
+    currId_ = lastId_ + 1;
+    return;
+  }
+
+  // Find the correct position in the first WAL file from the nearest indexed
+  // log, and index the logs passed by
+  auto& info = infos_.front();
+  auto indexed = info->seekIndex(currId_);
+  LogID id = indexed.first;
+  currPos_ = indexed.second;
+  while (true) {
+    CHECK_EQ(id, readHead()) << "currPos = " << currPos_;
+    info->addIndex(id, currPos_);
+    if (id == currId_) {
+      break;
     }
+    currPos_ += logSize();
+    ++id;
   }
-}
 
-WalFileIterator::~WalFileIterator() {
-  for (auto& fd : fds_) {
-    close(fd);
+  // Catching up reads the rest of the file in order
+  if (FLAGS_wal_readahead_kb > 0) {
+    auto pageSize = static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+    auto start = currPos_ / pageSize * pageSize;
+    auto len = std::min(static_cast<int64_t>(size_) - start,
+                        static_cast<int64_t>(FLAGS_wal_readahead_kb) * 1024);
+    madvise(data_ + start, len, MADV_WILLNEED);
   }
 }
 
+WalFileIterator::~WalFileIterator() { unmapFile(); }
+
 LogIterator& WalFileIterator::operator++() {
   ++currId_;
   if (currId_ >= nextFirstId_) {
@@ -108,8 +111,8 @@ LogIterator& WalFileIterator::operator++() {
     VLOG(2) << "Current ID is " << currId_ << ", and the first ID in the next file is "
             << nextFirstId_ << ", so need to move to the next file";
     // Close the current file
-    CHECK_EQ(close(fds_.front()), 0);
-    fds_.pop_front();
+    unmapFile();
+    infos_.pop_front();
     idRanges_.pop_front();
 
     if (idRanges_.empty()) {
@@ -122,10 +125,13 @@ LogIterator& WalFileIterator::operator++() {
     nextFirstId_ = getFirstIdInNextFile();
     CHECK_EQ(currId_, idRanges_.front().first);
     currPos_ = 0;
+    if (idRanges_.front().second > 0 && !mapFile()) {
+      currId_ = lastId_ + 1;
+      return *this;
+    }
   } else {
     // Move to the next log
-    currPos_ +=
-        sizeof(LogID) + sizeof(TermID) + sizeof(int32_t) * 2 + currMsgLen_ + sizeof(ClusterID);
+    currPos_ += logSize();
   }
 
   if (idRanges_.front().second <= 0) {
@@ -133,23 +139,8 @@ LogIterator& WalFileIterator::operator++() {
     currId_ = lastId_ + 1;
     return *this;
   } else {
-    LogID logId;
-    int fd = fds_.front();
-    // Read the logID
-    CHECK_EQ(pread(fd, reinterpret_cast<char*>(&logId), sizeof(LogID), currPos_),
-             static_cast<ssize_t>(sizeof(LogID)))
-        << "currPos = " << currPos_;
-    CHECK_EQ(currId_, logId);
-    // Read the termID
-    CHECK_EQ(
-        pread(fd, reinterpret_cast<char*>(&currTerm_), sizeof(TermID), currPos_ + sizeof(LogID)),
-        static_cast<ssize_t>(sizeof(TermID)));
-    // Read the log length
-    CHECK_EQ(pread(fd,
-                   reinterpret_cast<char*>(&currMsgLen_),
-                   sizeof(int32_t),
-                   currPos_ + sizeof(TermID) + sizeof(LogID)),
-             static_cast<ssize_t>(sizeof(int32_t)));
+    CHECK_EQ(currId_, readHead()) << "currPos = " << currPos_;
+    infos_.front()->addIndex(currId_, currPos_);
   }
 
   return *this;
@@ -162,34 +153,17 @@ LogID WalFileIterator::logId() const { return currId_; }
 TermID WalFileIterator::logTerm() const { return currTerm_; }
 
 ClusterID WalFileIterator::logSource() const {
-  // Retrieve from the file
-  DCHECK(!fds_.empty());
+  DCHECK(data_ != nullptr);
   ClusterID cluster = 0;
-  CHECK_EQ(pread(fds_.front(),
-                 &(cluster),
-                 sizeof(ClusterID),
-                 currPos_ + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t)),
-           static_cast<ssize_t>(sizeof(ClusterID)))
-      << "Failed to read. Curr position is " << currPos_ << ", expected read length is "
-      << sizeof(ClusterID) << " (errno: " << errno << "): " << strerror(errno);
-
+  memcpy(&cluster,
+         data_ + currPos_ + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t),
+         sizeof(ClusterID));
   return cluster;
 }
 
 folly::StringPiece WalFileIterator::logMsg() const {
-  // Retrieve from the file
-  DCHECK(!fds_.empty());
-
-  currLog_.resize(currMsgLen_);
-  CHECK_EQ(pread(fds_.front(),
-                 &(currLog_[0]),
-                 currMsgLen_,
-                 currPos_ + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t) + sizeof(ClusterID)),
-           static_cast<ssize_t>(currMsgLen_))
-      << "Failed to read. Curr position is " << currPos_ << ", expected read length is "
-      << currMsgLen_ << " (errno: " << errno << "): " << strerror(errno);
-
-  return currLog_;
+  DCHECK(data_ != nullptr);
+  return folly::StringPiece(data_ + currPos_ + kHeadSize, currMsgLen_);
 }
 
 LogID WalFileIterator::getFirstIdInNextFile() const {
@@ -202,5 +176,59 @@ LogID WalFileIterator::getFirstIdInNextFile() const {
   }
 }
 
+bool WalFileIterator::mapFile() {
+  DCHECK(data_ == nullptr);
+  auto* path = infos_.front()->path();
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    LOG(ERROR) << "Failed to open wal file \"" << path << "\" (" << errno
+               << "): " << strerror(errno);
+    return false;
+  }
+  SCOPE_EXIT { close(fd); };
+  // The logs before lastId_ have all been written, so they are in the mapping
+  struct stat st;
+  if (fstat(fd, &st) < 0) {
+    LOG(ERROR) << "Failed to stat wal file \"" << path << "\" (" << errno
+               << "): " << strerror(errno);
+    return false;
+  }
+  if (st.st_size == 0) {
+    return true;
+  }
+  void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    LOG(ERROR) << "Failed to mmap wal file \"" << path << "\" (" << errno
+               << "): " << strerror(errno);
+    return false;
+  }
+  madvise(addr, st.st_size, MADV_SEQUENTIAL);
+  data_ = static_cast<char*>(addr);
+  size_ = st.st_size;
+  return true;
+}
+
+void WalFileIterator::unmapFile() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+}
+
+LogID WalFileIterator::readHead() {
+  CHECK_LE(currPos_ + kHeadSize, static_cast<int64_t>(size_))
+      << "Failed to read the wal \"" << infos_.front()->path() << "\" at " << currPos_;
+  LogID logId;
+  memcpy(&logId, data_ + currPos_, sizeof(LogID));
+  memcpy(&currTerm_, data_ + currPos_ + sizeof(LogID), sizeof(TermID));
+  memcpy(&currMsgLen_, data_ + currPos_ + sizeof(LogID) + sizeof(TermID), sizeof(int32_t));
+  CHECK_LE(currPos_ + logSize(), static_cast<int64_t>(size_))
+      << "Failed to read the wal \"" << infos_.front()->path() << "\" at " << currPos_;
+  return logId;
+}
+
+int64_t WalFileIterator::logSize() const { return kHeadSize + currMsgLen_ + sizeof(int32_t); }
+
 }  // namespace wal
 }  // namespace nebula
@@ -6,14 +6,25 @@
 #ifndef WAL_WALFILEITERATOR_H_
 #define WAL_WALFILEITERATOR_H_
 
+#include <folly/SharedMutex.h>
+
 #include "common/base/Base.h"
 #include "common/utils/LogIterator.h"
+#include "kvstore/wal/WalFileInfo.h"
 
 namespace nebula {
 namespace wal {
 
 class FileBasedWal;
 
+/**
+ * Read the logs from the wal files.
+ *
+ * The files are memory mapped one at a time when the iterator reaches them,
+ * and the log to start from is found by the sparse index of the file, so
+ * only the logs after the nearest indexed one are scanned. The wal is not
+ * rolled back while the iterator lives, which would truncate the mapped file.
+ */
 class WalFileIterator final : public LogIterator {
  public:
   // The range is [startId, lastId]
@@ -37,9 +48,21 @@ class WalFileIterator final : public LogIterator {
  private:
   LogID getFirstIdInNextFile() const;
 
+  // Map the file at the front of infos_, return false if failed
+  bool mapFile();
+
+  void unmapFile();
+
+  // Read the head of the log at currPos_, return its id
+  LogID readHead();
+
+  // The size of the log at currPos_ in the file
+  int64_t logSize() const;
+
  private:
   // Holds the Wal object, so that it will not be destroyed before the iterator
   std::shared_ptr<FileBasedWal> wal_;
+  folly::SharedMutex::ReadHolder rollbackHolder_;
 
   LogID lastId_;
   LogID currId_;
@@ -49,10 +72,12 @@ class WalFileIterator final : public LogIterator {
 
   // [firstId, lastId]
   std::list<std::pair<LogID, LogID>> idRanges_;
-  std::list<int> fds_;
+  std::list<WalFileInfoPtr> infos_;
+  // The mapping of the current file
+  char* data_{nullptr};
+  size_t size_{0};
   int64_t currPos_{0};
   int32_t currMsgLen_{0};
-  mutable std::string currLog_;
 };
 
 }  // namespace wal
@@ -0,0 +1,114 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/wal/WalSyncer.h"
+
+#include <folly/system/ThreadName.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+DEFINE_uint32(wal_group_commit_window_us,
+              0,
+              "How long the wal group commit waits for more wals to join a batch "
+              "before syncing it, in microseconds");
+DEFINE_bool(wal_group_commit_syncfs,
+            false,
+            "Sync a batch of many wals by one syncfs instead of one fdatasync "
+            "for each, which flushes the other dirty files on the device too");
+
+namespace nebula {
+namespace wal {
+
+// static
+std::shared_ptr<WalSyncer> WalSyncer::get(const std::string& path) {
+  static std::mutex lock;
+  static std::unordered_map<dev_t, std::weak_ptr<WalSyncer>> syncers;
+
+  struct stat st;
+  dev_t dev = 0;
+  if (::stat(path.c_str(), &st) == 0) {
+    dev = st.st_dev;
+  } else {
+    LOG(WARNING) << "stat \"" << path << "\" failed, error: " << strerror(errno);
+  }
+  std::lock_guard<std::mutex> g(lock);
+  auto syncer = syncers[dev].lock();
+  if (syncer == nullptr) {
+    syncer.reset(new WalSyncer());
+    syncers[dev] = syncer;
+  }
+  return syncer;
+}
+
+WalSyncer::WalSyncer() {
+  thread_ = std::thread([this] {
+    folly::setThreadName("wal-syncer");
+    loop();
+  });
+}
+
+WalSyncer::~WalSyncer() {
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    stopped_ = true;
+  }
+  cv_.notify_one();
+  thread_.join();
+}
+
+folly::Future<bool> WalSyncer::sync(int fd) {
+  folly::Promise<bool> promise;
+  auto future = promise.getFuture();
+  {
+    std::lock_guard<std::mutex> g(lock_);
+    pending_.emplace_back(fd, std::move(promise));
+  }
+  cv_.notify_one();
+  return future;
+}
+
+void WalSyncer::loop() {
+  while (true) {
+    std::vector<std::pair<int, folly::Promise<bool>>> batch;
+    {
+      std::unique_lock<std::mutex> g(lock_);
+      cv_.wait(g, [this] { return stopped_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        // Stopped
+        return;
+      }
+      if (FLAGS_wal_group_commit_window_us > 0) {
+        cv_.wait_for(g, std::chrono::microseconds(FLAGS_wal_group_commit_window_us), [this] {
+          return stopped_;
+        });
+      }
+      batch.swap(pending_);
+    }
+    if (batch.size() > 1 && FLAGS_wal_group_commit_syncfs) {
+      bool ok = true;
+      if (::syncfs(batch.front().first) == -1) {
+        LOG(WARNING) << "syncfs for wal failed, error: " << strerror(errno);
+        ok = false;
+      }
+      for (auto& p : batch) {
+        p.second.setValue(ok);
+      }
+      continue;
+    }
+    // A wal waits for its fd being synced before appending more, so an fd is
+    // queued at most once in a batch
+    for (auto& p : batch) {
+      bool ok = true;
+      if (::fdatasync(p.first) == -1) {
+        LOG(WARNING) << "sync wal fd " << p.first << " failed, error: " << strerror(errno);
+        ok = false;
+      }
+      p.second.setValue(ok);
+    }
+  }
+}
+
+}  // namespace wal
+}  // namespace nebula
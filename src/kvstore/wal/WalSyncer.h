@@ -0,0 +1,55 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WAL_WALSYNCER_H_
+#define WAL_WALSYNCER_H_
+
+#include <folly/futures/Future.h>
+#include <sys/types.h>
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace wal {
+
+/**
+ * Group commit of the wal files on the same device.
+ *
+ * The wals queue the fds to sync and block on the futures. A background
+ * thread takes all the queued fds as a batch, syncs them and fulfills the
+ * promises. A wal doesn't write its next logs before its own sync is done,
+ * so the coalescing is across the wals: the appends of the different parts
+ * which come while a batch is being synced are synced together in the next
+ * one. Unless --wal_group_commit_syncfs is on, the fds of a batch are still
+ * synced one by one on the thread, so the syncs of the parts which used to
+ * run in parallel are serialized, and it only pays off when a single syncfs
+ * syncs the whole batch. Hence --wal_group_commit is off by default.
+ */
+class WalSyncer final {
+ public:
+  // The syncer shared by the wals on the device of `path'
+  static std::shared_ptr<WalSyncer> get(const std::string& path);
+
+  ~WalSyncer();
+
+  // Return false if failed
+  folly::Future<bool> sync(int fd);
+
+ private:
+  WalSyncer();
+
+  void loop();
+
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::vector<std::pair<int, folly::Promise<bool>>> pending_;
+  bool stopped_{false};
+  std::thread thread_;
+};
+
+}  // namespace wal
+}  // namespace nebula
+
+#endif  // WAL_WALSYNCER_H_
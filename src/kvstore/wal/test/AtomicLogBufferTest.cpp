@@ -146,6 +146,51 @@ TEST(AtomicLogBufferTest, ResetThenPushExceedLimit) {
   CHECK(logBuffer->seek(logId) != nullptr);
 }
 
+TEST(AtomicLogBufferTest, SharedLogMsgTest) {
+  auto logBuffer = AtomicLogBuffer::instance();
+  logBuffer->push(0, Record(0, 0, std::string(8, 'a')));
+  logBuffer->push(1, Record(0, 0, std::string(kMinSharedMsgSize, 'b')));
+  std::vector<folly::IOBuf> bufs;
+  {
+    auto iter = logBuffer->iterator(0, 1);
+    for (; iter->valid(); ++(*iter)) {
+      auto buf = iter->logMsgBuf();
+      EXPECT_EQ(iter->logMsg(), folly::StringPiece(buf.coalesce()));
+      // Only the large one refers to the record
+      auto shared = iter->logMsg().data() == reinterpret_cast<const char*>(buf.data());
+      EXPECT_EQ(iter->logId() == 1, shared);
+      bufs.emplace_back(std::move(buf));
+    }
+  }
+  // The shared log keeps the buffer referred after the iterator is gone
+  EXPECT_EQ(1, logBuffer->refs_.load());
+  bufs.clear();
+  EXPECT_EQ(0, logBuffer->refs_.load());
+}
+
+TEST(AtomicLogBufferTest, CopyLogMsgWhenGcPendingTest) {
+  auto logBuffer = AtomicLogBuffer::instance();
+  logBuffer->push(0, Record(0, 0, std::string(kMinSharedMsgSize, 'a')));
+  // Fill enough nodes to exceed the limit of dirty nodes once they are reset
+  LogID logId = 1;
+  for (; logId <= (logBuffer->dirtyNodesLimit_ + 1) * kMaxLength; logId++) {
+    logBuffer->push(logId, Record(0, 0, std::string(8, 'b')));
+  }
+  auto iter = logBuffer->iterator(0, 0);
+  ASSERT_TRUE(iter->valid());
+  auto shared = iter->logMsgBuf();
+  EXPECT_EQ(iter->logMsg().data(), reinterpret_cast<const char*>(shared.data()));
+  EXPECT_EQ(2, logBuffer->refs_.load());
+
+  logBuffer->reset();
+  EXPECT_TRUE(logBuffer->gcPending());
+  // The log is copied out, so it doesn't hold the buffer from being collected
+  auto copied = iter->logMsgBuf();
+  EXPECT_EQ(iter->logMsg(), folly::StringPiece(copied.coalesce()));
+  EXPECT_NE(iter->logMsg().data(), reinterpret_cast<const char*>(copied.data()));
+  EXPECT_EQ(2, logBuffer->refs_.load());
+}
+
 }  // namespace wal
 }  // namespace nebula
 
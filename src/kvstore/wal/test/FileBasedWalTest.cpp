@@ -3,6 +3,7 @@
  * This source code is licensed under Apache 2.0 License.
  */
 
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 
 #include "common/base/Base.h"
@@ -10,6 +11,7 @@
 #include "kvstore/wal/FileBasedWal.h"
 
 DECLARE_int32(wal_ttl);
+DECLARE_bool(wal_group_commit);
 
 namespace nebula {
 namespace wal {
@@ -194,6 +196,45 @@ TEST(FileBasedWal, Rollback) {
   EXPECT_EQ(6001, id);
 }
 
+TEST(FileBasedWal, RollbackWaitsForIterator) {
+  FileBasedWalInfo info;
+  FileBasedWalPolicy policy;
+  policy.fileSize = 1024L * 1024L;
+  policy.bufferSize = 1024L * 1024L;
+
+  TempDir walDir("/tmp/testWal.XXXXXX");
+  auto wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, const std::string&) {
+        return true;
+      });
+  for (int i = 1; i <= 3000; i++) {
+    ASSERT_TRUE(
+        wal->appendLog(i /*id*/, 1 /*term*/, 0 /*cluster*/, folly::stringPrintf(kLongMsg, i)));
+  }
+
+  // The logs at the beginning are only in the wal files
+  auto it = wal->iterator(1, 3000);
+  ASSERT_TRUE(it->valid());
+  std::atomic<bool> rolledBack{false};
+  std::thread t([&] {
+    ASSERT_TRUE(wal->rollbackToLog(10));
+    rolledBack = true;
+  });
+  // The rollback doesn't truncate the files under the iterator
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_FALSE(rolledBack);
+  LogID id = 1;
+  for (; it->valid(); ++(*it), ++id) {
+    ASSERT_EQ(id, it->logId());
+    ASSERT_EQ(folly::stringPrintf(kLongMsg, id), it->logMsg());
+  }
+  EXPECT_EQ(3001, id);
+  it.reset();
+  t.join();
+  EXPECT_TRUE(rolledBack);
+  EXPECT_EQ(10, wal->lastLogId());
+}
+
 TEST(FileBasedWal, RollbackThenReopen) {
   // Force to make each file 1MB, each buffer is 1MB, and there are two
   // buffers at most
@@ -568,6 +609,51 @@ TEST(FileBasedWal, CleanWalBeforeIdTest) {
   CHECK_EQ(1000, wal->lastLogId());
 }
 
+TEST(FileBasedWal, GroupCommit) {
+  FLAGS_wal_group_commit = true;
+  SCOPE_EXIT { FLAGS_wal_group_commit = false; };
+  FileBasedWalInfo info;
+  FileBasedWalPolicy policy;
+  policy.sync = true;
+  policy.fileSize = 16 * 1024;
+  TempDir walRoot("/tmp/testWal.XXXXXX");
+
+  // Several wals on the same device append concurrently
+  constexpr int kWals = 4;
+  constexpr int kLogs = 200;
+  std::vector<std::thread> threads;
+  for (int w = 0; w < kWals; ++w) {
+    threads.emplace_back([&, w] {
+      auto wal = FileBasedWal::getWal(
+          folly::stringPrintf("%s/%d", walRoot.path(), w),
+          info,
+          policy,
+          [](LogID, TermID, ClusterID, const std::string&) { return true; });
+      for (int i = 1; i <= kLogs; i++) {
+        EXPECT_TRUE(wal->appendLog(i, 1, 0, folly::stringPrintf(kLongMsg, i)));
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (int w = 0; w < kWals; ++w) {
+    auto wal = FileBasedWal::getWal(
+        folly::stringPrintf("%s/%d", walRoot.path(), w),
+        info,
+        policy,
+        [](LogID, TermID, ClusterID, const std::string&) { return true; });
+    EXPECT_EQ(kLogs, wal->lastLogId());
+    LogID id = 1;
+    for (auto iter = wal->iterator(1, kLogs); iter->valid(); ++(*iter)) {
+      EXPECT_EQ(folly::stringPrintf(kLongMsg, id), iter->logMsg().toString());
+      ++id;
+    }
+    EXPECT_EQ(kLogs + 1, id);
+  }
+}
+
 }  // namespace wal
 }  // namespace nebula
 
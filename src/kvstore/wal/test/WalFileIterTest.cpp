@@ -100,6 +100,59 @@ TEST(WalFileIter, MultiFilesReadTest) {
   }
 }
 
+TEST(WalFileIter, SeekByIndexTest) {
+  FileBasedWalInfo info;
+  FileBasedWalPolicy policy;
+  policy.fileSize = 64 * 1024;
+  TempDir walDir("/tmp/testWal.XXXXXX");
+
+  auto wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, const std::string&) {
+        return true;
+      });
+  for (int i = 1; i <= 10000; i++) {
+    EXPECT_TRUE(wal->appendLog(i /*id*/,
+                               i / 100 /*term*/,
+                               i % 3 /*cluster*/,
+                               folly::stringPrintf("Test string %02d", i)));
+  }
+  EXPECT_LT(2, wal->walFiles_.size());
+
+  auto check = [&wal](LogID start, LogID end) {
+    auto it = std::make_unique<WalFileIterator>(wal, start, end);
+    LogID id = start;
+    for (; it->valid(); ++(*it), ++id) {
+      ASSERT_EQ(id, it->logId());
+      ASSERT_EQ(id / 100, it->logTerm());
+      ASSERT_EQ(id % 3, it->logSource());
+      ASSERT_EQ(folly::stringPrintf("Test string %02ld", id), it->logMsg());
+    }
+    EXPECT_EQ(end + 1, id);
+  };
+  // Indexed when appended
+  auto first = wal->walFiles_.begin()->second;
+  EXPECT_EQ(kWalIndexInterval + 1, first->seekIndex(kWalIndexInterval + 10).first);
+  for (LogID start : {1, 63, 64, 65, 700, 9999}) {
+    check(start, std::min<LogID>(start + 300, 10000));
+  }
+
+  // The files before the last one are not indexed after a restart, until they
+  // are read
+  wal.reset();
+  wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, const std::string&) {
+        return true;
+      });
+  EXPECT_EQ(10000, wal->lastLogId());
+  first = wal->walFiles_.begin()->second;
+  EXPECT_EQ(1, first->seekIndex(700).first);
+  check(700, 800);
+  EXPECT_EQ(1 + 10 * kWalIndexInterval, first->seekIndex(700).first);
+  for (LogID start : {1, 63, 64, 65, 701, 9999}) {
+    check(start, std::min<LogID>(start + 300, 10000));
+  }
+}
+
 }  // namespace wal
 }  // namespace nebula
 
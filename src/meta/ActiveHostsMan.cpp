@@ -13,6 +13,10 @@
 
 DECLARE_int32(heartbeat_interval_secs);
 DECLARE_uint32(expired_time_factor);
+DEFINE_uint32(meta_change_log_ttl_secs,
+              3600,
+              "How long the entries of the meta change log are kept, the clients not synced "
+              "for longer reload all the meta data");
 
 namespace nebula {
 namespace meta {
@@ -62,8 +66,14 @@ nebula::cpp2::ErrorCode ActiveHostsMan::updateHostInfo(kvstore::KVStore* kv,
   }
   // indicate whether any leader info is updated
   bool hasUpdate = false;
+  std::vector<GraphSpaceID> spaces;
   if (!data.empty()) {
     hasUpdate = true;
+    std::vector<std::string> keys;
+    for (const auto& entry : data) {
+      keys.emplace_back(entry.first);
+    }
+    spaces = LastUpdateTimeMan::changedSpaces(keys);
   }
   data.emplace_back(MetaKeyUtils::hostKey(hostAddr.host, hostAddr.port), HostInfo::encodeV2(info));
 
@@ -80,7 +90,7 @@ nebula::cpp2::ErrorCode ActiveHostsMan::updateHostInfo(kvstore::KVStore* kv,
     return ret;
   }
   if (hasUpdate) {
-    ret = LastUpdateTimeMan::update(kv, time::WallClock::fastNowInMilliSec());
+    ret = LastUpdateTimeMan::update(kv, time::WallClock::fastNowInMilliSec(), spaces);
   }
   return ret;
 }
@@ -219,20 +229,69 @@ ErrorOr<nebula::cpp2::ErrorCode, HostInfo> ActiveHostsMan::getHostInfo(kvstore::
 
 nebula::cpp2::ErrorCode LastUpdateTimeMan::update(kvstore::KVStore* kv,
                                                   const int64_t timeInMilliSec) {
+  return doUpdate(kv, timeInMilliSec, true, {});
+}
+
+nebula::cpp2::ErrorCode LastUpdateTimeMan::update(kvstore::KVStore* kv,
+                                                  const int64_t timeInMilliSec,
+                                                  const std::vector<GraphSpaceID>& spaces) {
+  return doUpdate(kv, timeInMilliSec, false, spaces);
+}
+
+nebula::cpp2::ErrorCode LastUpdateTimeMan::doUpdate(kvstore::KVStore* kv,
+                                                    int64_t timeInMilliSec,
+                                                    bool full,
+                                                    const std::vector<GraphSpaceID>& spaces) {
   CHECK_NOTNULL(kv);
+  folly::SharedMutex::WriteHolder wHolder(LockUtils::lastUpdateTimeLock());
+  // Keep the time increasing even if the clock goes back or several updates
+  // happen in the same millisecond, since it's the key of the change log
+  std::string val;
+  auto code = kv->get(kDefaultSpaceId, kDefaultPartId, MetaKeyUtils::lastUpdateTimeKey(), &val);
+  if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    auto lastTime = *reinterpret_cast<const int64_t*>(val.data());
+    timeInMilliSec = std::max(timeInMilliSec, lastTime + 1);
+  } else if (code != nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    return code;
+  }
+
   std::vector<kvstore::KV> data;
   data.emplace_back(MetaKeyUtils::lastUpdateTimeKey(),
                     MetaKeyUtils::lastUpdateTimeVal(timeInMilliSec));
+  data.emplace_back(MetaKeyUtils::changeLogKey(timeInMilliSec),
+                    MetaKeyUtils::changeLogVal(full, spaces));
 
-  folly::SharedMutex::WriteHolder wHolder(LockUtils::lastUpdateTimeLock());
   folly::Baton<true, std::atomic> baton;
   nebula::cpp2::ErrorCode ret;
   kv->asyncMultiPut(
-      kDefaultSpaceId, kDefaultPartId, std::move(data), [&](nebula::cpp2::ErrorCode code) {
-        ret = code;
+      kDefaultSpaceId, kDefaultPartId, std::move(data), [&](nebula::cpp2::ErrorCode c) {
+        ret = c;
         baton.post();
       });
   baton.wait();
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+
+  // Truncate the expired entries once in a while rather than every update
+  static int64_t truncatedTime = 0;
+  int64_t ttl = static_cast<int64_t>(FLAGS_meta_change_log_ttl_secs) * 1000;
+  if (timeInMilliSec - truncatedTime > ttl / 2) {
+    baton.reset();
+    kv->asyncRemoveRange(kDefaultSpaceId,
+                         kDefaultPartId,
+                         MetaKeyUtils::changeLogPrefix(),
+                         MetaKeyUtils::changeLogKey(timeInMilliSec - ttl),
+                         [&](nebula::cpp2::ErrorCode c) {
+                           if (c != nebula::cpp2::ErrorCode::SUCCEEDED) {
+                             LOG(WARNING) << "Truncate the meta change log failed, error: "
+                                          << apache::thrift::util::enumNameSafe(c);
+                           }
+                           baton.post();
+                         });
+    baton.wait();
+    truncatedTime = timeInMilliSec;
+  }
   return ret;
 }
 
@@ -249,5 +308,61 @@ ErrorOr<nebula::cpp2::ErrorCode, int64_t> LastUpdateTimeMan::get(kvstore::KVStor
   return *reinterpret_cast<const int64_t*>(val.data());
 }
 
+ErrorOr<nebula::cpp2::ErrorCode, MetaChanges> LastUpdateTimeMan::getChanges(
+    kvstore::KVStore* kv, int64_t sinceInMilliSec) {
+  CHECK_NOTNULL(kv);
+  folly::SharedMutex::ReadHolder rHolder(LockUtils::lastUpdateTimeLock());
+  MetaChanges changes;
+  std::string val;
+  auto code = kv->get(kDefaultSpaceId, kDefaultPartId, MetaKeyUtils::lastUpdateTimeKey(), &val);
+  if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    changes.lastUpdateTimeInMilliSec = *reinterpret_cast<const int64_t*>(val.data());
+  } else if (code != nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    return code;
+  }
+  if (sinceInMilliSec == changes.lastUpdateTimeInMilliSec) {
+    return changes;
+  }
+
+  std::unique_ptr<kvstore::KVIterator> iter;
+  code = kv->rangeWithPrefix(kDefaultSpaceId,
+                             kDefaultPartId,
+                             MetaKeyUtils::changeLogKey(sinceInMilliSec),
+                             MetaKeyUtils::changeLogPrefix(),
+                             &iter);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  // The entry of the update the client synced to must be there, otherwise
+  // it has been truncated, or written before the change log is introduced
+  if (!iter->valid() || MetaKeyUtils::parseChangeLogTime(iter->key()) != sinceInMilliSec) {
+    changes.full = true;
+    return changes;
+  }
+  std::unordered_set<GraphSpaceID> spaces;
+  for (iter->next(); iter->valid(); iter->next()) {
+    bool full = false;
+    auto entry = MetaKeyUtils::parseChangeLogVal(iter->val(), &full);
+    if (full) {
+      changes.full = true;
+      return changes;
+    }
+    spaces.insert(entry.begin(), entry.end());
+  }
+  changes.spaces.assign(spaces.begin(), spaces.end());
+  return changes;
+}
+
+std::vector<GraphSpaceID> LastUpdateTimeMan::changedSpaces(const std::vector<std::string>& keys) {
+  std::unordered_set<GraphSpaceID> spaces;
+  for (const auto& key : keys) {
+    auto space = MetaKeyUtils::parseSpaceOfKey(key);
+    if (space != -1) {
+      spaces.emplace(space);
+    }
+  }
+  return std::vector<GraphSpaceID>(spaces.begin(), spaces.end());
+}
+
 }  // namespace meta
 }  // namespace nebula
@@ -153,16 +153,49 @@ class ActiveHostsMan final {
   ActiveHostsMan() = default;
 };
 
+// The meta data changed since some time
+struct MetaChanges {
+  int64_t lastUpdateTimeInMilliSec{0};
+  // Not all the changes are recorded, the client should reload all
+  bool full{false};
+  std::vector<GraphSpaceID> spaces;
+};
+
+/**
+ * Besides the last update time, each update appends an entry to the change
+ * log with the spaces it changed, so that the clients could reload only
+ * those spaces. The update times are kept increasing to be the keys of the
+ * entries, and the entries older than --meta_change_log_ttl_secs are
+ * truncated.
+ */
 class LastUpdateTimeMan final {
  public:
   ~LastUpdateTimeMan() = default;
 
+  // The changed spaces are unknown, the clients will reload all
   static nebula::cpp2::ErrorCode update(kvstore::KVStore* kv, const int64_t timeInMilliSec);
 
+  // Only the meta data of `spaces', and the ones not belonging to any space are changed
+  static nebula::cpp2::ErrorCode update(kvstore::KVStore* kv,
+                                        const int64_t timeInMilliSec,
+                                        const std::vector<GraphSpaceID>& spaces);
+
   static ErrorOr<nebula::cpp2::ErrorCode, int64_t> get(kvstore::KVStore* kv);
 
+  // The changes after the update at `sinceInMilliSec'
+  static ErrorOr<nebula::cpp2::ErrorCode, MetaChanges> getChanges(kvstore::KVStore* kv,
+                                                                  int64_t sinceInMilliSec);
+
+  // The spaces changed by putting or removing the keys
+  static std::vector<GraphSpaceID> changedSpaces(const std::vector<std::string>& keys);
+
  protected:
   LastUpdateTimeMan() = default;
+
+  static nebula::cpp2::ErrorCode doUpdate(kvstore::KVStore* kv,
+                                          int64_t timeInMilliSec,
+                                          bool full,
+                                          const std::vector<GraphSpaceID>& spaces);
 };
 
 }  // namespace meta
@@ -10,6 +10,7 @@
 #include "meta/processors/admin/CreateBackupProcessor.h"
 #include "meta/processors/admin/CreateSnapshotProcessor.h"
 #include "meta/processors/admin/DropSnapshotProcessor.h"
+#include "meta/processors/admin/GetMetaChangesProcessor.h"
 #include "meta/processors/admin/GetMetaDirInfoProcessor.h"
 #include "meta/processors/admin/HBProcessor.h"
 #include "meta/processors/admin/LeaderBalanceProcessor.h"
@@ -585,5 +586,11 @@ folly::Future<cpp2::VerifyClientVersionResp> MetaServiceHandler::future_verifyCl
   auto* processor = VerifyClientVersionProcessor::instance(kvstore_);
   RETURN_FUTURE(processor);
 }
+
+folly::Future<cpp2::GetMetaChangesResp> MetaServiceHandler::future_getMetaChanges(
+    const cpp2::GetMetaChangesReq& req) {
+  auto* processor = GetMetaChangesProcessor::instance(kvstore_);
+  RETURN_FUTURE(processor);
+}
 }  // namespace meta
 }  // namespace nebula
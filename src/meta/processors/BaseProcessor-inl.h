@@ -399,6 +399,12 @@ nebula::cpp2::ErrorCode BaseProcessor<RESP>::doSyncPut(std::vector<kvstore::KV>
 
 template <typename RESP>
 void BaseProcessor<RESP>::doSyncPutAndUpdate(std::vector<kvstore::KV> data) {
+  std::vector<std::string> keys;
+  keys.reserve(data.size());
+  for (const auto& kv : data) {
+    keys.emplace_back(kv.first);
+  }
+  auto spaces = LastUpdateTimeMan::changedSpaces(keys);
   folly::Baton<true, std::atomic> baton;
   auto ret = nebula::cpp2::ErrorCode::SUCCEEDED;
   kvstore_->asyncMultiPut(kDefaultSpaceId,
@@ -417,13 +423,15 @@ void BaseProcessor<RESP>::doSyncPutAndUpdate(std::vector<kvstore::KV> data) {
     this->onFinished();
     return;
   }
-  auto retCode = LastUpdateTimeMan::update(kvstore_, time::WallClock::fastNowInMilliSec());
+  auto retCode =
+      LastUpdateTimeMan::update(kvstore_, time::WallClock::fastNowInMilliSec(), spaces);
   this->handleErrorCode(retCode);
   this->onFinished();
 }
 
 template <typename RESP>
 void BaseProcessor<RESP>::doSyncMultiRemoveAndUpdate(std::vector<std::string> keys) {
+  auto spaces = LastUpdateTimeMan::changedSpaces(keys);
   folly::Baton<true, std::atomic> baton;
   auto ret = nebula::cpp2::ErrorCode::SUCCEEDED;
   kvstore_->asyncMultiRemove(kDefaultSpaceId,
@@ -442,7 +450,8 @@ void BaseProcessor<RESP>::doSyncMultiRemoveAndUpdate(std::vector<std::string> ke
     this->onFinished();
     return;
   }
-  auto retCode = LastUpdateTimeMan::update(kvstore_, time::WallClock::fastNowInMilliSec());
+  auto retCode =
+      LastUpdateTimeMan::update(kvstore_, time::WallClock::fastNowInMilliSec(), spaces);
   this->handleErrorCode(retCode);
   this->onFinished();
 }
@@ -0,0 +1,32 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "meta/processors/admin/GetMetaChangesProcessor.h"
+
+#include "meta/ActiveHostsMan.h"
+
+namespace nebula {
+namespace meta {
+
+void GetMetaChangesProcessor::process(const cpp2::GetMetaChangesReq& req) {
+  auto ret = LastUpdateTimeMan::getChanges(kvstore_, req.get_since_in_ms());
+  if (!nebula::ok(ret)) {
+    auto retCode = nebula::error(ret);
+    LOG(ERROR) << "Get meta changes failed, error: "
+               << apache::thrift::util::enumNameSafe(retCode);
+    handleErrorCode(retCode);
+    onFinished();
+    return;
+  }
+  auto changes = nebula::value(std::move(ret));
+  resp_.set_last_update_time_in_ms(changes.lastUpdateTimeInMilliSec);
+  resp_.set_full(changes.full);
+  resp_.set_spaces(std::move(changes.spaces));
+  handleErrorCode(nebula::cpp2::ErrorCode::SUCCEEDED);
+  onFinished();
+}
+
+}  // namespace meta
+}  // namespace nebula
@@ -0,0 +1,34 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef META_GETMETACHANGESPROCESSOR_H_
+#define META_GETMETACHANGESPROCESSOR_H_
+
+#include "meta/processors/BaseProcessor.h"
+
+namespace nebula {
+namespace meta {
+
+/**
+ * Return the spaces changed since the last update the client synced to, so
+ * that it reloads only them instead of all the meta data.
+ */
+class GetMetaChangesProcessor final : public BaseProcessor<cpp2::GetMetaChangesResp> {
+ public:
+  static GetMetaChangesProcessor* instance(kvstore::KVStore* kvstore) {
+    return new GetMetaChangesProcessor(kvstore);
+  }
+
+  void process(const cpp2::GetMetaChangesReq& req);
+
+ private:
+  explicit GetMetaChangesProcessor(kvstore::KVStore* kvstore)
+      : BaseProcessor<cpp2::GetMetaChangesResp>(kvstore) {}
+};
+
+}  // namespace meta
+}  // namespace nebula
+
+#endif  // META_GETMETACHANGESPROCESSOR_H_
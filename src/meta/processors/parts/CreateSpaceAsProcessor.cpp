@@ -92,7 +92,8 @@ void CreateSpaceAsProcessor::process(const cpp2::CreateSpaceAsReq &req) {
     return;
   }
 
-  rc_ = LastUpdateTimeMan::update(kvstore_, time::WallClock::fastNowInMilliSec());
+  rc_ = LastUpdateTimeMan::update(
+      kvstore_, time::WallClock::fastNowInMilliSec(), {nebula::value(newSpaceId)});
   if (rc_ != nebula::cpp2::ErrorCode::SUCCEEDED) {
     LOG(ERROR) << "update last update time error, " << apache::thrift::util::enumNameSafe(rc_);
     return;
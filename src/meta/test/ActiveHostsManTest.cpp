@@ -191,6 +191,7 @@ TEST(LastUpdateTimeManTest, NormalTest) {
   ASSERT_TRUE(nebula::ok(lastUpRet));
   ASSERT_EQ(now + 100, nebula::value(lastUpRet));
 
+  // The time is kept increasing even if the clock goes back
   LastUpdateTimeMan::update(kv.get(), now - 100);
   {
     auto key = MetaKeyUtils::lastUpdateTimeKey();
@@ -198,10 +199,72 @@ TEST(LastUpdateTimeManTest, NormalTest) {
     auto ret = kv->get(kDefaultSpaceId, kDefaultPartId, key, &val);
     ASSERT_EQ(ret, nebula::cpp2::ErrorCode::SUCCEEDED);
     int64_t lastUpdateTime = *reinterpret_cast<const int64_t*>(val.data());
-    ASSERT_EQ(now - 100, lastUpdateTime);
+    ASSERT_EQ(now + 101, lastUpdateTime);
   }
 }
 
+TEST(LastUpdateTimeManTest, ChangeLogTest) {
+  fs::TempDir rootPath("/tmp/LastUpdateTimeManTest.XXXXXX");
+  std::unique_ptr<kvstore::KVStore> kv(MockCluster::initMetaKV(rootPath.path()));
+  int64_t now = time::WallClock::fastNowInMilliSec();
+
+  {
+    // Nothing changed
+    auto ret = LastUpdateTimeMan::getChanges(kv.get(), 0);
+    ASSERT_TRUE(nebula::ok(ret));
+    auto changes = nebula::value(ret);
+    ASSERT_EQ(0, changes.lastUpdateTimeInMilliSec);
+    ASSERT_FALSE(changes.full);
+    ASSERT_TRUE(changes.spaces.empty());
+  }
+
+  ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, LastUpdateTimeMan::update(kv.get(), now, {1}));
+  ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            LastUpdateTimeMan::update(kv.get(), now + 1, {2, 3}));
+  ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, LastUpdateTimeMan::update(kv.get(), now + 2, {}));
+  {
+    auto ret = LastUpdateTimeMan::getChanges(kv.get(), now);
+    ASSERT_TRUE(nebula::ok(ret));
+    auto changes = nebula::value(ret);
+    ASSERT_EQ(now + 2, changes.lastUpdateTimeInMilliSec);
+    ASSERT_FALSE(changes.full);
+    std::sort(changes.spaces.begin(), changes.spaces.end());
+    ASSERT_EQ((std::vector<GraphSpaceID>{2, 3}), changes.spaces);
+  }
+  {
+    // The client has synced to the latest
+    auto ret = LastUpdateTimeMan::getChanges(kv.get(), now + 2);
+    ASSERT_TRUE(nebula::ok(ret));
+    ASSERT_FALSE(nebula::value(ret).full);
+    ASSERT_TRUE(nebula::value(ret).spaces.empty());
+  }
+  {
+    // The client has never synced, or synced to an update not recorded
+    for (auto since : {int64_t(0), now - 1}) {
+      auto ret = LastUpdateTimeMan::getChanges(kv.get(), since);
+      ASSERT_TRUE(nebula::ok(ret));
+      ASSERT_TRUE(nebula::value(ret).full);
+    }
+  }
+
+  // The changed spaces are unknown
+  ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, LastUpdateTimeMan::update(kv.get(), now + 3));
+  {
+    auto ret = LastUpdateTimeMan::getChanges(kv.get(), now + 1);
+    ASSERT_TRUE(nebula::ok(ret));
+    ASSERT_TRUE(nebula::value(ret).full);
+  }
+
+  std::vector<std::string> keys = {MetaKeyUtils::spaceKey(1),
+                                   MetaKeyUtils::schemaTagKey(2, 1, 0),
+                                   MetaKeyUtils::indexKey(3, 1),
+                                   MetaKeyUtils::userKey("root"),
+                                   MetaKeyUtils::hostKey("127.0.0.1", 1)};
+  auto spaces = LastUpdateTimeMan::changedSpaces(keys);
+  std::sort(spaces.begin(), spaces.end());
+  ASSERT_EQ((std::vector<GraphSpaceID>{1, 2, 3}), spaces);
+}
+
 }  // namespace meta
 }  // namespace nebula
 
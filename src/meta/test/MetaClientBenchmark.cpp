@@ -0,0 +1,121 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+
+#include "clients/meta/MetaClient.h"
+#include "common/base/Base.h"
+#include "common/fs/TempDir.h"
+#include "meta/test/TestUtils.h"
+#include "mock/MockCluster.h"
+
+DEFINE_int32(parts_num, 100, "The number of parts of the space looked up");
+
+namespace nebula {
+namespace meta {
+
+MetaClient* gClient = nullptr;
+GraphSpaceID gSpaceId = 0;
+TagID gTagId = 0;
+
+// Each thread looks up the cache for its share of iters, to see how the
+// lookups of many threads contend with each other
+template <typename Lookup>
+void lookupBM(uint32_t numThreads, uint32_t iters, Lookup lookup) {
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < numThreads; i++) {
+    auto itersInThread =
+        i == 0 ? iters - (iters / numThreads) * (numThreads - 1) : iters / numThreads;
+    threads.emplace_back([&lookup, itersInThread]() {
+      for (uint32_t k = 0; k < itersInThread; k++) {
+        lookup(k);
+      }
+    });
+  }
+
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+void getPartHosts(uint32_t numThreads, uint32_t iters) {
+  lookupBM(numThreads, iters, [](uint32_t k) {
+    auto ret = gClient->getPartHostsFromCache(gSpaceId, k % FLAGS_parts_num + 1);
+    folly::doNotOptimizeAway(ret);
+  });
+}
+
+void getVidLen(uint32_t numThreads, uint32_t iters) {
+  lookupBM(numThreads, iters, [](uint32_t) {
+    auto ret = gClient->getSpaceVidLen(gSpaceId);
+    folly::doNotOptimizeAway(ret);
+  });
+}
+
+void getTagSchema(uint32_t numThreads, uint32_t iters) {
+  lookupBM(numThreads, iters, [](uint32_t) {
+    auto ret = gClient->getTagSchemaFromCache(gSpaceId, gTagId);
+    folly::doNotOptimizeAway(ret);
+  });
+}
+
+BENCHMARK(get_part_hosts_1t, iters) { getPartHosts(1, iters); }
+
+BENCHMARK(get_part_hosts_8t, iters) { getPartHosts(8, iters); }
+
+BENCHMARK(get_part_hosts_32t, iters) { getPartHosts(32, iters); }
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(get_space_vid_len_1t, iters) { getVidLen(1, iters); }
+
+BENCHMARK(get_space_vid_len_8t, iters) { getVidLen(8, iters); }
+
+BENCHMARK(get_space_vid_len_32t, iters) { getVidLen(32, iters); }
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(get_tag_schema_1t, iters) { getTagSchema(1, iters); }
+
+BENCHMARK(get_tag_schema_8t, iters) { getTagSchema(8, iters); }
+
+BENCHMARK(get_tag_schema_32t, iters) { getTagSchema(32, iters); }
+
+}  // namespace meta
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+
+  nebula::fs::TempDir rootPath("/tmp/MetaClientBenchmark.XXXXXX");
+  nebula::mock::MockCluster cluster;
+  cluster.startMeta(rootPath.path());
+  auto* client = cluster.initMetaClient();
+  nebula::meta::TestUtils::createSomeHosts(cluster.metaKV_.get());
+
+  nebula::meta::cpp2::SpaceDesc spaceDesc;
+  spaceDesc.set_space_name("bm_space");
+  spaceDesc.set_partition_num(FLAGS_parts_num);
+  spaceDesc.set_replica_factor(3);
+  auto spaceRet = client->createSpace(spaceDesc).get();
+  CHECK(spaceRet.ok()) << spaceRet.status();
+
+  nebula::meta::cpp2::Schema schema;
+  for (auto i = 0; i < 10; i++) {
+    nebula::meta::cpp2::ColumnDef column;
+    column.name = folly::stringPrintf("col_%d", i);
+    column.type.set_type(nebula::cpp2::PropertyType::INT64);
+    (*schema.columns_ref()).emplace_back(std::move(column));
+  }
+  auto tagRet = client->createTagSchema(spaceRet.value(), "bm_tag", schema).get();
+  CHECK(tagRet.ok()) << tagRet.status();
+  CHECK(client->refreshCache().ok());
+
+  nebula::meta::gClient = client;
+  nebula::meta::gSpaceId = spaceRet.value();
+  nebula::meta::gTagId = tagRet.value();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -213,6 +213,9 @@ void MockCluster::initStorageKV(const char* dataPath,
 
   txnMan_ = std::make_unique<storage::TransactionManager>(storageEnv_.get());
   storageEnv_->txnMan_ = txnMan_.get();
+
+  scanSnapshots_ = std::make_unique<storage::ScanSnapshots>(storageKV_.get());
+  storageEnv_->scanSnapshots_ = scanSnapshots_.get();
 }
 
 void MockCluster::startStorage(HostAddr addr,
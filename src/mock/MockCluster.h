@@ -23,6 +23,7 @@
 #include "storage/BaseProcessor.h"
 #include "storage/GraphStorageServiceHandler.h"
 #include "storage/StorageAdminServiceHandler.h"
+#include "storage/query/ScanSnapshots.h"
 #include "storage/transaction/TransactionManager.h"
 
 namespace nebula {
@@ -107,6 +108,9 @@ class MockCluster {
     if (metaKV_) {
       metaKV_->stop();
     }
+    if (scanSnapshots_) {
+      scanSnapshots_->releaseAll();
+    }
     if (storageKV_) {
       storageKV_->stop();
     }
@@ -136,6 +140,7 @@ class MockCluster {
   std::unique_ptr<meta::SchemaManager> lSchemaMan_;
   std::unique_ptr<meta::MetaClient> lMetaClient_{nullptr};
   std::unique_ptr<storage::TransactionManager> txnMan_{nullptr};
+  std::unique_ptr<storage::ScanSnapshots> scanSnapshots_{nullptr};
 
   ObjectPool pool_;
 };
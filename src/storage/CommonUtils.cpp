@@ -6,6 +6,7 @@
 #include "storage/CommonUtils.h"
 
 #include "common/time/WallClock.h"
+#include "common/utils/NebulaKeyUtils.h"
 
 namespace nebula {
 namespace storage {
@@ -64,5 +65,54 @@ StatusOr<Value> CommonUtils::ttlValue(const meta::SchemaProviderIf* schema, RowR
   return reader->getValueByName(std::move(ttlProp).second.second);
 }
 
+ErrorOr<nebula::cpp2::ErrorCode, int64_t> CommonUtils::degree(kvstore::KVStore* kvstore,
+                                                              GraphSpaceID spaceId,
+                                                              PartitionID partId,
+                                                              size_t vIdLen,
+                                                              const VertexID& vId,
+                                                              EdgeType type) {
+  std::string val;
+  auto key = NebulaKeyUtils::degreeKey(vIdLen, partId, vId, type);
+  auto ret = kvstore->get(spaceId, partId, key, &val);
+  if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    return 0L;
+  } else if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+  if (val.size() != sizeof(int64_t)) {
+    return nebula::cpp2::ErrorCode::E_INVALID_DATA;
+  }
+  return *reinterpret_cast<const int64_t*>(val.data());
+}
+
+nebula::cpp2::ErrorCode CommonUtils::updateDegrees(
+    kvstore::KVStore* kvstore,
+    GraphSpaceID spaceId,
+    PartitionID partId,
+    size_t vIdLen,
+    const std::map<std::pair<VertexID, EdgeType>, int64_t>& deltas,
+    kvstore::BatchHolder* batchHolder) {
+  for (auto& delta : deltas) {
+    if (delta.second == 0) {
+      continue;
+    }
+    auto& vId = delta.first.first;
+    auto type = delta.first.second;
+    auto ret = degree(kvstore, spaceId, partId, vIdLen, vId, type);
+    if (!nebula::ok(ret)) {
+      return nebula::error(ret);
+    }
+    auto degree = nebula::value(ret) + delta.second;
+    auto key = NebulaKeyUtils::degreeKey(vIdLen, partId, vId, type);
+    if (degree <= 0) {
+      batchHolder->remove(std::move(key));
+    } else {
+      batchHolder->put(std::move(key),
+                       std::string(reinterpret_cast<const char*>(&degree), sizeof(int64_t)));
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 }  // namespace storage
 }  // namespace nebula
@@ -18,6 +18,7 @@
 #include "interface/gen-cpp2/storage_types.h"
 #include "kvstore/KVEngine.h"
 #include "kvstore/KVStore.h"
+#include "kvstore/LogEncoder.h"
 
 namespace nebula {
 namespace storage {
@@ -62,6 +63,7 @@ using EdgesMemLock = MemoryLockCore<EMLI>;
 
 class TransactionManager;
 class InternalStorageClient;
+class ScanSnapshots;
 
 // unify TagID, EdgeType
 using SchemaID = TagID;
@@ -77,6 +79,7 @@ class StorageEnv {
   meta::MetaClient* metaClient_{nullptr};
   InternalStorageClient* interClient_{nullptr};
   TransactionManager* txnMan_{nullptr};
+  ScanSnapshots* scanSnapshots_{nullptr};
   std::unique_ptr<VerticesMemLock> verticesML_{nullptr};
   std::unique_ptr<EdgesMemLock> edgesML_{nullptr};
   std::unique_ptr<kvstore::KVEngine> adminStore_{nullptr};
@@ -242,6 +245,25 @@ class CommonUtils final {
       const meta::SchemaProviderIf* schema);
 
   static StatusOr<Value> ttlValue(const meta::SchemaProviderIf* schema, RowReader* reader);
+
+  // The number of the edges of the type of the vertex, 0 if none
+  static ErrorOr<nebula::cpp2::ErrorCode, int64_t> degree(kvstore::KVStore* kvstore,
+                                                          GraphSpaceID spaceId,
+                                                          PartitionID partId,
+                                                          size_t vIdLen,
+                                                          const VertexID& vId,
+                                                          EdgeType type);
+
+  // Add the deltas of the degrees of (vid, edge type) to the batch. They must
+  // be called in an atomic op, so that no other one changes the degrees between
+  // the read and the write.
+  static nebula::cpp2::ErrorCode updateDegrees(
+      kvstore::KVStore* kvstore,
+      GraphSpaceID spaceId,
+      PartitionID partId,
+      size_t vIdLen,
+      const std::map<std::pair<VertexID, EdgeType>, int64_t>& deltas,
+      kvstore::BatchHolder* batchHolder);
 };
 
 }  // namespace storage
@@ -46,3 +46,20 @@ DEFINE_bool(query_concurrently,
             false,
             "whether to run query of each part concurrently, only lookup and "
             "go are supported");
+
+DEFINE_bool(enable_batched_index_scan,
+            true,
+            "Scan the contexts of a lookup on the same index with the same filter, "
+            "e.g. the ones of an IN-list, by one iterator of each part");
+
+DEFINE_uint64(storage_read_cache_capacity_mb,
+              0,
+              "Capacity of the cache of the tag rows and adjacency lists of the hot "
+              "vertices, in MB, 0 to disable it");
+
+DEFINE_bool(enable_edge_degree,
+            false,
+            "Keep the number of the edges of each type of each vertex, which is "
+            "updated atomically by the inserts and deletes of the edges. It should "
+            "be enabled before any edge is inserted, the existing edges are not "
+            "counted");
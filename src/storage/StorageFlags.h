@@ -34,4 +34,10 @@ DECLARE_int32(max_edge_returned_per_vertex);
 
 DECLARE_bool(query_concurrently);
 
+DECLARE_bool(enable_batched_index_scan);
+
+DECLARE_uint64(storage_read_cache_capacity_mb);
+
+DECLARE_bool(enable_edge_degree);
+
 #endif  // STORAGE_STORAGEFLAGS_H_
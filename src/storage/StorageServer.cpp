@@ -65,6 +65,10 @@ std::unique_ptr<kvstore::KVStore> StorageServer::getStoreInstance() {
   options.cffBuilder_ =
       std::make_unique<StorageCompactionFilterFactoryBuilder>(schemaMan_.get(), indexMan_.get());
   options.schemaMan_ = schemaMan_.get();
+  if (FLAGS_storage_read_cache_capacity_mb > 0) {
+    options.readCache_ =
+        std::make_shared<kvstore::ReadCache>(FLAGS_storage_read_cache_capacity_mb * 1024 * 1024);
+  }
   if (FLAGS_store_type == "nebula") {
     auto nbStore = std::make_unique<kvstore::NebulaStore>(
         std::move(options), ioThreadPool_, localHost_, workers_);
@@ -200,6 +204,9 @@ bool StorageServer::start() {
   }
   env_->txnMan_ = txnMan_.get();
 
+  scanSnapshots_ = std::make_unique<ScanSnapshots>(kvstore_.get());
+  env_->scanSnapshots_ = scanSnapshots_.get();
+
   env_->verticesML_ = std::make_unique<VerticesMemLock>();
   env_->edgesML_ = std::make_unique<EdgesMemLock>();
   env_->adminStore_ = getAdminStoreInstance();
@@ -328,6 +335,11 @@ void StorageServer::stop() {
   ServiceStatus interStorageExpected = ServiceStatus::STATUS_RUNNING;
   internalStorageSvcStatus_.compare_exchange_strong(interStorageExpected, STATUS_STOPPED);
 
+  // The snapshots must be released before the engines are closed
+  if (scanSnapshots_) {
+    scanSnapshots_->releaseAll();
+  }
+
   // kvstore need to stop back ground job before http server dctor
   if (kvstore_) {
     kvstore_->stop();
@@ -16,6 +16,7 @@
 #include "kvstore/NebulaStore.h"
 #include "storage/CommonUtils.h"
 #include "storage/admin/AdminTaskManager.h"
+#include "storage/query/ScanSnapshots.h"
 #include "storage/transaction/TransactionManager.h"
 
 namespace nebula {
@@ -86,6 +87,7 @@ class StorageServer final {
 
   AdminTaskManager* taskMgr_{nullptr};
   std::unique_ptr<TransactionManager> txnMan_{nullptr};
+  std::unique_ptr<ScanSnapshots> scanSnapshots_{nullptr};
   // used for communicate between one storaged to another
   std::unique_ptr<InternalStorageClient> interClient_;
 };
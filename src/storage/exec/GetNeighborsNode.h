@@ -106,8 +106,13 @@ class GetNeighborsNode : public QueryNode<VertexID> {
 
       list.reserve(props->size());
       // collect props need to return
-      if (!QueryUtils::collectEdgeProps(
-               key, context_->vIdLen(), context_->isIntId(), reader, props, list)
+      if (!QueryUtils::collectEdgeProps(key,
+                                        context_->vIdLen(),
+                                        context_->isIntId(),
+                                        reader,
+                                        props,
+                                        &projections_,
+                                        list)
                .ok()) {
         return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
       }
@@ -128,6 +133,7 @@ class GetNeighborsNode : public QueryNode<VertexID> {
   EdgeContext* edgeContext_;
   nebula::DataSet* resultDataSet_;
   int64_t limit_;
+  PropProjections projections_;
 };
 
 class GetNeighborsSampleNode : public GetNeighborsNode {
@@ -142,11 +148,37 @@ class GetNeighborsSampleNode : public GetNeighborsNode {
     sampler_ = std::make_unique<nebula::algorithm::ReservoirSampling<Sample>>(limit);
   }
 
+  nebula::cpp2::ErrorCode doExecute(PartitionID partId, const VertexID& vId) override {
+    // No need to sample if the vertex has no more edges than the limit
+    takeAll_ = false;
+    if (FLAGS_enable_edge_degree) {
+      int64_t degree = 0;
+      for (const auto& ec : edgeContext_->propContexts_) {
+        auto ret = CommonUtils::degree(context_->env()->kvstore_,
+                                       context_->spaceId(),
+                                       partId,
+                                       context_->vIdLen(),
+                                       vId,
+                                       ec.first);
+        if (!nebula::ok(ret)) {
+          degree = limit_ + 1;
+          break;
+        }
+        degree += nebula::value(ret);
+      }
+      takeAll_ = degree <= limit_;
+    }
+    return GetNeighborsNode::doExecute(partId, vId);
+  }
+
  private:
   using Sample =
       std::tuple<EdgeType, std::string, std::string, const std::vector<PropContext>*, size_t>;
 
   nebula::cpp2::ErrorCode iterateEdges(std::vector<Value>& row) override {
+    if (takeAll_) {
+      return GetNeighborsNode::iterateEdges(row);
+    }
     int64_t edgeRowCount = 0;
     nebula::List list;
     for (; upstream_->valid(); upstream_->next(), ++edgeRowCount) {
@@ -177,8 +209,13 @@ class GetNeighborsSampleNode : public GetNeighborsNode {
 
       const auto& key = std::get<2>(sample);
       const auto& props = std::get<3>(sample);
-      if (!QueryUtils::collectEdgeProps(
-               key, context_->vIdLen(), context_->isIntId(), reader.get(), props, list)
+      if (!QueryUtils::collectEdgeProps(key,
+                                        context_->vIdLen(),
+                                        context_->isIntId(),
+                                        reader.get(),
+                                        props,
+                                        &projections_,
+                                        list)
                .ok()) {
         return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
       }
@@ -190,6 +227,8 @@ class GetNeighborsSampleNode : public GetNeighborsNode {
   }
 
   std::unique_ptr<nebula::algorithm::ReservoirSampling<Sample>> sampler_;
+  // Take all the edges of the vertex without sampling
+  bool takeAll_{false};
 };
 
 }  // namespace storage
@@ -56,11 +56,13 @@ class GetTagPropNode : public QueryNode<VertexID> {
             }
             return nebula::cpp2::ErrorCode::SUCCEEDED;
           },
-          [&row, vIdLen, isIntId](
+          [&row, vIdLen, isIntId, this](
               folly::StringPiece key,
               RowReader* reader,
               const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
-            if (!QueryUtils::collectVertexProps(key, vIdLen, isIntId, reader, props, row).ok()) {
+            if (!QueryUtils::collectVertexProps(
+                     key, vIdLen, isIntId, reader, props, &projections_, row)
+                     .ok()) {
               return nebula::cpp2::ErrorCode::E_TAG_PROP_NOT_FOUND;
             }
             return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -77,6 +79,7 @@ class GetTagPropNode : public QueryNode<VertexID> {
   RuntimeContext* context_;
   std::vector<TagNode*> tagNodes_;
   nebula::DataSet* resultDataSet_;
+  PropProjections projections_;
 };
 
 class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
@@ -109,11 +112,13 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
             }
             return nebula::cpp2::ErrorCode::SUCCEEDED;
           },
-          [&row, vIdLen, isIntId](
+          [&row, vIdLen, isIntId, this](
               folly::StringPiece key,
               RowReader* reader,
               const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
-            if (!QueryUtils::collectEdgeProps(key, vIdLen, isIntId, reader, props, row).ok()) {
+            if (!QueryUtils::collectEdgeProps(
+                     key, vIdLen, isIntId, reader, props, &projections_, row)
+                     .ok()) {
               return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
             }
             return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -130,6 +135,7 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
   RuntimeContext* context_;
   std::vector<EdgeNode<cpp2::EdgeKey>*> edgeNodes_;
   nebula::DataSet* resultDataSet_;
+  PropProjections projections_;
 };
 
 }  // namespace storage
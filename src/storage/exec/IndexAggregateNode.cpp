@@ -0,0 +1,178 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+#include "storage/exec/IndexAggregateNode.h"
+
+#include <thrift/lib/cpp/util/EnumUtils.h>
+namespace nebula {
+namespace storage {
+IndexAggregateNode::IndexAggregateNode(const IndexAggregateNode& node)
+    : IndexNode(node),
+      groupColumns_(node.groupColumns_),
+      stats_(node.stats_),
+      statFuncs_(node.statFuncs_),
+      groupPos_(node.groupPos_),
+      statPos_(node.statPos_) {}
+
+IndexAggregateNode::IndexAggregateNode(RuntimeContext* context,
+                                       const std::vector<std::string>& groupColumns,
+                                       const std::vector<cpp2::StatProp>& stats)
+    : IndexNode(context, "IndexAggregateNode"), groupColumns_(groupColumns), stats_(stats) {}
+
+// static
+bool IndexAggregateNode::isSupported(cpp2::StatType type) {
+  switch (type) {
+    case cpp2::StatType::COUNT:
+    case cpp2::StatType::SUM:
+    case cpp2::StatType::MAX:
+    case cpp2::StatType::MIN:
+      return true;
+    default:
+      return false;
+  }
+}
+
+::nebula::cpp2::ErrorCode IndexAggregateNode::init(InitContext& ctx) {
+  DCHECK_EQ(children_.size(), 1);
+  for (auto& stat : stats_) {
+    if (!isSupported(stat.get_stat())) {
+      return ::nebula::cpp2::ErrorCode::E_INVALID_STAT_TYPE;
+    }
+    auto func = AggFunctionManager::get(apache::thrift::util::enumNameSafe(stat.get_stat()));
+    if (!func.ok()) {
+      return ::nebula::cpp2::ErrorCode::E_INVALID_STAT_TYPE;
+    }
+    statFuncs_.emplace_back(std::move(func).value());
+    if (!stat.get_prop().empty()) {
+      ctx.requiredColumns.insert(stat.get_prop());
+    }
+  }
+  for (auto& col : groupColumns_) {
+    ctx.requiredColumns.insert(col);
+  }
+  auto ret = children_[0]->init(ctx);
+  if (UNLIKELY(ret != ::nebula::cpp2::ErrorCode::SUCCEEDED)) {
+    return ret;
+  }
+  for (auto& col : groupColumns_) {
+    auto iter = ctx.retColMap.find(col);
+    DCHECK(iter != ctx.retColMap.end());
+    groupPos_.push_back(iter->second);
+  }
+  for (auto& stat : stats_) {
+    if (stat.get_prop().empty()) {
+      statPos_.push_back(-1);
+      continue;
+    }
+    auto iter = ctx.retColMap.find(stat.get_prop());
+    DCHECK(iter != ctx.retColMap.end());
+    statPos_.push_back(iter->second);
+  }
+  ctx.returnColumns = groupColumns_;
+  for (auto& stat : stats_) {
+    ctx.returnColumns.emplace_back(stat.get_alias());
+  }
+  ctx.retColMap.clear();
+  for (size_t i = 0; i < ctx.returnColumns.size(); i++) {
+    ctx.retColMap[ctx.returnColumns[i]] = i;
+  }
+  return ::nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+::nebula::cpp2::ErrorCode IndexAggregateNode::doExecute(PartitionID partId) {
+  groups_.clear();
+  aggregated_ = false;
+  return IndexNode::doExecute(partId);
+}
+
+IndexAggregateNode::AggDataList IndexAggregateNode::makeAggData() {
+  AggDataList aggData;
+  aggData.reserve(stats_.size());
+  for (size_t i = 0; i < stats_.size(); i++) {
+    aggData.emplace_back(std::make_unique<AggData>());
+  }
+  return aggData;
+}
+
+::nebula::cpp2::ErrorCode IndexAggregateNode::aggregate() {
+  auto& child = *children_[0];
+  static const Value kCounted(true);
+  do {
+    auto result = child.next();
+    if (!result.success()) {
+      return result.code();
+    }
+    if (!result.hasData()) {
+      break;
+    }
+    auto& row = result.row();
+    List key;
+    key.values.reserve(groupPos_.size());
+    for (auto pos : groupPos_) {
+      key.values.emplace_back(row[pos]);
+    }
+    auto iter = groups_.find(key);
+    if (iter == groups_.end()) {
+      iter = groups_.emplace(std::move(key), makeAggData()).first;
+    }
+    auto& aggData = iter->second;
+    for (size_t i = 0; i < stats_.size(); i++) {
+      statFuncs_[i](aggData[i].get(), statPos_[i] < 0 ? kCounted : row[statPos_[i]]);
+    }
+  } while (true);
+  // The stats of an empty part are still returned when not grouped, which are the same as the
+  // ones of the graph on an empty input, e.g. the count is 0
+  if (groups_.empty() && groupColumns_.empty()) {
+    auto aggData = makeAggData();
+    for (size_t i = 0; i < stats_.size(); i++) {
+      statFuncs_[i](aggData[i].get(), Value::kNullValue);
+    }
+    groups_.emplace(List(), std::move(aggData));
+  }
+  return ::nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+IndexNode::Result IndexAggregateNode::doNext() {
+  DCHECK_EQ(children_.size(), 1);
+  if (!aggregated_) {
+    auto ret = aggregate();
+    if (ret != ::nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return Result(ret);
+    }
+    aggregated_ = true;
+    resultIter_ = groups_.begin();
+  }
+  if (resultIter_ == groups_.end()) {
+    return Result();
+  }
+  Row row;
+  row.values.reserve(groupColumns_.size() + stats_.size());
+  for (auto& value : resultIter_->first.values) {
+    row.values.emplace_back(value);
+  }
+  for (auto& aggData : resultIter_->second) {
+    row.values.emplace_back(std::move(aggData->result()));
+  }
+  ++resultIter_;
+  return Result(std::move(row));
+}
+
+std::unique_ptr<IndexNode> IndexAggregateNode::copy() {
+  return std::make_unique<IndexAggregateNode>(*this);
+}
+
+std::string IndexAggregateNode::identify() {
+  std::vector<std::string> stats;
+  for (auto& stat : stats_) {
+    stats.emplace_back(fmt::format(
+        "{}({})", apache::thrift::util::enumNameSafe(stat.get_stat()), stat.get_prop()));
+  }
+  return fmt::format("{}(groupColumn=[{}], stat=[{}])",
+                     name_,
+                     folly::join(",", groupColumns_),
+                     folly::join(",", stats));
+}
+
+}  // namespace storage
+}  // namespace nebula
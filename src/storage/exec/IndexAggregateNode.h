@@ -0,0 +1,72 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+#pragma once
+#include "common/function/AggFunctionManager.h"
+#include "interface/gen-cpp2/storage_types.h"
+#include "storage/exec/IndexNode.h"
+namespace nebula {
+namespace storage {
+/**
+ *
+ * IndexAggregateNode
+ *
+ * reference: IndexNode
+ *
+ * `IndexAggregateNode` is the class which is used to aggregate the rows of a part returned by the
+ * child node, so only one row for each group is returned to the graph instead of all the rows. The
+ * rows are grouped by `groupColumns_`, and a row of the group columns followed by the stats is
+ * returned for each group. If there are no group columns, one row is returned even if the part is
+ * empty.
+ *
+ * The stats are partial ones of a part, which should be merged by the graph: the COUNTs are
+ * summed, and the SUMs, MINs and MAXs are merged by themselves. AVG is not supported since it
+ * can't be merged.
+ *                   ┌───────────┐
+ *                   │ IndexNode │
+ *                   └─────┬─────┘
+ *                         │
+ *              ┌──────────┴─────────┐
+ *              │ IndexAggregateNode │
+ *              └────────────────────┘
+ *
+ * Member:
+ * `groupColumns_` : columns' name which are used to group
+ * `stats_`        : the stats to calculate, a stat with an empty prop counts the rows
+ * `groupPos_`     : group columns' position in child return row
+ * `statPos_`      : stat props' position in child return row, -1 for an empty prop
+ * `groups_`       : the stats of each group of the current part
+ * `resultIter_`   : the next group to return, only valid after all rows of the child are consumed
+ */
+class IndexAggregateNode : public IndexNode {
+ public:
+  IndexAggregateNode(const IndexAggregateNode& node);
+  IndexAggregateNode(RuntimeContext* context,
+                     const std::vector<std::string>& groupColumns,
+                     const std::vector<cpp2::StatProp>& stats);
+  ::nebula::cpp2::ErrorCode init(InitContext& ctx) override;
+  std::unique_ptr<IndexNode> copy() override;
+  std::string identify() override;
+
+  // Whether the stat could be calculated by the node
+  static bool isSupported(cpp2::StatType type);
+
+ private:
+  using AggDataList = std::vector<std::unique_ptr<AggData>>;
+  ::nebula::cpp2::ErrorCode doExecute(PartitionID partId) override;
+  Result doNext() override;
+  // Consume all the rows of the child
+  ::nebula::cpp2::ErrorCode aggregate();
+  AggDataList makeAggData();
+  std::vector<std::string> groupColumns_;
+  std::vector<cpp2::StatProp> stats_;
+  std::vector<AggFunctionManager::AggFunction> statFuncs_;
+  std::vector<size_t> groupPos_;
+  std::vector<int64_t> statPos_;
+  std::unordered_map<List, AggDataList> groups_;
+  std::unordered_map<List, AggDataList>::iterator resultIter_;
+  bool aggregated_{false};
+};
+}  // namespace storage
+}  // namespace nebula
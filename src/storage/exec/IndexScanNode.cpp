@@ -348,16 +348,19 @@ IndexScanNode::IndexScanNode(const IndexScanNode& node)
       index_(node.index_),
       indexNullable_(node.indexNullable_),
       columnHints_(node.columnHints_),
+      batchedHints_(node.batchedHints_),
       kvstore_(node.kvstore_),
       requiredColumns_(node.requiredColumns_),
       requiredAndHintColumns_(node.requiredAndHintColumns_),
       ttlProps_(node.ttlProps_),
       needAccessBase_(node.needAccessBase_),
       colPosMap_(node.colPosMap_) {
-  if (node.path_->isRange()) {
-    path_ = std::make_unique<RangePath>(*dynamic_cast<RangePath*>(node.path_.get()));
-  } else {
-    path_ = std::make_unique<PrefixPath>(*dynamic_cast<PrefixPath*>(node.path_.get()));
+  for (auto& path : node.paths_) {
+    if (path->isRange()) {
+      paths_.emplace_back(std::make_unique<RangePath>(*dynamic_cast<RangePath*>(path.get())));
+    } else {
+      paths_.emplace_back(std::make_unique<PrefixPath>(*dynamic_cast<PrefixPath*>(path.get())));
+    }
   }
 }
 
@@ -369,6 +372,11 @@ IndexScanNode::IndexScanNode(const IndexScanNode& node)
   for (auto& hint : columnHints_) {
     requiredAndHintColumns_.insert(hint.get_column_name());
   }
+  for (auto* hints : batchedHints_) {
+    for (auto& hint : *hints) {
+      requiredAndHintColumns_.insert(hint.get_column_name());
+    }
+  }
   for (auto& col : ctx.requiredColumns) {
     requiredColumns_.push_back(col);
   }
@@ -396,7 +404,27 @@ IndexScanNode::IndexScanNode(const IndexScanNode& node)
   tmp.erase(kDst);
   tmp.erase(kType);
   needAccessBase_ = !tmp.empty();
-  path_ = Path::make(index_.get(), getSchema().back().get(), columnHints_, context_->vIdLen());
+  paths_.clear();
+  paths_.emplace_back(
+      Path::make(index_.get(), getSchema().back().get(), columnHints_, context_->vIdLen()));
+  for (auto* hints : batchedHints_) {
+    paths_.emplace_back(
+        Path::make(index_.get(), getSchema().back().get(), *hints, context_->vIdLen()));
+  }
+  if (paths_.size() > 1) {
+    std::vector<std::pair<std::string, std::unique_ptr<Path>>> sorted;
+    sorted.reserve(paths_.size());
+    for (auto& path : paths_) {
+      auto lower = path->lowerBound();
+      sorted.emplace_back(std::move(lower), std::move(path));
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    for (size_t i = 0; i < sorted.size(); i++) {
+      paths_[i] = std::move(sorted[i].second);
+    }
+  }
   return ::nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
@@ -407,7 +435,20 @@ nebula::cpp2::ErrorCode IndexScanNode::doExecute(PartitionID partId) {
 }
 
 IndexNode::Result IndexScanNode::doNext() {
-  for (; iter_ && iter_->valid(); iter_->next()) {
+  while (true) {
+    auto result = nextInPath();
+    if (!result.success() || result.hasData() || currentPath_ + 1 >= paths_.size()) {
+      return result;
+    }
+    auto ret = seekPath(currentPath_ + 1);
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return Result(ret);
+    }
+  }
+}
+
+IndexNode::Result IndexScanNode::nextInPath() {
+  for (; iter_ && iter_->valid() && inPath(); iter_->next()) {
     if (!checkTTL()) {
       continue;
     }
@@ -468,18 +509,42 @@ bool IndexScanNode::checkTTL() {
 }
 
 nebula::cpp2::ErrorCode IndexScanNode::resetIter(PartitionID partId) {
-  path_->resetPart(partId);
+  for (auto& path : paths_) {
+    path->resetPart(partId);
+  }
+  currentPath_ = 0;
+  path_ = paths_.front().get();
   nebula::cpp2::ErrorCode ret = nebula::cpp2::ErrorCode::SUCCEEDED;
-  if (path_->isRange()) {
-    auto rangePath = dynamic_cast<RangePath*>(path_.get());
+  if (paths_.size() > 1) {
+    // One iterator over the bounds of all the paths, which is sought to each path in turn
+    batchStart_ = path_->lowerBound();
+    batchEnd_.clear();
+    for (auto& path : paths_) {
+      batchEnd_ = std::max(batchEnd_, path->upperBound());
+    }
+    pathEnd_ = path_->upperBound();
+    ret = kvstore_->range(spaceId_, partId, batchStart_, batchEnd_, &iter_);
+  } else if (path_->isRange()) {
+    auto rangePath = dynamic_cast<RangePath*>(path_);
     kvstore_->range(spaceId_, partId, rangePath->getStartKey(), rangePath->getEndKey(), &iter_);
   } else {
-    auto prefixPath = dynamic_cast<PrefixPath*>(path_.get());
+    auto prefixPath = dynamic_cast<PrefixPath*>(path_);
     ret = kvstore_->prefix(spaceId_, partId, prefixPath->getPrefixKey(), &iter_);
   }
   return ret;
 }
 
+nebula::cpp2::ErrorCode IndexScanNode::seekPath(size_t pathIndex) {
+  currentPath_ = pathIndex;
+  path_ = paths_[pathIndex].get();
+  pathStart_ = path_->lowerBound();
+  pathEnd_ = path_->upperBound();
+  if (iter_ != nullptr && iter_->seek(pathStart_)) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  return kvstore_->range(spaceId_, partId_, pathStart_, pathEnd_, &iter_);
+}
+
 void IndexScanNode::decodePropFromIndex(folly::StringPiece key,
                                         const Map<std::string, size_t>& colPosMap,
                                         std::vector<Value>& values) {
@@ -539,7 +604,14 @@ void IndexScanNode::decodePropFromIndex(folly::StringPiece key,
 }
 
 std::string IndexScanNode::identify() {
-  return fmt::format("{}(IndexID={}, Path=({}))", name_, indexId_, path_->toString());
+  if (paths_.size() > 1) {
+    return fmt::format("{}(IndexID={}, Paths={}, First=({}))",
+                       name_,
+                       indexId_,
+                       paths_.size(),
+                       paths_.front()->toString());
+  }
+  return fmt::format("{}(IndexID={}, Path=({}))", name_, indexId_, paths_.front()->toString());
 }
 
 // End of IndexScan
@@ -84,6 +84,15 @@ namespace storage {
  *
  * `Path` whild be reseted when `IndexScanNode` execute on a new part.
  *
+ * Batched Mode
+ *
+ * Many contexts on the same index, e.g. one for each value of an IN-list, could be scanned by one
+ * node with `addBatchedHints`, instead of one node for each of them. There is a path for each
+ * context, sorted by their lower bounds. On each part, one iterator over the bounds of all the
+ * paths is sought to each path in turn. If the iterator could not seek, an iterator is opened for
+ * each path. A key in many paths is returned once for each of them, so the node should be under
+ * a `IndexDedupNode`.
+ *
  * It should be noted that the range generated by `rangepath` is a certain left included and right
  * excluded interval,like [startKey_, endKey_), although `ColumnHint` may have many different
  * constraint ranges(e.g., (x, y],(INF,y),(x,INF)). Because the length of index key is fixed, the
@@ -143,10 +152,16 @@ class IndexScanNode : public IndexNode {
       : IndexNode(context, name), indexId_(indexId), columnHints_(columnHints), kvstore_(kvstore) {}
   ::nebula::cpp2::ErrorCode init(InitContext& ctx) override;
   std::string identify() override;
+  // Scan the keys of another context on the same index in the batched mode, `hints` must outlive
+  // the node
+  void addBatchedHints(const std::vector<cpp2::IndexColumnHint>& hints) {
+    batchedHints_.emplace_back(&hints);
+  }
 
  protected:
   nebula::cpp2::ErrorCode doExecute(PartitionID partId) final;
   Result doNext() final;
+  Result nextInPath();
   void decodePropFromIndex(folly::StringPiece key,
                            const Map<std::string, size_t>& colPosMap,
                            std::vector<Value>& values);
@@ -158,12 +173,24 @@ class IndexScanNode : public IndexNode {
   virtual const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>& getSchema() = 0;
   bool checkTTL();
   nebula::cpp2::ErrorCode resetIter(PartitionID partId);
+  nebula::cpp2::ErrorCode seekPath(size_t pathIndex);
+  // The iterator is shared by all the paths in the batched mode
+  bool inPath() const { return paths_.size() == 1 || iter_->key().compare(pathEnd_) < 0; }
   PartitionID partId_;
   const IndexID indexId_;
   std::shared_ptr<nebula::meta::cpp2::IndexItem> index_;
   bool indexNullable_ = false;
   const std::vector<cpp2::IndexColumnHint>& columnHints_;
-  std::unique_ptr<Path> path_;
+  std::vector<const std::vector<cpp2::IndexColumnHint>*> batchedHints_;
+  // The paths of `columnHints_` and `batchedHints_` sorted by the lower bounds
+  std::vector<std::unique_ptr<Path>> paths_;
+  size_t currentPath_{0};
+  Path* path_{nullptr};
+  // The bounds referred to by `iter_` in the batched mode
+  std::string batchStart_;
+  std::string batchEnd_;
+  std::string pathStart_;
+  std::string pathEnd_;
   std::unique_ptr<kvstore::KVIterator> iter_;
   nebula::kvstore::KVStore* kvstore_;
   std::vector<std::string> requiredColumns_;
@@ -339,6 +366,9 @@ class Path {
                                     int64_t vidLen);
   QualifiedStrategy::Result qualified(const folly::StringPiece& key);
   virtual bool isRange() { return false; }
+  // The bounds [lower, upper) of the keys of the path
+  virtual std::string lowerBound() = 0;
+  virtual std::string upperBound() = 0;
 
   virtual QualifiedStrategy::Result qualified(const Map<std::string, Value>& rowData) = 0;
   virtual void resetPart(PartitionID partId) = 0;
@@ -370,6 +400,11 @@ class PrefixPath : public Path {
   void resetPart(PartitionID partId) override;
 
   const std::string& getPrefixKey() { return prefix_; }
+  std::string lowerBound() override { return prefix_; }
+  // The keys are of the same length, so any key with the prefix is less than it
+  std::string upperBound() override {
+    return prefix_ + std::string(totalKeyLength_ - prefix_.size() + 1, '\xFF');
+  }
 
  private:
   std::string prefix_;
@@ -389,6 +424,8 @@ class RangePath : public Path {
   inline const std::string& getStartKey() { return startKey_; }
   inline const std::string& getEndKey() { return endKey_; }
   bool isRange() override { return true; }
+  std::string lowerBound() override { return startKey_; }
+  std::string upperBound() override { return endKey_; }
 
  private:
   std::string startKey_, endKey_;
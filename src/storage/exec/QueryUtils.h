@@ -6,6 +6,7 @@
 #ifndef STORAGE_EXEC_QUERYUTILS_H_
 #define STORAGE_EXEC_QUERYUTILS_H_
 
+#include "codec/RowProjection.h"
 #include "common/base/Base.h"
 #include "common/expression/Expression.h"
 #include "common/utils/DefaultValueContext.h"
@@ -15,6 +16,46 @@
 namespace nebula {
 namespace storage {
 
+// The projections of the returned props in the values of the rows, built for
+// each schema version and list of props the first time it is read. It is kept
+// by a node for all the rows it reads, so it is not thread safe.
+class PropProjections final {
+ public:
+  const RowProjection* get(const meta::SchemaProviderIf* schema,
+                           const std::vector<PropContext>* props) {
+    if (last_ != nullptr && last_->schema() == schema && lastProps_ == props) {
+      return last_;
+    }
+    auto& projection = projections_[std::make_pair(schema, props)];
+    if (projection == nullptr) {
+      std::vector<std::string> names;
+      for (const auto& prop : *props) {
+        if (prop.returned_ && prop.propInKeyType_ == PropContext::PropInKeyType::NONE) {
+          names.emplace_back(prop.name_);
+        }
+      }
+      projection = std::make_unique<RowProjection>(schema, names);
+    }
+    last_ = projection.get();
+    lastProps_ = props;
+    return last_;
+  }
+
+  // The buffer to decode the values of a row, reused by the rows
+  std::vector<Value>& values(size_t size) {
+    values_.resize(size);
+    return values_;
+  }
+
+ private:
+  std::map<std::pair<const meta::SchemaProviderIf*, const std::vector<PropContext>*>,
+           std::unique_ptr<RowProjection>>
+      projections_;
+  const RowProjection* last_{nullptr};
+  const std::vector<PropContext>* lastProps_{nullptr};
+  std::vector<Value> values_;
+};
+
 class QueryUtils final {
  public:
   enum class ReturnColType : uint16_t {
@@ -48,7 +89,14 @@ class QueryUtils final {
   static StatusOr<nebula::Value> readValue(RowReader* reader,
                                            const std::string& propName,
                                            const meta::SchemaProviderIf::Field* field) {
-    auto value = reader->getValueByName(propName);
+    return toPropValue(reader->getValueByName(propName), propName, field);
+  }
+
+  // Check the value read from a row, use the default value of the field if
+  // the row doesn't have it
+  static StatusOr<nebula::Value> toPropValue(Value value,
+                                             const std::string& propName,
+                                             const meta::SchemaProviderIf::Field* field) {
     if (value.type() == Value::Type::NULLVALUE) {
       // read null value
       auto nullType = value.getNull();
@@ -196,6 +244,54 @@ class QueryUtils final {
     return Status::OK();
   }
 
+  // Same as above, but the props in the value are decoded by the projection
+  // of the schema of the row in one pass
+  static Status collectVertexProps(folly::StringPiece key,
+                                   size_t vIdLen,
+                                   bool isIntId,
+                                   RowReader* reader,
+                                   const std::vector<PropContext>* props,
+                                   PropProjections* projections,
+                                   nebula::List& list) {
+    return collectProps(
+        key, vIdLen, isIntId, reader, props, projections, list, QueryUtils::readVertexProp);
+  }
+
+  static Status collectEdgeProps(folly::StringPiece key,
+                                 size_t vIdLen,
+                                 bool isIntId,
+                                 RowReader* reader,
+                                 const std::vector<PropContext>* props,
+                                 PropProjections* projections,
+                                 nebula::List& list) {
+    return collectProps(
+        key, vIdLen, isIntId, reader, props, projections, list, QueryUtils::readEdgeProp);
+  }
+
+  // Return the time when the row is written in microseconds without decoding
+  // it, or none if the row doesn't have one, e.g. it's encoded by RowWriterV1
+  static folly::Optional<int64_t> getRowTimestamp(folly::StringPiece row) {
+    if (row.size() < 1 + sizeof(int64_t)) {
+      return folly::none;
+    }
+    SchemaVer schemaVer;
+    int32_t readerVer;
+    RowReaderWrapper::getVersions(row, schemaVer, readerVer);
+    if (readerVer != 2) {
+      return folly::none;
+    }
+    int64_t ts;
+    memcpy(&ts, row.end() - sizeof(int64_t), sizeof(int64_t));
+    return ts;
+  }
+
+  // Whether the row is written in [start, end), the rows without the time
+  // are always in the range
+  static bool inTimeRange(folly::StringPiece row, int64_t start, int64_t end) {
+    auto ts = getRowTimestamp(row);
+    return !ts.hasValue() || (start <= ts.value() && ts.value() < end);
+  }
+
   // return none if no valid ttl, else return the ttl property name and time
   static folly::Optional<std::pair<std::string, int64_t>> getEdgeTTLInfo(EdgeContext* edgeContext,
                                                                          EdgeType edgeType) {
@@ -217,6 +313,51 @@ class QueryUtils final {
     }
     return ret;
   }
+
+ private:
+  using ReadProp = StatusOr<nebula::Value> (*)(
+      folly::StringPiece, size_t, bool, RowReader*, const PropContext&);
+
+  static Status collectProps(folly::StringPiece key,
+                             size_t vIdLen,
+                             bool isIntId,
+                             RowReader* reader,
+                             const std::vector<PropContext>* props,
+                             PropProjections* projections,
+                             nebula::List& list,
+                             ReadProp readProp) {
+    if (reader == nullptr || projections == nullptr) {
+      for (const auto& prop : *props) {
+        if (prop.returned_) {
+          auto value = readProp(key, vIdLen, isIntId, reader, prop);
+          if (!value.ok()) {
+            return value.status();
+          }
+          list.emplace_back(std::move(value).value());
+        }
+      }
+      return Status::OK();
+    }
+
+    auto* projection = projections->get(reader->getSchema(), props);
+    auto& values = projections->values(projection->size());
+    reader->getValues(*projection, values.data());
+    size_t i = 0;
+    for (const auto& prop : *props) {
+      if (!prop.returned_) {
+        continue;
+      }
+      VLOG(2) << "Collect prop " << prop.name_;
+      auto value = prop.propInKeyType_ == PropContext::PropInKeyType::NONE
+                       ? toPropValue(std::move(values[i++]), prop.name_, prop.field_)
+                       : readProp(key, vIdLen, isIntId, reader, prop);
+      if (!value.ok()) {
+        return value.status();
+      }
+      list.emplace_back(std::move(value).value());
+    }
+    return Status::OK();
+  }
 };
 
 }  // namespace storage
@@ -521,17 +521,26 @@ class UpdateEdgeNode : public UpdateNode<cpp2::EdgeKey> {
       }
     };
 
-    auto batch = op();
-    if (batch == folly::none) {
-      return this->exeResult_;
-    }
-
     folly::Baton<true, std::atomic> baton;
     auto callback = [&ret, &baton](nebula::cpp2::ErrorCode code) {
       ret = code;
       baton.post();
     };
 
+    if (FLAGS_enable_edge_degree) {
+      // An upsert might add an edge, so the degree is read and written in the
+      // atomic op
+      context_->planContext_->env_->kvstore_->asyncAtomicOp(
+          context_->planContext_->spaceId_, partId, std::move(op), callback);
+      baton.wait();
+      return this->exeResult_ == nebula::cpp2::ErrorCode::SUCCEEDED ? ret : this->exeResult_;
+    }
+
+    auto batch = op();
+    if (batch == folly::none) {
+      return this->exeResult_;
+    }
+
     context_->planContext_->env_->kvstore_->asyncAppendBatch(
         context_->planContext_->spaceId_, partId, std::move(batch).value(), callback);
     baton.wait();
@@ -734,6 +743,22 @@ class UpdateEdgeNode : public UpdateNode<cpp2::EdgeKey> {
         }
       }
     }
+    // An upserted edge which doesn't exist before adds to the degree of the vertex
+    if (FLAGS_enable_edge_degree && context_->insert_) {
+      auto* kvstore = context_->env()->kvstore_;
+      std::string oldVal;
+      auto ret = kvstore->get(context_->spaceId(), partId, key_, &oldVal);
+      if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+        std::map<std::pair<VertexID, EdgeType>, int64_t> degrees;
+        degrees[std::make_pair(edgeKey.get_src().getStr(), edgeKey.get_edge_type())] = 1;
+        ret = CommonUtils::updateDegrees(
+            kvstore, context_->spaceId(), partId, context_->vIdLen(), degrees, batchHolder.get());
+      }
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return folly::none;
+      }
+    }
+
     // step 3, insert new edge data
     batchHolder->put(std::move(key_), std::move(nVal));
 
@@ -11,6 +11,7 @@
 #include "interface/gen-cpp2/common_types.tcc"
 #include "interface/gen-cpp2/meta_types.tcc"
 #include "interface/gen-cpp2/storage_types.tcc"
+#include "storage/exec/IndexAggregateNode.h"
 #include "storage/exec/IndexDedupNode.h"
 #include "storage/exec/IndexEdgeScanNode.h"
 #include "storage/exec/IndexLimitNode.h"
@@ -95,35 +96,85 @@ void LookupProcessor::doProcess(const cpp2::LookupIndexRequest& req) {
   for (auto& col : *req.get_return_columns()) {
     colNames.emplace_back(schemaName + "." + col);
   }
+  if (req.stat_columns_ref().has_value()) {
+    for (auto& stat : *req.stat_columns_ref()) {
+      colNames.emplace_back(stat.get_alias());
+    }
+  }
   resultDataSet_ = ::nebula::DataSet(colNames);
   return ::nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
 std::unique_ptr<IndexNode> LookupProcessor::buildPlan(const cpp2::LookupIndexRequest& req) {
-  std::vector<std::unique_ptr<IndexNode>> nodes;
+  // Group the contexts scanning the same index with the same filter, each group is scanned by
+  // one node in the batched mode
+  std::vector<std::vector<const cpp2::IndexQueryContext*>> groups;
+  std::map<std::pair<IndexID, std::string>, size_t> groupIndex;
+  bool batched = false;
   for (auto& ctx : req.get_indices().get_contexts()) {
-    auto node = buildOneContext(ctx);
+    if (!FLAGS_enable_batched_index_scan) {
+      groups.emplace_back(std::vector<const cpp2::IndexQueryContext*>{&ctx});
+      continue;
+    }
+    auto key = std::make_pair(ctx.get_index_id(), ctx.filter_ref().value_or(""));
+    auto found = groupIndex.find(key);
+    if (found == groupIndex.end()) {
+      groupIndex.emplace(std::move(key), groups.size());
+      groups.emplace_back(std::vector<const cpp2::IndexQueryContext*>{&ctx});
+    } else {
+      groups[found->second].emplace_back(&ctx);
+      batched = true;
+    }
+  }
+  std::vector<std::unique_ptr<IndexNode>> nodes;
+  for (auto& group : groups) {
+    auto node = buildOneContext(group);
     nodes.emplace_back(std::move(node));
   }
+  bool needDedup = nodes.size() > 1 || batched;
+  std::vector<std::string> dedupColumn;
+  if (context_->isEdge()) {
+    dedupColumn = std::vector<std::string>{kSrc, kRank, kDst};
+  } else {
+    dedupColumn = std::vector<std::string>{kVid};
+  }
+  // The rows are aggregated by the return columns, which need the stat props, and the dedup
+  // columns if deduped
+  auto projectColumns = *req.get_return_columns();
+  if (req.stat_columns_ref().has_value()) {
+    auto addColumn = [&projectColumns](const std::string& col) {
+      if (!col.empty() &&
+          std::find(projectColumns.begin(), projectColumns.end(), col) == projectColumns.end()) {
+        projectColumns.emplace_back(col);
+      }
+    };
+    for (auto& stat : *req.stat_columns_ref()) {
+      addColumn(stat.get_prop());
+    }
+    if (needDedup) {
+      for (auto& col : dedupColumn) {
+        addColumn(col);
+      }
+    }
+  }
   for (size_t i = 0; i < nodes.size(); i++) {
-    auto projection =
-        std::make_unique<IndexProjectionNode>(context_.get(), *req.get_return_columns());
+    auto projection = std::make_unique<IndexProjectionNode>(context_.get(), projectColumns);
     projection->addChild(std::move(nodes[i]));
     nodes[i] = std::move(projection);
   }
-  if (nodes.size() > 1) {
-    std::vector<std::string> dedupColumn;
-    if (context_->isEdge()) {
-      dedupColumn = std::vector<std::string>{kSrc, kRank, kDst};
-    } else {
-      dedupColumn = std::vector<std::string>{kVid};
-    }
+  if (needDedup) {
     auto dedup = std::make_unique<IndexDedupNode>(context_.get(), dedupColumn);
     for (auto& node : nodes) {
       dedup->addChild(std::move(node));
     }
     nodes.clear();
-    nodes[0] = std::move(dedup);
+    nodes.emplace_back(std::move(dedup));
+  }
+  if (req.stat_columns_ref().has_value()) {
+    auto aggregate = std::make_unique<IndexAggregateNode>(
+        context_.get(), *req.get_return_columns(), *req.stat_columns_ref());
+    aggregate->addChild(std::move(nodes[0]));
+    nodes[0] = std::move(aggregate);
   }
   if (req.limit_ref().has_value()) {
     auto limit = *req.get_limit();
@@ -134,18 +185,25 @@ std::unique_ptr<IndexNode> LookupProcessor::buildPlan(const cpp2::LookupIndexReq
   return std::move(nodes[0]);
 }
 
-std::unique_ptr<IndexNode> LookupProcessor::buildOneContext(const cpp2::IndexQueryContext& ctx) {
-  std::unique_ptr<IndexNode> node;
+std::unique_ptr<IndexNode> LookupProcessor::buildOneContext(
+    const std::vector<const cpp2::IndexQueryContext*>& contexts) {
+  DCHECK(!contexts.empty());
+  auto& ctx = *contexts.front();
+  std::unique_ptr<IndexScanNode> scan;
   DLOG(INFO) << ctx.get_column_hints().size();
   DLOG(INFO) << &ctx.get_column_hints();
   DLOG(INFO) << ::apache::thrift::SimpleJSONSerializer::serialize<std::string>(ctx);
   if (context_->isEdge()) {
-    node = std::make_unique<IndexEdgeScanNode>(
+    scan = std::make_unique<IndexEdgeScanNode>(
         context_.get(), ctx.get_index_id(), ctx.get_column_hints(), context_->env()->kvstore_);
   } else {
-    node = std::make_unique<IndexVertexScanNode>(
+    scan = std::make_unique<IndexVertexScanNode>(
         context_.get(), ctx.get_index_id(), ctx.get_column_hints(), context_->env()->kvstore_);
   }
+  for (size_t i = 1; i < contexts.size(); i++) {
+    scan->addBatchedHints(contexts[i]->get_column_hints());
+  }
+  std::unique_ptr<IndexNode> node = std::move(scan);
   if (ctx.filter_ref().is_set() && !ctx.get_filter().empty()) {
     auto expr = Expression::decode(context_->objPool(), *ctx.filter_ref());
     auto filterNode = std::make_unique<IndexSelectionNode>(context_.get(), expr);
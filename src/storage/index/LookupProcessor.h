@@ -33,7 +33,9 @@ class LookupProcessor : public BaseProcessor<cpp2::LookupIndexResp> {
   void runInMultipleThread(const std::vector<PartitionID>& parts, std::unique_ptr<IndexNode> plan);
   ::nebula::cpp2::ErrorCode prepare(const cpp2::LookupIndexRequest& req);
   std::unique_ptr<IndexNode> buildPlan(const cpp2::LookupIndexRequest& req);
-  std::unique_ptr<IndexNode> buildOneContext(const cpp2::IndexQueryContext& ctx);
+  // Build the scan of the contexts on the same index with the same filter
+  std::unique_ptr<IndexNode> buildOneContext(
+      const std::vector<const cpp2::IndexQueryContext*>& contexts);
   std::vector<std::unique_ptr<IndexNode>> reproducePlan(IndexNode* root, size_t count);
   folly::Executor* executor_{nullptr};
   std::unique_ptr<PlanContext> planContext_;
@@ -51,7 +51,9 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
 
   CHECK_NOTNULL(env_->kvstore_);
 
-  if (indexes_.empty()) {
+  if (FLAGS_enable_edge_degree) {
+    doProcessWithDegree(req);
+  } else if (indexes_.empty()) {
     doProcess(req);
   } else {
     doProcessWithIndex(req);
@@ -321,6 +323,105 @@ void AddEdgesProcessor::doProcessWithIndex(const cpp2::AddEdgesRequest& req) {
   }
 }
 
+void AddEdgesProcessor::doProcessWithDegree(const cpp2::AddEdgesRequest& req) {
+  const auto& partEdges = req.get_parts();
+  const auto& propNames = req.get_prop_names();
+  for (auto& part : partEdges) {
+    auto partId = part.first;
+    const auto& newEdges = part.second;
+    std::vector<EMLI> dummyLock;
+    dummyLock.reserve(newEdges.size());
+    auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
+
+    std::vector<kvstore::KV> edges;
+    edges.reserve(newEdges.size());
+    for (auto& newEdge : newEdges) {
+      auto edgeKey = *newEdge.key_ref();
+      auto l = std::make_tuple(spaceId_,
+                               partId,
+                               (*edgeKey.src_ref()).getStr(),
+                               *edgeKey.edge_type_ref(),
+                               *edgeKey.ranking_ref(),
+                               (*edgeKey.dst_ref()).getStr());
+      if (std::find(dummyLock.begin(), dummyLock.end(), l) == dummyLock.end()) {
+        if (!env_->edgesML_->try_lock(l)) {
+          LOG(ERROR) << folly::format("edge locked : src {}, type {}, rank {}, dst {}",
+                                      (*edgeKey.src_ref()).getStr(),
+                                      *edgeKey.edge_type_ref(),
+                                      *edgeKey.ranking_ref(),
+                                      (*edgeKey.dst_ref()).getStr());
+          code = nebula::cpp2::ErrorCode::E_DATA_CONFLICT_ERROR;
+          break;
+        }
+        dummyLock.emplace_back(std::move(l));
+      }
+
+      if (!NebulaKeyUtils::isValidVidLen(
+              spaceVidLen_, (*edgeKey.src_ref()).getStr(), (*edgeKey.dst_ref()).getStr())) {
+        LOG(ERROR) << "Space " << spaceId_ << " vertex length invalid, "
+                   << "space vid len: " << spaceVidLen_ << ", edge srcVid: " << *edgeKey.src_ref()
+                   << ", dstVid: " << *edgeKey.dst_ref();
+        code = nebula::cpp2::ErrorCode::E_INVALID_VID;
+        break;
+      }
+
+      auto schema = env_->schemaMan_->getEdgeSchema(spaceId_, std::abs(*edgeKey.edge_type_ref()));
+      if (!schema) {
+        LOG(ERROR) << "Space " << spaceId_ << ", Edge " << *edgeKey.edge_type_ref() << " invalid";
+        code = nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND;
+        break;
+      }
+
+      auto props = newEdge.get_props();
+      WriteResult wRet;
+      auto retEnc = encodeRowVal(schema.get(), propNames, props, wRet);
+      if (!retEnc.ok()) {
+        LOG(ERROR) << retEnc.status();
+        code = writeResultTo(wRet, true);
+        break;
+      }
+      edges.emplace_back(NebulaKeyUtils::edgeKey(spaceVidLen_,
+                                                 partId,
+                                                 (*edgeKey.src_ref()).getStr(),
+                                                 *edgeKey.edge_type_ref(),
+                                                 *edgeKey.ranking_ref(),
+                                                 (*edgeKey.dst_ref()).getStr()),
+                         std::move(retEnc.value()));
+    }
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      env_->edgesML_->unlockBatch(dummyLock);
+      handleAsync(spaceId_, partId, code);
+      continue;
+    }
+
+    // Whether the edges exist and the degrees are read in the atomic op, so
+    // that the concurrent inserts of the edges of a vertex are counted right
+    auto opCode = std::make_shared<nebula::cpp2::ErrorCode>(nebula::cpp2::ErrorCode::SUCCEEDED);
+    auto op = [partId, edges = std::move(edges), opCode, this]() -> folly::Optional<std::string> {
+      auto batch = addEdges(partId, edges);
+      if (!nebula::ok(batch)) {
+        *opCode = nebula::error(batch);
+        return folly::none;
+      }
+      return std::move(nebula::value(batch));
+    };
+    IndexCountWrapper wrapper(env_);
+    nebula::MemoryLockGuard<EMLI> lg(env_->edgesML_.get(), std::move(dummyLock), false, false);
+    env_->kvstore_->asyncAtomicOp(
+        spaceId_,
+        partId,
+        std::move(op),
+        [l = std::move(lg), icw = std::move(wrapper), opCode, partId, this](
+            nebula::cpp2::ErrorCode retCode) {
+          UNUSED(l);
+          UNUSED(icw);
+          handleAsync(spaceId_,
+                      partId,
+                      *opCode != nebula::cpp2::ErrorCode::SUCCEEDED ? *opCode : retCode);
+        });
+  }
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::string> AddEdgesProcessor::addEdges(
     PartitionID partId, const std::vector<kvstore::KV>& edges) {
   IndexCountWrapper wrapper(env_);
@@ -343,8 +444,11 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> AddEdgesProcessor::addEdges(
   std::for_each(
       edges.begin(), edges.end(), [&newEdges](const auto& e) { newEdges[e.first] = e.second; });
 
+  // The deltas of the degrees by the new edges
+  std::map<std::pair<VertexID, EdgeType>, int64_t> degrees;
   for (auto& e : newEdges) {
     std::string val;
+    bool oldLoaded = false;
     RowReaderWrapper oReader;
     RowReaderWrapper nReader;
     auto edgeType = NebulaKeyUtils::getEdgeType(spaceVidLen_, e.first);
@@ -353,24 +457,38 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> AddEdgesProcessor::addEdges(
       LOG(ERROR) << "Space " << spaceId_ << ", Edge " << edgeType << " invalid";
       return nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND;
     }
+    if (ifNotExists_ || FLAGS_enable_edge_degree) {
+      auto obsIdx = findOldValue(partId, e.first);
+      if (!nebula::ok(obsIdx)) {
+        return nebula::error(obsIdx);
+      }
+      val = std::move(nebula::value(obsIdx));
+      oldLoaded = true;
+      if (ifNotExists_ && !val.empty()) {
+        continue;
+      }
+      if (FLAGS_enable_edge_degree && val.empty()) {
+        ++degrees[std::make_pair(NebulaKeyUtils::getSrcId(spaceVidLen_, e.first).str(), edgeType)];
+      }
+    }
     for (auto& index : indexes_) {
       if (edgeType == index->get_schema_id().get_edge_type()) {
         /*
          * step 1 , Delete old version index if exists.
          */
-        if (val.empty()) {
+        if (!oldLoaded) {
           auto obsIdx = findOldValue(partId, e.first);
           if (!nebula::ok(obsIdx)) {
             return nebula::error(obsIdx);
           }
           val = std::move(nebula::value(obsIdx));
-          if (!val.empty()) {
-            oReader =
-                RowReaderWrapper::getEdgePropReader(env_->schemaMan_, spaceId_, edgeType, val);
-            if (oReader == nullptr) {
-              LOG(ERROR) << "Bad format row";
-              return nebula::cpp2::ErrorCode::E_INVALID_DATA;
-            }
+          oldLoaded = true;
+        }
+        if (!val.empty() && oReader == nullptr) {
+          oReader = RowReaderWrapper::getEdgePropReader(env_->schemaMan_, spaceId_, edgeType, val);
+          if (oReader == nullptr) {
+            LOG(ERROR) << "Bad format row";
+            return nebula::cpp2::ErrorCode::E_INVALID_DATA;
           }
         }
 
@@ -436,6 +554,14 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> AddEdgesProcessor::addEdges(
     auto prop = e.second;
     batchHolder->put(std::move(key), std::move(prop));
   }
+  auto code = CommonUtils::updateDegrees(
+      env_->kvstore_, spaceId_, partId, spaceVidLen_, degrees, batchHolder.get());
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  if (consistOp_) {
+    (*consistOp_)(*batchHolder, nullptr);
+  }
   return encodeBatchValue(batchHolder->getBatch());
 }
 
@@ -32,6 +32,9 @@ class AddEdgesProcessor : public BaseProcessor<cpp2::ExecResponse> {
 
   void doProcessWithIndex(const cpp2::AddEdgesRequest& req);
 
+  // Keep the degrees of the vertices, see --enable_edge_degree
+  void doProcessWithDegree(const cpp2::AddEdgesRequest& req);
+
  private:
   AddEdgesProcessor(StorageEnv* env, const ProcessorCounters* counters)
       : BaseProcessor<cpp2::ExecResponse>(env, counters) {}
@@ -10,6 +10,7 @@
 #include "common/utils/IndexKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "common/utils/OperationKeyUtils.h"
+#include "storage/StorageFlags.h"
 
 namespace nebula {
 namespace storage {
@@ -46,7 +47,7 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
   indexes_ = std::move(iRet).value();
 
   CHECK_NOTNULL(env_->kvstore_);
-  if (indexes_.empty()) {
+  if (indexes_.empty() && !FLAGS_enable_edge_degree) {
     // Operate every part, the graph layer guarantees the unique of the edgeKey
     for (auto& part : partEdges) {
       std::vector<std::string> keys;
@@ -112,6 +113,33 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
         handleAsync(spaceId_, partId, err);
         continue;
       }
+      if (FLAGS_enable_edge_degree) {
+        // Whether the edges exist and the degrees are read in the atomic op
+        auto opCode =
+            std::make_shared<nebula::cpp2::ErrorCode>(nebula::cpp2::ErrorCode::SUCCEEDED);
+        auto op = [partId, edges = part.second, opCode, this]() -> folly::Optional<std::string> {
+          auto batch = deleteEdges(partId, edges);
+          if (!nebula::ok(batch)) {
+            *opCode = nebula::error(batch);
+            return folly::none;
+          }
+          return std::move(nebula::value(batch));
+        };
+        nebula::MemoryLockGuard<EMLI> lg(env_->edgesML_.get(), std::move(dummyLock), false, false);
+        env_->kvstore_->asyncAtomicOp(
+            spaceId_,
+            partId,
+            std::move(op),
+            [l = std::move(lg), icw = std::move(wrapper), opCode, partId, this](
+                nebula::cpp2::ErrorCode code) {
+              UNUSED(l);
+              UNUSED(icw);
+              handleAsync(spaceId_,
+                          partId,
+                          *opCode != nebula::cpp2::ErrorCode::SUCCEEDED ? *opCode : code);
+            });
+        continue;
+      }
       auto batch = deleteEdges(partId, std::move(part.second));
       if (!nebula::ok(batch)) {
         env_->edgesML_->unlockBatch(dummyLock);
@@ -136,12 +164,18 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
 ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
     PartitionID partId, const std::vector<cpp2::EdgeKey>& edges) {
   std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
+  // The deltas of the degrees by the deleted edges
+  std::map<std::pair<VertexID, EdgeType>, int64_t> degrees;
+  std::unordered_set<std::string> visited;
   for (auto& edge : edges) {
     auto type = *edge.edge_type_ref();
     auto srcId = (*edge.src_ref()).getStr();
     auto rank = *edge.ranking_ref();
     auto dstId = (*edge.dst_ref()).getStr();
     auto key = NebulaKeyUtils::edgeKey(spaceVidLen_, partId, srcId, type, rank, dstId);
+    if (!visited.emplace(key).second) {
+      continue;
+    }
     std::string val;
     auto ret = env_->kvstore_->get(spaceId_, partId, key, &val);
 
@@ -184,6 +218,9 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
           }
         }
       }
+      if (FLAGS_enable_edge_degree) {
+        --degrees[std::make_pair(srcId, type)];
+      }
       batchHolder->remove(std::move(key));
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
       continue;
@@ -194,6 +231,11 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
     }
   }
 
+  auto code = CommonUtils::updateDegrees(
+      env_->kvstore_, spaceId_, partId, spaceVidLen_, degrees, batchHolder.get());
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
   return encodeBatchValue(batchHolder->getBatch());
 }
 
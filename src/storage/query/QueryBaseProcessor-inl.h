@@ -134,10 +134,12 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::buildFilter(const REQ& re
   if (!traverseSpec.filter_ref().has_value()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
-  const auto& filterStr = *traverseSpec.filter_ref();
+  return decodeFilter(*traverseSpec.filter_ref());
+}
 
+template <typename REQ, typename RESP>
+nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::decodeFilter(const std::string& filterStr) {
   auto pool = &this->planContext_->objPool_;
-  // auto v = env_;
   if (!filterStr.empty()) {
     // the filter expression **must** return a bool
     filter_ = Expression::decode(pool, filterStr);
@@ -438,8 +440,10 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkExp(const Expression
       }
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     }
+    case Expression::Kind::kTagProperty:
     case Expression::Kind::kSrcProperty: {
-      auto* sourceExp = static_cast<const SourcePropertyExpression*>(exp);
+      // Both tag.prop and $^.tag.prop are the props of the source vertex
+      auto* sourceExp = static_cast<const PropertyExpression*>(exp);
       const auto& tagName = sourceExp->sym();
       const auto& propName = sourceExp->prop();
       auto tagRet = this->env_->schemaMan_->toTagID(spaceId_, tagName);
@@ -561,7 +565,6 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkExp(const Expression
     case Expression::Kind::kSubscript:
     case Expression::Kind::kAttribute:
     case Expression::Kind::kLabelAttribute:
-    case Expression::Kind::kTagProperty:
     case Expression::Kind::kVertex:
     case Expression::Kind::kEdge:
     case Expression::Kind::kLabel:
@@ -155,6 +155,8 @@ class QueryBaseProcessor : public BaseProcessor<RESP> {
   nebula::cpp2::ErrorCode handleEdgeProps(std::vector<cpp2::EdgeProp>& edgeProps);
 
   nebula::cpp2::ErrorCode buildFilter(const REQ& req);
+  // Decode the filter into filter_ and check it, nothing to do if empty
+  nebula::cpp2::ErrorCode decodeFilter(const std::string& filterStr);
   nebula::cpp2::ErrorCode buildYields(const REQ& req);
 
   // build ttl info map
@@ -0,0 +1,111 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/query/ScanSnapshots.h"
+
+#include "common/time/WallClock.h"
+
+DEFINE_uint32(scan_snapshot_ttl_secs,
+              600,
+              "How long the snapshot of a scan is kept after its last batch, "
+              "in seconds");
+DEFINE_uint32(scan_snapshot_expire_interval_secs,
+              60,
+              "How often the expired snapshots of the scans are released, in seconds");
+
+namespace nebula {
+namespace storage {
+
+ScanSnapshots::ScanSnapshots(kvstore::KVStore* kvstore)
+    // Not to mistake the ids handed out before a restart for the new ones
+    : kvstore_(kvstore), nextId_(time::WallClock::fastNowInMicroSec()) {
+  bgThread_ = std::make_unique<thread::GenericWorker>();
+  CHECK(bgThread_->start("scan-snapshots"));
+  bgThread_->addRepeatTask(
+      std::max(FLAGS_scan_snapshot_expire_interval_secs, 1U) * 1000, &ScanSnapshots::sweep, this);
+}
+
+ScanSnapshots::~ScanSnapshots() {
+  bgThread_->stop();
+  bgThread_->wait();
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::pair<int64_t, const void*>> ScanSnapshots::create(
+    GraphSpaceID spaceId, PartitionID partId, bool canReadFromFollower) {
+  auto ret = kvstore_->getSnapshot(spaceId, partId, canReadFromFollower);
+  if (!nebula::ok(ret)) {
+    return nebula::error(ret);
+  }
+  auto* snapshot = nebula::value(ret);
+  if (snapshot == nullptr) {
+    return std::pair<int64_t, const void*>(0, nullptr);
+  }
+  auto now = time::WallClock::fastNowInSec();
+  std::lock_guard<std::mutex> g(lock_);
+  expire(now);
+  auto id = nextId_++;
+  snapshots_.emplace(id, Snapshot{spaceId, partId, snapshot, now});
+  return std::make_pair(id, snapshot);
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, const void*> ScanSnapshots::get(GraphSpaceID spaceId,
+                                                                 PartitionID partId,
+                                                                 int64_t id) {
+  std::lock_guard<std::mutex> g(lock_);
+  auto iter = snapshots_.find(id);
+  if (iter == snapshots_.end() || iter->second.spaceId != spaceId ||
+      iter->second.partId != partId) {
+    return nebula::cpp2::ErrorCode::E_SCAN_SNAPSHOT_EXPIRED;
+  }
+  iter->second.lastAccess = time::WallClock::fastNowInSec();
+  return iter->second.snapshot;
+}
+
+void ScanSnapshots::release(GraphSpaceID spaceId, PartitionID partId, int64_t id) {
+  std::lock_guard<std::mutex> g(lock_);
+  auto iter = snapshots_.find(id);
+  if (iter == snapshots_.end() || iter->second.spaceId != spaceId ||
+      iter->second.partId != partId) {
+    return;
+  }
+  kvstore_->releaseSnapshot(spaceId, partId, iter->second.snapshot);
+  snapshots_.erase(iter);
+}
+
+void ScanSnapshots::releaseAll() {
+  std::lock_guard<std::mutex> g(lock_);
+  for (auto& entry : snapshots_) {
+    auto& s = entry.second;
+    kvstore_->releaseSnapshot(s.spaceId, s.partId, s.snapshot);
+  }
+  snapshots_.clear();
+}
+
+size_t ScanSnapshots::size() {
+  std::lock_guard<std::mutex> g(lock_);
+  return snapshots_.size();
+}
+
+void ScanSnapshots::sweep() {
+  std::lock_guard<std::mutex> g(lock_);
+  expire(time::WallClock::fastNowInSec());
+}
+
+void ScanSnapshots::expire(int64_t now) {
+  for (auto iter = snapshots_.begin(); iter != snapshots_.end();) {
+    auto& s = iter->second;
+    if (now - s.lastAccess > FLAGS_scan_snapshot_ttl_secs) {
+      VLOG(1) << "The snapshot " << iter->first << " of space " << s.spaceId << ", part "
+              << s.partId << " expired";
+      kvstore_->releaseSnapshot(s.spaceId, s.partId, s.snapshot);
+      iter = snapshots_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+}  // namespace storage
+}  // namespace nebula
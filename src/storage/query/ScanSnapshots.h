@@ -0,0 +1,74 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_QUERY_SCANSNAPSHOTS_H_
+#define STORAGE_QUERY_SCANSNAPSHOTS_H_
+
+#include "common/base/Base.h"
+#include "common/base/ErrorOr.h"
+#include "common/thread/GenericWorker.h"
+#include "kvstore/KVStore.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * The snapshots pinned by the scans of parts, so that all the batches of a
+ * part are read from the same point in time.
+ *
+ * A snapshot is created by the first batch of a part and referred by its id
+ * in the cursors of the later ones. It is released when the part is scanned
+ * to the end, or when no batch has read it for --scan_snapshot_ttl_secs, e.g.
+ * the client has given up, since a snapshot keeps the compaction from
+ * dropping the data overwritten after it. The expired ones are swept every
+ * --scan_snapshot_expire_interval_secs in the background.
+ */
+class ScanSnapshots final {
+ public:
+  explicit ScanSnapshots(kvstore::KVStore* kvstore);
+
+  ~ScanSnapshots();
+
+  // Pin a snapshot of the part, return its id and the snapshot. The id is 0
+  // and the snapshot is null if the store doesn't support snapshots.
+  ErrorOr<nebula::cpp2::ErrorCode, std::pair<int64_t, const void*>> create(
+      GraphSpaceID spaceId, PartitionID partId, bool canReadFromFollower);
+
+  // Return E_SCAN_SNAPSHOT_EXPIRED if the snapshot has been released
+  ErrorOr<nebula::cpp2::ErrorCode, const void*> get(GraphSpaceID spaceId,
+                                                    PartitionID partId,
+                                                    int64_t id);
+
+  void release(GraphSpaceID spaceId, PartitionID partId, int64_t id);
+
+  // Release all, must be called before the store stops
+  void releaseAll();
+
+  size_t size();
+
+ private:
+  struct Snapshot {
+    GraphSpaceID spaceId;
+    PartitionID partId;
+    const void* snapshot;
+    int64_t lastAccess;
+  };
+
+  // Release the ones not read for a while, the lock must be held
+  void expire(int64_t now);
+
+  void sweep();
+
+  kvstore::KVStore* kvstore_;
+  std::unique_ptr<thread::GenericWorker> bgThread_;
+  std::mutex lock_;
+  std::unordered_map<int64_t, Snapshot> snapshots_;
+  int64_t nextId_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_QUERY_SCANSNAPSHOTS_H_
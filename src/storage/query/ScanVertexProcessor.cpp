@@ -8,6 +8,7 @@
 #include "common/utils/NebulaKeyUtils.h"
 #include "storage/StorageFlags.h"
 #include "storage/exec/QueryUtils.h"
+#include "storage/query/ScanSnapshots.h"
 
 namespace nebula {
 namespace storage {
@@ -25,41 +26,154 @@ void ScanVertexProcessor::process(const cpp2::ScanVertexRequest& req) {
 void ScanVertexProcessor::doProcess(const cpp2::ScanVertexRequest& req) {
   spaceId_ = req.get_space_id();
   partId_ = req.get_part_id();
+  if (req.get_parts() != nullptr) {
+    multiParts_ = true;
+    parts_.assign(req.get_parts()->begin(), req.get_parts()->end());
+  } else {
+    cpp2::ScanCursor cursor;
+    if (req.get_cursor() != nullptr) {
+      cursor.set_next_cursor(*req.get_cursor());
+    }
+    parts_.emplace_back(partId_, std::move(cursor));
+  }
 
   auto retCode = getSpaceVidLen(spaceId_);
   if (retCode != nebula::cpp2::ErrorCode::SUCCEEDED) {
-    pushResultCode(retCode, partId_);
+    for (const auto& part : parts_) {
+      pushResultCode(retCode, part.first);
+    }
     onFinished();
     return;
   }
 
+  this->planContext_ = std::make_unique<PlanContext>(
+      this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
+
   retCode = checkAndBuildContexts(req);
   if (retCode != nebula::cpp2::ErrorCode::SUCCEEDED) {
-    pushResultCode(retCode, partId_);
+    for (const auto& part : parts_) {
+      pushResultCode(retCode, part.first);
+    }
     onFinished();
     return;
   }
 
+  limit_ = req.get_limit();
+  // The rows out of the time range are skipped before decoding
+  hasTimeRange_ = req.get_start_time() != nullptr || req.get_end_time() != nullptr;
+  if (req.get_start_time() != nullptr) {
+    startTime_ = *req.get_start_time();
+  }
+  if (req.get_end_time() != nullptr) {
+    endTime_ = *req.get_end_time();
+  }
+  canReadFromFollower_ = req.get_enable_read_from_follower();
+  useSnapshot_ = multiParts_ && req.get_use_snapshot() && env_->scanSnapshots_ != nullptr;
+
+  if (!FLAGS_query_concurrently || executor_ == nullptr || parts_.size() == 1) {
+    runInSingleThread();
+  } else {
+    runInMultipleThread();
+  }
+}
+
+void ScanVertexProcessor::runInSingleThread() {
+  for (const auto& [partId, cursor] : parts_) {
+    cpp2::ScanCursor next;
+    auto ret = scanPart(partId, cursor, expCtx_.get(), &resultDataSet_, &next);
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      handleErrorCode(ret, spaceId_, partId);
+      continue;
+    }
+    cursors_.emplace(partId, std::move(next));
+  }
+  onProcessFinished();
+  onFinished();
+}
+
+void ScanVertexProcessor::runInMultipleThread() {
+  std::vector<folly::Future<nebula::cpp2::ErrorCode>> futures;
+  for (size_t i = 0; i < parts_.size(); i++) {
+    nebula::DataSet result;
+    result.colNames = resultDataSet_.colNames;
+    results_.emplace_back(std::move(result));
+    nexts_.emplace_back();
+    std::unique_ptr<StorageExpressionContext> expCtx;
+    if (expCtx_ != nullptr) {
+      expCtx = std::make_unique<StorageExpressionContext>(*expCtx_);
+    }
+    expCtxs_.emplace_back(std::move(expCtx));
+  }
+  for (size_t i = 0; i < parts_.size(); i++) {
+    futures.emplace_back(folly::via(executor_, [this, i]() {
+      return scanPart(
+          parts_[i].first, parts_[i].second, expCtxs_[i].get(), &results_[i], &nexts_[i]);
+    }));
+  }
+
+  folly::collectAll(futures).via(executor_).thenTry([this](auto&& t) mutable {
+    CHECK(!t.hasException());
+    const auto& tries = t.value();
+    for (size_t j = 0; j < tries.size(); j++) {
+      CHECK(!tries[j].hasException());
+      auto code = tries[j].value();
+      auto partId = parts_[j].first;
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        handleErrorCode(code, spaceId_, partId);
+      } else {
+        resultDataSet_.append(std::move(results_[j]));
+        cursors_.emplace(partId, std::move(nexts_[j]));
+      }
+    }
+    this->onProcessFinished();
+    this->onFinished();
+  });
+}
+
+nebula::cpp2::ErrorCode ScanVertexProcessor::scanPart(PartitionID partId,
+                                                      const cpp2::ScanCursor& cursor,
+                                                      StorageExpressionContext* expCtx,
+                                                      nebula::DataSet* result,
+                                                      cpp2::ScanCursor* next) {
   std::string start;
-  std::string prefix = NebulaKeyUtils::vertexPrefix(partId_);
-  if (req.get_cursor() == nullptr || req.get_cursor()->empty()) {
+  std::string prefix = NebulaKeyUtils::vertexPrefix(partId);
+  if (cursor.get_next_cursor() == nullptr || cursor.get_next_cursor()->empty()) {
     start = prefix;
   } else {
-    start = *req.get_cursor();
+    start = *cursor.get_next_cursor();
+  }
+
+  int64_t snapshotId = 0;
+  const void* snapshot = nullptr;
+  if (useSnapshot_) {
+    if (cursor.get_snapshot_id() != nullptr) {
+      snapshotId = *cursor.get_snapshot_id();
+      auto ret = env_->scanSnapshots_->get(spaceId_, partId, snapshotId);
+      if (!nebula::ok(ret)) {
+        return nebula::error(ret);
+      }
+      snapshot = nebula::value(ret);
+    } else {
+      auto ret = env_->scanSnapshots_->create(spaceId_, partId, canReadFromFollower_);
+      if (!nebula::ok(ret)) {
+        return nebula::error(ret);
+      }
+      std::tie(snapshotId, snapshot) = nebula::value(ret);
+    }
   }
 
   std::unique_ptr<kvstore::KVIterator> iter;
   auto kvRet = env_->kvstore_->rangeWithPrefix(
-      spaceId_, partId_, start, prefix, &iter, req.get_enable_read_from_follower());
+      spaceId_, partId, start, prefix, &iter, canReadFromFollower_, snapshot);
   if (kvRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
-    handleErrorCode(kvRet, spaceId_, partId_);
-    onFinished();
-    return;
+    if (snapshot != nullptr) {
+      env_->scanSnapshots_->release(spaceId_, partId, snapshotId);
+    }
+    return kvRet;
   }
 
-  auto rowLimit = req.get_limit();
   RowReaderWrapper reader;
-  for (int64_t rowCount = 0; iter->valid() && rowCount < rowLimit; iter->next()) {
+  for (int64_t rowCount = 0; iter->valid() && rowCount < limit_; iter->next()) {
     auto key = iter->key();
 
     auto tagId = NebulaKeyUtils::getTagId(spaceVidLen_, key);
@@ -69,12 +183,18 @@ void ScanVertexProcessor::doProcess(const cpp2::ScanVertexRequest& req) {
     }
 
     auto val = iter->val();
+    if (hasTimeRange_ && !QueryUtils::inTimeRange(val, startTime_, endTime_)) {
+      continue;
+    }
     auto schemaIter = tagContext_.schemas_.find(tagId);
     CHECK(schemaIter != tagContext_.schemas_.end());
     reader.reset(schemaIter->second, val);
     if (!reader) {
       continue;
     }
+    if (!checkFilter(expCtx, reader.get(), key)) {
+      continue;
+    }
 
     nebula::List list;
     auto idx = tagIter->second;
@@ -83,18 +203,25 @@ void ScanVertexProcessor::doProcess(const cpp2::ScanVertexRequest& req) {
              .ok()) {
       continue;
     }
-    resultDataSet_.rows.emplace_back(std::move(list));
+    result->rows.emplace_back(std::move(list));
     rowCount++;
   }
 
   if (iter->valid()) {
-    resp_.set_has_next(true);
-    resp_.set_next_cursor(iter->key().str());
+    next->set_has_next(true);
+    next->set_next_cursor(iter->key().str());
+    if (snapshot != nullptr) {
+      next->set_snapshot_id(snapshotId);
+    }
   } else {
-    resp_.set_has_next(false);
+    next->set_has_next(false);
+    if (snapshot != nullptr) {
+      // The iterator must not outlive the snapshot it reads from
+      iter.reset();
+      env_->scanSnapshots_->release(spaceId_, partId, snapshotId);
+    }
   }
-  onProcessFinished();
-  onFinished();
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
 nebula::cpp2::ErrorCode ScanVertexProcessor::checkAndBuildContexts(
@@ -106,8 +233,43 @@ nebula::cpp2::ErrorCode ScanVertexProcessor::checkAndBuildContexts(
 
   std::vector<cpp2::VertexProp> returnProps = {*req.return_columns_ref()};
   ret = handleVertexProps(returnProps);
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
   buildTagColName(returnProps);
-  return ret;
+
+  if (req.get_filter() != nullptr) {
+    auto numTags = tagContext_.indexMap_.size();
+    ret = decodeFilter(*req.get_filter());
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return ret;
+    }
+    // Only the props of the scanned tag could be filtered
+    if (tagContext_.indexMap_.size() != numTags) {
+      return nebula::cpp2::ErrorCode::E_INVALID_FILTER;
+    }
+    if (filter_ != nullptr) {
+      auto tagId = req.get_return_columns().get_tag();
+      expCtx_ = std::make_unique<StorageExpressionContext>(spaceVidLen_,
+                                                           isIntId_,
+                                                           tagContext_.tagNames_[tagId],
+                                                           tagContext_.schemas_[tagId].back().get(),
+                                                           false);
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+bool ScanVertexProcessor::checkFilter(StorageExpressionContext* expCtx,
+                                      RowReader* reader,
+                                      folly::StringPiece key) {
+  if (filter_ == nullptr) {
+    return true;
+  }
+  expCtx->reset(reader, key.str());
+  // NULL is always false
+  auto result = filter_->eval(*expCtx).toBool();
+  return result.isBool() && result.getBool();
 }
 
 void ScanVertexProcessor::buildTagColName(const std::vector<cpp2::VertexProp>& tagProps) {
@@ -120,7 +282,20 @@ void ScanVertexProcessor::buildTagColName(const std::vector<cpp2::VertexProp>& t
   }
 }
 
-void ScanVertexProcessor::onProcessFinished() { resp_.set_vertex_data(std::move(resultDataSet_)); }
+void ScanVertexProcessor::onProcessFinished() {
+  resp_.set_vertex_data(std::move(resultDataSet_));
+  if (multiParts_) {
+    resp_.set_cursors(std::move(cursors_));
+    return;
+  }
+  auto iter = cursors_.find(partId_);
+  if (iter != cursors_.end() && iter->second.get_has_next()) {
+    resp_.set_has_next(true);
+    resp_.set_next_cursor(*iter->second.get_next_cursor());
+  } else {
+    resp_.set_has_next(false);
+  }
+}
 
 }  // namespace storage
 }  // namespace nebula
@@ -7,6 +7,7 @@
 #define STORAGE_QUERY_SCANVERTEXPROCESSOR_H_
 
 #include "common/base/Base.h"
+#include "storage/context/StorageExpressionContext.h"
 #include "storage/query/QueryBaseProcessor.h"
 
 namespace nebula {
@@ -36,10 +37,42 @@ class ScanVertexProcessor
 
   void buildTagColName(const std::vector<cpp2::VertexProp>& tagProps);
 
+  // Scan at most limit_ rows of the part from the cursor into the result, and
+  // set where to go on in next
+  nebula::cpp2::ErrorCode scanPart(PartitionID partId,
+                                   const cpp2::ScanCursor& cursor,
+                                   StorageExpressionContext* expCtx,
+                                   nebula::DataSet* result,
+                                   cpp2::ScanCursor* next);
+
+  void runInSingleThread();
+
+  void runInMultipleThread();
+
+  // Whether the row passes the filter
+  bool checkFilter(StorageExpressionContext* expCtx, RowReader* reader, folly::StringPiece key);
+
   void onProcessFinished() override;
 
  private:
   PartitionID partId_;
+  // Whether the request scans the parts in `parts', or only `part_id'
+  bool multiParts_{false};
+  std::vector<std::pair<PartitionID, cpp2::ScanCursor>> parts_;
+  std::unordered_map<PartitionID, cpp2::ScanCursor> cursors_;
+
+  int64_t limit_{0};
+  bool hasTimeRange_{false};
+  int64_t startTime_{0};
+  int64_t endTime_{std::numeric_limits<int64_t>::max()};
+  bool canReadFromFollower_{true};
+  bool useSnapshot_{false};
+
+  std::unique_ptr<StorageExpressionContext> expCtx_;
+  // The contexts, results and cursors of each part when run in multiple threads
+  std::vector<std::unique_ptr<StorageExpressionContext>> expCtxs_;
+  std::vector<nebula::DataSet> results_;
+  std::vector<cpp2::ScanCursor> nexts_;
 };
 
 }  // namespace storage
@@ -191,14 +191,14 @@ class MetaClientTestUpdater {
   static void addLocalCache(meta::MetaClient& mClient,
                             GraphSpaceID spaceId,
                             std::shared_ptr<meta::SpaceInfoCache> spInfoCache) {
-    mClient.localCache_[spaceId] = spInfoCache;
+    mClient.metadata_.load()->localCache_[spaceId] = spInfoCache;
   }
 
   static meta::SpaceInfoCache* getLocalCache(meta::MetaClient* mClient, GraphSpaceID spaceId) {
-    if (mClient->localCache_.count(spaceId) == 0) {
+    if (mClient->metadata_.load()->localCache_.count(spaceId) == 0) {
       return nullptr;
     }
-    return mClient->localCache_[spaceId].get();
+    return mClient->metadata_.load()->localCache_[spaceId].get();
   }
 
   static void addPartTerm(meta::MetaClient* mClient,
@@ -220,17 +220,18 @@ class MetaClientTestUpdater {
     meta::MetaClientOptions options;
 
     auto mClient = std::make_unique<meta::MetaClient>(exec, addrs, options);
-    mClient->localCache_[mockSpaceId] = std::make_shared<meta::SpaceInfoCache>();
+    auto& localCache = mClient->metadata_.load()->localCache_;
+    localCache[mockSpaceId] = std::make_shared<meta::SpaceInfoCache>();
     for (int i = 0; i != mockPartNum; ++i) {
-      mClient->localCache_[mockSpaceId]->termOfPartition_[i] = i;
-      auto ignoreItem = mClient->localCache_[mockSpaceId]->partsAlloc_[i];
+      localCache[mockSpaceId]->termOfPartition_[i] = i;
+      auto ignoreItem = localCache[mockSpaceId]->partsAlloc_[i];
       UNUSED(ignoreItem);
     }
     meta::cpp2::ColumnTypeDef type;
     type.set_type(nebula::cpp2::PropertyType::FIXED_STRING);
     type.set_type_length(32);
 
-    mClient->localCache_[mockSpaceId]->spaceDesc_.set_vid_type(std::move(type));
+    localCache[mockSpaceId]->spaceDesc_.set_vid_type(std::move(type));
     mClient->ready_ = true;
     return mClient;
   }
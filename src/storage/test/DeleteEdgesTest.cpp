@@ -3,6 +3,7 @@
  * This source code is licensed under Apache 2.0 License.
  */
 
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
 #include <rocksdb/db.h>
 
@@ -13,6 +14,7 @@
 #include "interface/gen-cpp2/storage_types.h"
 #include "mock/MockCluster.h"
 #include "mock/MockData.h"
+#include "storage/StorageFlags.h"
 #include "storage/mutate/AddEdgesProcessor.h"
 #include "storage/mutate/DeleteEdgesProcessor.h"
 #include "storage/test/TestUtils.h"
@@ -124,6 +126,76 @@ TEST(DeleteEdgesTest, MultiVersionTest) {
   }
 }
 
+// Sum the degrees of all the vertices in the parts
+int64_t sumDegrees(StorageEnv* env, GraphSpaceID spaceId, const std::vector<PartitionID>& parts) {
+  int64_t total = 0;
+  for (auto partId : parts) {
+    std::unique_ptr<kvstore::KVIterator> iter;
+    auto prefix = NebulaKeyUtils::degreePrefix(partId);
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              env->kvstore_->prefix(spaceId, partId, prefix, &iter));
+    while (iter && iter->valid()) {
+      total += *reinterpret_cast<const int64_t*>(iter->val().data());
+      iter->next();
+    }
+  }
+  return total;
+}
+
+TEST(DeleteEdgesTest, DegreeTest) {
+  FLAGS_enable_edge_degree = true;
+  SCOPE_EXIT {
+    FLAGS_enable_edge_degree = false;
+  };
+  fs::TempDir rootPath("/tmp/DeleteEdgesTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  std::vector<PartitionID> parts;
+
+  // Add edges twice, the existing ones are not counted again
+  for (auto i = 0; i < 2; i++) {
+    auto* processor = AddEdgesProcessor::instance(env, nullptr);
+    cpp2::AddEdgesRequest req = mock::MockData::mockAddEdgesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    EXPECT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    checkAddEdgesData(req, env, 334, 0);
+    if (parts.empty()) {
+      for (auto& part : *req.parts_ref()) {
+        parts.emplace_back(part.first);
+      }
+    }
+    EXPECT_EQ(334, sumDegrees(env, req.get_space_id(), parts));
+  }
+
+  // Delete edges, the degrees of the vertices are removed
+  {
+    auto* processor = DeleteEdgesProcessor::instance(env, nullptr);
+    cpp2::DeleteEdgesRequest req = mock::MockData::mockDeleteEdgesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    EXPECT_EQ(0, (*resp.result_ref()).failed_parts.size());
+
+    auto spaceId = req.get_space_id();
+    auto vIdLen = env->schemaMan_->getSpaceVidLen(spaceId).value();
+    checkEdgesData(vIdLen, spaceId, *req.parts_ref(), env, 0);
+    EXPECT_EQ(0, sumDegrees(env, spaceId, parts));
+
+    auto& edgeKey = req.get_parts().begin()->second.front();
+    auto ret = CommonUtils::degree(env->kvstore_,
+                                   spaceId,
+                                   req.get_parts().begin()->first,
+                                   vIdLen,
+                                   edgeKey.get_src().getStr(),
+                                   edgeKey.get_edge_type());
+    ASSERT_TRUE(nebula::ok(ret));
+    EXPECT_EQ(0, nebula::value(ret));
+  }
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -0,0 +1,165 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "clients/storage/GetNeighborsCoalescer.h"
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace storage {
+
+class GetNeighborsCoalescerTest : public ::testing::Test {
+ protected:
+  static cpp2::GetNeighborsRequest request(
+      std::unordered_map<PartitionID, std::vector<std::string>> parts, bool profile = false) {
+    cpp2::GetNeighborsRequest req;
+    req.set_space_id(1);
+    req.set_column_names({kVid});
+    std::unordered_map<PartitionID, std::vector<Row>> rows;
+    for (auto& part : parts) {
+      for (auto& vid : part.second) {
+        rows[part.first].emplace_back(Row({Value(vid)}));
+      }
+    }
+    req.set_parts(std::move(rows));
+    cpp2::TraverseSpec spec;
+    spec.set_edge_types({1});
+    req.set_traverse_spec(std::move(spec));
+    cpp2::RequestCommon common;
+    common.set_profile_detail(profile);
+    req.set_common(std::move(common));
+    return req;
+  }
+
+  static cpp2::GetNeighborsResponse response(const std::vector<std::string>& vids,
+                                             std::vector<PartitionID> failedParts = {}) {
+    cpp2::GetNeighborsResponse resp;
+    cpp2::ResponseCommon result;
+    std::vector<cpp2::PartitionResult> failed;
+    for (auto part : failedParts) {
+      cpp2::PartitionResult partResult;
+      partResult.set_code(nebula::cpp2::ErrorCode::E_LEADER_CHANGED);
+      partResult.set_part_id(part);
+      failed.emplace_back(std::move(partResult));
+    }
+    result.set_failed_parts(std::move(failed));
+    result.set_latency_in_us(100);
+    resp.set_result(std::move(result));
+    DataSet ds({kVid, "_stats"});
+    for (auto& vid : vids) {
+      ds.rows.emplace_back(Row({Value(vid), Value("stats of " + vid)}));
+    }
+    resp.set_vertices(std::move(ds));
+    return resp;
+  }
+
+  static std::vector<std::string> vidsOf(const cpp2::GetNeighborsResponse& resp) {
+    std::vector<std::string> vids;
+    for (auto& row : resp.get_vertices()->rows) {
+      vids.emplace_back(row.values[0].getStr());
+    }
+    std::sort(vids.begin(), vids.end());
+    return vids;
+  }
+
+  // Keep the requests sent and reply them later
+  GetNeighborsCoalescer::SendFunc sendFunc() {
+    return [this](const cpp2::GetNeighborsRequest& req) {
+      sent_.emplace_back(req);
+      promises_.emplace_back();
+      return promises_.back().getFuture();
+    };
+  }
+
+  HostAddr host_{"127.0.0.1", 1};
+  std::vector<cpp2::GetNeighborsRequest> sent_;
+  std::deque<folly::Promise<cpp2::GetNeighborsResponse>> promises_;
+};
+
+TEST_F(GetNeighborsCoalescerTest, MergeAndSplit) {
+  GetNeighborsCoalescer coalescer(100);
+  auto req1 = request({{1, {"a", "b"}}});
+  auto req2 = request({{1, {"b", "c", "c"}}, {2, {"d"}}});
+  auto req3 = request({{2, {"d"}}});
+
+  auto f1 = coalescer.send(host_, req1, sendFunc());
+  // Wait for the first one in flight
+  auto f2 = coalescer.send(host_, req2, sendFunc());
+  auto f3 = coalescer.send(host_, req3, sendFunc());
+  ASSERT_EQ(1, sent_.size());
+
+  promises_[0].setValue(response({"a", "b"}));
+  ASSERT_TRUE(f1.isReady());
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), vidsOf(f1.value()));
+
+  // The queued ones are merged into one, and the vids are deduplicated
+  ASSERT_EQ(2, sent_.size());
+  auto& parts = sent_[1].get_parts();
+  ASSERT_EQ(2, parts.size());
+  EXPECT_EQ(2, parts.at(1).size());
+  EXPECT_EQ(1, parts.at(2).size());
+  EXPECT_FALSE(f2.isReady());
+
+  promises_[1].setValue(response({"b", "c"}, {2}));
+  ASSERT_TRUE(f2.isReady());
+  ASSERT_TRUE(f3.isReady());
+  // A vid is returned as many times as it is asked
+  EXPECT_EQ((std::vector<std::string>{"b", "c", "c"}), vidsOf(f2.value()));
+  EXPECT_TRUE(vidsOf(f3.value()).empty());
+  ASSERT_EQ(1, f2.value().get_result().get_failed_parts().size());
+  ASSERT_EQ(1, f3.value().get_result().get_failed_parts().size());
+  EXPECT_EQ(2, f3.value().get_result().get_failed_parts()[0].get_part_id());
+  EXPECT_EQ(100, f3.value().get_result().get_latency_in_us());
+
+  // Nothing is in flight, sent at once
+  auto f4 = coalescer.send(host_, req3, sendFunc());
+  EXPECT_EQ(3, sent_.size());
+  promises_[2].setValue(response({"d"}));
+  ASSERT_TRUE(f4.isReady());
+}
+
+TEST_F(GetNeighborsCoalescerTest, NotMerged) {
+  GetNeighborsCoalescer coalescer(2);
+  auto req1 = request({{1, {"a"}}});
+  auto profiled = request({{1, {"b"}}}, true);
+  auto otherSpace = request({{1, {"c"}}});
+  otherSpace.set_space_id(2);
+  auto req2 = request({{1, {"d", "e"}}});
+  auto req3 = request({{1, {"f"}}});
+
+  auto f1 = coalescer.send(host_, req1, sendFunc());
+  // Not to merge the profiled ones or the ones of another space
+  auto f2 = coalescer.send(host_, profiled, sendFunc());
+  auto f3 = coalescer.send(host_, otherSpace, sendFunc());
+  ASSERT_EQ(3, sent_.size());
+
+  // Exceed the max size of a batch together
+  auto f4 = coalescer.send(host_, req2, sendFunc());
+  auto f5 = coalescer.send(host_, req3, sendFunc());
+  ASSERT_EQ(3, sent_.size());
+  promises_[0].setValue(response({"a"}));
+  ASSERT_EQ(4, sent_.size());
+  EXPECT_EQ(2, sent_[3].get_parts().at(1).size());
+  promises_[3].setException(std::runtime_error("rpc failed"));
+  ASSERT_TRUE(f4.isReady());
+  EXPECT_TRUE(f4.hasException());
+  ASSERT_EQ(5, sent_.size());
+  EXPECT_EQ(1, sent_[4].get_parts().at(1).size());
+  promises_[4].setValue(response({"f"}));
+  ASSERT_TRUE(f5.isReady());
+  EXPECT_EQ((std::vector<std::string>{"f"}), vidsOf(f5.value()));
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
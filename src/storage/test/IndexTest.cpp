@@ -17,6 +17,7 @@
 #include "common/utils/NebulaKeyUtils.h"
 #include "kvstore/KVEngine.h"
 #include "kvstore/KVIterator.h"
+#include "storage/exec/IndexAggregateNode.h"
 #include "storage/exec/IndexDedupNode.h"
 #include "storage/exec/IndexEdgeScanNode.h"
 #include "storage/exec/IndexLimitNode.h"
@@ -1733,6 +1734,63 @@ TEST_F(IndexScanTest, DateTime) {
 TEST_F(IndexScanTest, Compound) {
   // TODO(hs.zhang): add unittest
 }
+TEST_F(IndexScanTest, Batched) {
+  auto rows = R"(
+    int | int
+    1   | -10
+    2   | -1
+    3   | 0
+    4   | 1
+    5   | 0
+  )"_row;
+  auto schema = R"(
+    a   | int | | false
+    c   | int | | false
+  )"_schema;
+  auto indices = R"(
+    TAG(t,1)
+    (i1,2):c
+  )"_index(schema);
+  auto kv = encodeTag(rows, 1, schema, indices);
+  auto kvstore = std::make_unique<MockKVStore>();
+  for (auto& iter : kv) {
+    for (auto& item : iter) {
+      kvstore->put(item.first, item.second);
+    }
+  }
+  // c=0, c=-10 and -1<=c<1 are scanned by one node, in the order of their lower bounds, and the
+  // keys in both c=0 and -1<=c<1 are returned twice
+  std::vector<ColumnHint> columnHints = {makeColumnHint("c", 0)};
+  std::vector<ColumnHint> batchedHints1 = {makeColumnHint("c", -10)};
+  std::vector<ColumnHint> batchedHints2 = {makeColumnHint<true, false>("c", -1, 1)};
+  auto context = makeContext(1, 0);
+  auto scanNode =
+      std::make_unique<IndexVertexScanNode>(context.get(), 0, columnHints, kvstore.get());
+  scanNode->addBatchedHints(batchedHints1);
+  scanNode->addBatchedHints(batchedHints2);
+  IndexScanTestHelper helper;
+  helper.setIndex(scanNode.get(), indices[0]);
+  helper.setTag(scanNode.get(), schema);
+  InitContext initCtx;
+  initCtx.requiredColumns = {kVid};
+  scanNode->init(initCtx);
+  scanNode->execute(0);
+
+  std::vector<Row> result;
+  while (true) {
+    auto res = scanNode->next();
+    ASSERT(res.success());
+    if (!res.hasData()) {
+      break;
+    }
+    result.emplace_back(std::move(res).row());
+  }
+  std::vector<Row> expect;
+  for (auto vid : {"0", "1", "2", "4", "2", "4"}) {
+    expect.emplace_back(Row({Value(vid)}));
+  }
+  EXPECT_EQ(result, expect);
+}
 
 class IndexTest : public ::testing::Test {
  protected:
@@ -1927,6 +1985,93 @@ TEST_F(IndexTest, Dedup) {
   )"_row;
   ASSERT_EQ(collectResult(dedup.get()), expect);
 }
+TEST_F(IndexTest, Aggregate) {
+  auto rows = R"(
+    int | int
+    1   | 2
+    1   | <null>
+    2   | 5
+    1   | 7
+    2   | 3
+  )"_row;
+  auto makeChild = [&rows](RuntimeContext* ctx, size_t* offset) {
+    auto child = std::make_unique<MockIndexNode>(ctx);
+    child->executeFunc = [offset](PartitionID) {
+      *offset = 0;
+      return ::nebula::cpp2::ErrorCode::SUCCEEDED;
+    };
+    child->nextFunc = [&rows, offset]() -> IndexNode::Result {
+      if (*offset < rows.size()) {
+        auto row = rows[(*offset)++];
+        return IndexNode::Result(std::move(row));
+      } else {
+        return IndexNode::Result();
+      }
+    };
+    child->initFunc = [](InitContext& initCtx) -> ::nebula::cpp2::ErrorCode {
+      initCtx.returnColumns = {"a", "b"};
+      initCtx.retColMap = {{"a", 0}, {"b", 1}};
+      return ::nebula::cpp2::ErrorCode::SUCCEEDED;
+    };
+    return child;
+  };
+  auto makeStat = [](const std::string& alias, const std::string& prop, cpp2::StatType type) {
+    cpp2::StatProp stat;
+    stat.set_alias(alias);
+    stat.set_prop(prop);
+    stat.set_stat(type);
+    return stat;
+  };
+  std::vector<cpp2::StatProp> stats = {makeStat("count", "", cpp2::StatType::COUNT),
+                                       makeStat("count_b", "b", cpp2::StatType::COUNT),
+                                       makeStat("sum", "b", cpp2::StatType::SUM),
+                                       makeStat("min", "b", cpp2::StatType::MIN),
+                                       makeStat("max", "b", cpp2::StatType::MAX)};
+  auto ctx = makeContext();
+  {
+    size_t offset = 0;
+    auto aggregate =
+        std::make_unique<IndexAggregateNode>(ctx.get(), std::vector<std::string>{"a"}, stats);
+    aggregate->addChild(makeChild(ctx.get(), &offset));
+    auto result = collectResult(aggregate.get());
+    std::sort(result.begin(), result.end());
+    auto expect = R"(
+      int | int | int | int | int | int
+      1   | 3   | 2   | 9   | 2   | 7
+      2   | 2   | 2   | 8   | 3   | 5
+    )"_row;
+    ASSERT_EQ(result, expect);
+  }
+  {
+    size_t offset = 0;
+    auto aggregate =
+        std::make_unique<IndexAggregateNode>(ctx.get(), std::vector<std::string>{}, stats);
+    aggregate->addChild(makeChild(ctx.get(), &offset));
+    auto expect = R"(
+      int | int | int | int | int
+      5   | 4   | 17  | 2   | 7
+    )"_row;
+    ASSERT_EQ(collectResult(aggregate.get()), expect);
+  }
+  {
+    // The stats are returned for an empty part if not grouped
+    auto aggregate =
+        std::make_unique<IndexAggregateNode>(ctx.get(), std::vector<std::string>{}, stats);
+    auto child = std::make_unique<MockIndexNode>(ctx.get());
+    child->nextFunc = []() -> IndexNode::Result { return IndexNode::Result(); };
+    child->initFunc = [](InitContext& initCtx) -> ::nebula::cpp2::ErrorCode {
+      initCtx.returnColumns = {"a", "b"};
+      initCtx.retColMap = {{"a", 0}, {"b", 1}};
+      return ::nebula::cpp2::ErrorCode::SUCCEEDED;
+    };
+    aggregate->addChild(std::move(child));
+    auto expect = R"(
+      int | int | int | int    | int
+      0   | 0   | 0   | <null> | <null>
+    )"_row;
+    ASSERT_EQ(collectResult(aggregate.get()), expect);
+  }
+}
 }  // namespace storage
 }  // namespace nebula
 int main(int argc, char** argv) {
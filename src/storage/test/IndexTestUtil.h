@@ -25,18 +25,22 @@ class MockKVIterator : public KVIterator {
   using KVMap = std::map<std::string, std::string>;
 
  public:
-  MockKVIterator(const KVMap& kv, KVMap::iterator&& iter) : kv_(kv), iter_(std::move(iter)) {}
+  MockKVIterator(KVMap& kv, KVMap::iterator&& iter) : kv_(kv), iter_(std::move(iter)) {}
   bool valid() const { return iter_ != kv_.end() && validFunc_(iter_); }
   void next() { iter_++; }
   void prev() { iter_--; }
   folly::StringPiece key() const { return folly::StringPiece(iter_->first); }
   folly::StringPiece val() const { return folly::StringPiece(iter_->second); }
+  bool seek(folly::StringPiece target) {
+    iter_ = kv_.lower_bound(target.str());
+    return true;
+  }
   void setValidFunc(const std::function<bool(const KVMap::iterator& iter)> validFunc) {
     validFunc_ = validFunc;
   }
 
  private:
-  const KVMap& kv_;
+  KVMap& kv_;
   KVMap::iterator iter_;
   std::function<bool(const KVMap::iterator& iter)> validFunc_;
 };
@@ -170,10 +174,12 @@ class MockKVStore : public ::nebula::kvstore::KVStore {
                                           const std::string& start,
                                           const std::string& prefix,
                                           std::unique_ptr<KVIterator>* iter,
-                                          bool canReadFromFollower = false) override {
+                                          bool canReadFromFollower = false,
+                                          const void* snapshot = nullptr) override {
     UNUSED(canReadFromFollower);
     UNUSED(spaceId);
     UNUSED(partId);
+    UNUSED(snapshot);
     CHECK_EQ(spaceId, spaceId_);
     auto mockIter = std::make_unique<MockKVIterator>(kv_, kv_.lower_bound(start));
     mockIter->setValidFunc([prefix](const decltype(kv_)::iterator& it) {
@@ -191,6 +197,20 @@ class MockKVStore : public ::nebula::kvstore::KVStore {
     return ::nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
+  ErrorOr<nebula::cpp2::ErrorCode, const void*> getSnapshot(
+      GraphSpaceID spaceId, PartitionID partId, bool canReadFromFollower = false) override {
+    UNUSED(spaceId);
+    UNUSED(partId);
+    UNUSED(canReadFromFollower);
+    return static_cast<const void*>(nullptr);
+  }
+
+  void releaseSnapshot(GraphSpaceID spaceId, PartitionID partId, const void* snapshot) override {
+    UNUSED(spaceId);
+    UNUSED(partId);
+    UNUSED(snapshot);
+  }
+
   nebula::cpp2::ErrorCode sync(GraphSpaceID spaceId, PartitionID partId) override {
     UNUSED(spaceId);
     UNUSED(partId);
@@ -3,10 +3,12 @@
  * This source code is licensed under Apache 2.0 License.
  */
 
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 
 #include "common/base/Base.h"
 #include "common/fs/TempDir.h"
+#include "common/time/WallClock.h"
 #include "storage/query/ScanEdgeProcessor.h"
 #include "storage/test/QueryTestUtils.h"
 
@@ -193,6 +195,120 @@ TEST(ScanEdgeTest, CursorTest) {
   }
 }
 
+TEST(ScanEdgeTest, FilterTest) {
+  fs::TempDir rootPath("/tmp/ScanEdgeTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  ObjectPool objPool;
+  auto* pool = &objPool;
+
+  EdgeType serve = 101;
+  auto edge = std::make_pair(
+      serve, std::vector<std::string>{kSrc, kType, kRank, kDst, "teamName", "startYear"});
+
+  LOG(INFO) << "Scan one edge with filter";
+  // where serve.startYear > 2010
+  const auto& exp = *RelationalExpression::makeGT(
+      pool,
+      EdgePropertyExpression::make(pool, folly::to<std::string>(serve), "startYear"),
+      ConstantExpression::make(pool, Value(2010)));
+  size_t totalRowCount = 0;
+  for (PartitionID partId = 1; partId <= totalParts; partId++) {
+    auto req = buildRequest(partId, "", edge);
+    req.set_filter(Expression::encode(exp));
+    auto* processor = ScanEdgeProcessor::instance(env, nullptr);
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+
+    ASSERT_EQ(0, resp.result.failed_parts.size());
+    checkResponse(*resp.edge_data_ref(), edge, edge.second.size(), totalRowCount);
+    for (const auto& row : resp.edge_data_ref()->rows) {
+      ASSERT_GT(row.values[5].getInt(), 2010);
+    }
+  }
+  auto expected = std::count_if(mock::MockData::serves_.begin(),
+                                mock::MockData::serves_.end(),
+                                [](const auto& s) { return s.startYear_ > 2010; });
+  CHECK_EQ(expected, totalRowCount);
+}
+
+TEST(ScanEdgeTest, TimeRangeTest) {
+  fs::TempDir rootPath("/tmp/ScanEdgeTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  auto before = time::WallClock::fastNowInMicroSec();
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  auto after = time::WallClock::fastNowInMicroSec() + 1;
+
+  EdgeType serve = 101;
+  auto edge = std::make_pair(
+      serve, std::vector<std::string>{kSrc, kType, kRank, kDst, "teamName", "startYear"});
+  auto scan = [&](int64_t startTime, int64_t endTime) {
+    size_t totalRowCount = 0;
+    for (PartitionID partId = 1; partId <= totalParts; partId++) {
+      auto req = buildRequest(partId, "", edge, 100, startTime, endTime);
+      auto* processor = ScanEdgeProcessor::instance(env, nullptr);
+      auto f = processor->getFuture();
+      processor->process(req);
+      auto resp = std::move(f).get();
+
+      EXPECT_EQ(0, resp.result.failed_parts.size());
+      checkResponse(*resp.edge_data_ref(), edge, edge.second.size(), totalRowCount);
+    }
+    return totalRowCount;
+  };
+  EXPECT_EQ(mock::MockData::serves_.size(), scan(before, after));
+  EXPECT_EQ(0, scan(0, before));
+  EXPECT_EQ(0, scan(after, std::numeric_limits<int64_t>::max()));
+}
+
+TEST(ScanEdgeTest, MultiPartsTest) {
+  FLAGS_query_concurrently = true;
+  fs::TempDir rootPath("/tmp/ScanEdgeTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+
+  EdgeType serve = 101;
+  auto edge = std::make_pair(
+      serve, std::vector<std::string>{kSrc, kType, kRank, kDst, "teamName", "startYear"});
+  std::unordered_map<PartitionID, cpp2::ScanCursor> cursors;
+  for (PartitionID partId = 1; partId <= totalParts; partId++) {
+    cursors.emplace(partId, cpp2::ScanCursor());
+  }
+  size_t totalRowCount = 0;
+  while (!cursors.empty()) {
+    auto req = buildRequest(0, "", edge, 5);
+    req.set_parts(cursors);
+    req.set_use_snapshot(true);
+    auto* processor = ScanEdgeProcessor::instance(env, nullptr, threadPool.get());
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+
+    ASSERT_EQ(0, resp.result.failed_parts.size());
+    checkResponse(*resp.edge_data_ref(), edge, edge.second.size(), totalRowCount);
+    cursors.clear();
+    for (const auto& [partId, cursor] : *resp.cursors_ref()) {
+      if (cursor.get_has_next()) {
+        cursors.emplace(partId, cursor);
+      }
+    }
+  }
+  CHECK_EQ(mock::MockData::serves_.size(), totalRowCount);
+  ASSERT_EQ(0, cluster.scanSnapshots_->size());
+  FLAGS_query_concurrently = false;
+}
+
 }  // namespace storage
 }  // namespace nebula
 
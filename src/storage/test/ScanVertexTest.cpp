@@ -3,10 +3,13 @@
  * This source code is licensed under Apache 2.0 License.
  */
 
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 
 #include "common/base/Base.h"
 #include "common/fs/TempDir.h"
+#include "common/time/WallClock.h"
+#include "common/utils/NebulaKeyUtils.h"
 #include "storage/query/ScanVertexProcessor.h"
 #include "storage/test/QueryTestUtils.h"
 
@@ -190,6 +193,212 @@ TEST(ScanVertexTest, CursorTest) {
   }
 }
 
+TEST(ScanVertexTest, FilterTest) {
+  fs::TempDir rootPath("/tmp/ScanVertexTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ObjectPool objPool;
+  auto* pool = &objPool;
+
+  TagID player = 1;
+  auto tag = std::make_pair(player, std::vector<std::string>{kVid, "name", "age", "avgScore"});
+
+  {
+    LOG(INFO) << "Scan one tag with filter";
+    // where player.age > 30
+    const auto& exp = *RelationalExpression::makeGT(
+        pool,
+        TagPropertyExpression::make(pool, folly::to<std::string>(player), "age"),
+        ConstantExpression::make(pool, Value(30)));
+    size_t totalRowCount = 0;
+    for (PartitionID partId = 1; partId <= totalParts; partId++) {
+      auto req = buildRequest(partId, "", tag);
+      req.set_filter(Expression::encode(exp));
+      auto* processor = ScanVertexProcessor::instance(env, nullptr);
+      auto f = processor->getFuture();
+      processor->process(req);
+      auto resp = std::move(f).get();
+
+      ASSERT_EQ(0, resp.result.failed_parts.size());
+      checkResponse(*resp.vertex_data_ref(), tag, tag.second.size(), totalRowCount);
+      for (const auto& row : resp.vertex_data_ref()->rows) {
+        ASSERT_GT(row.values[2].getInt(), 30);
+      }
+    }
+    auto expected = std::count_if(mock::MockData::players_.begin(),
+                                  mock::MockData::players_.end(),
+                                  [](const auto& p) { return p.age_ > 30; });
+    CHECK_EQ(expected, totalRowCount);
+  }
+  {
+    LOG(INFO) << "Scan one tag with filter on another tag";
+    // where 2.name == "Spurs"
+    const auto& exp = *RelationalExpression::makeEQ(
+        pool,
+        TagPropertyExpression::make(pool, "2", "name"),
+        ConstantExpression::make(pool, Value("Spurs")));
+    auto req = buildRequest(1, "", tag);
+    req.set_filter(Expression::encode(exp));
+    auto* processor = ScanVertexProcessor::instance(env, nullptr);
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+    ASSERT_EQ(1, resp.result.failed_parts.size());
+    ASSERT_EQ(nebula::cpp2::ErrorCode::E_INVALID_FILTER, resp.result.failed_parts[0].get_code());
+  }
+}
+
+TEST(ScanVertexTest, TimeRangeTest) {
+  fs::TempDir rootPath("/tmp/ScanVertexTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  auto before = time::WallClock::fastNowInMicroSec();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  auto after = time::WallClock::fastNowInMicroSec() + 1;
+
+  TagID player = 1;
+  auto tag = std::make_pair(player, std::vector<std::string>{kVid, "name", "age", "avgScore"});
+  auto scan = [&](int64_t startTime, int64_t endTime) {
+    size_t totalRowCount = 0;
+    for (PartitionID partId = 1; partId <= totalParts; partId++) {
+      auto req = buildRequest(partId, "", tag, 100, startTime, endTime);
+      auto* processor = ScanVertexProcessor::instance(env, nullptr);
+      auto f = processor->getFuture();
+      processor->process(req);
+      auto resp = std::move(f).get();
+
+      EXPECT_EQ(0, resp.result.failed_parts.size());
+      checkResponse(*resp.vertex_data_ref(), tag, tag.second.size(), totalRowCount);
+    }
+    return totalRowCount;
+  };
+  EXPECT_EQ(mock::MockData::players_.size(), scan(before, after));
+  EXPECT_EQ(0, scan(0, before));
+  EXPECT_EQ(0, scan(after, std::numeric_limits<int64_t>::max()));
+}
+
+TEST(ScanVertexTest, MultiPartsTest) {
+  fs::TempDir rootPath("/tmp/ScanVertexTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+
+  TagID player = 1;
+  auto tag = std::make_pair(player, std::vector<std::string>{kVid, "name", "age", "avgScore"});
+  auto scan = [&](const std::unordered_map<PartitionID, cpp2::ScanCursor>& parts,
+                  bool useSnapshot) {
+    auto req = buildRequest(0, "", tag, 5);
+    req.set_parts(parts);
+    req.set_use_snapshot(useSnapshot);
+    auto* processor = ScanVertexProcessor::instance(env, nullptr, threadPool.get());
+    auto f = processor->getFuture();
+    processor->process(req);
+    return std::move(f).get();
+  };
+
+  std::unordered_map<PartitionID, cpp2::ScanCursor> parts;
+  for (PartitionID partId = 1; partId <= totalParts; partId++) {
+    parts.emplace(partId, cpp2::ScanCursor());
+  }
+
+  {
+    LOG(INFO) << "Scan all parts in parallel in batches";
+    FLAGS_query_concurrently = true;
+    size_t totalRowCount = 0;
+    auto cursors = parts;
+    while (!cursors.empty()) {
+      auto resp = scan(cursors, false);
+      ASSERT_EQ(0, resp.result.failed_parts.size());
+      checkResponse(*resp.vertex_data_ref(), tag, tag.second.size(), totalRowCount);
+      ASSERT_TRUE(resp.cursors_ref().has_value());
+      ASSERT_EQ(cursors.size(), resp.cursors_ref()->size());
+      cursors.clear();
+      for (const auto& [partId, cursor] : *resp.cursors_ref()) {
+        if (cursor.get_has_next()) {
+          cursors.emplace(partId, cursor);
+        }
+      }
+    }
+    CHECK_EQ(mock::MockData::players_.size(), totalRowCount);
+    FLAGS_query_concurrently = false;
+  }
+  {
+    LOG(INFO) << "Scan all parts from the snapshots while they are cleared";
+    size_t totalRowCount = 0;
+    auto resp = scan(parts, true);
+    ASSERT_EQ(0, resp.result.failed_parts.size());
+    checkResponse(*resp.vertex_data_ref(), tag, tag.second.size(), totalRowCount);
+    std::unordered_map<PartitionID, cpp2::ScanCursor> cursors;
+    for (const auto& [partId, cursor] : *resp.cursors_ref()) {
+      if (cursor.get_has_next()) {
+        ASSERT_TRUE(cursor.snapshot_id_ref().has_value());
+        cursors.emplace(partId, cursor);
+      }
+    }
+    ASSERT_EQ(cursors.size(), cluster.scanSnapshots_->size());
+
+    // Remove all the vertices
+    for (PartitionID partId = 1; partId <= totalParts; partId++) {
+      auto prefix = NebulaKeyUtils::vertexPrefix(partId);
+      std::unique_ptr<kvstore::KVIterator> iter;
+      ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+                env->kvstore_->prefix(1, partId, prefix, &iter));
+      std::vector<std::string> keys;
+      for (; iter->valid(); iter->next()) {
+        keys.emplace_back(iter->key().str());
+      }
+      folly::Baton<true, std::atomic> baton;
+      env->kvstore_->asyncMultiRemove(
+          1, partId, std::move(keys), [&](nebula::cpp2::ErrorCode code) {
+            EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, code);
+            baton.post();
+          });
+      baton.wait();
+    }
+
+    while (!cursors.empty()) {
+      resp = scan(cursors, true);
+      ASSERT_EQ(0, resp.result.failed_parts.size());
+      checkResponse(*resp.vertex_data_ref(), tag, tag.second.size(), totalRowCount);
+      cursors.clear();
+      for (const auto& [partId, cursor] : *resp.cursors_ref()) {
+        if (cursor.get_has_next()) {
+          cursors.emplace(partId, cursor);
+        }
+      }
+    }
+    CHECK_EQ(mock::MockData::players_.size(), totalRowCount);
+    // Released when the parts are scanned to the end
+    ASSERT_EQ(0, cluster.scanSnapshots_->size());
+
+    totalRowCount = 0;
+    resp = scan(parts, false);
+    checkResponse(*resp.vertex_data_ref(), tag, tag.second.size(), totalRowCount);
+    ASSERT_EQ(0, totalRowCount);
+  }
+  {
+    LOG(INFO) << "Scan from an expired snapshot";
+    std::unordered_map<PartitionID, cpp2::ScanCursor> cursors;
+    cpp2::ScanCursor cursor;
+    cursor.set_has_next(true);
+    cursor.set_next_cursor(NebulaKeyUtils::vertexPrefix(1));
+    cursor.set_snapshot_id(-1);
+    cursors.emplace(1, std::move(cursor));
+    auto resp = scan(cursors, true);
+    ASSERT_EQ(1, resp.result.failed_parts.size());
+    ASSERT_EQ(nebula::cpp2::ErrorCode::E_SCAN_SNAPSHOT_EXPIRED,
+              resp.result.failed_parts[0].get_code());
+  }
+}
+
 }  // namespace storage
 }  // namespace nebula
 
@@ -0,0 +1,641 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "tools/sst-generator/SstGenerator.h"
+
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
+#include <rocksdb/sst_file_reader.h>
+#include <rocksdb/sst_file_writer.h>
+#include <thrift/lib/cpp/util/EnumUtils.h>
+
+#include <fstream>
+#include <queue>
+
+#include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
+#include "common/fs/FileUtils.h"
+#include "common/geo/io/wkt/WKTReader.h"
+#include "common/time/Duration.h"
+#include "common/time/TimeUtils.h"
+#include "common/utils/IndexKeyUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/RocksEngineConfig.h"
+#include "storage/CommonUtils.h"
+
+DEFINE_string(meta_server, "127.0.0.1:45500", "Meta servers' address.");
+DEFINE_string(space_name, "", "The space name.");
+DEFINE_string(tag, "", "The tag of the vertices in the files.");
+DEFINE_string(edge, "", "The edge of the edges in the files.");
+DEFINE_string(files, "", "A list of csv files seperated by comma.");
+DEFINE_string(columns,
+              "",
+              "A list of properties of the columns after the vid, or the src, dst and rank, "
+              "seperated by comma. All the properties of the schema in order if not given.");
+DEFINE_string(delimiter, ",", "The delimiter of the csv files.");
+DEFINE_bool(header, false, "Whether the first line of each file is a header to skip.");
+DEFINE_bool(with_rank, false, "Whether the edge rank follows the dst in the files.");
+DEFINE_string(output_path, "./sst", "The directory to write the SST files of the parts.");
+DEFINE_uint32(sort_buffer_mb,
+              256,
+              "The keys buffered by a thread before sorted and spilled as a run, in MB.");
+DEFINE_uint32(num_threads, 8, "The number of threads reading the files and merging the parts.");
+DEFINE_bool(skip_bad_rows, false, "Skip the rows failed to be encoded instead of giving up.");
+
+namespace nebula {
+namespace storage {
+
+// The overhead of a buffered key besides its data
+static constexpr size_t kKeyOverhead = 2 * sizeof(std::string);
+
+Status SstGenerator::init() {
+  auto status = initMeta();
+  if (!status.ok()) {
+    return status;
+  }
+
+  status = initSchema();
+  if (!status.ok()) {
+    return status;
+  }
+
+  status = initParams();
+  if (!status.ok()) {
+    return status;
+  }
+  return Status::OK();
+}
+
+Status SstGenerator::initMeta() {
+  auto addrs = network::NetworkUtils::toHosts(FLAGS_meta_server);
+  if (!addrs.ok()) {
+    return addrs.status();
+  }
+
+  auto ioExecutor = std::make_shared<folly::IOThreadPoolExecutor>(1);
+  meta::MetaClientOptions options;
+  options.skipConfig_ = true;
+  metaClient_ = std::make_unique<meta::MetaClient>(ioExecutor, std::move(addrs.value()), options);
+  if (!metaClient_->waitForMetadReady(1)) {
+    return Status::Error("Meta is not ready: '%s'.", FLAGS_meta_server.c_str());
+  }
+  schemaMng_ = std::make_unique<meta::ServerBasedSchemaManager>();
+  schemaMng_->init(metaClient_.get());
+  return Status::OK();
+}
+
+Status SstGenerator::initSchema() {
+  if (FLAGS_space_name.empty()) {
+    return Status::Error("Space name is not given.");
+  }
+  auto space = schemaMng_->toGraphSpaceID(FLAGS_space_name);
+  if (!space.ok()) {
+    return Status::Error("Space '%s' not found in meta server.", FLAGS_space_name.c_str());
+  }
+  spaceId_ = space.value();
+
+  auto spaceVidLen = metaClient_->getSpaceVidLen(spaceId_);
+  if (!spaceVidLen.ok()) {
+    return spaceVidLen.status();
+  }
+  spaceVidLen_ = spaceVidLen.value();
+
+  auto vidTypeStatus = metaClient_->getSpaceVidType(spaceId_);
+  if (!vidTypeStatus) {
+    return vidTypeStatus.status();
+  }
+  spaceVidType_ = std::move(vidTypeStatus).value();
+
+  auto partNum = metaClient_->partsNum(spaceId_);
+  if (!partNum.ok()) {
+    return Status::Error("Get partition number from '%s' failed.", FLAGS_space_name.c_str());
+  }
+  partNum_ = partNum.value();
+
+  if (FLAGS_tag.empty() == FLAGS_edge.empty()) {
+    return Status::Error("Either a tag or an edge must be given.");
+  }
+  isEdge_ = !FLAGS_edge.empty();
+  if (isEdge_) {
+    auto edgeType = schemaMng_->toEdgeType(spaceId_, FLAGS_edge);
+    if (!edgeType.ok()) {
+      return Status::Error("Edge '%s' not found in meta.", FLAGS_edge.c_str());
+    }
+    schemaId_ = edgeType.value();
+    schema_ = schemaMng_->getEdgeSchema(spaceId_, schemaId_);
+  } else {
+    auto tagId = schemaMng_->toTagID(spaceId_, FLAGS_tag);
+    if (!tagId.ok()) {
+      return Status::Error("Tag '%s' not found in meta.", FLAGS_tag.c_str());
+    }
+    schemaId_ = tagId.value();
+    schema_ = schemaMng_->getTagSchema(spaceId_, schemaId_);
+  }
+  if (schema_ == nullptr) {
+    return Status::Error("Schema of '%s' not found.", (FLAGS_tag + FLAGS_edge).c_str());
+  }
+
+  auto indexes = isEdge_ ? metaClient_->getEdgeIndexesFromCache(spaceId_)
+                         : metaClient_->getTagIndexesFromCache(spaceId_);
+  if (!indexes.ok()) {
+    return indexes.status();
+  }
+  for (auto& index : indexes.value()) {
+    auto& schemaId = index->get_schema_id();
+    if ((isEdge_ && schemaId.getType() == nebula::cpp2::SchemaID::Type::edge_type &&
+         schemaId.get_edge_type() == schemaId_) ||
+        (!isEdge_ && schemaId.getType() == nebula::cpp2::SchemaID::Type::tag_id &&
+         schemaId.get_tag_id() == schemaId_)) {
+      indexes_.emplace_back(index);
+    }
+  }
+
+  auto status = kvstore::initRocksdbOptions(options_, spaceId_, spaceVidLen_);
+  if (!status.ok()) {
+    return Status::Error("Init rocksdb options failed: %s", status.ToString().c_str());
+  }
+  return Status::OK();
+}
+
+Status SstGenerator::initParams() {
+  try {
+    folly::splitTo<std::string>(',', FLAGS_files, std::back_inserter(files_), true);
+    folly::splitTo<std::string>(',', FLAGS_columns, std::back_inserter(propNames_), true);
+  } catch (const std::exception& e) {
+    return Status::Error("Parse files/columns error: %s", e.what());
+  }
+  if (files_.empty()) {
+    return Status::Error("No file is given.");
+  }
+  for (auto& file : files_) {
+    if (fs::FileUtils::fileType(file.c_str()) != fs::FileType::REGULAR) {
+      return Status::Error("File '%s' not exists.", file.c_str());
+    }
+  }
+
+  if (propNames_.empty()) {
+    for (size_t i = 0; i < schema_->getNumFields(); i++) {
+      propNames_.emplace_back(schema_->getFieldName(i));
+    }
+  }
+  for (auto& name : propNames_) {
+    if (schema_->getFieldIndex(name) < 0) {
+      return Status::Error("Property '%s' not found in the schema.", name.c_str());
+    }
+    propTypes_.emplace_back(schema_->getFieldType(name));
+  }
+  keyColumns_ = isEdge_ ? (FLAGS_with_rank ? 3 : 2) : 1;
+
+  if (FLAGS_delimiter.size() != 1) {
+    return Status::Error("The delimiter must be one character.");
+  }
+  delimiter_ = FLAGS_delimiter[0];
+
+  if (FLAGS_num_threads == 0 || FLAGS_sort_buffer_mb == 0) {
+    return Status::Error("Both the num_threads and the sort_buffer_mb must be positive.");
+  }
+  tmpPath_ = fs::FileUtils::joinPath(FLAGS_output_path, "tmp");
+  if (!fs::FileUtils::makeDir(tmpPath_)) {
+    return Status::Error("Make directory '%s' failed.", tmpPath_.c_str());
+  }
+  pool_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+      FLAGS_num_threads, std::make_shared<folly::NamedThreadFactory>("sst-generator"));
+  return Status::OK();
+}
+
+Status SstGenerator::run() {
+  time::Duration dur;
+  // Step 1, read the files and spill the sorted runs by part
+  std::atomic<size_t> next{0};
+  std::vector<folly::Future<Status>> futures;
+  for (size_t i = 0; i < std::min<size_t>(FLAGS_num_threads, files_.size()); i++) {
+    futures.emplace_back(folly::via(pool_.get(), [this, &next] {
+      Buffer buffer;
+      size_t index;
+      while ((index = next++) < files_.size()) {
+        auto status = readFile(files_[index], &buffer);
+        if (!status.ok()) {
+          return status;
+        }
+      }
+      return spill(&buffer);
+    }));
+  }
+  for (auto& status : folly::collectAll(futures).get()) {
+    if (!status.value().ok()) {
+      return status.value();
+    }
+  }
+  LOG(INFO) << "Read " << rows_ << " rows, skipped " << badRows_ << " bad rows, spilled "
+            << runSeq_ << " runs in " << dur.elapsedInSec() << " seconds";
+
+  // Step 2, merge the runs of each part
+  futures.clear();
+  for (auto& entry : runs_) {
+    futures.emplace_back(folly::via(
+        pool_.get(), [this, partId = entry.first, runs = std::move(entry.second)]() mutable {
+          return merge(partId, std::move(runs));
+        }));
+  }
+  for (auto& status : folly::collectAll(futures).get()) {
+    if (!status.value().ok()) {
+      return status.value();
+    }
+  }
+  fs::FileUtils::remove(tmpPath_.c_str(), true);
+  LOG(INFO) << "Generated the SST files of " << runs_.size() << " parts in " << dur.elapsedInSec()
+            << " seconds";
+  return Status::OK();
+}
+
+Status SstGenerator::readFile(const std::string& file, Buffer* buffer) {
+  std::ifstream in(file);
+  if (!in.is_open()) {
+    return Status::Error("Open file '%s' failed.", file.c_str());
+  }
+  LOG(INFO) << "Reading " << file;
+  std::string line;
+  std::vector<std::string> fields;
+  size_t lineNo = 0;
+  while (std::getline(in, line)) {
+    ++lineNo;
+    if ((lineNo == 1 && FLAGS_header) || line.empty()) {
+      continue;
+    }
+    auto status = Status::OK();
+    if (!splitLine(line, delimiter_, &fields)) {
+      status = Status::Error("Unclosed quote");
+    } else if (fields.size() != keyColumns_ + propNames_.size()) {
+      status = Status::Error(
+          "Expect %lu columns, got %lu", keyColumns_ + propNames_.size(), fields.size());
+    } else {
+      status = encodeRow(fields, buffer);
+    }
+    if (!status.ok()) {
+      auto msg = folly::stringPrintf("%s:%lu, %s", file.c_str(), lineNo, status.toString().c_str());
+      if (!FLAGS_skip_bad_rows) {
+        return Status::Error("%s", msg.c_str());
+      }
+      LOG(WARNING) << "Skip the bad row " << msg;
+      ++badRows_;
+      continue;
+    }
+    ++rows_;
+    if (buffer->bytes >= FLAGS_sort_buffer_mb * 1024UL * 1024UL) {
+      status = spill(buffer);
+      if (!status.ok()) {
+        return status;
+      }
+    }
+  }
+  if (in.bad()) {
+    return Status::Error("Read file '%s' failed.", file.c_str());
+  }
+  return Status::OK();
+}
+
+// static
+bool SstGenerator::splitLine(folly::StringPiece line,
+                             char delimiter,
+                             std::vector<std::string>* fields) {
+  fields->clear();
+  if (!line.empty() && line.back() == '\r') {
+    line.pop_back();
+  }
+  std::string field;
+  bool quoted = false;
+  for (size_t i = 0; i < line.size(); i++) {
+    auto c = line[i];
+    if (quoted) {
+      if (c != '"') {
+        field += c;
+      } else if (i + 1 < line.size() && line[i + 1] == '"') {
+        field += '"';
+        ++i;
+      } else {
+        quoted = false;
+      }
+    } else if (c == '"') {
+      quoted = true;
+    } else if (c == delimiter) {
+      fields->emplace_back(std::move(field));
+      field.clear();
+    } else {
+      field += c;
+    }
+  }
+  fields->emplace_back(std::move(field));
+  return !quoted;
+}
+
+Status SstGenerator::encodeRow(const std::vector<std::string>& fields, Buffer* buffer) {
+  // The vid, or the src and dst
+  auto src = toVid(fields[0]);
+  if (!src.ok()) {
+    return src.status();
+  }
+  VertexID dst;
+  EdgeRanking rank = 0;
+  if (isEdge_) {
+    auto ret = toVid(fields[1]);
+    if (!ret.ok()) {
+      return ret.status();
+    }
+    dst = std::move(ret).value();
+    if (keyColumns_ == 3) {
+      auto r = folly::tryTo<EdgeRanking>(fields[2]);
+      if (!r.hasValue()) {
+        return Status::Error("Invalid rank '%s'", fields[2].c_str());
+      }
+      rank = r.value();
+    }
+  }
+  auto srcPart = metaClient_->partId(partNum_, src.value());
+
+  RowWriterV2 writer(schema_.get());
+  for (size_t i = 0; i < propNames_.size(); i++) {
+    auto& field = fields[keyColumns_ + i];
+    // Leave the empty ones to the default value or null
+    if (field.empty()) {
+      continue;
+    }
+    auto value = toValue(field, propTypes_[i]);
+    if (!value.ok()) {
+      return value.status();
+    }
+    auto ret = writer.setValue(propNames_[i], value.value());
+    if (ret != WriteResult::SUCCEEDED) {
+      return Status::Error(
+          "Set property '%s' failed, error %d", propNames_[i].c_str(), static_cast<int32_t>(ret));
+    }
+  }
+  auto ret = writer.finish();
+  if (ret != WriteResult::SUCCEEDED) {
+    return Status::Error("Encode row failed, error %d", static_cast<int32_t>(ret));
+  }
+  auto val = writer.moveEncodedStr();
+
+  // The index keys are in the part of the vid, or the src
+  if (!indexes_.empty()) {
+    auto reader = RowReaderWrapper::getRowReader(schema_.get(), val);
+    auto ttl = CommonUtils::ttlValue(schema_.get(), reader.get());
+    auto indexVal = ttl.ok() ? IndexKeyUtils::indexVal(std::move(ttl).value()) : "";
+    for (auto& index : indexes_) {
+      auto values = IndexKeyUtils::collectIndexValues(reader.get(), index->get_fields());
+      if (!values.ok()) {
+        continue;
+      }
+      auto keys = isEdge_ ? IndexKeyUtils::edgeIndexKeys(spaceVidLen_,
+                                                          srcPart,
+                                                          index->get_index_id(),
+                                                          src.value(),
+                                                          rank,
+                                                          dst,
+                                                          std::move(values).value())
+                          : IndexKeyUtils::vertexIndexKeys(spaceVidLen_,
+                                                           srcPart,
+                                                           index->get_index_id(),
+                                                           src.value(),
+                                                           std::move(values).value());
+      for (auto& key : keys) {
+        add(srcPart, std::move(key), indexVal, buffer);
+      }
+    }
+  }
+
+  if (isEdge_) {
+    // The out edge in the part of the src, and the in edge in the one of the dst
+    auto dstPart = metaClient_->partId(partNum_, dst);
+    add(srcPart,
+        NebulaKeyUtils::edgeKey(spaceVidLen_, srcPart, src.value(), schemaId_, rank, dst),
+        val,
+        buffer);
+    add(dstPart,
+        NebulaKeyUtils::edgeKey(spaceVidLen_, dstPart, dst, -schemaId_, rank, src.value()),
+        std::move(val),
+        buffer);
+  } else {
+    add(srcPart,
+        NebulaKeyUtils::vertexKey(spaceVidLen_, srcPart, src.value(), schemaId_),
+        std::move(val),
+        buffer);
+  }
+  return Status::OK();
+}
+
+StatusOr<VertexID> SstGenerator::toVid(const std::string& field) const {
+  VertexID vid;
+  if (spaceVidType_ == nebula::cpp2::PropertyType::INT64) {
+    auto intVid = folly::tryTo<int64_t>(field);
+    if (!intVid.hasValue()) {
+      return Status::Error("Invalid vid '%s'", field.c_str());
+    }
+    vid.assign(reinterpret_cast<const char*>(&intVid.value()), sizeof(int64_t));
+  } else {
+    vid = field;
+  }
+  if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, vid)) {
+    return Status::Error("Invalid vid length '%s'", field.c_str());
+  }
+  return vid;
+}
+
+StatusOr<Value> SstGenerator::toValue(const std::string& field,
+                                      nebula::cpp2::PropertyType type) const {
+  switch (type) {
+    case nebula::cpp2::PropertyType::BOOL: {
+      auto v = folly::tryTo<bool>(field);
+      if (v.hasValue()) {
+        return Value(v.value());
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::INT8:
+    case nebula::cpp2::PropertyType::INT16:
+    case nebula::cpp2::PropertyType::INT32:
+    case nebula::cpp2::PropertyType::INT64: {
+      auto v = folly::tryTo<int64_t>(field);
+      if (v.hasValue()) {
+        return Value(v.value());
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::TIMESTAMP: {
+      auto v = folly::tryTo<int64_t>(field);
+      if (v.hasValue()) {
+        return Value(v.value());
+      }
+      auto ts = time::TimeUtils::toTimestamp(Value(field));
+      if (ts.ok()) {
+        return std::move(ts).value();
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::FLOAT:
+    case nebula::cpp2::PropertyType::DOUBLE: {
+      auto v = folly::tryTo<double>(field);
+      if (v.hasValue()) {
+        return Value(v.value());
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::STRING:
+    case nebula::cpp2::PropertyType::FIXED_STRING: {
+      return Value(field);
+    }
+    case nebula::cpp2::PropertyType::DATE: {
+      auto v = time::TimeUtils::parseDate(field);
+      if (v.ok()) {
+        return Value(std::move(v).value());
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::TIME: {
+      auto v = time::TimeUtils::parseTime(field);
+      if (v.ok()) {
+        return Value(time::TimeUtils::timeToUTC(v.value()));
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::DATETIME: {
+      auto v = time::TimeUtils::parseDateTime(field);
+      if (v.ok()) {
+        return Value(time::TimeUtils::dateTimeToUTC(v.value()));
+      }
+      break;
+    }
+    case nebula::cpp2::PropertyType::GEOGRAPHY: {
+      geo::WKTReader reader;
+      auto v = reader.read(field);
+      if (v.ok()) {
+        return Value(std::move(v).value());
+      }
+      break;
+    }
+    default:
+      return Status::Error("Unsupported property type %s",
+                           apache::thrift::util::enumNameSafe(type).c_str());
+  }
+  return Status::Error("Invalid value '%s' of type %s",
+                       field.c_str(),
+                       apache::thrift::util::enumNameSafe(type).c_str());
+}
+
+void SstGenerator::add(PartitionID partId, std::string key, std::string val, Buffer* buffer) {
+  buffer->bytes += key.size() + val.size() + kKeyOverhead;
+  buffer->parts[partId].emplace_back(std::move(key), std::move(val));
+}
+
+Status SstGenerator::spill(Buffer* buffer) {
+  rocksdb::Options options;
+  options.compression = rocksdb::kNoCompression;
+  for (auto& entry : buffer->parts) {
+    auto& kvs = entry.second;
+    if (kvs.empty()) {
+      continue;
+    }
+    std::sort(kvs.begin(), kvs.end(), [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    auto seq = runSeq_++;
+    auto path = folly::stringPrintf("%s/%d-%ld.sst", tmpPath_.c_str(), entry.first, seq);
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options);
+    auto status = writer.Open(path);
+    for (size_t i = 0; status.ok() && i < kvs.size(); i++) {
+      if (i + 1 < kvs.size() && kvs[i + 1].first == kvs[i].first) {
+        return duplicateKey(entry.first, kvs[i].first);
+      }
+      status = writer.Put(kvs[i].first, kvs[i].second);
+    }
+    if (status.ok()) {
+      status = writer.Finish();
+    }
+    if (!status.ok()) {
+      return Status::Error("Write run '%s' failed: %s", path.c_str(), status.ToString().c_str());
+    }
+    std::lock_guard<std::mutex> g(runsLock_);
+    runs_[entry.first].emplace_back(Run{seq, std::move(path)});
+  }
+  buffer->parts.clear();
+  buffer->bytes = 0;
+  return Status::OK();
+}
+
+Status SstGenerator::merge(PartitionID partId, std::vector<Run> runs) {
+  rocksdb::Options options;
+  std::vector<std::unique_ptr<rocksdb::SstFileReader>> readers;
+  std::vector<std::unique_ptr<rocksdb::Iterator>> iters;
+  rocksdb::ReadOptions readOptions;
+  readOptions.total_order_seek = true;
+  for (auto& run : runs) {
+    auto reader = std::make_unique<rocksdb::SstFileReader>(options);
+    auto status = reader->Open(run.path);
+    if (!status.ok()) {
+      return Status::Error("Open run '%s' failed: %s", run.path.c_str(), status.ToString().c_str());
+    }
+    iters.emplace_back(reader->NewIterator(readOptions));
+    iters.back()->SeekToFirst();
+    readers.emplace_back(std::move(reader));
+  }
+
+  // The smallest key on top
+  auto greater = [&](size_t a, size_t b) { return iters[a]->key().compare(iters[b]->key()) > 0; };
+  std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+  for (size_t i = 0; i < iters.size(); i++) {
+    if (iters[i]->Valid()) {
+      heap.emplace(i);
+    }
+  }
+
+  auto dir = folly::stringPrintf("%s/%d", FLAGS_output_path.c_str(), partId);
+  if (!fs::FileUtils::makeDir(dir)) {
+    return Status::Error("Make directory '%s' failed.", dir.c_str());
+  }
+  auto path = folly::stringPrintf("%s/%s_%d.sst", dir.c_str(), isEdge_ ? "edge" : "tag", schemaId_);
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options_);
+  auto status = writer.Open(path);
+  std::string lastKey;
+  bool first = true;
+  while (status.ok() && !heap.empty()) {
+    auto i = heap.top();
+    heap.pop();
+    auto key = iters[i]->key();
+    if (!first && key == rocksdb::Slice(lastKey)) {
+      return duplicateKey(partId, folly::StringPiece(key.data(), key.size()));
+    }
+    status = writer.Put(key, iters[i]->value());
+    lastKey = key.ToString();
+    first = false;
+    iters[i]->Next();
+    if (iters[i]->Valid()) {
+      heap.emplace(i);
+    } else if (!iters[i]->status().ok()) {
+      status = iters[i]->status();
+    }
+  }
+  if (status.ok()) {
+    status = writer.Finish();
+  }
+  if (!status.ok()) {
+    return Status::Error("Write '%s' failed: %s", path.c_str(), status.ToString().c_str());
+  }
+  iters.clear();
+  readers.clear();
+  for (auto& run : runs) {
+    fs::FileUtils::remove(run.path.c_str());
+  }
+  LOG(INFO) << "Merged " << runs.size() << " runs into " << path;
+  return Status::OK();
+}
+
+// static
+Status SstGenerator::duplicateKey(PartitionID partId, folly::StringPiece key) {
+  return Status::Error("Duplicate key %s in part %d, a vertex or an edge is in the input twice.",
+                       folly::hexlify(key).c_str(),
+                       partId);
+}
+
+}  // namespace storage
+}  // namespace nebula
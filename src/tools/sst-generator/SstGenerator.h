@@ -0,0 +1,138 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef TOOLS_SSTGENERATOR_SSTGENERATOR_H_
+#define TOOLS_SSTGENERATOR_SSTGENERATOR_H_
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <rocksdb/options.h>
+
+#include "clients/meta/MetaClient.h"
+#include "common/base/Base.h"
+#include "common/base/Status.h"
+#include "common/meta/ServerBasedSchemaManager.h"
+
+DECLARE_string(meta_server);
+DECLARE_string(space_name);
+DECLARE_string(tag);
+DECLARE_string(edge);
+DECLARE_string(files);
+DECLARE_string(columns);
+DECLARE_string(delimiter);
+DECLARE_bool(header);
+DECLARE_bool(with_rank);
+DECLARE_string(output_path);
+DECLARE_uint32(sort_buffer_mb);
+DECLARE_uint32(num_threads);
+DECLARE_bool(skip_bad_rows);
+
+namespace nebula {
+namespace storage {
+
+/**
+ * Build the SST files of a tag or an edge from the local csv files, to be
+ * ingested into a space without going through the raft of each insert.
+ *
+ * The rows are encoded the same way as the storage does for the inserts,
+ * with the keys of the indexes on the schema, and the reversed keys of the
+ * edges. The keys are sorted externally: each thread reads some of the files,
+ * buffers the keys by part, and spills them as a sorted run once the buffer
+ * is full. Then the runs of each part are merged into one SST file
+ * `<output_path>/<part>/<tag|edge>_<id>.sst', which is the layout expected by
+ * the DOWNLOAD and INGEST.
+ *
+ * A vertex or an edge must be in the input only once. Otherwise the index
+ * keys of the rows overwritten would be left in the SST files, so the
+ * generation fails once a key is found in many rows.
+ */
+class SstGenerator {
+ public:
+  SstGenerator() = default;
+
+  ~SstGenerator() = default;
+
+  Status init();
+
+  Status run();
+
+  // Split a line of csv, the fields could be quoted by '"' with '""' as an
+  // escaped '"' in it. Return false if the quotes are not closed.
+  static bool splitLine(folly::StringPiece line, char delimiter, std::vector<std::string>* fields);
+
+ private:
+  // The keys of a thread buffered by part before spilled as the runs
+  struct Buffer {
+    std::unordered_map<PartitionID, std::vector<std::pair<std::string, std::string>>> parts;
+    size_t bytes{0};
+  };
+
+  // A sorted run of a part spilled to the disk
+  struct Run {
+    int64_t seq;
+    std::string path;
+  };
+
+  Status initMeta();
+
+  Status initSchema();
+
+  Status initParams();
+
+  // Read a csv file into the buffer of the thread, spill it when full
+  Status readFile(const std::string& file, Buffer* buffer);
+
+  // Encode a row to the data and index keys
+  Status encodeRow(const std::vector<std::string>& fields, Buffer* buffer);
+
+  StatusOr<VertexID> toVid(const std::string& field) const;
+
+  StatusOr<Value> toValue(const std::string& field, nebula::cpp2::PropertyType type) const;
+
+  void add(PartitionID partId, std::string key, std::string val, Buffer* buffer);
+
+  Status spill(Buffer* buffer);
+
+  // Merge the runs of a part into the final SST file
+  Status merge(PartitionID partId, std::vector<Run> runs);
+
+  // The error of a key found in many rows
+  static Status duplicateKey(PartitionID partId, folly::StringPiece key);
+
+ private:
+  std::unique_ptr<meta::MetaClient> metaClient_;
+  std::unique_ptr<meta::ServerBasedSchemaManager> schemaMng_;
+  GraphSpaceID spaceId_;
+  int32_t spaceVidLen_;
+  nebula::cpp2::PropertyType spaceVidType_;
+  int32_t partNum_;
+
+  bool isEdge_{false};
+  // The tag id or the edge type
+  int32_t schemaId_;
+  std::shared_ptr<const meta::NebulaSchemaProvider> schema_;
+  std::vector<std::shared_ptr<meta::cpp2::IndexItem>> indexes_;
+  // The properties of the columns following the vid, or the src, dst and rank
+  std::vector<std::string> propNames_;
+  std::vector<nebula::cpp2::PropertyType> propTypes_;
+  size_t keyColumns_;
+  std::vector<std::string> files_;
+  char delimiter_;
+
+  // The options of the final SST files, same as the ones of the space
+  rocksdb::Options options_;
+  std::string tmpPath_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> pool_;
+
+  std::mutex runsLock_;
+  std::unordered_map<PartitionID, std::vector<Run>> runs_;
+  std::atomic<int64_t> runSeq_{0};
+  std::atomic<int64_t> rows_{0};
+  std::atomic<int64_t> badRows_{0};
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // TOOLS_SSTGENERATOR_SSTGENERATOR_H_
@@ -0,0 +1,104 @@
+/* Copyright (c) 2021 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/base/Base.h"
+#include "tools/sst-generator/SstGenerator.h"
+
+void printHelp() {
+  fprintf(stderr,
+          R"(  ./sst_generator --space_name=<space name> --tag=<tag name> --files=<csv files>
+  ./sst_generator --space_name=<space name> --edge=<edge name> --files=<csv files>
+
+required:
+       --space_name=<space name>
+         A space name must be given.
+
+       --tag=<tag name> | --edge=<edge name>
+         Either a tag or an edge must be given.
+
+       --files=<list of csv file>
+         A list of local csv files seperated by comma. Each row of a tag is
+           <vid>,<prop>,...
+         and each row of an edge is
+           <src>,<dst>[,<rank>],<prop>,...
+         An empty property is set to its default value or null.
+
+optional:
+       --meta_server=<ip:port,...>
+         A list of meta severs' ip:port seperated by comma.
+         Default: 127.0.0.1:45500
+
+       --columns=<list of property name>
+         The properties of the columns after the vid, or the src, dst and rank.
+         Default: all the properties of the schema in order.
+
+       --delimiter=<char>
+         Default: ,
+
+       --header=<true|false>
+         Skip the first line of each file.
+         Default: false
+
+       --with_rank=<true|false>
+         The rank of an edge follows its dst.
+         Default: false
+
+       --output_path=<path>
+         The SST files are written to <output_path>/<part id>/, copy them to
+         <data path>/nebula/<space id>/download/<part id>/ of the storage hosts
+         of the parts, or to the HDFS path to DOWNLOAD, then INGEST.
+         Default: ./sst
+
+       --sort_buffer_mb=<N>
+         The memory of each thread to sort the keys before spilling them.
+         Default: 256
+
+       --num_threads=<N>
+         Default: 8
+
+       --skip_bad_rows=<true|false>
+         Skip the rows failed to be parsed instead of giving up.
+         Default: false
+
+)");
+}
+
+void printParams() {
+  std::cout << "===========================PARAMS============================\n";
+  std::cout << "meta server: " << FLAGS_meta_server << "\n";
+  std::cout << "space name: " << FLAGS_space_name << "\n";
+  std::cout << "tag: " << FLAGS_tag << "\n";
+  std::cout << "edge: " << FLAGS_edge << "\n";
+  std::cout << "files: " << FLAGS_files << "\n";
+  std::cout << "columns: " << FLAGS_columns << "\n";
+  std::cout << "output path: " << FLAGS_output_path << "\n";
+  std::cout << "sort buffer: " << FLAGS_sort_buffer_mb << "MB\n";
+  std::cout << "threads: " << FLAGS_num_threads << "\n";
+  std::cout << "===========================PARAMS============================\n\n";
+}
+
+int main(int argc, char *argv[]) {
+  if (argc == 1) {
+    printHelp();
+    return EXIT_FAILURE;
+  } else {
+    folly::init(&argc, &argv, true);
+  }
+
+  printParams();
+
+  nebula::storage::SstGenerator generator;
+  auto status = generator.init();
+  if (!status.ok()) {
+    std::cerr << "Error: " << status << "\n\n";
+    return EXIT_FAILURE;
+  }
+  status = generator.run();
+  if (!status.ok()) {
+    std::cerr << "Error: " << status << "\n\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}